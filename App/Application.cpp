@@ -3,6 +3,9 @@
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
 #include "ControllerCore.h"
+#include "ScenarioRunner.h"
+#include <shellapi.h>
+#include <cstdlib>
 #include <sstream>
 
 namespace {
@@ -37,6 +40,43 @@ namespace {
         MessageBoxW(nullptr, message, title ? nullptr : L"Error", MB_OK | MB_ICONERROR);
     }
 
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Command line
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    struct LaunchOptions {
+        std::filesystem::path scenario;
+        std::filesystem::path report;
+    };
+
+    // %APPDATA%\SpectrumCpp\settings.ini, or the working directory when
+    // APPDATA is not set.
+    std::filesystem::path SettingsPath() {
+        if (const wchar_t* appData = _wgetenv(L"APPDATA"))
+            return std::filesystem::path(appData) / L"SpectrumCpp" / L"settings.ini";
+        return L"settings.ini";
+    }
+
+    // --scenario <file> [--report <file>]; anything else is ignored.
+    LaunchOptions ParseCommandLine() {
+        LaunchOptions options;
+
+        int argc = 0;
+        LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+        if (!argv) return options;
+
+        for (int i = 1; i + 1 < argc; ++i) {
+            const std::wstring_view arg = argv[i];
+            if (arg == L"--scenario") options.scenario = argv[++i];
+            else if (arg == L"--report") options.report = argv[++i];
+        }
+        LocalFree(argv);
+
+        if (!options.scenario.empty() && options.report.empty())
+            options.report = Spectrum::ScenarioRunner::DefaultReportPath(options.scenario);
+        return options;
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Application lifecycle
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -60,8 +100,15 @@ namespace {
 
         try {
             Spectrum::ControllerCore app(hInstance);
+            const LaunchOptions options = ParseCommandLine();
+            app.SetSettingsPath(SettingsPath());
 
-            if (!app.Initialize()) {
+            if (!options.scenario.empty() && !app.LoadScenario(options.scenario, options.report)) {
+                ShowError("Scenario Error",
+                    L"Failed to load the scenario file.\nSee the log for the offending line.");
+                exitCode = -1;
+            }
+            else if (!app.Initialize()) {
                 ShowError("Initialization Error",
                     "Failed to initialize.\n\n"
                     "Possible causes:\n"
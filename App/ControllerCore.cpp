@@ -1,15 +1,22 @@
 ﻿#include "ControllerCore.h"
+#include "ScenarioRunner.h"
+#include "SettingsStore.h"
 
 #include "Audio/AudioManager.h"
+#include "Audio/Processing/SpectrumSampler.h"
 #include "Common/EventBus.h"
 #include "Graphics/IRenderer.h"
+#include "Graphics/RenderCalibrator.h"
 #include "Graphics/RendererManager.h"
+#include "Graphics/ViewLayout.h"
+#include "Platform/ControlServer.h"
 #include "Platform/InputManager.h"
 #include "Platform/MainWindow.h"
 #include "Platform/MessageHandler.h"
 #include "Platform/WindowManager.h"
 #include "UI/UIManager.h"
 
+#include <chrono>
 #include <thread>
 
 namespace Spectrum {
@@ -35,6 +42,26 @@ namespace Spectrum {
         Shutdown();
     }
 
+    bool ControllerCore::LoadScenario(const std::filesystem::path& script,
+        const std::filesystem::path& report)
+    {
+        auto scenario = std::make_unique<ScenarioRunner>(kFrameTime);
+        if (!scenario->Load(script)) return false;
+
+        m_scenario = std::move(scenario);
+        m_scenarioReport = report;
+        return true;
+    }
+
+    void ControllerCore::SetSettingsPath(std::filesystem::path path) {
+        m_settingsPath = std::move(path);
+    }
+
+    std::filesystem::path ControllerCore::CostProfilePath() const {
+        if (m_settingsPath.empty()) return {};
+        return m_settingsPath.parent_path() / "render_profile.ini";
+    }
+
     bool ControllerCore::Initialize() {
         if (!InitializeSubsystems()) return false;
         m_timer.Reset();
@@ -49,7 +76,22 @@ namespace Spectrum {
     }
 
     void ControllerCore::Shutdown() {
+        // Stops publishing before the bus goes away.
+        m_controlServer.reset();
+
+        if (m_scenario) {
+            m_scenario->WriteReport(m_scenarioReport, kFrameTime * 1000.0f);
+            m_scenario.reset();
+        }
+
+        if (m_settings) {
+            CaptureSettings();
+            m_settings->Shutdown();
+            m_settings.reset();
+        }
+
         if (m_audioMgr) m_audioMgr->Shutdown();
+        m_calibrator.reset();
         m_rendererMgr.reset();
         m_audioMgr.reset();
         m_inputMgr.reset();
@@ -63,6 +105,7 @@ namespace Spectrum {
 
     void ControllerCore::OnResize(int w, int h) {
         if (m_rendererMgr) m_rendererMgr->OnResize(w, h);
+        m_dynamicRes.Reset();
     }
 
     void ControllerCore::OnUIResize(int w, int h) {
@@ -85,9 +128,10 @@ namespace Spectrum {
     }
 
     void ControllerCore::SetPrimaryColor(const Color& color) {
+        m_primaryColor = color;
+
         if (m_rendererMgr)
-            if (auto* r = m_rendererMgr->GetCurrentRenderer())
-                r->SetPrimaryColor(color);
+            m_rendererMgr->SetPrimaryColor(color);
     }
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
@@ -95,6 +139,16 @@ namespace Spectrum {
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
     bool ControllerCore::InitializeSubsystems() {
+        // Settings come first so every subsystem is built in its saved state.
+        // A scenario starts from the defaults and must not overwrite them.
+        const AppSettings defaults;
+        if (!m_scenario && !m_settingsPath.empty()) {
+            m_settings = std::make_unique<SettingsStore>(m_settingsPath);
+            m_settings->Load();
+        }
+        const AppSettings& saved = m_settings ? m_settings->Get() : defaults;
+        m_primaryColor = saved.primaryColor;
+
         m_eventBus = std::make_unique<EventBus>();
 
         m_windowMgr = std::make_unique<Platform::WindowManager>(
@@ -103,17 +157,69 @@ namespace Spectrum {
 
         m_inputMgr = std::make_unique<Platform::InputManager>();
 
-        m_audioMgr = std::make_unique<AudioManager>(m_eventBus.get());
+        m_audioMgr = std::make_unique<AudioManager>(m_eventBus.get(), saved.audio);
         if (!m_audioMgr->Initialize()) return false;
 
         m_rendererMgr = std::make_unique<RendererManager>(
             m_eventBus.get(), m_windowMgr.get());
-        if (!m_rendererMgr->Initialize()) return false;
+        if (!m_rendererMgr->Initialize(saved.style, saved.quality)) return false;
+
+        // Tuning from a machine-specific profile would make runs incomparable.
+        if (!m_scenario && !CostProfilePath().empty())
+            m_costProfile.Load(CostProfilePath());
+        m_eventBus->Subscribe(InputAction::Calibrate, [this] { ToggleCalibration(); });
+        m_eventBus->Subscribe<Platform::ControlEvent>([this](const Platform::ControlEvent& e) {
+            m_pendingControls[static_cast<size_t>(e.setting)] = e;
+        });
+
+        // Remote control is optional; a scenario must not be steered.
+        if (!m_scenario) {
+            m_controlServer = std::make_unique<Platform::ControlServer>(m_eventBus.get());
+            if (!m_controlServer->Initialize()) m_controlServer.reset();
+        }
 
-        m_rendererMgr->SetCurrentRenderer(m_rendererMgr->GetCurrentStyle());
+        if (m_settings)
+            RestoreSettings();
         return true;
     }
 
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Settings
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    void ControllerCore::RestoreSettings() {
+        const AppSettings& saved = m_settings->Get();
+
+        if (saved.frequencyZoomed)
+            m_audioMgr->SetFrequencyWindow(saved.windowMinHz, saved.windowMaxHz, false);
+
+        SetPrimaryColor(saved.primaryColor);
+    }
+
+    // Snapshots the live state each frame; the store ignores unchanged
+    // snapshots and debounces the rest onto its writer thread.
+    void ControllerCore::CaptureSettings() {
+        if (!m_settings || !m_audioMgr || !m_rendererMgr) return;
+
+        AppSettings s;
+        s.audio = m_audioMgr->GetConfig();
+        s.frequencyZoomed = m_audioMgr->IsFrequencyZoomed();
+        s.windowMinHz = m_audioMgr->GetWindowMinHz();
+        s.windowMaxHz = m_audioMgr->GetWindowMaxHz();
+        s.style = m_rendererMgr->GetCurrentStyle();
+        s.quality = m_rendererMgr->GetQuality();
+        s.primaryColor = m_primaryColor;
+
+        // Tuned values depend on the style and window at hand; the file
+        // keeps what the user picked, so the next start tunes from that.
+        if (m_userQuality != RenderQuality::Count && s.quality == m_appliedQuality)
+            s.quality = m_userQuality;
+        if (m_userBarCount != 0 && s.audio.barCount == m_appliedBarCount)
+            s.audio.barCount = m_userBarCount;
+
+        m_settings->Update(s);
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
     // Main loop
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
@@ -130,7 +236,15 @@ namespace Spectrum {
             if (!m_windowMgr->IsRunning()) break;
 
             if (ShouldProcessFrame()) {
+                const auto start = std::chrono::steady_clock::now();
                 ProcessFrame();
+
+                if (m_scenario) {
+                    m_scenario->RecordFrame(std::chrono::duration<float, std::milli>(
+                        std::chrono::steady_clock::now() - start).count());
+                    if (m_scenario->IsFinished()) OnCloseRequest();
+                }
+
                 ++m_frameCounter;
                 m_timer.Reset();
             }
@@ -145,11 +259,19 @@ namespace Spectrum {
 
         ProcessInput(fs.deltaTime);
 
+        // A new style starts over at full resolution, after its tuning.
+        if (!m_calibrator && m_rendererMgr && m_rendererMgr->GetCurrentStyle() != m_tunedStyle) {
+            ApplyCostProfile();
+            m_dynamicRes.Reset();
+        }
+
         if (fs.isOverlay || fs.isActive)
             RenderVisualization(fs);
 
         if (m_windowMgr && m_windowMgr->IsUIWindowVisible())
             RenderUI();
+
+        CaptureSettings();
     }
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
@@ -176,35 +298,206 @@ namespace Spectrum {
     void ControllerCore::ProcessInput(float dt) {
         if (!m_inputMgr || !m_eventBus) return;
 
-        m_inputMgr->Update();
+        // A scenario replaces the keyboard, so stray keys cannot skew a run.
+        if (m_scenario) {
+            for (const auto& cmd : m_scenario->TakeDue(m_frameCounter))
+                ExecuteScenarioCommand(cmd);
+        }
+        else {
+            m_inputMgr->Update();
+
+            for (const auto& action : m_inputMgr->FlushActions())
+                m_eventBus->Publish(action);
+        }
 
-        for (const auto& action : m_inputMgr->FlushActions())
-            m_eventBus->Publish(action);
+        // The one place handlers run, whichever thread published.
+        m_eventBus->Dispatch();
+        ApplyPendingControls();
 
         if (m_audioMgr)
             m_audioMgr->Update(dt);
     }
 
+    // However many updates arrived, each setting is applied at most once
+    // per frame, after the frame's actions.
+    void ControllerCore::ApplyPendingControls() {
+        for (auto& pending : m_pendingControls) {
+            if (!pending) continue;
+            ApplyControl(*pending);
+            pending.reset();
+        }
+    }
+
+    void ControllerCore::ApplyControl(const Platform::ControlEvent& e) {
+        if (!m_audioMgr || !m_rendererMgr) return;
+
+        using ControlProtocol::Setting;
+        switch (e.setting) {
+        case Setting::Style:
+            m_rendererMgr->SetCurrentRenderer(static_cast<RenderStyle>(e.value));
+            break;
+        case Setting::Quality:
+            m_rendererMgr->SetQuality(static_cast<RenderQuality>(e.value));
+            break;
+        case Setting::BarCount:
+            m_audioMgr->SetBarCount(e.value);
+            break;
+        case Setting::FFTWindow:
+            m_audioMgr->SetFFTWindowByName(
+                std::string(Helpers::Utils::ToString(static_cast<FFTWindowType>(e.value))));
+            break;
+        case Setting::SpectrumScale:
+            m_audioMgr->SetSpectrumScaleByName(
+                std::string(Helpers::Utils::ToString(static_cast<SpectrumScale>(e.value))));
+            break;
+        case Setting::Animation:
+            if (m_audioMgr->IsAnimating() != (e.value != 0))
+                m_audioMgr->ToggleAnimation();
+            break;
+        case Setting::Amplification:
+            m_audioMgr->SetAmplification(e.amount);
+            break;
+        case Setting::Color:
+            SetPrimaryColor(e.color);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void ControllerCore::ExecuteScenarioCommand(const ScenarioCommand& cmd) {
+        if (!m_audioMgr || !m_rendererMgr) return;
+
+        switch (cmd.type) {
+        case ScenarioCommandType::Action:
+            m_eventBus->Publish(cmd.action);
+            break;
+        case ScenarioCommandType::Style:
+            m_rendererMgr->SetCurrentRenderer(cmd.style);
+            break;
+        case ScenarioCommandType::Quality:
+            m_rendererMgr->SetQuality(cmd.quality);
+            break;
+        case ScenarioCommandType::Bars:
+            m_audioMgr->SetBarCount(cmd.count);
+            break;
+        case ScenarioCommandType::Window:
+            m_audioMgr->SetFFTWindowByName(cmd.text);
+            break;
+        case ScenarioCommandType::Scale:
+            m_audioMgr->SetSpectrumScaleByName(cmd.text);
+            break;
+        case ScenarioCommandType::Animation:
+            if (m_audioMgr->IsAnimating() != cmd.enabled)
+                m_audioMgr->ToggleAnimation();
+            break;
+        case ScenarioCommandType::Track:
+            if (!m_audioMgr->PlayTrack(std::filesystem::u8path(cmd.text)))
+                LOG_WARNING("ControllerCore: Scenario track not playable: " << cmd.text);
+            break;
+        default:
+            break;
+        }
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
     // Rendering
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
     void ControllerCore::RenderVisualization(const FrameState& fs) {
         auto* engine = m_windowMgr->GetVisualizationEngine();
-        if (!engine || !engine->BeginDraw()) return;
+        if (!engine) return;
+
+        if (m_calibrator) {
+            RenderCalibration(engine);
+            return;
+        }
+
+        auto* renderer = m_rendererMgr ? m_rendererMgr->GetCurrentRenderer() : nullptr;
+        // The analyzer plays frames back late enough to have both ends of
+        // the blend in hand, so this is simply now.
+        const int64_t presentNs = SpectrumSampler::NowNs();
+        const SpectrumData spectrum = m_audioMgr ? m_audioMgr->GetSpectrumAt(presentNs) : SpectrumData{};
+
+        if (auto* layout = m_rendererMgr ? m_rendererMgr->GetLayout() : nullptr) {
+            RenderLayout(engine, *layout, spectrum, fs);
+            return;
+        }
+
+        // Silence or a paused track settles most renderers; the previous
+        // frame is still on screen, so drawing and presenting it is wasted.
+        // Scenario runs draw every frame so their timings cover each one.
+        FrameChangeDetector::FrameKey key;
+        key.renderer = renderer;
+        key.quality = m_rendererMgr ? m_rendererMgr->GetQuality() : RenderQuality::Medium;
+        key.color = m_primaryColor;
+        key.width = engine->GetWidth();
+        key.height = engine->GetHeight();
+        key.overlay = fs.isOverlay;
+        key.buttonHovered = m_settingsBtnRect.Contains(fs.mouse.position);
+        if (!m_scenario && !m_frameDetector.ShouldRender(key, spectrum)) return;
+
+        // Scenario runs stay at full resolution so they compare like for like.
+        engine->SetRenderScale(m_scenario ? 1.0f : m_dynamicRes.GetScale());
+        if (!engine->BeginDraw()) {
+            m_frameDetector.Invalidate();
+            return;
+        }
+
+        // Timed up to a Flush after the upscale, not to EndDraw: that one
+        // waits for vsync. GPU backpressure still shows up in the Flush.
+        const auto start = std::chrono::steady_clock::now();
 
         engine->Clear(fs.isOverlay ? Color::Transparent() : kClearColor);
 
-        if (m_audioMgr && m_rendererMgr)
-            if (auto* r = m_rendererMgr->GetCurrentRenderer())
-                r->Render(engine->GetCanvas(), m_audioMgr->GetSpectrum());
+        if (renderer)
+            renderer->Render(engine->GetCanvas(), spectrum, fs.deltaTime);
+
+        engine->ResolveScaled();
+        if (auto* rt = engine->GetCanvas().GetRenderTarget()) rt->Flush();
+        m_dynamicRes.Update(std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - start).count());
 
+        // Drawn after the resolve, so it stays sharp at any scale.
         RenderSettingsButton(fs);
 
         if (engine->EndDraw() == D2DERR_RECREATE_TARGET)
             HandleDeviceLoss(engine);
     }
 
+    // Every view reads the same spectrum snapshot. Views that are not due
+    // keep their pixels, so only a lost or resized target is cleared whole.
+    void ControllerCore::RenderLayout(RenderEngine* engine, ViewLayout& layout,
+        const SpectrumData& spectrum, const FrameState& fs)
+    {
+        // Whatever the single-renderer path shows next must be drawn fresh.
+        m_frameDetector.Invalidate();
+
+        // The button blends over the view beneath it; a hover change needs
+        // that view repainted to take the old highlight away.
+        const bool hovered = m_settingsBtnRect.Contains(fs.mouse.position);
+        if (hovered != m_btnHovered) {
+            layout.InvalidateArea(m_settingsBtnRect);
+            m_btnHovered = hovered;
+        }
+
+        engine->SetRenderScale(1.0f);
+        if (!engine->BeginDraw()) return;
+
+        const bool redrawAll = !engine->HasRetainedFrame();
+        const Color background = fs.isOverlay ? Color::Transparent() : kClearColor;
+        if (redrawAll)
+            engine->Clear(background);
+
+        layout.Render(engine->GetCanvas(), spectrum, fs.deltaTime, redrawAll, background);
+
+        if (layout.WasRedrawn(m_settingsBtnRect))
+            RenderSettingsButton(fs);
+
+        if (engine->EndDraw() == D2DERR_RECREATE_TARGET)
+            HandleDeviceLoss(engine);
+    }
+
     void ControllerCore::RenderUI() {
         auto* ui = m_windowMgr->GetUIManager();
         auto* engine = m_windowMgr->GetUIEngine();
@@ -239,6 +532,8 @@ namespace Spectrum {
     void ControllerCore::HandleDeviceLoss(RenderEngine* engine) {
         if (!m_windowMgr || !engine) return;
 
+        m_frameDetector.Invalidate();
+
         const bool isUI = (engine == m_windowMgr->GetUIEngine());
         const bool ok = isUI
             ? m_windowMgr->HandleUIResize(engine->GetWidth(), engine->GetHeight(), true)
@@ -249,4 +544,94 @@ namespace Spectrum {
                 << (isUI ? "UI" : "viz") << ")");
     }
 
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Cost calibration
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    // Plugins are left out: the one behind the Plugin slot can be swapped
+    // at any time, so a stored model for it would not stay true.
+    void ControllerCore::ToggleCalibration() {
+        if (m_calibrator) {
+            m_calibrator.reset();
+            m_frameDetector.Invalidate();
+            LOG_INFO("ControllerCore: Calibration cancelled");
+            return;
+        }
+        if (!m_rendererMgr) return;
+
+        std::vector<RenderStyle> styles;
+        for (int i = 0; i < static_cast<int>(RenderStyle::Count); ++i) {
+            const auto style = static_cast<RenderStyle>(i);
+            if (style != RenderStyle::Plugin && m_rendererMgr->IsAvailable(style))
+                styles.push_back(style);
+        }
+
+        m_calibrator = std::make_unique<RenderCalibrator>(styles);
+        LOG_INFO("ControllerCore: Calibrating " << styles.size() << " renderers");
+    }
+
+    void ControllerCore::RenderCalibration(RenderEngine* engine) {
+        // The sweep measures renderers at the window's own resolution.
+        engine->SetRenderScale(1.0f);
+        if (!engine->BeginDraw()) return;
+
+        engine->Clear(kClearColor);
+        const bool more = m_calibrator->Step(
+            engine->GetCanvas(), engine->GetWidth(), engine->GetHeight());
+
+        if (engine->EndDraw() == D2DERR_RECREATE_TARGET)
+            HandleDeviceLoss(engine);
+
+        if (more) return;
+
+        RenderCostProfile profile = m_calibrator->BuildProfile();
+        m_calibrator.reset();
+
+        if (profile.IsEmpty()) {
+            LOG_WARNING("ControllerCore: Calibration produced no usable models");
+        }
+        else {
+            m_costProfile = std::move(profile);
+            if (!CostProfilePath().empty()) m_costProfile.Save(CostProfilePath());
+            LOG_INFO("ControllerCore: Calibration finished");
+        }
+
+        // Re-tune the current style and repaint whatever the sweep left.
+        m_tunedStyle = RenderStyle::Count;
+        m_frameDetector.Invalidate();
+        engine->InvalidateAll();
+    }
+
+    // Runs once per style switch: picks the best quality, up to the user's
+    // own, whose predicted cost fits the budget at the user's bar count,
+    // and only lowers the bar count when even Low does not fit. A quality
+    // or bar count the user set by hand since the last adjustment becomes
+    // the new target.
+    void ControllerCore::ApplyCostProfile() {
+        const RenderStyle style = m_rendererMgr->GetCurrentStyle();
+        m_tunedStyle = style;
+
+        auto* engine = m_windowMgr ? m_windowMgr->GetVisualizationEngine() : nullptr;
+        if (!engine || !m_audioMgr || m_rendererMgr->GetLayout() || !m_costProfile.Has(style)) return;
+
+        const size_t current = m_audioMgr->GetConfig().barCount;
+        if (current != m_appliedBarCount) m_userBarCount = current;
+
+        const RenderQuality quality = m_rendererMgr->GetQuality();
+        if (quality != m_appliedQuality) m_userQuality = quality;
+
+        const CostRecommendation rec = m_costProfile.Recommend(style,
+            engine->GetWidth(), engine->GetHeight(), m_userBarCount,
+            kRenderBudgetMs, m_userQuality);
+
+        m_rendererMgr->SetQuality(rec.quality);
+        m_appliedQuality = m_rendererMgr->GetQuality();
+        if (rec.bars != current) m_audioMgr->SetBarCount(rec.bars);
+        m_appliedBarCount = m_audioMgr->GetConfig().barCount;
+
+        LOG_INFO("ControllerCore: " << m_rendererMgr->GetCurrentRendererName().data() << " tuned to "
+            << m_rendererMgr->GetQualityName().data() << ", " << m_appliedBarCount
+            << " bars (~" << rec.predictedMs << " ms)");
+    }
+
 } // namespace Spectrum
\ No newline at end of file
@@ -7,17 +7,30 @@
 
 #include "Common/Common.h"
 #include "Graphics/API/GraphicsHelpers.h"
+#include "Graphics/DynamicResolution.h"
+#include "Graphics/FrameChangeDetector.h"
+#include "Graphics/RenderCostProfile.h"
+#include "Platform/ControlDecoder.h"
 #include "Platform/MessageHandlerBase.h"
+#include <array>
+#include <filesystem>
 #include <memory>
+#include <optional>
 
 namespace Spectrum {
 
     class AudioManager;
     class EventBus;
+    class RenderCalibrator;
     class RendererManager;
     class RenderEngine;
+    class ScenarioRunner;
+    class SettingsStore;
+    struct ScenarioCommand;
+    class ViewLayout;
 
     namespace Platform {
+        class ControlServer;
         class WindowManager;
         class InputManager;
     }
@@ -46,6 +59,16 @@ namespace Spectrum {
         ControllerCore(const ControllerCore&) = delete;
         ControllerCore& operator=(const ControllerCore&) = delete;
 
+        // Before Initialize: replays `script` on a virtual clock instead of
+        // taking input, leaves the saved settings alone, and writes the
+        // frame timing report to `report` on shutdown.
+        [[nodiscard]] bool LoadScenario(const std::filesystem::path& script,
+            const std::filesystem::path& report);
+
+        // Before Initialize: the file settings are loaded from and saved
+        // to. Without one the defaults are used and nothing is written.
+        void SetSettingsPath(std::filesystem::path path);
+
         [[nodiscard]] bool Initialize();
         void Run();
         void Shutdown();
@@ -67,21 +90,37 @@ namespace Spectrum {
         [[nodiscard]] RendererManager* GetRendererManager() const noexcept { return m_rendererMgr.get(); }
         [[nodiscard]] AudioManager* GetAudioManager()   const noexcept { return m_audioMgr.get(); }
         [[nodiscard]] Platform::WindowManager* GetWindowManager()  const noexcept { return m_windowMgr.get(); }
+        [[nodiscard]] const Color& GetPrimaryColor() const noexcept { return m_primaryColor; }
 
     private:
         bool InitializeSubsystems();
+        void RestoreSettings();
+        void CaptureSettings();
         void MainLoop();
         void ProcessFrame();
 
         [[nodiscard]] FrameState CollectFrameState() const;
         void ProcessInput(float dt);
+        void ExecuteScenarioCommand(const ScenarioCommand& cmd);
+        void ApplyPendingControls();
+        void ApplyControl(const Platform::ControlEvent& e);
         void RenderVisualization(const FrameState& fs);
+        void RenderLayout(RenderEngine* engine, ViewLayout& layout,
+            const SpectrumData& spectrum, const FrameState& fs);
         void RenderUI();
         void RenderSettingsButton(const FrameState& fs);
         void HandleDeviceLoss(RenderEngine* engine);
 
+        void ToggleCalibration();
+        void RenderCalibration(RenderEngine* engine);
+        void ApplyCostProfile();
+
+        // Beside the settings file; empty when settings are not persisted.
+        [[nodiscard]] std::filesystem::path CostProfilePath() const;
+
+        // Scenario frames run back to back; their clock is the frame count.
         [[nodiscard]] bool ShouldProcessFrame() const {
-            return m_timer.GetElapsedSeconds() >= kFrameTime;
+            return m_scenario || m_timer.GetElapsedSeconds() >= kFrameTime;
         }
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -91,21 +130,48 @@ namespace Spectrum {
         static constexpr float kFps = 60.0f;
         static constexpr float kFrameTime = 1.0f / kFps;
 
+        // Share of the frame a renderer may take by the cost profile; the
+        // rest is UI, presentation and scheduling slack.
+        static constexpr float kRenderBudgetMs = kFrameTime * 1000.0f * 0.5f;
+
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // State
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
         HINSTANCE m_hInstance;
 
+        std::unique_ptr<SettingsStore>              m_settings;
         std::unique_ptr<EventBus>                   m_eventBus;
         std::unique_ptr<Platform::WindowManager>    m_windowMgr;
         std::unique_ptr<AudioManager>               m_audioMgr;
         std::unique_ptr<RendererManager>             m_rendererMgr;
         std::unique_ptr<Platform::InputManager>      m_inputMgr;
+        std::unique_ptr<RenderCalibrator>           m_calibrator;
+        std::unique_ptr<ScenarioRunner>             m_scenario;
+        std::unique_ptr<Platform::ControlServer>    m_controlServer;
+        std::filesystem::path                       m_scenarioReport;
+        std::filesystem::path                       m_settingsPath;
 
         Helpers::Utils::Timer m_timer;
         uint64_t m_frameCounter = 0;
         Rect     m_settingsBtnRect;
+        FrameChangeDetector m_frameDetector;
+        RenderCostProfile   m_costProfile;
+        DynamicResolution   m_dynamicRes{ kRenderBudgetMs };
+        RenderStyle m_tunedStyle = RenderStyle::Count;
+        // What the user picked versus what tuning last applied; a value
+        // that differs from the applied one was changed by hand.
+        RenderQuality m_userQuality = RenderQuality::Count;
+        RenderQuality m_appliedQuality = RenderQuality::Count;
+        size_t   m_userBarCount = 0;
+        size_t   m_appliedBarCount = 0;
+        Color    m_primaryColor;
+        bool     m_btnHovered = false;
+
+        // Latest value per setting from the control pipe, applied once
+        // per frame after dispatch.
+        std::array<std::optional<Platform::ControlEvent>,
+            static_cast<size_t>(ControlProtocol::Setting::Count)> m_pendingControls;
     };
 
 } // namespace Spectrum
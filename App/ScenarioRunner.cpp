@@ -0,0 +1,287 @@
+#include "ScenarioRunner.h"
+#include "Common/EnumNames.h"
+#include "Common/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+
+namespace Spectrum {
+
+    namespace {
+        constexpr int kReportVersion = 1;
+        constexpr const char* kDefaultSegment = "default";
+
+        std::string Trim(const std::string& s) {
+            const size_t first = s.find_first_not_of(" \t\r");
+            if (first == std::string::npos) return {};
+            const size_t last = s.find_last_not_of(" \t\r");
+            return s.substr(first, last - first + 1);
+        }
+
+        bool ParseCommand(const std::string& name, const std::string& arg, ScenarioCommand& cmd) {
+            if (name == "segment") {
+                cmd.type = ScenarioCommandType::Segment;
+                cmd.text = arg;
+                return !arg.empty();
+            }
+            if (name == "action") {
+                cmd.type = ScenarioCommandType::Action;
+                return Helpers::Utils::FromString(arg, cmd.action, static_cast<int>(InputAction::Exit) + 1);
+            }
+            if (name == "style") {
+                cmd.type = ScenarioCommandType::Style;
+                return Helpers::Utils::FromString(arg, cmd.style);
+            }
+            if (name == "quality") {
+                cmd.type = ScenarioCommandType::Quality;
+                return Helpers::Utils::FromString(arg, cmd.quality);
+            }
+            if (name == "bars") {
+                cmd.type = ScenarioCommandType::Bars;
+                std::istringstream in(arg);
+                in.imbue(std::locale::classic());
+                return static_cast<bool>(in >> cmd.count) && cmd.count > 0;
+            }
+            if (name == "window") {
+                FFTWindowType window;
+                cmd.type = ScenarioCommandType::Window;
+                cmd.text = arg;
+                return Helpers::Utils::FromString(arg, window);
+            }
+            if (name == "scale") {
+                SpectrumScale scale;
+                cmd.type = ScenarioCommandType::Scale;
+                cmd.text = arg;
+                return Helpers::Utils::FromString(arg, scale);
+            }
+            if (name == "animation") {
+                cmd.type = ScenarioCommandType::Animation;
+                cmd.enabled = arg == "on";
+                return arg == "on" || arg == "off";
+            }
+            if (name == "track") {
+                cmd.type = ScenarioCommandType::Track;
+                cmd.text = arg;
+                return !arg.empty();
+            }
+            if (name == "end") {
+                cmd.type = ScenarioCommandType::End;
+                return arg.empty();
+            }
+            return false;
+        }
+
+        // Nearest rank on sorted samples.
+        float Percentile(const std::vector<float>& sorted, float p) {
+            if (sorted.empty()) return 0.0f;
+            const auto rank = static_cast<size_t>(std::ceil(p * static_cast<float>(sorted.size())));
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        }
+
+        void WriteJsonString(std::ostream& out, const std::string& s) {
+            out << '"';
+            for (const char c : s) {
+                switch (c) {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    else
+                        out << c;
+                }
+            }
+            out << '"';
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Loading
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    bool ScenarioRunner::Parse(
+        const std::string& text,
+        float frameSeconds,
+        std::vector<ScenarioCommand>& commands,
+        std::string& error
+    ) {
+        std::vector<ScenarioCommand> result;
+        std::istringstream in(text);
+        std::string line;
+        uint64_t lastFrame = 0;
+        int lineNumber = 0;
+
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            const size_t hash = line.find('#');
+            line = Trim(line.substr(0, hash));
+            if (line.empty()) continue;
+
+            std::istringstream fields(line);
+            fields.imbue(std::locale::classic());
+            double seconds = -1.0;
+            std::string name;
+            fields >> seconds >> name;
+
+            std::string arg;
+            std::getline(fields, arg);
+            arg = Trim(arg);
+
+            ScenarioCommand cmd;
+            if (!(seconds >= 0.0) || !ParseCommand(name, arg, cmd)) {
+                error = "line " + std::to_string(lineNumber) + ": cannot parse '" + line + "'";
+                return false;
+            }
+
+            cmd.frame = static_cast<uint64_t>(std::llround(seconds / frameSeconds));
+            if (cmd.frame < lastFrame) {
+                error = "line " + std::to_string(lineNumber) + ": time goes backwards";
+                return false;
+            }
+            lastFrame = cmd.frame;
+            result.push_back(std::move(cmd));
+        }
+
+        commands = std::move(result);
+        return true;
+    }
+
+    bool ScenarioRunner::Load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            LOG_ERROR("ScenarioRunner: Cannot open " << path.string());
+            return false;
+        }
+
+        std::ostringstream text;
+        text << file.rdbuf();
+
+        std::string error;
+        if (!Parse(text.str(), m_frameSeconds, m_commands, error)) {
+            LOG_ERROR("ScenarioRunner: " << path.string() << ", " << error);
+            return false;
+        }
+
+        m_source = path;
+        m_segments.clear();
+        m_next = 0;
+        m_finished = false;
+
+        LOG_INFO("ScenarioRunner: Loaded " << m_commands.size() << " commands from " << path.string());
+        return true;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Running
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    Span<const ScenarioCommand> ScenarioRunner::TakeDue(uint64_t frame) {
+        const size_t first = m_next;
+        while (m_next < m_commands.size() && m_commands[m_next].frame <= frame) {
+            const auto& cmd = m_commands[m_next++];
+            if (cmd.type == ScenarioCommandType::Segment)
+                m_segments.push_back({ cmd.text, {} });
+            else if (cmd.type == ScenarioCommandType::End)
+                m_finished = true;
+        }
+
+        // A script without an end stops after its last command's frame.
+        if (m_next == m_commands.size()) m_finished = true;
+
+        return Span<const ScenarioCommand>(m_commands.data() + first, m_next - first);
+    }
+
+    void ScenarioRunner::RecordFrame(float ms) {
+        if (m_segments.empty()) m_segments.push_back({ kDefaultSegment, {} });
+        m_segments.back().frameMs.push_back(ms);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Reporting
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    std::vector<ScenarioSegmentStats> ScenarioRunner::Summarize(float budgetMs) const {
+        std::vector<ScenarioSegmentStats> result;
+        result.reserve(m_segments.size());
+
+        for (const auto& segment : m_segments) {
+            ScenarioSegmentStats stats;
+            stats.name = segment.name;
+            stats.frames = segment.frameMs.size();
+
+            if (!segment.frameMs.empty()) {
+                std::vector<float> sorted = segment.frameMs;
+                std::sort(sorted.begin(), sorted.end());
+
+                double sum = 0.0;
+                for (const float ms : sorted) {
+                    sum += ms;
+                    if (ms > budgetMs) ++stats.overBudget;
+                }
+
+                stats.meanMs = static_cast<float>(sum / static_cast<double>(sorted.size()));
+                stats.p50Ms = Percentile(sorted, 0.50f);
+                stats.p95Ms = Percentile(sorted, 0.95f);
+                stats.p99Ms = Percentile(sorted, 0.99f);
+                stats.maxMs = sorted.back();
+            }
+            result.push_back(std::move(stats));
+        }
+        return result;
+    }
+
+    // One segment per line so that reports from two builds diff cleanly.
+    std::string ScenarioRunner::BuildReport(float budgetMs) const {
+        std::ostringstream out;
+        out.imbue(std::locale::classic());
+        out << std::fixed << std::setprecision(3);
+
+        out << "{\n  \"version\": " << kReportVersion << ",\n  \"scenario\": ";
+        WriteJsonString(out, m_source.filename().u8string());
+        out << ",\n  \"frame_budget_ms\": " << budgetMs << ",\n  \"segments\": [";
+
+        const auto stats = Summarize(budgetMs);
+        for (size_t i = 0; i < stats.size(); ++i) {
+            const auto& s = stats[i];
+            out << (i == 0 ? "\n" : ",\n") << "    { \"name\": ";
+            WriteJsonString(out, s.name);
+            out << ", \"frames\": " << s.frames
+                << ", \"mean_ms\": " << s.meanMs
+                << ", \"p50_ms\": " << s.p50Ms
+                << ", \"p95_ms\": " << s.p95Ms
+                << ", \"p99_ms\": " << s.p99Ms
+                << ", \"max_ms\": " << s.maxMs
+                << ", \"over_budget\": " << s.overBudget << " }";
+        }
+        out << (stats.empty() ? "]\n}\n" : "\n  ]\n}\n");
+        return out.str();
+    }
+
+    bool ScenarioRunner::WriteReport(const std::filesystem::path& path, float budgetMs) const {
+        std::error_code ec;
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path(), ec);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file || !(file << BuildReport(budgetMs)).flush()) {
+            LOG_ERROR("ScenarioRunner: Cannot write report " << path.string());
+            return false;
+        }
+        LOG_INFO("ScenarioRunner: Report written to " << path.string());
+        return true;
+    }
+
+    std::filesystem::path ScenarioRunner::DefaultReportPath(const std::filesystem::path& script) {
+        auto report = script;
+        report.replace_extension(L".report.json");
+        return report;
+    }
+
+} // namespace Spectrum
@@ -0,0 +1,110 @@
+#ifndef SPECTRUM_CPP_SCENARIO_RUNNER_H
+#define SPECTRUM_CPP_SCENARIO_RUNNER_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// ScenarioRunner - replays a scripted session for performance runs.
+//
+// A scenario is a text file of timed commands, one per line:
+//
+//     # seconds  command    argument
+//     0          segment    bars-high
+//     0          style      Bars
+//     0          quality    High
+//     0          animation  on
+//     10         action     SwitchRenderer
+//     20         end
+//
+// Time is virtual: it advances by exactly one frame interval per frame,
+// so every run issues the same commands on the same frames however fast
+// the machine is. Frame times are kept per segment and written out as
+// JSON, so two builds can be compared by diffing their reports.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Span.h"
+#include "Common/Types.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Spectrum {
+
+    enum class ScenarioCommandType {
+        Segment,    // segment <name>: later frames are timed under <name>
+        Action,     // action <InputAction>, as if the key were pressed
+        Style,      // style <RenderStyle>
+        Quality,    // quality <RenderQuality>
+        Bars,       // bars <count>
+        Window,     // window <FFTWindowType>
+        Scale,      // scale <SpectrumScale>
+        Animation,  // animation on|off
+        Track,      // track <path to a precomputed track>
+        End         // end: the run is over
+    };
+
+    struct ScenarioCommand {
+        uint64_t            frame = 0;
+        ScenarioCommandType type = ScenarioCommandType::End;
+        InputAction         action = InputAction::Exit;
+        RenderStyle         style = RenderStyle::Bars;
+        RenderQuality       quality = RenderQuality::Medium;
+        size_t              count = 0;
+        bool                enabled = false;
+        std::string         text;
+    };
+
+    struct ScenarioSegmentStats {
+        std::string name;
+        size_t      frames = 0;
+        float       meanMs = 0.0f;
+        float       p50Ms = 0.0f;
+        float       p95Ms = 0.0f;
+        float       p99Ms = 0.0f;
+        float       maxMs = 0.0f;
+        size_t      overBudget = 0;
+    };
+
+    class ScenarioRunner final {
+    public:
+        explicit ScenarioRunner(float frameSeconds) : m_frameSeconds(frameSeconds) {}
+
+        // Commands come back sorted by frame; on failure `error` names the
+        // offending line and `commands` is left alone.
+        static bool Parse(const std::string& text, float frameSeconds,
+            std::vector<ScenarioCommand>& commands, std::string& error);
+
+        bool Load(const std::filesystem::path& path);
+
+        // Commands due on `frame`, in file order; frames must be passed in
+        // increasing order. Segment and End are handled here but still
+        // returned.
+        [[nodiscard]] Span<const ScenarioCommand> TakeDue(uint64_t frame);
+
+        // Time of the frame just run, charged to the current segment.
+        void RecordFrame(float ms);
+
+        [[nodiscard]] bool IsFinished() const noexcept { return m_finished; }
+
+        [[nodiscard]] std::vector<ScenarioSegmentStats> Summarize(float budgetMs) const;
+        [[nodiscard]] std::string BuildReport(float budgetMs) const;
+        bool WriteReport(const std::filesystem::path& path, float budgetMs) const;
+
+        // Beside the script: run.scenario -> run.report.json.
+        [[nodiscard]] static std::filesystem::path DefaultReportPath(const std::filesystem::path& script);
+
+    private:
+        struct Segment {
+            std::string        name;
+            std::vector<float> frameMs;
+        };
+
+        float                        m_frameSeconds;
+        std::filesystem::path        m_source;
+        std::vector<ScenarioCommand> m_commands;
+        std::vector<Segment>         m_segments;
+        size_t                       m_next = 0;
+        bool                         m_finished = false;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,165 @@
+#include "SettingsFormat.h"
+#include "Common/EnumNames.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+namespace Spectrum {
+
+    namespace {
+        constexpr int kFormatVersion = 1;
+        constexpr const char* kHeader = "# SpectrumCpp settings";
+
+        // The classic locale keeps '.' as the decimal point whatever the
+        // user's regional settings are, so files move between machines.
+        template<typename T>
+        bool ParseValue(const std::string& text, T& out) {
+            std::istringstream in(text);
+            in.imbue(std::locale::classic());
+            T value{};
+            if (!(in >> value)) return false;
+            out = value;
+            return true;
+        }
+
+        template<typename TEnum>
+        bool ParseIndex(const std::string& text, TEnum& out) {
+            int index = -1;
+            if (!ParseValue(text, index)) return false;
+            if (index < 0 || index >= static_cast<int>(TEnum::Count)) return false;
+            out = static_cast<TEnum>(index);
+            return true;
+        }
+
+        bool ParseColor(const std::string& text, Color& out) {
+            std::istringstream in(text);
+            in.imbue(std::locale::classic());
+            Color c;
+            char sep1 = 0, sep2 = 0;
+            if (!(in >> c.r >> sep1 >> c.g >> sep2 >> c.b) || sep1 != ',' || sep2 != ',')
+                return false;
+            out = Color(
+                std::clamp(c.r, 0.0f, 1.0f),
+                std::clamp(c.g, 0.0f, 1.0f),
+                std::clamp(c.b, 0.0f, 1.0f),
+                1.0f);
+            return true;
+        }
+
+        std::string Trim(const std::string& s) {
+            const size_t first = s.find_first_not_of(" \t\r");
+            if (first == std::string::npos) return {};
+            const size_t last = s.find_last_not_of(" \t\r");
+            return s.substr(first, last - first + 1);
+        }
+    }
+
+    bool operator==(const AppSettings& a, const AppSettings& b) noexcept {
+        return a.audio.fftSize == b.audio.fftSize
+            && a.audio.barCount == b.audio.barCount
+            && a.audio.amplification == b.audio.amplification
+            && a.audio.smoothing == b.audio.smoothing
+            && a.audio.whitening == b.audio.whitening
+            && a.audio.windowType == b.audio.windowType
+            && a.audio.scaleType == b.audio.scaleType
+            && a.frequencyZoomed == b.frequencyZoomed
+            && a.windowMinHz == b.windowMinHz
+            && a.windowMaxHz == b.windowMaxHz
+            && a.style == b.style
+            && a.quality == b.quality
+            && a.primaryColor.r == b.primaryColor.r
+            && a.primaryColor.g == b.primaryColor.g
+            && a.primaryColor.b == b.primaryColor.b;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Serialization
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    std::string SerializeSettings(const AppSettings& s) {
+        std::ostringstream out;
+        out.imbue(std::locale::classic());
+
+        // Enough digits that every float reads back exactly, so a loaded
+        // file compares equal to what was saved.
+        out << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+        out << kHeader << "\n"
+            << "version = " << kFormatVersion << "\n"
+            << "\n[audio]\n"
+            << "fft_size = " << s.audio.fftSize << "\n"
+            << "bar_count = " << s.audio.barCount << "\n"
+            << "amplification = " << s.audio.amplification << "\n"
+            << "smoothing = " << s.audio.smoothing << "\n"
+            << "whitening = " << (s.audio.whitening ? 1 : 0) << "\n"
+            << "fft_window = " << Helpers::Utils::ToString(s.audio.windowType) << "\n"
+            << "scale = " << Helpers::Utils::ToString(s.audio.scaleType) << "\n"
+            << "zoomed = " << (s.frequencyZoomed ? 1 : 0) << "\n"
+            << "zoom_min_hz = " << s.windowMinHz << "\n"
+            << "zoom_max_hz = " << s.windowMaxHz << "\n"
+            << "\n[renderer]\n"
+            << "style = " << static_cast<int>(s.style) << "\n"
+            << "quality = " << static_cast<int>(s.quality) << "\n"
+            << "color = " << s.primaryColor.r << ", "
+            << s.primaryColor.g << ", " << s.primaryColor.b << "\n";
+
+        return out.str();
+    }
+
+    bool DeserializeSettings(const std::string& text, AppSettings& settings) {
+        AppSettings result = settings;
+        int version = 0;
+
+        std::istringstream in(text);
+        std::string line;
+        std::string section;
+
+        while (std::getline(in, line)) {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+            if (line.front() == '[' && line.back() == ']') {
+                section = line.substr(1, line.size() - 2);
+                continue;
+            }
+
+            const size_t eq = line.find('=');
+            if (eq == std::string::npos) continue;
+
+            const std::string key = Trim(line.substr(0, eq));
+            const std::string value = Trim(line.substr(eq + 1));
+
+            // Unknown keys and bad values are skipped one at a time, so a
+            // hand-edited typo only costs that one setting.
+            if (section.empty()) {
+                if (key == "version") ParseValue(value, version);
+            }
+            else if (section == "audio") {
+                if (key == "fft_size") ParseValue(value, result.audio.fftSize);
+                else if (key == "bar_count") ParseValue(value, result.audio.barCount);
+                else if (key == "amplification") ParseValue(value, result.audio.amplification);
+                else if (key == "smoothing") ParseValue(value, result.audio.smoothing);
+                else if (key == "whitening") ParseValue(value, result.audio.whitening);
+                else if (key == "fft_window") Helpers::Utils::FromString(value, result.audio.windowType);
+                else if (key == "scale") Helpers::Utils::FromString(value, result.audio.scaleType);
+                else if (key == "zoomed") ParseValue(value, result.frequencyZoomed);
+                else if (key == "zoom_min_hz") ParseValue(value, result.windowMinHz);
+                else if (key == "zoom_max_hz") ParseValue(value, result.windowMaxHz);
+            }
+            else if (section == "renderer") {
+                if (key == "style") ParseIndex(value, result.style);
+                else if (key == "quality") ParseIndex(value, result.quality);
+                else if (key == "color") ParseColor(value, result.primaryColor);
+            }
+        }
+
+        if (version < 1 || version > kFormatVersion) return false;
+
+        settings = result;
+        return true;
+    }
+
+} // namespace Spectrum
@@ -0,0 +1,40 @@
+#ifndef SPECTRUM_CPP_SETTINGS_FORMAT_H
+#define SPECTRUM_CPP_SETTINGS_FORMAT_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// SettingsFormat - the persisted settings and their INI-style text form.
+//
+// Kept apart from SettingsStore's file and thread handling and free of
+// platform headers, so the format can be tested on any platform.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Types.h"
+#include <string>
+
+namespace Spectrum {
+
+    struct AppSettings {
+        AudioConfig   audio;
+        bool          frequencyZoomed = false;
+        float         windowMinHz = 20.0f;
+        float         windowMaxHz = 20000.0f;
+        RenderStyle   style = RenderStyle::Bars;
+        RenderQuality quality = RenderQuality::Medium;
+        Color         primaryColor = Color::FromRGB(33, 150, 243);
+    };
+
+    [[nodiscard]] bool operator==(const AppSettings& a, const AppSettings& b) noexcept;
+    [[nodiscard]] inline bool operator!=(const AppSettings& a, const AppSettings& b) noexcept {
+        return !(a == b);
+    }
+
+    [[nodiscard]] std::string SerializeSettings(const AppSettings& settings);
+
+    // Fills `settings` from `text`, starting from its current values. Unknown
+    // keys and bad values are skipped; only a missing or unsupported version
+    // rejects the text, leaving `settings` untouched.
+    bool DeserializeSettings(const std::string& text, AppSettings& settings);
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,139 @@
+#include "SettingsStore.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace Spectrum {
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Lifecycle
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    SettingsStore::SettingsStore(std::filesystem::path path)
+        : m_path(std::move(path))
+    {
+        m_writer = std::thread([this] { WriterLoop(); });
+    }
+
+    SettingsStore::~SettingsStore() noexcept {
+        Shutdown();
+    }
+
+    bool SettingsStore::Load() {
+        std::ifstream file(m_path, std::ios::binary);
+        if (!file) {
+            LOG_INFO("SettingsStore: No saved settings, using defaults");
+            return false;
+        }
+
+        std::ostringstream text;
+        text << file.rdbuf();
+
+        AppSettings loaded;
+        if (!DeserializeSettings(text.str(), loaded)) {
+            LOG_WARNING("SettingsStore: Unreadable settings file, using defaults");
+            return false;
+        }
+
+        m_current = loaded;
+        {
+            std::lock_guard lock(m_mutex);
+            m_pending = loaded;
+        }
+
+        LOG_INFO("SettingsStore: Loaded " << m_path.string());
+        return true;
+    }
+
+    void SettingsStore::Shutdown() noexcept {
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_stop) return;
+            m_stop = true;
+        }
+        m_cv.notify_one();
+
+        if (m_writer.joinable()) m_writer.join();
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Access
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    void SettingsStore::Update(const AppSettings& settings) {
+        if (settings == m_current) return;
+        m_current = settings;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_pending = settings;
+            m_lastChange = std::chrono::steady_clock::now();
+            m_dirty = true;
+        }
+        m_cv.notify_one();
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Background writer
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    void SettingsStore::WriterLoop() {
+        std::unique_lock lock(m_mutex);
+
+        while (true) {
+            m_cv.wait(lock, [this] { return m_dirty || m_stop; });
+
+            // Hold off until changes stop arriving; each new snapshot
+            // pushes the deadline back.
+            while (m_dirty && !m_stop) {
+                const auto deadline = m_lastChange + kDebounce;
+                if (std::chrono::steady_clock::now() >= deadline) break;
+                m_cv.wait_until(lock, deadline);
+            }
+
+            if (m_dirty) {
+                const AppSettings snapshot = m_pending;
+                m_dirty = false;
+
+                lock.unlock();
+                Write(snapshot);
+                lock.lock();
+            }
+
+            if (m_stop && !m_dirty) return;
+        }
+    }
+
+    bool SettingsStore::Write(const AppSettings& settings) const {
+        std::error_code ec;
+        if (m_path.has_parent_path())
+            std::filesystem::create_directories(m_path.parent_path(), ec);
+
+        // Write beside the target and swap it in, so a crash mid-write
+        // never leaves a truncated file behind.
+        std::filesystem::path temp = m_path;
+        temp += L".tmp";
+
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                LOG_WARNING("SettingsStore: Cannot open " << temp.string());
+                return false;
+            }
+            file << SerializeSettings(settings);
+            if (!file.flush()) {
+                LOG_WARNING("SettingsStore: Write failed");
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temp, m_path, ec);
+        if (ec) {
+            LOG_WARNING("SettingsStore: Cannot replace settings file: " << ec.message());
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace Spectrum
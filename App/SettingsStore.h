@@ -0,0 +1,73 @@
+#ifndef SPECTRUM_CPP_SETTINGS_STORE_H
+#define SPECTRUM_CPP_SETTINGS_STORE_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// SettingsStore - user settings that survive a restart.
+//
+// Loaded once at startup, before any subsystem is built, so managers are
+// constructed straight into the saved state. The frame thread only hands
+// over snapshots; a background writer persists them once they have been
+// stable for kDebounce, so dragging a slider never touches disk.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Common.h"
+#include "SettingsFormat.h"
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Spectrum {
+
+    class SettingsStore final {
+    public:
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Lifecycle
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        explicit SettingsStore(std::filesystem::path path);
+        ~SettingsStore() noexcept;
+
+        SettingsStore(const SettingsStore&) = delete;
+        SettingsStore& operator=(const SettingsStore&) = delete;
+
+        // Reads the file; a missing or damaged file leaves the defaults.
+        bool Load();
+
+        // Stops the writer and persists anything still pending.
+        void Shutdown() noexcept;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Access
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        [[nodiscard]] const AppSettings& Get() const noexcept { return m_current; }
+
+        // Cheap enough to call every frame: compares against the last
+        // snapshot and only wakes the writer when something changed.
+        void Update(const AppSettings& settings);
+
+    private:
+        void WriterLoop();
+        bool Write(const AppSettings& settings) const;
+
+        static constexpr auto kDebounce = std::chrono::milliseconds(500);
+
+        std::filesystem::path m_path;
+        AppSettings           m_current;
+
+        // Shared with the writer thread.
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        AppSettings             m_pending;
+        std::chrono::steady_clock::time_point m_lastChange;
+        bool                    m_dirty = false;
+        bool                    m_stop = false;
+        std::thread             m_writer;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -3,6 +3,9 @@
 #include "Graphics/API/GraphicsHelpers.h"
 #include "Audio/Sources/RealtimeAudioSource.h"
 #include "Audio/Sources/AnimatedAudioSource.h"
+#include "Audio/Sources/TrackPlaybackSource.h"
+#include "Audio/Sharing/SpectrumPublisher.h"
+#include "Audio/Processing/FFTPlanCache.h"
 
 namespace Spectrum {
 
@@ -19,12 +22,25 @@ namespace Spectrum {
 
         constexpr size_t kMinBarCount = 16;
         constexpr size_t kMaxBarCount = 256;
+
+        constexpr float kFullRangeMinHz = 20.0f;
+        constexpr float kFullRangeMaxHz = 20000.0f;
+        constexpr float kMinWindowRatio = 1.1f;
+        constexpr float kWindowEaseRate = 8.0f;
+        constexpr float kWindowSnapLog = 1e-3f;
     }
 
-    AudioManager::AudioManager(EventBus* bus)
+    AudioManager::AudioManager(EventBus* bus, const AudioConfig& config)
         : m_currentSource(nullptr)
+        , m_audioConfig(SanitizeConfig(config))
         , m_isCapturing(false)
         , m_isAnimating(false)
+        , m_windowMinHz(kFullRangeMinHz)
+        , m_windowMaxHz(kFullRangeMaxHz)
+        , m_appliedMinHz(kFullRangeMinHz)
+        , m_appliedMaxHz(kFullRangeMaxHz)
+        , m_isZoomed(false)
+        , m_isWindowMoving(false)
     {
         LOG_INFO("AudioManager: Initializing...");
 
@@ -54,6 +70,16 @@ namespace Spectrum {
 
         m_currentSource = m_realtimeSource.get();
 
+        // Sharing is optional; the app runs normally without it.
+        m_publisher = std::make_unique<SpectrumPublisher>();
+        if (!m_publisher->Initialize()) {
+            m_publisher.reset();
+        }
+        else {
+            ConnectPublisher(*m_realtimeSource);
+            ConnectPublisher(*m_animatedSource);
+        }
+
         LOG_INFO("AudioManager: Initialization completed successfully");
         return true;
     }
@@ -70,11 +96,14 @@ namespace Spectrum {
         }
 
         m_currentSource = nullptr;
+        m_publisher.reset();
         LOG_INFO("AudioManager: Shutdown complete");
     }
 
     void AudioManager::Update(float deltaTime)
     {
+        AnimateFrequencyWindow(deltaTime);
+
         if (m_currentSource) {
             m_currentSource->Update(deltaTime);
         }
@@ -85,6 +114,11 @@ namespace Spectrum {
         return m_currentSource ? m_currentSource->GetSpectrum() : SpectrumData{};
     }
 
+    SpectrumData AudioManager::GetSpectrumAt(int64_t presentNs)
+    {
+        return m_currentSource ? m_currentSource->GetSpectrumAt(presentNs) : SpectrumData{};
+    }
+
     void AudioManager::ToggleCapture()
     {
         if (m_isAnimating) {
@@ -97,6 +131,8 @@ namespace Spectrum {
             return;
         }
 
+        if (m_trackSource) StopTrack();
+
         m_isCapturing = !m_isCapturing;
 
         LOG_INFO("AudioManager: " << (m_isCapturing ? "Starting" : "Stopping") << " realtime capture...");
@@ -113,17 +149,14 @@ namespace Spectrum {
 
     void AudioManager::ToggleAnimation()
     {
+        if (m_trackSource) StopTrack();
+
         m_isAnimating = !m_isAnimating;
 
         if (m_isAnimating) {
             LOG_INFO("AudioManager: Activating animation mode...");
 
-            if (m_isCapturing && m_realtimeSource) {
-                LOG_INFO("AudioManager: Stopping realtime capture...");
-                m_isCapturing = false;
-                m_realtimeSource->StopCapture();
-                LOG_INFO("AudioManager: Realtime capture stopped");
-            }
+            StopRealtimeCapture();
 
             LOG_INFO("AudioManager: Switching to animated source");
             m_currentSource = m_animatedSource.get();
@@ -139,6 +172,74 @@ namespace Spectrum {
         LOG_INFO("AudioManager: Animation mode " << (m_isAnimating ? "ON" : "OFF"));
     }
 
+    bool AudioManager::PlayTrack(const std::filesystem::path& path)
+    {
+        LOG_INFO("AudioManager: Loading track " << path.string());
+
+        auto source = std::make_unique<TrackPlaybackSource>(m_audioConfig, path);
+        if (!source->Initialize()) {
+            LOG_ERROR("AudioManager: Failed to load track " << path.string());
+            return false;
+        }
+
+        StopRealtimeCapture();
+
+        if (m_publisher) ConnectPublisher(*source);
+
+        m_trackSource = std::move(source);
+        m_currentSource = m_trackSource.get();
+
+        LOG_INFO("AudioManager: Track playback started");
+        return true;
+    }
+
+    void AudioManager::StopTrack()
+    {
+        if (!m_trackSource) return;
+
+        m_currentSource = m_isAnimating ? m_animatedSource.get() : m_realtimeSource.get();
+        m_trackSource.reset();
+
+        LOG_INFO("AudioManager: Track playback stopped");
+    }
+
+    void AudioManager::StopRealtimeCapture()
+    {
+        if (!m_isCapturing || !m_realtimeSource) return;
+
+        LOG_INFO("AudioManager: Stopping realtime capture...");
+        m_isCapturing = false;
+        m_realtimeSource->StopCapture();
+        LOG_INFO("AudioManager: Realtime capture stopped");
+    }
+
+    void AudioManager::AnimateFrequencyWindow(float deltaTime)
+    {
+        if (!m_isWindowMoving) return;
+
+        const float t = 1.0f - std::exp(-kWindowEaseRate * deltaTime);
+        const float logMin = Lerp(std::log(m_appliedMinHz), std::log(m_windowMinHz), t);
+        const float logMax = Lerp(std::log(m_appliedMaxHz), std::log(m_windowMaxHz), t);
+
+        const bool arrived =
+            std::abs(logMin - std::log(m_windowMinHz)) < kWindowSnapLog &&
+            std::abs(logMax - std::log(m_windowMaxHz)) < kWindowSnapLog;
+
+        m_appliedMinHz = arrived ? m_windowMinHz : std::exp(logMin);
+        m_appliedMaxHz = arrived ? m_windowMaxHz : std::exp(logMax);
+        m_isWindowMoving = !arrived;
+
+        if (!m_realtimeSource) return;
+
+        // Once the zoom-out lands, hand back to the scale's own full range.
+        if (arrived && !m_isZoomed) {
+            m_realtimeSource->ResetFrequencyWindow();
+        }
+        else {
+            m_realtimeSource->SetFrequencyWindow(m_appliedMinHz, m_appliedMaxHz);
+        }
+    }
+
     void AudioManager::ChangeAmplification(float delta)
     {
         const float newValue = Clamp(
@@ -204,6 +305,19 @@ namespace Spectrum {
         LOG_INFO("AudioManager: Smoothing = " << clampedValue);
     }
 
+    void AudioManager::SetWhitening(bool enabled)
+    {
+        if (enabled == m_audioConfig.whitening) return;
+
+        m_audioConfig.whitening = enabled;
+
+        if (m_realtimeSource) {
+            m_realtimeSource->SetWhitening(enabled);
+        }
+
+        LOG_INFO("AudioManager: Whitening " << (enabled ? "ON" : "OFF"));
+    }
+
     void AudioManager::SetBarCount(size_t count)
     {
         const size_t clampedValue = Clamp(count, kMinBarCount, kMaxBarCount);
@@ -214,6 +328,10 @@ namespace Spectrum {
             m_realtimeSource->SetBarCount(clampedValue);
         }
 
+        if (m_trackSource) {
+            m_trackSource->SetBarCount(clampedValue);
+        }
+
         LOG_INFO("AudioManager: Bar Count = " << clampedValue);
     }
 
@@ -229,6 +347,28 @@ namespace Spectrum {
         LOG_INFO("AudioManager: FFT Window = " << ToString(newType).data());
     }
 
+    void AudioManager::SetFFTSize(size_t fftSize)
+    {
+        const size_t clampedValue = Clamp(fftSize, MIN_FFT_SIZE, MAX_FFT_SIZE);
+        if (!FFTPlanCache::IsSupportedSize(clampedValue) ||
+            clampedValue == m_audioConfig.fftSize) {
+            return;
+        }
+
+        m_audioConfig.fftSize = clampedValue;
+
+        if (m_realtimeSource) {
+            m_realtimeSource->SetFFTSize(clampedValue);
+        }
+
+        LOG_INFO("AudioManager: FFT Size = " << clampedValue);
+    }
+
+    void AudioManager::SetFFTSizeByName(const std::string& name)
+    {
+        SetFFTSize(static_cast<size_t>(std::strtoul(name.c_str(), nullptr, 10)));
+    }
+
     void AudioManager::SetSpectrumScaleByName(const std::string& name)
     {
         const SpectrumScale newType = StringToSpectrumScale(name);
@@ -241,6 +381,41 @@ namespace Spectrum {
         LOG_INFO("AudioManager: Spectrum Scale = " << ToString(newType).data());
     }
 
+    void AudioManager::SetFrequencyWindow(float minHz, float maxHz, bool animate)
+    {
+        const float lo = Clamp(minHz, kFullRangeMinHz, kFullRangeMaxHz);
+        const float hi = Clamp(maxHz, kFullRangeMinHz, kFullRangeMaxHz);
+        if (hi < lo * kMinWindowRatio) return;
+
+        m_windowMinHz = lo;
+        m_windowMaxHz = hi;
+        m_isZoomed = true;
+        m_isWindowMoving = true;
+
+        if (!animate) {
+            m_appliedMinHz = lo;
+            m_appliedMaxHz = hi;
+            if (m_realtimeSource) {
+                m_realtimeSource->SetFrequencyWindow(lo, hi);
+                m_isWindowMoving = false;
+            }
+        }
+
+        LOG_INFO("AudioManager: Frequency window = " << lo << " - " << hi << " Hz");
+    }
+
+    void AudioManager::ResetFrequencyWindow()
+    {
+        if (!m_isZoomed) return;
+
+        m_windowMinHz = kFullRangeMinHz;
+        m_windowMaxHz = kFullRangeMaxHz;
+        m_isZoomed = false;
+        m_isWindowMoving = true;
+
+        LOG_INFO("AudioManager: Frequency window = full range");
+    }
+
     bool AudioManager::IsCapturing() const noexcept
     {
         return m_isCapturing;
@@ -251,6 +426,11 @@ namespace Spectrum {
         return m_isAnimating;
     }
 
+    bool AudioManager::IsPlayingTrack() const noexcept
+    {
+        return m_trackSource != nullptr;
+    }
+
     bool AudioManager::HasActiveSource() const noexcept
     {
         return m_currentSource != nullptr;
@@ -266,11 +446,36 @@ namespace Spectrum {
         return m_audioConfig.smoothing;
     }
 
+    bool AudioManager::IsWhitening() const noexcept
+    {
+        return m_audioConfig.whitening;
+    }
+
     size_t AudioManager::GetBarCount() const noexcept
     {
         return m_audioConfig.barCount;
     }
 
+    size_t AudioManager::GetFFTSize() const noexcept
+    {
+        return m_audioConfig.fftSize;
+    }
+
+    bool AudioManager::IsFrequencyZoomed() const noexcept
+    {
+        return m_isZoomed;
+    }
+
+    float AudioManager::GetWindowMinHz() const noexcept
+    {
+        return m_windowMinHz;
+    }
+
+    float AudioManager::GetWindowMaxHz() const noexcept
+    {
+        return m_windowMaxHz;
+    }
+
     std::string_view AudioManager::GetSpectrumScaleName() const noexcept
     {
         return ToString(m_audioConfig.scaleType);
@@ -289,6 +494,18 @@ namespace Spectrum {
         return windows;
     }
 
+    const std::vector<std::string>& AudioManager::GetAvailableFFTSizes() const
+    {
+        static const std::vector<std::string> sizes = [] {
+            std::vector<std::string> names;
+            for (size_t n = MIN_FFT_SIZE; n <= MAX_FFT_SIZE; n *= 2) {
+                names.push_back(std::to_string(n));
+            }
+            return names;
+        }();
+        return sizes;
+    }
+
     const std::vector<std::string>& AudioManager::GetAvailableSpectrumScales() const
     {
         static const std::vector<std::string> scales = {
@@ -319,6 +536,15 @@ namespace Spectrum {
         }
     }
 
+    // Sources publish from their own frame path, so every analysis hop
+    // lands in the ring once, however fast the UI happens to run.
+    void AudioManager::ConnectPublisher(IAudioSource& source)
+    {
+        source.SetFrameSink([this](const SpectrumData& bars, const SpectrumData& peaks) {
+            if (m_publisher) m_publisher->Publish(bars, peaks);
+        });
+    }
+
     bool AudioManager::CreateAudioSources()
     {
         LOG_INFO("AudioManager: Creating audio sources...");
@@ -335,6 +561,25 @@ namespace Spectrum {
         return true;
     }
 
+    AudioConfig AudioManager::SanitizeConfig(const AudioConfig& config)
+    {
+        AudioConfig result = config;
+        result.amplification = Clamp(config.amplification, kMinAmplification, kMaxAmplification);
+        result.smoothing = Clamp(config.smoothing, kMinSmoothing, kMaxSmoothing);
+        result.barCount = Clamp(config.barCount, kMinBarCount, kMaxBarCount);
+
+        if (!FFTPlanCache::IsSupportedSize(config.fftSize)) {
+            result.fftSize = DEFAULT_FFT_SIZE;
+        }
+        if (config.windowType >= FFTWindowType::Count) {
+            result.windowType = FFTWindowType::Hann;
+        }
+        if (config.scaleType >= SpectrumScale::Count) {
+            result.scaleType = SpectrumScale::Logarithmic;
+        }
+        return result;
+    }
+
     template<typename TSource>
     bool AudioManager::InitializeSource(
         std::unique_ptr<IAudioSource>& source,
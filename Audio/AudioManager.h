@@ -2,6 +2,7 @@
 #define SPECTRUM_CPP_AUDIO_MANAGER_H
 
 #include "Common/Common.h"
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -9,11 +10,12 @@ namespace Spectrum {
 
     class EventBus;
     class IAudioSource;
+    class SpectrumPublisher;
 
     class AudioManager final
     {
     public:
-        explicit AudioManager(EventBus* bus);
+        explicit AudioManager(EventBus* bus, const AudioConfig& config = {});
         ~AudioManager();
 
         AudioManager(const AudioManager&) = delete;
@@ -26,36 +28,60 @@ namespace Spectrum {
 
         void Update(float deltaTime);
         [[nodiscard]] SpectrumData GetSpectrum();
+        [[nodiscard]] SpectrumData GetSpectrumAt(int64_t presentNs);
 
         void ToggleCapture();
         void ToggleAnimation();
 
+        [[nodiscard]] bool PlayTrack(const std::filesystem::path& path);
+        void StopTrack();
+
         void ChangeAmplification(float delta);
         void ChangeFFTWindow(int direction);
         void ChangeSpectrumScale(int direction);
 
         void SetAmplification(float amp);
         void SetSmoothing(float smoothing);
+        void SetWhitening(bool enabled);
         void SetBarCount(size_t count);
         void SetFFTWindowByName(const std::string& name);
+        void SetFFTSize(size_t fftSize);
+        void SetFFTSizeByName(const std::string& name);
         void SetSpectrumScaleByName(const std::string& name);
 
+        // Zooms the bars onto [minHz, maxHz]; the change is animated
+        // unless `animate` is false (e.g. when restoring saved settings).
+        void SetFrequencyWindow(float minHz, float maxHz, bool animate = true);
+        void ResetFrequencyWindow();
+
         [[nodiscard]] bool IsCapturing() const noexcept;
         [[nodiscard]] bool IsAnimating() const noexcept;
+        [[nodiscard]] bool IsPlayingTrack() const noexcept;
         [[nodiscard]] bool HasActiveSource() const noexcept;
 
+        [[nodiscard]] const AudioConfig& GetConfig() const noexcept { return m_audioConfig; }
         [[nodiscard]] float GetAmplification() const noexcept;
         [[nodiscard]] float GetSmoothing() const noexcept;
+        [[nodiscard]] bool IsWhitening() const noexcept;
         [[nodiscard]] size_t GetBarCount() const noexcept;
+        [[nodiscard]] size_t GetFFTSize() const noexcept;
+        [[nodiscard]] bool IsFrequencyZoomed() const noexcept;
+        [[nodiscard]] float GetWindowMinHz() const noexcept;
+        [[nodiscard]] float GetWindowMaxHz() const noexcept;
         [[nodiscard]] std::string_view GetSpectrumScaleName() const noexcept;
         [[nodiscard]] std::string_view GetFFTWindowName() const noexcept;
 
         [[nodiscard]] const std::vector<std::string>& GetAvailableFFTWindows() const;
+        [[nodiscard]] const std::vector<std::string>& GetAvailableFFTSizes() const;
         [[nodiscard]] const std::vector<std::string>& GetAvailableSpectrumScales() const;
 
     private:
         void SubscribeToEvents(EventBus* bus);
+        void StopRealtimeCapture();
+        void AnimateFrequencyWindow(float deltaTime);
         bool CreateAudioSources();
+        void ConnectPublisher(IAudioSource& source);
+        static AudioConfig SanitizeConfig(const AudioConfig& config);
 
         template<typename TSource>
         bool InitializeSource(
@@ -68,11 +94,23 @@ namespace Spectrum {
 
         std::unique_ptr<IAudioSource> m_realtimeSource;
         std::unique_ptr<IAudioSource> m_animatedSource;
+        std::unique_ptr<IAudioSource> m_trackSource;
         IAudioSource* m_currentSource;
 
+        std::unique_ptr<SpectrumPublisher> m_publisher;
+
         AudioConfig m_audioConfig;
         bool m_isCapturing;
         bool m_isAnimating;
+
+        // Frequency window: the target and the value currently applied,
+        // which eases toward it in log-frequency.
+        float m_windowMinHz;
+        float m_windowMaxHz;
+        float m_appliedMinHz;
+        float m_appliedMaxHz;
+        bool m_isZoomed;
+        bool m_isWindowMoving;
     };
 
 }
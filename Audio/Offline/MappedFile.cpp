@@ -0,0 +1,117 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// MappedFile.cpp: Win32 file mapping wrapper, with an mmap fallback so the
+// track reader also builds in the portable tests.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "MappedFile.h"
+#include "Common/Log.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Spectrum {
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+#if defined(_WIN32)
+
+    bool MappedFile::Open(const std::filesystem::path& path) {
+        Close();
+
+        m_file = CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+        if (m_file == INVALID_HANDLE_VALUE) {
+            LOG_ERROR("MappedFile: cannot open " << path.string());
+            return false;
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            LOG_ERROR("MappedFile: empty or unreadable file " << path.string());
+            Close();
+            return false;
+        }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) {
+            LOG_ERROR("MappedFile: CreateFileMapping failed for " << path.string());
+            Close();
+            return false;
+        }
+
+        m_view = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_view) {
+            LOG_ERROR("MappedFile: MapViewOfFile failed for " << path.string());
+            Close();
+            return false;
+        }
+
+        m_size = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close() noexcept {
+        if (m_view) UnmapViewOfFile(m_view);
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+
+        m_view = nullptr;
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+        m_size = 0;
+    }
+
+#else
+
+    // The mapping outlives the descriptor, so nothing but the view is kept.
+    bool MappedFile::Open(const std::filesystem::path& path) {
+        Close();
+
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            LOG_ERROR("MappedFile: cannot open " << path.string());
+            return false;
+        }
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            LOG_ERROR("MappedFile: empty or unreadable file " << path.string());
+            ::close(fd);
+            return false;
+        }
+
+        void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            LOG_ERROR("MappedFile: mmap failed for " << path.string());
+            return false;
+        }
+
+        m_view = static_cast<const uint8_t*>(view);
+        m_size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::Close() noexcept {
+        if (m_view) ::munmap(const_cast<uint8_t*>(m_view), m_size);
+
+        m_view = nullptr;
+        m_size = 0;
+    }
+
+#endif
+
+} // namespace Spectrum
@@ -0,0 +1,48 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// MappedFile.h: Read-only memory mapping of a whole file. Pages are brought
+// in by the OS on first touch, so opening a long track costs nothing up
+// front and reading it streams straight from the page cache. Maps with
+// Win32 file mapping on Windows and mmap elsewhere (the tests).
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_MAPPED_FILE_H
+#define SPECTRUM_CPP_MAPPED_FILE_H
+
+#include "Common/Types.h"
+#include <filesystem>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace Spectrum {
+
+    class MappedFile final {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        [[nodiscard]] bool Open(const std::filesystem::path& path);
+        void Close() noexcept;
+
+        [[nodiscard]] const uint8_t* GetData() const noexcept { return m_view; }
+        [[nodiscard]] size_t GetSize() const noexcept { return m_size; }
+        [[nodiscard]] bool IsOpen() const noexcept { return m_view != nullptr; }
+
+    private:
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+        const uint8_t* m_view = nullptr;
+        size_t m_size = 0;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_MAPPED_FILE_H
@@ -0,0 +1,380 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectralTrackFile.cpp: Quantisation, Rice coding and keyframe indexing
+// for .sptk tracks.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "SpectralTrackFile.h"
+#include "Common/Log.h"
+#include <cstring>
+#include <fstream>
+
+namespace Spectrum {
+
+    namespace {
+
+        constexpr uint8_t kKeyframe = 0;
+        constexpr uint8_t kDeltaFrame = 1;
+        constexpr size_t kFrameHeaderBytes = 2; // type, Rice parameter
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Bit I/O (MSB first, each frame starts byte aligned)
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        class BitWriter {
+        public:
+            explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+            void Write(uint32_t value, uint32_t bits) {
+                for (uint32_t i = bits; i-- > 0;) PutBit((value >> i) & 1u);
+            }
+
+            void WriteUnary(uint32_t count) {
+                for (uint32_t i = 0; i < count; ++i) PutBit(1);
+                PutBit(0);
+            }
+
+            void Flush() {
+                if (m_used > 0) m_out.push_back(static_cast<uint8_t>(m_acc << (8 - m_used)));
+                m_acc = 0;
+                m_used = 0;
+            }
+
+        private:
+            void PutBit(uint32_t bit) {
+                m_acc = static_cast<uint8_t>((m_acc << 1) | bit);
+                if (++m_used == 8) {
+                    m_out.push_back(m_acc);
+                    m_acc = 0;
+                    m_used = 0;
+                }
+            }
+
+            std::vector<uint8_t>& m_out;
+            uint8_t m_acc = 0;
+            uint32_t m_used = 0;
+        };
+
+        class BitReader {
+        public:
+            BitReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+            bool Read(uint32_t bits, uint32_t& outValue) {
+                outValue = 0;
+                for (uint32_t i = 0; i < bits; ++i) {
+                    uint32_t bit = 0;
+                    if (!GetBit(bit)) return false;
+                    outValue = (outValue << 1) | bit;
+                }
+                return true;
+            }
+
+            bool ReadUnary(uint32_t limit, uint32_t& outCount) {
+                outCount = 0;
+                uint32_t bit = 0;
+                while (GetBit(bit)) {
+                    if (bit == 0) return true;
+                    if (++outCount > limit) return false;
+                }
+                return false;
+            }
+
+            [[nodiscard]] size_t GetBytesConsumed() const noexcept {
+                return m_bitPos / 8 + (m_bitPos % 8 ? 1 : 0);
+            }
+
+        private:
+            bool GetBit(uint32_t& bit) {
+                const size_t byte = m_bitPos >> 3;
+                if (byte >= m_size) return false;
+                bit = (m_data[byte] >> (7 - (m_bitPos & 7))) & 1u;
+                ++m_bitPos;
+                return true;
+            }
+
+            const uint8_t* m_data;
+            size_t m_size;
+            size_t m_bitPos = 0;
+        };
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Coding helpers
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        uint32_t ZigZag(int32_t v) noexcept {
+            return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+        }
+
+        int32_t UnZigZag(uint32_t v) noexcept {
+            return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1u);
+        }
+
+        uint32_t MaxQuantized(uint32_t bitDepth) noexcept {
+            return (1u << bitDepth) - 1u;
+        }
+
+        // Written so NaN falls through to 0; std::clamp would pass it on
+        // to the int conversion.
+        int32_t Quantize(float value, uint32_t maxQ) noexcept {
+            const float v = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+            return static_cast<int32_t>(v * static_cast<float>(maxQ) + 0.5f);
+        }
+
+        // Picks the Rice parameter that minimises the encoded size of a frame.
+        uint32_t ChooseRiceParameter(const std::vector<uint32_t>& values, uint32_t maxK) {
+            uint32_t bestK = 0;
+            uint64_t bestBits = UINT64_MAX;
+            for (uint32_t k = 0; k <= maxK; ++k) {
+                uint64_t bits = 0;
+                for (uint32_t v : values) bits += (v >> k) + 1 + k;
+                if (bits < bestBits) {
+                    bestBits = bits;
+                    bestK = k;
+                }
+            }
+            return bestK;
+        }
+
+        // 64-bit, as frameCount + keyframeInterval - 1 can wrap in 32.
+        uint64_t CountKeyframes(const SpectralTrackHeader& header) noexcept {
+            return (static_cast<uint64_t>(header.frameCount) + header.keyframeInterval - 1) /
+                header.keyframeInterval;
+        }
+
+        template<typename T>
+        T ReadLE(const uint8_t* src) noexcept {
+            T value{};
+            std::memcpy(&value, src, sizeof(T));
+            return value;
+        }
+
+    } // anonymous namespace
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Writer
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool SpectralTrackWriter::Write(
+        const SpectralTrack& track,
+        const std::filesystem::path& path,
+        uint32_t bitDepth,
+        uint32_t keyframeInterval
+    ) {
+        if (bitDepth != 8 && bitDepth != 12) return false;
+        if (track.barCount == 0 || keyframeInterval == 0) return false;
+
+        SpectralTrackHeader header;
+        header.bitDepth = bitDepth;
+        header.sampleRate = static_cast<uint32_t>(track.sampleRate);
+        header.hopSize = static_cast<uint32_t>(track.hopSize);
+        header.barCount = static_cast<uint32_t>(track.barCount);
+        header.frameCount = static_cast<uint32_t>(track.GetFrameCount());
+        header.keyframeInterval = keyframeInterval;
+
+        const uint32_t maxQ = MaxQuantized(bitDepth);
+        const size_t barCount = track.barCount;
+
+        std::vector<uint8_t> body;
+        body.reserve(track.bars.size());
+        std::vector<uint64_t> index;
+
+        std::vector<int32_t> previous(barCount, 0);
+        std::vector<int32_t> current(barCount, 0);
+        std::vector<uint32_t> residuals(barCount, 0);
+
+        for (size_t frame = 0; frame < header.frameCount; ++frame) {
+            const Span<const float> bars = track.GetFrame(frame);
+            for (size_t i = 0; i < barCount; ++i)
+                current[i] = Quantize(bars[i], maxQ);
+
+            const uint64_t offset = sizeof(SpectralTrackHeader) + body.size();
+            const bool isKey = frame % keyframeInterval == 0;
+
+            if (isKey) {
+                index.push_back(offset);
+                body.push_back(kKeyframe);
+                body.push_back(0);
+
+                BitWriter bits(body);
+                for (int32_t q : current) bits.Write(static_cast<uint32_t>(q), bitDepth);
+                bits.Flush();
+            }
+            else {
+                for (size_t i = 0; i < barCount; ++i)
+                    residuals[i] = ZigZag(current[i] - previous[i]);
+
+                const uint32_t k = ChooseRiceParameter(residuals, bitDepth);
+                body.push_back(kDeltaFrame);
+                body.push_back(static_cast<uint8_t>(k));
+
+                BitWriter bits(body);
+                for (uint32_t r : residuals) {
+                    bits.WriteUnary(r >> k);
+                    bits.Write(r & ((1u << k) - 1u), k);
+                }
+                bits.Flush();
+            }
+
+            previous.swap(current);
+        }
+
+        // Keep the index 8-byte aligned inside the file.
+        while ((sizeof(SpectralTrackHeader) + body.size()) % alignof(uint64_t) != 0)
+            body.push_back(0);
+        header.indexOffset = sizeof(SpectralTrackHeader) + body.size();
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG_ERROR("SpectralTrackWriter: cannot create " << path.string());
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(body.data()),
+            static_cast<std::streamsize>(body.size()));
+        file.write(reinterpret_cast<const char*>(index.data()),
+            static_cast<std::streamsize>(index.size() * sizeof(uint64_t)));
+
+        return static_cast<bool>(file);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Reader
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool SpectralTrackReader::Open(const std::filesystem::path& path) {
+        Close();
+        if (!m_file.Open(path)) return false;
+
+        if (m_file.GetSize() < sizeof(SpectralTrackHeader)) {
+            LOG_ERROR("SpectralTrackReader: file too small " << path.string());
+            Close();
+            return false;
+        }
+
+        std::memcpy(&m_header, m_file.GetData(), sizeof(m_header));
+        if (!ValidateHeader()) {
+            LOG_ERROR("SpectralTrackReader: invalid track " << path.string());
+            Close();
+            return false;
+        }
+
+        m_index = m_file.GetData() + m_header.indexOffset;
+        m_indexCount = static_cast<size_t>(CountKeyframes(m_header));
+        m_quantized.assign(m_header.barCount, 0);
+        return true;
+    }
+
+    void SpectralTrackReader::Close() noexcept {
+        m_file.Close();
+        m_header = SpectralTrackHeader{};
+        m_index = nullptr;
+        m_indexCount = 0;
+        m_hasCursor = false;
+    }
+
+    double SpectralTrackReader::GetFrameRate() const noexcept {
+        return m_header.hopSize > 0
+            ? static_cast<double>(m_header.sampleRate) / static_cast<double>(m_header.hopSize)
+            : 0.0;
+    }
+
+    double SpectralTrackReader::GetDurationSeconds() const noexcept {
+        const double rate = GetFrameRate();
+        return rate > 0.0 ? static_cast<double>(m_header.frameCount) / rate : 0.0;
+    }
+
+    bool SpectralTrackReader::ReadFrame(size_t index, SpectrumData& outBars) {
+        if (!IsOpen() || index >= m_header.frameCount) return false;
+
+        const bool sequential = m_hasCursor && index >= m_cursorFrame &&
+            index / m_header.keyframeInterval == m_cursorFrame / m_header.keyframeInterval;
+
+        if (!sequential && !SeekToKeyframe(index / m_header.keyframeInterval))
+            return false;
+
+        while (m_cursorFrame < index) {
+            if (!DecodeNextFrame()) {
+                m_hasCursor = false;
+                return false;
+            }
+        }
+
+        const float scale = 1.0f / static_cast<float>(MaxQuantized(m_header.bitDepth));
+        outBars.resize(m_header.barCount);
+        for (size_t i = 0; i < m_header.barCount; ++i)
+            outBars[i] = static_cast<float>(m_quantized[i]) * scale;
+
+        return true;
+    }
+
+    bool SpectralTrackReader::ValidateHeader() const {
+        static constexpr char kMagic[4] = { 'S', 'P', 'T', 'K' };
+        if (std::memcmp(m_header.magic, kMagic, 4) != 0) return false;
+        if (m_header.version != 1) return false;
+        if (m_header.bitDepth != 8 && m_header.bitDepth != 12) return false;
+        if (m_header.barCount == 0 || m_header.frameCount == 0) return false;
+        if (m_header.keyframeInterval == 0 || m_header.hopSize == 0) return false;
+
+        // Subtraction form: indexOffset comes from the file and the sum
+        // could wrap past the size.
+        const uint64_t size = m_file.GetSize();
+        return m_header.indexOffset >= sizeof(SpectralTrackHeader) &&
+            m_header.indexOffset <= size &&
+            CountKeyframes(m_header) <= (size - m_header.indexOffset) / sizeof(uint64_t);
+    }
+
+    bool SpectralTrackReader::SeekToKeyframe(size_t keyframe) {
+        m_hasCursor = false;
+        if (keyframe >= m_indexCount) return false;
+
+        const uint64_t offset = ReadLE<uint64_t>(m_index + keyframe * sizeof(uint64_t));
+        if (offset >= m_header.indexOffset || m_header.indexOffset - offset < kFrameHeaderBytes)
+            return false;
+
+        const uint8_t* record = m_file.GetData() + offset;
+        if (record[0] != kKeyframe) return false;
+
+        BitReader bits(record + kFrameHeaderBytes,
+            static_cast<size_t>(m_header.indexOffset - offset - kFrameHeaderBytes));
+
+        for (auto& q : m_quantized) {
+            uint32_t value = 0;
+            if (!bits.Read(m_header.bitDepth, value)) return false;
+            q = static_cast<int32_t>(value);
+        }
+
+        m_cursorFrame = keyframe * m_header.keyframeInterval;
+        m_nextOffset = static_cast<size_t>(offset) + kFrameHeaderBytes + bits.GetBytesConsumed();
+        m_hasCursor = true;
+        return true;
+    }
+
+    bool SpectralTrackReader::DecodeNextFrame() {
+        if (m_nextOffset >= m_header.indexOffset || m_header.indexOffset - m_nextOffset < kFrameHeaderBytes)
+            return false;
+
+        const uint8_t* record = m_file.GetData() + m_nextOffset;
+        const uint32_t k = record[1];
+        if (record[0] != kDeltaFrame || k > m_header.bitDepth) return false;
+
+        BitReader bits(record + kFrameHeaderBytes,
+            static_cast<size_t>(m_header.indexOffset - m_nextOffset - kFrameHeaderBytes));
+
+        const int32_t maxQ = static_cast<int32_t>(MaxQuantized(m_header.bitDepth));
+        const uint32_t unaryLimit = (2u << m_header.bitDepth) >> k;
+
+        for (auto& q : m_quantized) {
+            uint32_t high = 0;
+            uint32_t low = 0;
+            if (!bits.ReadUnary(unaryLimit, high) || !bits.Read(k, low)) return false;
+
+            q += UnZigZag((high << k) | low);
+            if (q < 0 || q > maxQ) return false;
+        }
+
+        ++m_cursorFrame;
+        m_nextOffset += kFrameHeaderBytes + bits.GetBytesConsumed();
+        return true;
+    }
+
+} // namespace Spectrum
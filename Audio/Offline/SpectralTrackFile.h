@@ -0,0 +1,79 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectralTrackFile.h: Compact, seekable storage for bar frames (.sptk).
+//
+// Layout:  Header | frame records | keyframe index (uint64 offsets)
+//
+// Bars are quantised to 8 or 12 bits. Every keyframeInterval-th frame is a
+// keyframe holding the quantised values at fixed width; the frames between
+// hold per-bar deltas, zigzag mapped and Rice coded with a parameter chosen
+// per frame. Seeking jumps to the preceding keyframe through the index and
+// replays at most keyframeInterval - 1 deltas, so cost is bounded.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_SPECTRAL_TRACK_FILE_H
+#define SPECTRUM_CPP_SPECTRAL_TRACK_FILE_H
+
+#include "Common/Types.h"
+#include "MappedFile.h"
+#include "SpectrumPrecomputer.h"
+
+namespace Spectrum {
+
+    struct SpectralTrackHeader {
+        char magic[4] = { 'S', 'P', 'T', 'K' };
+        uint32_t version = 1;
+        uint32_t bitDepth = 8;
+        uint32_t sampleRate = 0;
+        uint32_t hopSize = 0;
+        uint32_t barCount = 0;
+        uint32_t frameCount = 0;
+        uint32_t keyframeInterval = 0;
+        uint64_t indexOffset = 0;
+    };
+
+    class SpectralTrackWriter {
+    public:
+        static constexpr uint32_t kDefaultKeyframeInterval = 64;
+
+        [[nodiscard]] static bool Write(
+            const SpectralTrack& track,
+            const std::filesystem::path& path,
+            uint32_t bitDepth = 8,
+            uint32_t keyframeInterval = kDefaultKeyframeInterval
+        );
+    };
+
+    class SpectralTrackReader {
+    public:
+        [[nodiscard]] bool Open(const std::filesystem::path& path);
+        void Close() noexcept;
+
+        // Decodes frame `index` into `outBars` (resized to GetBarCount()).
+        // Sequential reads decode a single delta frame each.
+        [[nodiscard]] bool ReadFrame(size_t index, SpectrumData& outBars);
+
+        [[nodiscard]] bool IsOpen() const noexcept { return m_file.IsOpen(); }
+        [[nodiscard]] size_t GetFrameCount() const noexcept { return m_header.frameCount; }
+        [[nodiscard]] size_t GetBarCount() const noexcept { return m_header.barCount; }
+        [[nodiscard]] double GetFrameRate() const noexcept;
+        [[nodiscard]] double GetDurationSeconds() const noexcept;
+
+    private:
+        [[nodiscard]] bool ValidateHeader() const;
+        [[nodiscard]] bool SeekToKeyframe(size_t keyframe);
+        [[nodiscard]] bool DecodeNextFrame();
+
+        MappedFile m_file;
+        SpectralTrackHeader m_header;
+        const uint8_t* m_index = nullptr;
+        size_t m_indexCount = 0;
+
+        std::vector<int32_t> m_quantized;
+        size_t m_cursorFrame = 0;     // frame held in m_quantized
+        size_t m_nextOffset = 0;      // byte offset of the frame after it
+        bool m_hasCursor = false;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_SPECTRAL_TRACK_FILE_H
@@ -0,0 +1,167 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumPrecomputer.cpp: Offline spectrum and feature extraction.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "SpectrumPrecomputer.h"
+#include "Audio/Processing/FFTProcessor.h"
+#include "Audio/Processing/FrequencyMapper.h"
+#include "Audio/Processing/SpectrumPostProcessor.h"
+
+namespace Spectrum {
+
+    namespace {
+
+        // Below this many frames per worker, thread start-up costs more
+        // than the FFTs it would save.
+        constexpr size_t kMinFramesPerWorker = 256;
+
+    } // anonymous namespace
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Lifecycle Management
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    SpectrumPrecomputer::SpectrumPrecomputer(const PrecomputeSettings& settings)
+        : m_settings(settings)
+        , m_hopSize(settings.hopSize > 0 ? settings.hopSize : settings.audio.fftSize / 2) {
+        m_settings.workerThreads = std::max<size_t>(1, m_settings.workerThreads);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Public Interface
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool SpectrumPrecomputer::Process(
+        const DecodedAudio& audio,
+        SpectralTrack& outTrack
+    ) const {
+        if (audio.samples.empty() || audio.sampleRate == 0) return false;
+
+        const size_t barCount = m_settings.audio.barCount;
+        const size_t frameCount = CountFrames(audio.samples.size());
+
+        outTrack.sampleRate = audio.sampleRate;
+        outTrack.hopSize = m_hopSize;
+        outTrack.barCount = barCount;
+        outTrack.bars.assign(frameCount * barCount, 0.0f);
+        outTrack.features.assign(frameCount, FrameFeatures{});
+
+        AudioBuffer rawBars(frameCount * barCount, 0.0f);
+
+        const size_t workers = std::clamp<size_t>(
+            frameCount / kMinFramesPerWorker, 1, m_settings.workerThreads);
+        const size_t framesPerWorker = (frameCount + workers - 1) / workers;
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t w = 1; w < workers; ++w) {
+            const size_t first = w * framesPerWorker;
+            const size_t last = std::min(frameCount, first + framesPerWorker);
+            if (first >= last) break;
+            threads.emplace_back([&, first, last] {
+                AnalyzeRange(audio, first, last, outTrack, rawBars);
+            });
+        }
+
+        AnalyzeRange(audio, 0, std::min(frameCount, framesPerWorker), outTrack, rawBars);
+        for (auto& t : threads) t.join();
+
+        PostProcess(outTrack, rawBars);
+        return true;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Analysis Stages
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    size_t SpectrumPrecomputer::CountFrames(size_t sampleCount) const noexcept {
+        const size_t fftSize = m_settings.audio.fftSize;
+        if (sampleCount <= fftSize) return 1;
+        return 1 + (sampleCount - fftSize + m_hopSize - 1) / m_hopSize;
+    }
+
+    void SpectrumPrecomputer::AnalyzeRange(
+        const DecodedAudio& audio,
+        size_t firstFrame,
+        size_t lastFrame,
+        SpectralTrack& track,
+        AudioBuffer& rawBars
+    ) const {
+        const size_t fftSize = m_settings.audio.fftSize;
+        const size_t barCount = m_settings.audio.barCount;
+        const size_t sampleCount = audio.samples.size();
+
+        // Each worker owns its processors; none of them are shared.
+        FFTProcessor fft(fftSize);
+        fft.SetWindowType(m_settings.audio.windowType);
+        FrequencyMapper mapper(barCount, audio.sampleRate);
+
+        AudioBuffer window(fftSize, 0.0f);
+        SpectrumData bars(barCount, 0.0f);
+
+        const float binWidth = static_cast<float>(audio.sampleRate) / static_cast<float>(fftSize);
+
+        for (size_t frame = firstFrame; frame < lastFrame; ++frame) {
+            const size_t start = frame * m_hopSize;
+            const size_t count = start < sampleCount ? std::min(fftSize, sampleCount - start) : 0;
+
+            std::copy_n(audio.samples.begin() + start, count, window.begin());
+            std::fill(window.begin() + count, window.end(), 0.0f);
+
+            float energy = 0.0f;
+            for (float s : window.Padded()) energy += s * s;
+
+            fft.Process(window);
+            const SpectrumData& mags = fft.GetMagnitudes();
+
+            float weighted = 0.0f;
+            float total = 0.0f;
+            for (size_t bin = 0; bin < mags.size(); ++bin) {
+                weighted += static_cast<float>(bin) * binWidth * mags[bin];
+                total += mags[bin];
+            }
+
+            mapper.MapFFTToBars(mags, bars, m_settings.audio.scaleType);
+            std::copy(bars.begin(), bars.end(), rawBars.begin() + frame * barCount);
+
+            FrameFeatures& f = track.features[frame];
+            f.rms = std::sqrt(energy / static_cast<float>(fftSize));
+            f.centroidHz = total > 0.0f ? weighted / total : 0.0f;
+        }
+    }
+
+    void SpectrumPrecomputer::PostProcess(
+        SpectralTrack& track,
+        const AudioBuffer& rawBars
+    ) const {
+        const size_t barCount = track.barCount;
+
+        SpectrumPostProcessor post(barCount);
+        post.SetAmplification(m_settings.audio.amplification);
+        post.SetSmoothing(m_settings.audio.smoothing);
+        post.SetWhitening(m_settings.audio.whitening);
+
+        SpectrumData bars(barCount, 0.0f);
+
+        for (size_t frame = 0; frame < track.GetFrameCount(); ++frame) {
+            const float* raw = rawBars.data() + frame * barCount;
+            std::copy_n(raw, barCount, bars.begin());
+
+            float flux = 0.0f;
+            if (frame > 0) {
+                const float* prev = raw - barCount;
+                for (size_t i = 0; i < barCount; ++i)
+                    flux += std::max(0.0f, raw[i] - prev[i]);
+            }
+
+            post.Process(bars);
+            const SpectrumData& smoothed = post.GetSmoothedBars();
+            std::copy(smoothed.begin(), smoothed.end(), track.bars.begin() + frame * barCount);
+
+            FrameFeatures& f = track.features[frame];
+            f.flux = flux;
+            f.peak = smoothed.empty() ? 0.0f : *std::max_element(smoothed.begin(), smoothed.end());
+        }
+    }
+
+} // namespace Spectrum
@@ -0,0 +1,78 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumPrecomputer.h: Offline analysis of a whole decoded track using the
+// same FFTProcessor / FrequencyMapper / SpectrumPostProcessor chain as the
+// live analyzer. FFT and bar mapping are independent per hop and run on
+// several worker threads; post-processing carries state (smoothing, gain,
+// peaks) from frame to frame and runs afterwards in a single pass.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_SPECTRUM_PRECOMPUTER_H
+#define SPECTRUM_CPP_SPECTRUM_PRECOMPUTER_H
+
+#include "Common/Span.h"
+#include "Common/Types.h"
+#include "WavFileReader.h"
+
+namespace Spectrum {
+
+    struct FrameFeatures {
+        float rms = 0.0f;        // time-domain level of the analysis window
+        float peak = 0.0f;       // largest post-processed bar
+        float centroidHz = 0.0f; // magnitude-weighted mean frequency
+        float flux = 0.0f;       // positive change of raw bars since last frame
+    };
+
+    struct SpectralTrack {
+        size_t sampleRate = 0;
+        size_t hopSize = 0;
+        size_t barCount = 0;
+        AudioBuffer bars;                    // frameCount rows of barCount
+        std::vector<FrameFeatures> features; // one per frame
+
+        [[nodiscard]] size_t GetFrameCount() const noexcept { return features.size(); }
+
+        [[nodiscard]] double GetFrameRate() const noexcept {
+            return hopSize > 0
+                ? static_cast<double>(sampleRate) / static_cast<double>(hopSize)
+                : 0.0;
+        }
+
+        [[nodiscard]] Span<const float> GetFrame(size_t index) const noexcept {
+            return { bars.data() + index * barCount, barCount };
+        }
+    };
+
+    struct PrecomputeSettings {
+        AudioConfig audio;
+        size_t hopSize = 0;      // 0: half the FFT size, as in the live analyzer
+        size_t workerThreads = 1;
+    };
+
+    class SpectrumPrecomputer {
+    public:
+        explicit SpectrumPrecomputer(const PrecomputeSettings& settings);
+
+        [[nodiscard]] bool Process(const DecodedAudio& audio, SpectralTrack& outTrack) const;
+
+        [[nodiscard]] size_t GetHopSize() const noexcept { return m_hopSize; }
+
+    private:
+        [[nodiscard]] size_t CountFrames(size_t sampleCount) const noexcept;
+
+        void AnalyzeRange(
+            const DecodedAudio& audio,
+            size_t firstFrame,
+            size_t lastFrame,
+            SpectralTrack& track,
+            AudioBuffer& rawBars
+        ) const;
+
+        void PostProcess(SpectralTrack& track, const AudioBuffer& rawBars) const;
+
+        PrecomputeSettings m_settings;
+        size_t m_hopSize;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_SPECTRUM_PRECOMPUTER_H
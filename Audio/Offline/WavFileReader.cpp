@@ -0,0 +1,191 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// WavFileReader.cpp: Minimal RIFF/WAVE parser. Unknown chunks are skipped,
+// so files carrying LIST/bext/cue metadata load without special handling.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "WavFileReader.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Spectrum {
+
+    namespace {
+
+        constexpr uint16_t kFormatPcm = 0x0001;
+        constexpr uint16_t kFormatFloat = 0x0003;
+        constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+        template<typename T>
+        T ReadLE(const char* src) noexcept {
+            T value{};
+            std::memcpy(&value, src, sizeof(T));
+            return value;
+        }
+
+        bool ReadChunkHeader(std::ifstream& file, char (&id)[4], uint32_t& size) {
+            char header[8];
+            if (!file.read(header, sizeof(header))) return false;
+            std::memcpy(id, header, 4);
+            size = ReadLE<uint32_t>(header + 4);
+            return true;
+        }
+
+        // Chunk sizes come from the file, so buffers are never sized past
+        // what is actually left in it.
+        uint64_t BytesLeft(std::ifstream& file, std::streamoff fileSize) {
+            const std::streamoff pos = file.tellg();
+            return pos < 0 || pos >= fileSize ? 0 : static_cast<uint64_t>(fileSize - pos);
+        }
+
+    } // anonymous namespace
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Public Interface
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool WavFileReader::Load(
+        const std::filesystem::path& path,
+        DecodedAudio& outAudio
+    ) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            LOG_ERROR("WavFileReader: cannot open " << path.string());
+            return false;
+        }
+        const std::streamoff fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        char riff[12];
+        if (!file.read(riff, sizeof(riff)) ||
+            std::memcmp(riff, "RIFF", 4) != 0 ||
+            std::memcmp(riff + 8, "WAVE", 4) != 0) {
+            LOG_ERROR("WavFileReader: not a RIFF/WAVE file: " << path.string());
+            return false;
+        }
+
+        Format format;
+        bool haveFormat = false;
+        std::vector<char> data;
+
+        char id[4];
+        uint32_t size = 0;
+        while (ReadChunkHeader(file, id, size)) {
+            const uint64_t left = BytesLeft(file, fileSize);
+            if (std::memcmp(id, "fmt ", 4) == 0) {
+                if (size > left) break;
+                std::vector<char> chunk(size);
+                if (!file.read(chunk.data(), size)) break;
+                haveFormat = ParseFormat(chunk, format);
+            }
+            else if (std::memcmp(id, "data", 4) == 0) {
+                // Truncated files are common in the wild; keep what is there.
+                data.resize(static_cast<size_t>(std::min<uint64_t>(size, left)));
+                file.read(data.data(), static_cast<std::streamsize>(data.size()));
+                data.resize(static_cast<size_t>(file.gcount()));
+                break;
+            }
+            else {
+                file.seekg(size, std::ios::cur);
+            }
+
+            // Chunks are word-aligned.
+            if (size & 1u) file.seekg(1, std::ios::cur);
+        }
+
+        if (!haveFormat || !IsSupported(format)) {
+            LOG_ERROR("WavFileReader: unsupported format in " << path.string());
+            return false;
+        }
+        if (data.empty()) {
+            LOG_ERROR("WavFileReader: no audio data in " << path.string());
+            return false;
+        }
+
+        outAudio.sampleRate = format.sampleRate;
+        outAudio.channels = format.channels;
+        Mixdown(data, format, outAudio.samples);
+        return true;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Header Parsing
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool WavFileReader::ParseFormat(const std::vector<char>& chunk, Format& outFormat) {
+        if (chunk.size() < 16) return false;
+
+        const char* p = chunk.data();
+        outFormat.tag = ReadLE<uint16_t>(p);
+        outFormat.channels = ReadLE<uint16_t>(p + 2);
+        outFormat.sampleRate = ReadLE<uint32_t>(p + 4);
+        outFormat.blockAlign = ReadLE<uint16_t>(p + 12);
+        outFormat.bitsPerSample = ReadLE<uint16_t>(p + 14);
+
+        // WAVE_FORMAT_EXTENSIBLE stores the real tag in the first two bytes
+        // of the sub-format GUID.
+        if (outFormat.tag == kFormatExtensible && chunk.size() >= 26)
+            outFormat.tag = ReadLE<uint16_t>(p + 24);
+
+        return true;
+    }
+
+    bool WavFileReader::IsSupported(const Format& format) noexcept {
+        if (format.channels == 0 || format.sampleRate == 0) return false;
+        if (format.blockAlign < format.channels * (format.bitsPerSample / 8)) return false;
+
+        if (format.tag == kFormatFloat) return format.bitsPerSample == 32;
+        if (format.tag == kFormatPcm) {
+            return format.bitsPerSample == 16 ||
+                format.bitsPerSample == 24 ||
+                format.bitsPerSample == 32;
+        }
+        return false;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Sample Conversion
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    float WavFileReader::DecodeSample(const char* src, const Format& format) noexcept {
+        if (format.tag == kFormatFloat)
+            return ReadLE<float>(src);
+
+        switch (format.bitsPerSample) {
+        case 16:
+            return static_cast<float>(ReadLE<int16_t>(src)) / 32768.0f;
+        case 24: {
+            const auto* b = reinterpret_cast<const uint8_t*>(src);
+            int32_t v = static_cast<int32_t>(
+                (static_cast<uint32_t>(b[0]) << 8) |
+                (static_cast<uint32_t>(b[1]) << 16) |
+                (static_cast<uint32_t>(b[2]) << 24));
+            return static_cast<float>(v >> 8) / 8388608.0f;
+        }
+        default:
+            return static_cast<float>(ReadLE<int32_t>(src)) / 2147483648.0f;
+        }
+    }
+
+    void WavFileReader::Mixdown(
+        const std::vector<char>& data,
+        const Format& format,
+        AudioBuffer& outSamples
+    ) {
+        const size_t frameCount = data.size() / format.blockAlign;
+        const size_t bytesPerSample = format.bitsPerSample / 8u;
+        const float invChannels = 1.0f / static_cast<float>(format.channels);
+
+        outSamples.resize(frameCount);
+        for (size_t frame = 0; frame < frameCount; ++frame) {
+            const char* src = data.data() + frame * format.blockAlign;
+
+            float sum = 0.0f;
+            for (uint16_t ch = 0; ch < format.channels; ++ch)
+                sum += DecodeSample(src + ch * bytesPerSample, format);
+
+            outSamples[frame] = sum * invChannels;
+        }
+    }
+
+} // namespace Spectrum
@@ -0,0 +1,57 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// WavFileReader.h: Loads a RIFF/WAVE file into a mono float buffer for
+// offline analysis. Supports 16/24/32-bit PCM and 32-bit IEEE float,
+// including WAVE_FORMAT_EXTENSIBLE headers.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_WAV_FILE_READER_H
+#define SPECTRUM_CPP_WAV_FILE_READER_H
+
+#include "Common/Log.h"
+#include "Common/Types.h"
+#include <filesystem>
+
+namespace Spectrum {
+
+    struct DecodedAudio {
+        AudioBuffer samples;      // mono, mixed down from all channels
+        size_t sampleRate = 0;
+        int channels = 0;
+
+        [[nodiscard]] double GetDurationSeconds() const noexcept {
+            return sampleRate > 0
+                ? static_cast<double>(samples.size()) / static_cast<double>(sampleRate)
+                : 0.0;
+        }
+    };
+
+    class WavFileReader {
+    public:
+        [[nodiscard]] static bool Load(
+            const std::filesystem::path& path,
+            DecodedAudio& outAudio
+        );
+
+    private:
+        struct Format {
+            uint16_t tag = 0;
+            uint16_t channels = 0;
+            uint32_t sampleRate = 0;
+            uint16_t blockAlign = 0;
+            uint16_t bitsPerSample = 0;
+        };
+
+        [[nodiscard]] static bool ParseFormat(const std::vector<char>& chunk, Format& outFormat);
+        [[nodiscard]] static bool IsSupported(const Format& format) noexcept;
+        [[nodiscard]] static float DecodeSample(const char* src, const Format& format) noexcept;
+
+        static void Mixdown(
+            const std::vector<char>& data,
+            const Format& format,
+            AudioBuffer& outSamples
+        );
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_WAV_FILE_READER_H
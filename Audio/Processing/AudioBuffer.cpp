@@ -1,4 +1,5 @@
 #include "AudioBuffer.h"
+#include <chrono>
 
 namespace Spectrum {
 
@@ -25,6 +26,9 @@ namespace Spectrum {
             const float* currentFrameData = data + frame * static_cast<size_t>(channels);
             m_buffer.push_back(MixdownMonoFrame(currentFrameData, channels));
         }
+
+        m_lastAddNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
     }
 
     bool ThreadSafeAudioBuffer::HasEnoughData(size_t required) const {
@@ -42,6 +46,17 @@ namespace Spectrum {
         }
     }
 
+    int64_t ThreadSafeAudioBuffer::CaptureTimeNs(
+        size_t index,
+        size_t sampleRate
+    ) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (sampleRate == 0 || index >= m_buffer.size()) return m_lastAddNs;
+
+        const auto behind = static_cast<int64_t>(m_buffer.size() - 1 - index);
+        return m_lastAddNs - behind * 1'000'000'000 / static_cast<int64_t>(sampleRate);
+    }
+
     void ThreadSafeAudioBuffer::Consume(size_t size) {
         std::lock_guard<std::mutex> lock(m_mutex);
         if (m_buffer.size() >= size) {
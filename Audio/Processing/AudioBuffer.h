@@ -12,10 +12,17 @@ namespace Spectrum {
         void CopyTo(AudioBuffer& dest, size_t size);
         void Consume(size_t size);
 
+        // Estimated steady-clock capture time of buffered sample `index`
+        // (0 = oldest), counted back from when the newest one arrived.
+        [[nodiscard]] int64_t CaptureTimeNs(size_t index, size_t sampleRate) const;
+
     private:
         float MixdownMonoFrame(const float* frameData, int channels) const;
 
-        AudioBuffer m_buffer;
+        // Plain vector: the FIFO is consumed from the front, which the
+        // padded AudioBuffer type does not support.
+        std::vector<float> m_buffer;
+        int64_t m_lastAddNs = 0;
         mutable std::mutex m_mutex;
     };
 
@@ -0,0 +1,95 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FFTPlanCache.cpp: Plan construction and lookup.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "FFTPlanCache.h"
+#include "FFTProcessor.h"
+
+namespace Spectrum {
+
+    void FFTPlan::Transform(std::complex<float>* data) const noexcept {
+        for (size_t i = 0; i < size; ++i) {
+            const size_t j = bitReverse[i];
+            if (i < j) std::swap(data[i], data[j]);
+        }
+
+        for (size_t stage = 1; stage <= logSize; ++stage) {
+            const size_t m = 1ULL << stage;
+            const size_t halfM = m >> 1;
+            const size_t step = size / m;
+
+            for (size_t base = 0; base < size; base += m) {
+                for (size_t j = 0; j < halfM; ++j) {
+                    const std::complex<float> t = twiddles[j * step] * data[base + j + halfM];
+                    const std::complex<float> u = data[base + j];
+
+                    data[base + j] = u + t;
+                    data[base + j + halfM] = u - t;
+                }
+            }
+        }
+    }
+
+    FFTPlanCache& FFTPlanCache::Instance() {
+        static FFTPlanCache instance;
+        return instance;
+    }
+
+    bool FFTPlanCache::IsSupportedSize(size_t fftSize) noexcept {
+        const bool powerOfTwo = fftSize && ((fftSize & (fftSize - 1)) == 0);
+        return powerOfTwo && fftSize >= MIN_FFT_SIZE && fftSize <= MAX_FFT_SIZE;
+    }
+
+    FFTPlanPtr FFTPlanCache::Acquire(size_t fftSize) {
+        if (!IsSupportedSize(fftSize)) {
+            LOG_ERROR("FFTPlanCache: unsupported FFT size " << fftSize);
+            return nullptr;
+        }
+
+        if (FFTPlanPtr plan = Find(fftSize)) return plan;
+
+        // Built outside the lock so a large plan never stalls lookups of
+        // sizes that are already cached. If two threads race, the first
+        // insert wins and the other copy is dropped.
+        FFTPlanPtr plan = Build(fftSize);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_plans.emplace(fftSize, std::move(plan)).first->second;
+    }
+
+    FFTPlanPtr FFTPlanCache::Find(size_t fftSize) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_plans.find(fftSize);
+        return it != m_plans.end() ? it->second : nullptr;
+    }
+
+    FFTPlanPtr FFTPlanCache::Build(size_t fftSize) {
+        auto plan = std::make_shared<FFTPlan>();
+        plan->size = fftSize;
+        while ((fftSize >> plan->logSize) > 1) ++plan->logSize;
+
+        plan->twiddles.resize(fftSize / 2);
+        for (size_t i = 0; i < fftSize / 2; ++i) {
+            const float angle =
+                -TWO_PI * static_cast<float>(i) / static_cast<float>(fftSize);
+            plan->twiddles[i] = std::complex<float>(std::cos(angle), std::sin(angle));
+        }
+
+        plan->bitReverse.resize(fftSize);
+        for (size_t i = 0; i < fftSize; ++i) {
+            size_t rev = 0;
+            for (size_t b = 0; b < plan->logSize; ++b)
+                rev |= ((i >> b) & 1ULL) << (plan->logSize - 1 - b);
+            plan->bitReverse[i] = static_cast<uint32_t>(rev);
+        }
+
+        for (size_t w = 0; w < plan->windows.size(); ++w) {
+            plan->windows[w] = FFTProcessor::GenerateWindow(
+                static_cast<FFTWindowType>(w), fftSize);
+        }
+
+        LOG_DEBUG("FFTPlanCache: built plan for " << fftSize << "-point FFT");
+        return plan;
+    }
+
+} // namespace Spectrum
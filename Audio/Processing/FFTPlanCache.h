@@ -0,0 +1,57 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FFTPlanCache.h: Size-dependent FFT tables (twiddles, bit-reverse order,
+// windows), built once per size and shared by every FFTProcessor. Plans
+// are immutable after construction, so any thread may read them.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_FFT_PLAN_CACHE_H
+#define SPECTRUM_CPP_FFT_PLAN_CACHE_H
+
+#include "Common/Common.h"
+
+namespace Spectrum {
+
+    struct FFTPlan {
+        size_t size = 0;
+        size_t logSize = 0;
+        std::vector<std::complex<float>> twiddles;   // size / 2
+        std::vector<uint32_t> bitReverse;            // size
+        std::array<AudioBuffer, static_cast<size_t>(FFTWindowType::Count)> windows;
+
+        [[nodiscard]] const AudioBuffer& GetWindow(FFTWindowType type) const noexcept {
+            return windows[static_cast<size_t>(type)];
+        }
+
+        // In-place forward transform of `size` complex values (radix-2
+        // Cooley-Tukey, decimation in time).
+        void Transform(std::complex<float>* data) const noexcept;
+    };
+
+    using FFTPlanPtr = std::shared_ptr<const FFTPlan>;
+
+    class FFTPlanCache final {
+    public:
+        [[nodiscard]] static FFTPlanCache& Instance();
+
+        FFTPlanCache(const FFTPlanCache&) = delete;
+        FFTPlanCache& operator=(const FFTPlanCache&) = delete;
+
+        // Returns the cached plan, building it on first use. Null for sizes
+        // outside [MIN_FFT_SIZE, MAX_FFT_SIZE] or not a power of two.
+        [[nodiscard]] FFTPlanPtr Acquire(size_t fftSize);
+
+        [[nodiscard]] static bool IsSupportedSize(size_t fftSize) noexcept;
+
+    private:
+        FFTPlanCache() = default;
+
+        [[nodiscard]] FFTPlanPtr Find(size_t fftSize) const;
+        [[nodiscard]] static FFTPlanPtr Build(size_t fftSize);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<size_t, FFTPlanPtr> m_plans;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_FFT_PLAN_CACHE_H
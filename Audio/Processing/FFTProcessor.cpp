@@ -7,68 +7,45 @@
 
 namespace Spectrum {
 
-    namespace {
-        inline size_t IntegerLog2(size_t n) noexcept {
-            size_t l = 0;
-            while ((n >> l) > 1) ++l;
-            return l;
-        }
-    }
-
     FFTProcessor::FFTProcessor(size_t fftSize)
-        : m_fftSize(fftSize)
-        , m_logSize(IntegerLog2(fftSize))
+        : m_fftSize(0)
+        , m_window(nullptr)
         , m_windowType(FFTWindowType::Hann) {
 
-        ValidateFFTSize();
-        AllocateBuffers();
-        InitializeTwiddleFactors();
-        GenerateWindow();
+        FFTPlanPtr plan = FFTPlanCache::Instance().Acquire(fftSize);
+        if (!plan) {
+            LOG_ERROR("FFTProcessor: falling back to " << DEFAULT_FFT_SIZE << "-point FFT");
+            plan = FFTPlanCache::Instance().Acquire(DEFAULT_FFT_SIZE);
+        }
+        SetPlan(std::move(plan));
     }
 
-    void FFTProcessor::ValidateFFTSize() const {
-        if (!IsPowerOfTwo(m_fftSize)) {
-            LOG_ERROR("FFT size must be a power of two. Got: " << m_fftSize);
-        }
+    void FFTProcessor::SetPlan(FFTPlanPtr plan) {
+        if (!plan || plan == m_plan) return;
+
+        m_plan = std::move(plan);
+        m_fftSize = m_plan->size;
+        m_window = &m_plan->GetWindow(m_windowType);
+        AllocateBuffers();
     }
 
     void FFTProcessor::AllocateBuffers() {
         m_fftBuffer.resize(m_fftSize);
         m_magnitudes.resize(m_fftSize / 2 + 1);
         m_phases.resize(m_fftSize / 2 + 1);
-        m_window.resize(m_fftSize);
-    }
-
-    bool FFTProcessor::IsPowerOfTwo(size_t n) noexcept {
-        return n && ((n & (n - 1)) == 0);
-    }
-
-    void FFTProcessor::InitializeTwiddleFactors() {
-        m_twiddleFactors.resize(m_fftSize / 2);
-        for (size_t i = 0; i < m_fftSize / 2; ++i) {
-            const float angle =
-                -TWO_PI * static_cast<float>(i) / static_cast<float>(m_fftSize);
-            m_twiddleFactors[i] = std::complex<float>(
-                std::cos(angle), std::sin(angle)
-            );
-        }
     }
 
     void FFTProcessor::SetWindowType(FFTWindowType type) {
         if (type == m_windowType) return;
         m_windowType = type;
-        GenerateWindow();
-    }
-
-    void FFTProcessor::GenerateWindow() {
-        m_window = GenerateWindow(m_windowType, m_fftSize);
+        m_window = &m_plan->GetWindow(m_windowType);
     }
 
-    std::vector<float> FFTProcessor::GenerateWindow(
+    AudioBuffer FFTProcessor::GenerateWindow(
         FFTWindowType type,
         size_t size
     ) {
-        std::vector<float> window(size);
+        AudioBuffer window(size);
         for (size_t i = 0; i < size; ++i)
             window[i] = ApplyWindowFunction(type, i, size);
         return window;
@@ -108,7 +85,7 @@ namespace Spectrum {
 
     void FFTProcessor::ApplyWindowToData(const AudioBuffer& input, size_t count) {
         for (size_t i = 0; i < count; ++i)
-            m_fftBuffer[i] = std::complex<float>(input[i] * m_window[i], 0.0f);
+            m_fftBuffer[i] = std::complex<float>(input[i] * (*m_window)[i], 0.0f);
     }
 
     void FFTProcessor::PadBuffer(size_t fromIndex) {
@@ -116,61 +93,8 @@ namespace Spectrum {
             m_fftBuffer[i] = std::complex<float>(0.0f, 0.0f);
     }
 
-    size_t FFTProcessor::ReverseBits(
-        size_t num,
-        size_t bitCount
-    ) const noexcept {
-        size_t rev = 0;
-        for (size_t i = 0; i < bitCount; ++i)
-            rev |= ((num >> i) & 1ULL) << (bitCount - 1 - i);
-        return rev;
-    }
-
-    void FFTProcessor::BitReversalPermutation() {
-        for (size_t i = 0; i < m_fftSize; ++i) {
-            const size_t j = ReverseBits(i, m_logSize);
-            if (i < j) std::swap(m_fftBuffer[i], m_fftBuffer[j]);
-        }
-    }
-
-    void FFTProcessor::StagePass(
-        size_t m,
-        size_t halfM,
-        size_t step
-    ) noexcept {
-        for (size_t base = 0; base < m_fftSize; base += m)
-            ButterflyBlock(base, halfM, step);
-    }
-
-    void FFTProcessor::ButterflyBlock(
-        size_t base,
-        size_t halfM,
-        size_t step
-    ) noexcept {
-        for (size_t j = 0; j < halfM; ++j) {
-            const size_t tw = j * step;
-
-            const std::complex<float> t =
-                m_twiddleFactors[tw] * m_fftBuffer[base + j + halfM];
-            const std::complex<float> u = m_fftBuffer[base + j];
-
-            m_fftBuffer[base + j] = u + t;
-            m_fftBuffer[base + j + halfM] = u - t;
-        }
-    }
-
-    void FFTProcessor::CooleyTukeyFFT() {
-        for (size_t stage = 1; stage <= m_logSize; ++stage) {
-            const size_t m = 1ULL << stage;
-            const size_t halfM = m >> 1;
-            const size_t step = m_fftSize / m;
-            StagePass(m, halfM, step);
-        }
-    }
-
     void FFTProcessor::PerformFFT() {
-        BitReversalPermutation();
-        CooleyTukeyFFT();
+        m_plan->Transform(m_fftBuffer.data());
     }
 
     float FFTProcessor::CalculateMagnitude(
@@ -6,6 +6,7 @@
 #define SPECTRUM_CPP_FFT_PROCESSOR_H
 
 #include "Common/Common.h"
+#include "FFTPlanCache.h"
 
 namespace Spectrum {
 
@@ -18,6 +19,10 @@ namespace Spectrum {
         void Process(const AudioBuffer& input);
         void SetWindowType(FFTWindowType type);
 
+        // Switches to another cached plan; output buffers are resized to
+        // match. Call between frames, never during Process.
+        void SetPlan(FFTPlanPtr plan);
+
         // Getters
         const SpectrumData& GetMagnitudes() const noexcept { return m_magnitudes; }
         const SpectrumData& GetPhases() const noexcept { return m_phases; }
@@ -25,7 +30,7 @@ namespace Spectrum {
         FFTWindowType GetWindowType() const noexcept { return m_windowType; }
 
         // Static window function generators
-        static std::vector<float> GenerateWindow(FFTWindowType type, size_t size);
+        static AudioBuffer GenerateWindow(FFTWindowType type, size_t size);
         static float ApplyWindowFunction(
             FFTWindowType type,
             size_t index,
@@ -34,32 +39,15 @@ namespace Spectrum {
 
     private:
         // Initialization
-        void ValidateFFTSize() const;
         void AllocateBuffers();
-        void InitializeTwiddleFactors();
 
         // Window and input preparation
-        void GenerateWindow();
         void ApplyWindow(const AudioBuffer& input);
         void ApplyWindowToData(const AudioBuffer& input, size_t count);
         void PadBuffer(size_t fromIndex);
 
         // FFT processing
         void PerformFFT();
-        void BitReversalPermutation();
-        void CooleyTukeyFFT();
-
-        // CooleyTukey helpers
-        void StagePass(
-            size_t m,
-            size_t halfM,
-            size_t step
-        ) noexcept;
-        void ButterflyBlock(
-            size_t base,
-            size_t halfM,
-            size_t step
-        ) noexcept;
 
         // Result calculation
         void CalculateMagnitudesAndPhases();
@@ -67,28 +55,20 @@ namespace Spectrum {
         float CalculateMagnitude(const std::complex<float>& c) const noexcept;
         float CalculatePhase(const std::complex<float>& c) const noexcept;
 
-        // Helpers
-        size_t ReverseBits(
-            size_t num,
-            size_t bitCount
-        ) const noexcept;
-        static bool IsPowerOfTwo(size_t n) noexcept;
-
     private:
         // FFT parameters
+        FFTPlanPtr m_plan;
         size_t m_fftSize;
-        size_t m_logSize;
 
         // Buffers
         std::vector<std::complex<float>> m_fftBuffer;
-        std::vector<std::complex<float>> m_twiddleFactors;
 
         // Results
         SpectrumData m_magnitudes;
         SpectrumData m_phases;
 
-        // Window
-        std::vector<float> m_window;
+        // Window (owned by the plan)
+        const AudioBuffer* m_window;
         FFTWindowType m_windowType;
     };
 
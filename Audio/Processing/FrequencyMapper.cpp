@@ -9,12 +9,15 @@ namespace Spectrum {
         : m_barCount(barCount)
         , m_sampleRate(sampleRate)
         , m_nyquistFrequency(sampleRate * 0.5f)
-        , m_currentFFTSize(0) {
+        , m_windowMinHz(0.0f)
+        , m_windowMaxHz(std::numeric_limits<float>::max())
+        , m_tableScale(SpectrumScale::Linear) {
     }
 
     void FrequencyMapper::SetBarCount(size_t newBarCount) {
         if (newBarCount > 0 && newBarCount != m_barCount) {
             m_barCount = newBarCount;
+            m_binTable.clear();
         }
     }
 
@@ -22,9 +25,43 @@ namespace Spectrum {
         if (newSampleRate > 0 && newSampleRate != m_sampleRate) {
             m_sampleRate = newSampleRate;
             m_nyquistFrequency = newSampleRate * 0.5f;
+            m_binTable.clear();
         }
     }
 
+    void FrequencyMapper::SetFrequencyWindow(float minHz, float maxHz) {
+        if (!(maxHz > minHz) || minHz < 0.0f) return;
+        if (minHz == m_windowMinHz && maxHz == m_windowMaxHz) return;
+
+        m_windowMinHz = minHz;
+        m_windowMaxHz = maxHz;
+        m_binTable.clear();
+    }
+
+    void FrequencyMapper::ResetFrequencyWindow() {
+        SetFrequencyWindow(0.0f, std::numeric_limits<float>::max());
+    }
+
+    void FrequencyMapper::PrepareForFFTSize(size_t fftSize, SpectrumScale scaleType) {
+        BinLayout layout;
+        layout.fftSize = fftSize;
+        RebuildBinTable(layout, scaleType);
+    }
+
+    void FrequencyMapper::AdoptBinTable(FrequencyMapper&& prepared) {
+        if (prepared.m_barCount != m_barCount ||
+            prepared.m_sampleRate != m_sampleRate ||
+            prepared.m_windowMinHz != m_windowMinHz ||
+            prepared.m_windowMaxHz != m_windowMaxHz ||
+            prepared.m_binTable.size() != m_barCount) {
+            return;
+        }
+
+        m_binTable = std::move(prepared.m_binTable);
+        m_tableLayout = prepared.m_tableLayout;
+        m_tableScale = prepared.m_tableScale;
+    }
+
     void FrequencyMapper::MapFFTToBars(
         const SpectrumData& fftMagnitudes,
         SpectrumData& outputBars,
@@ -34,25 +71,94 @@ namespace Spectrum {
             return;
         }
 
-        // Store FFT size for frequency calculations
-        m_currentFFTSize = (fftMagnitudes.size() - 1) * 2;
+        BinLayout layout;
+        layout.fftSize = (fftMagnitudes.size() - 1) * 2;
+        MapWithLayout(fftMagnitudes, outputBars, scaleType, layout);
+    }
+
+    void FrequencyMapper::MapBandToBars(
+        const SpectrumData& bandMagnitudes,
+        SpectrumData& outputBars,
+        SpectrumScale scaleType,
+        float firstBinHz,
+        float binWidthHz
+    ) {
+        if (bandMagnitudes.empty() || outputBars.size() != m_barCount || binWidthHz <= 0.0f) {
+            return;
+        }
+
+        BinLayout layout;
+        layout.firstBinHz = firstBinHz;
+        layout.binWidthHz = binWidthHz;
+        layout.binCount = bandMagnitudes.size();
+        MapWithLayout(bandMagnitudes, outputBars, scaleType, layout);
+    }
+
+    void FrequencyMapper::MapWithLayout(
+        const SpectrumData& mags,
+        SpectrumData& bars,
+        SpectrumScale scaleType,
+        const BinLayout& layout
+    ) {
+        if (layout != m_tableLayout ||
+            scaleType != m_tableScale ||
+            m_binTable.size() != m_barCount) {
+            RebuildBinTable(layout, scaleType);
+        }
+
+        const AggregationFunc aggFunc = GetAggregationFunc(scaleType);
+        for (size_t i = 0; i < m_barCount; ++i) {
+            const BinRange& bins = m_binTable[i];
+            bars[i] = CalculateBarValue(mags, bins.start, bins.end, aggFunc);
+        }
+    }
+
+    void FrequencyMapper::RebuildBinTable(const BinLayout& layout, SpectrumScale scaleType) {
+        m_tableLayout = layout;
+        m_tableScale = scaleType;
 
+        const RangeFunc getRange = GetRangeFunc(scaleType);
+        m_binTable.resize(m_barCount);
+        for (size_t i = 0; i < m_barCount; ++i) {
+            const FrequencyRange range = (this->*getRange)(i);
+            m_binTable[i].start = GetBinForLayout(range.start, layout);
+            m_binTable[i].end = GetBinForLayout(range.end, layout);
+        }
+    }
+
+    size_t FrequencyMapper::GetBinForLayout(float frequency, const BinLayout& layout) const {
+        if (layout.fftSize > 0) {
+            return GetBinForFrequency(frequency, layout.fftSize);
+        }
+
+        const float offset = (frequency - layout.firstBinHz) / layout.binWidthHz;
+        if (offset <= 0.0f || layout.binCount == 0) return 0;
+        return std::min(static_cast<size_t>(offset), layout.binCount - 1);
+    }
+
+    float FrequencyMapper::GetWindowLow(float scaleFloor) const noexcept {
+        return std::min(std::max(scaleFloor, m_windowMinHz), GetWindowHigh());
+    }
+
+    float FrequencyMapper::GetWindowHigh() const noexcept {
+        return std::min(m_nyquistFrequency, m_windowMaxHz);
+    }
+
+    FrequencyMapper::RangeFunc FrequencyMapper::GetRangeFunc(SpectrumScale scaleType) noexcept {
         switch (scaleType) {
+        case SpectrumScale::Logarithmic: return &FrequencyMapper::GetLogarithmicRange;
+        case SpectrumScale::Mel:         return &FrequencyMapper::GetMelRange;
         case SpectrumScale::Linear:
-            MapLinearScale(fftMagnitudes, outputBars);
-            break;
-        case SpectrumScale::Logarithmic:
-            MapLogarithmicScale(fftMagnitudes, outputBars);
-            break;
-        case SpectrumScale::Mel:
-            MapMelScale(fftMagnitudes, outputBars);
-            break;
-        default:
-            MapLinearScale(fftMagnitudes, outputBars);
-            break;
+        default:                         return &FrequencyMapper::GetLinearRange;
         }
     }
 
+    FrequencyMapper::AggregationFunc FrequencyMapper::GetAggregationFunc(SpectrumScale scaleType) noexcept {
+        return scaleType == SpectrumScale::Logarithmic
+            ? &FrequencyMapper::AverageRange
+            : &FrequencyMapper::MaxInRange;
+    }
+
     float FrequencyMapper::GetFrequencyForBin(size_t bin, size_t fftSize) const {
         if (fftSize == 0) return 0.0f;
         return (static_cast<float>(bin) * static_cast<float>(m_sampleRate)) /
@@ -68,15 +174,18 @@ namespace Spectrum {
     }
 
     FrequencyMapper::FrequencyRange FrequencyMapper::GetLinearRange(size_t barIndex) const {
+        const float low = GetWindowLow(0.0f);
+        const float span = GetWindowHigh() - low;
+
         FrequencyRange range;
-        range.start = (barIndex * m_nyquistFrequency) / static_cast<float>(m_barCount);
-        range.end = ((barIndex + 1) * m_nyquistFrequency) / static_cast<float>(m_barCount);
+        range.start = low + (barIndex * span) / static_cast<float>(m_barCount);
+        range.end = low + ((barIndex + 1) * span) / static_cast<float>(m_barCount);
         return range;
     }
 
     FrequencyMapper::FrequencyRange FrequencyMapper::GetLogarithmicRange(size_t barIndex) const {
-        const float minLog = std::log10(LOG_MIN_FREQ);
-        const float maxLog = std::log10(m_nyquistFrequency);
+        const float minLog = std::log10(GetWindowLow(LOG_MIN_FREQ));
+        const float maxLog = std::log10(GetWindowHigh());
 
         const float t0 = static_cast<float>(barIndex) / static_cast<float>(m_barCount);
         const float t1 = static_cast<float>(barIndex + 1) / static_cast<float>(m_barCount);
@@ -88,10 +197,11 @@ namespace Spectrum {
     }
 
     FrequencyMapper::FrequencyRange FrequencyMapper::GetMelRange(size_t barIndex) const {
-        const float maxMel = FreqToMel(m_nyquistFrequency);
+        const float minMel = FreqToMel(GetWindowLow(0.0f));
+        const float melSpan = FreqToMel(GetWindowHigh()) - minMel;
 
-        const float melStart = (barIndex * maxMel) / static_cast<float>(m_barCount);
-        const float melEnd = ((barIndex + 1) * maxMel) / static_cast<float>(m_barCount);
+        const float melStart = minMel + (barIndex * melSpan) / static_cast<float>(m_barCount);
+        const float melEnd = minMel + ((barIndex + 1) * melSpan) / static_cast<float>(m_barCount);
 
         FrequencyRange range;
         range.start = MelToFreq(melStart);
@@ -143,30 +253,4 @@ namespace Spectrum {
         return (this->*aggFunc)(magnitudes, validStart, clampedEnd);
     }
 
-    void FrequencyMapper::MapGenericScale(
-        const SpectrumData& mags,
-        SpectrumData& bars,
-        RangeFunc getRange,
-        AggregationFunc aggFunc
-    ) {
-        for (size_t i = 0; i < m_barCount; ++i) {
-            auto range = (this->*getRange)(i);
-            const size_t startBin = GetBinForFrequency(range.start, m_currentFFTSize);
-            const size_t endBin = GetBinForFrequency(range.end, m_currentFFTSize);
-            bars[i] = CalculateBarValue(mags, startBin, endBin, aggFunc);
-        }
-    }
-
-    void FrequencyMapper::MapLinearScale(const SpectrumData& mags, SpectrumData& bars) {
-        MapGenericScale(mags, bars, &FrequencyMapper::GetLinearRange, &FrequencyMapper::MaxInRange);
-    }
-
-    void FrequencyMapper::MapLogarithmicScale(const SpectrumData& mags, SpectrumData& bars) {
-        MapGenericScale(mags, bars, &FrequencyMapper::GetLogarithmicRange, &FrequencyMapper::AverageRange);
-    }
-
-    void FrequencyMapper::MapMelScale(const SpectrumData& mags, SpectrumData& bars) {
-        MapGenericScale(mags, bars, &FrequencyMapper::GetMelRange, &FrequencyMapper::MaxInRange);
-    }
-
 } // namespace Spectrum
\ No newline at end of file
@@ -22,10 +22,34 @@ namespace Spectrum {
             SpectrumScale scaleType
         );
 
+        // Maps a band-limited spectrum (see ZoomFFT) whose bin i lies at
+        // firstBinHz + i * binWidthHz.
+        void MapBandToBars(
+            const SpectrumData& bandMagnitudes,
+            SpectrumData& outputBars,
+            SpectrumScale scaleType,
+            float firstBinHz,
+            float binWidthHz
+        );
+
         // Configuration
         void SetBarCount(size_t newBarCount);
         void SetSampleRate(size_t newSampleRate);
 
+        // Restricts all scales to [minHz, maxHz]; bars spread over the
+        // window only. Cheap to call every frame while it animates.
+        void SetFrequencyWindow(float minHz, float maxHz);
+        void ResetFrequencyWindow();
+
+        // Builds the bar table for a regular FFT of `fftSize` ahead of use,
+        // e.g. on a copy alongside a new FFT plan, so switching sizes does
+        // not rebuild it on the audio path.
+        void PrepareForFFTSize(size_t fftSize, SpectrumScale scaleType);
+
+        // Takes over `prepared`'s table if it was built for the same bars,
+        // sample rate and window as this mapper has now.
+        void AdoptBinTable(FrequencyMapper&& prepared);
+
         // Frequency calculations
         float GetFrequencyForBin(size_t bin, size_t fftSize) const;
         size_t GetBinForFrequency(float frequency, size_t fftSize) const;
@@ -43,24 +67,48 @@ namespace Spectrum {
         using RangeFunc = FrequencyRange(FrequencyMapper::*)(size_t) const;
         using AggregationFunc = float (FrequencyMapper::*)(const SpectrumData&, size_t, size_t) const;
 
-        // Generic mapping function
-        void MapGenericScale(
+        struct BinRange {
+            size_t start = 0;
+            size_t end = 0;
+        };
+
+        // Where the bins of the spectrum being mapped sit in frequency:
+        // either a regular FFT of fftSize points or a zoomed band.
+        struct BinLayout {
+            size_t fftSize = 0;
+            float firstBinHz = 0.0f;
+            float binWidthHz = 0.0f;
+            size_t binCount = 0;
+
+            bool operator==(const BinLayout& o) const noexcept {
+                return fftSize == o.fftSize && firstBinHz == o.firstBinHz &&
+                    binWidthHz == o.binWidthHz && binCount == o.binCount;
+            }
+            bool operator!=(const BinLayout& o) const noexcept { return !(*this == o); }
+        };
+
+        void MapWithLayout(
             const SpectrumData& mags,
             SpectrumData& bars,
-            RangeFunc getRange,
-            AggregationFunc aggFunc
+            SpectrumScale scaleType,
+            const BinLayout& layout
         );
 
+        // The bar -> bin table depends only on the bin layout, bar count,
+        // sample rate, frequency window and scale, so it is rebuilt when
+        // one of those changes rather than on every frame.
+        void RebuildBinTable(const BinLayout& layout, SpectrumScale scaleType);
+        size_t GetBinForLayout(float frequency, const BinLayout& layout) const;
+        float GetWindowLow(float scaleFloor) const noexcept;
+        float GetWindowHigh() const noexcept;
+        static RangeFunc GetRangeFunc(SpectrumScale scaleType) noexcept;
+        static AggregationFunc GetAggregationFunc(SpectrumScale scaleType) noexcept;
+
         // Frequency range calculators
         FrequencyRange GetLinearRange(size_t barIndex) const;
         FrequencyRange GetLogarithmicRange(size_t barIndex) const;
         FrequencyRange GetMelRange(size_t barIndex) const;
 
-        // Mapping implementations
-        void MapLinearScale(const SpectrumData& mags, SpectrumData& bars);
-        void MapLogarithmicScale(const SpectrumData& mags, SpectrumData& bars);
-        void MapMelScale(const SpectrumData& mags, SpectrumData& bars);
-
         // Bar value calculation
         float CalculateBarValue(
             const SpectrumData& magnitudes,
@@ -83,7 +131,12 @@ namespace Spectrum {
         size_t m_barCount;
         size_t m_sampleRate;
         float m_nyquistFrequency;
-        size_t m_currentFFTSize;
+        float m_windowMinHz;
+        float m_windowMaxHz;
+
+        std::vector<BinRange> m_binTable;
+        BinLayout m_tableLayout;
+        SpectrumScale m_tableScale;
     };
 
 } // namespace Spectrum
@@ -18,9 +18,12 @@ namespace Spectrum {
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
     void GainNormalizer::Process(SpectrumData& spectrum) {
+        // Padding lanes are zero, so full-width passes need no tail loop.
+        auto lanes = spectrum.Padded();
+
         float currentMax = 0.0f;
-        if (!spectrum.empty())
-            currentMax = *std::max_element(spectrum.begin(), spectrum.end());
+        for (float val : lanes)
+            currentMax = std::max(currentMax, val);
 
         // Update the running peak level with attack/decay behavior.
         if (currentMax > m_peakLevel)
@@ -33,7 +36,7 @@ namespace Spectrum {
         // Calculate and apply the dynamic gain.
         const float dynamicGain = Clamp(kTargetGainLevel / m_peakLevel, kMinGain, kMaxGain);
 
-        for (float& val : spectrum)
+        for (float& val : lanes)
             val *= dynamicGain;
     }
 
@@ -0,0 +1,118 @@
+#include "SpectralWhitener.h"
+#include <algorithm>
+
+namespace Spectrum {
+
+    // Padding lanes are zero in the input and in every state buffer, and
+    // each pass maps zeros to zero, so all passes run full width.
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Public Interface
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void SpectralWhitener::Process(SpectrumData& spectrum) {
+        if (spectrum.empty()) return;
+        if (!m_primed || m_level.size() != spectrum.size())
+            Prime(spectrum);
+
+        TrackNoiseFloor(spectrum);
+        Whiten(spectrum);
+    }
+
+    void SpectralWhitener::Reset() {
+        m_primed = false;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Processing Steps
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    // Level and peaks start from the first frame, so they do not have to
+    // climb up from zero. The floor starts at zero: until a sub-window
+    // closes, the only minimum is of the signal itself.
+    void SpectralWhitener::Prime(const SpectrumData& spectrum) {
+        const size_t count = spectrum.size();
+
+        m_level.assign(spectrum.begin(), spectrum.end());
+        m_peak.assign(spectrum.begin(), spectrum.end());
+        m_currentMin.assign(count, kUnset);
+        m_windowMin.assign(count, kUnset);
+        m_noiseFloor.assign(count, 0.0f);
+        for (auto& mins : m_subWindowMins)
+            mins.assign(count, kUnset);
+
+        m_slot = 0;
+        m_framesInSlot = 0;
+        m_hasFloor = false;
+        m_primed = true;
+    }
+
+    void SpectralWhitener::TrackNoiseFloor(const SpectrumData& spectrum) {
+        const size_t n = spectrum.PaddedSize();
+        const float* in = spectrum.data();
+        float* level = m_level.data();
+        float* currentMin = m_currentMin.data();
+        const float* windowMin = m_windowMin.data();
+        float* floor = m_noiseFloor.data();
+        const float bias = m_hasFloor ? kFloorBias : 0.0f;
+
+        for (size_t i = 0; i < n; ++i) {
+            level[i] = kLevelSmoothing * level[i] + (1.0f - kLevelSmoothing) * in[i];
+            currentMin[i] = std::min(currentMin[i], level[i]);
+            floor[i] = bias * std::min(windowMin[i], currentMin[i]);
+        }
+
+        if (++m_framesInSlot == kSubWindowFrames)
+            AdvanceSubWindow();
+    }
+
+    // Closes the open sub-window into the ring, dropping the oldest one,
+    // and recomputes the window minimum from the ring.
+    void SpectralWhitener::AdvanceSubWindow() {
+        const size_t n = m_currentMin.PaddedSize();
+        float* currentMin = m_currentMin.data();
+        float* windowMin = m_windowMin.data();
+
+        std::copy_n(currentMin, n, m_subWindowMins[m_slot].data());
+        m_slot = (m_slot + 1) % kSubWindows;
+        m_framesInSlot = 0;
+        m_hasFloor = true;
+
+        std::copy_n(m_subWindowMins[0].data(), n, windowMin);
+        for (size_t w = 1; w < kSubWindows; ++w) {
+            const float* mins = m_subWindowMins[w].data();
+            for (size_t i = 0; i < n; ++i)
+                windowMin[i] = std::min(windowMin[i], mins[i]);
+        }
+
+        std::fill_n(currentMin, m_currentMin.size(), kUnset);
+    }
+
+    void SpectralWhitener::Whiten(SpectrumData& spectrum) {
+        const size_t n = spectrum.PaddedSize();
+        float* values = spectrum.data();
+        float* peak = m_peak.data();
+        const float* level = m_level.data();
+        const float* floor = m_noiseFloor.data();
+
+        // The gate opens with the smoothed level's distance above the
+        // floor; gating on the level rather than the raw input keeps it
+        // steady across frames.
+        float loudest = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            const float above = std::max(level[i] - floor[i], 0.0f);
+            const float gate = std::min(above / (kGateWidth * floor[i] + kEpsilon), 1.0f);
+            values[i] *= gate;
+            peak[i] = std::max(values[i], peak[i] * kPeakDecay);
+            loudest = std::max(loudest, peak[i]);
+        }
+
+        // Each bar is lifted toward the loudest one, by at most
+        // 1 / kRelaxation, so the overall level still reaches the
+        // normalizer and silence stays quiet.
+        const float relaxation = kRelaxation * loudest + kEpsilon;
+        for (size_t i = 0; i < n; ++i)
+            values[i] *= loudest / (peak[i] + relaxation);
+    }
+
+} // namespace Spectrum
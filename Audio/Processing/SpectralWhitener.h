@@ -0,0 +1,82 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectralWhitener.h: Optional per-bar stage ahead of GainNormalizer. The
+// normalizer scales by the loudest bar, so one strong bass bar squeezes
+// everything else, and in a quiet room the noise floor becomes the signal.
+//
+// Per bar, the whitener first tracks the noise floor with minimum
+// statistics: the minimum of a smoothed level over a sliding window of
+// kSubWindows * kSubWindowFrames hops, kept as a ring of sub-window minima
+// so the window slides without storing every frame. A bar is gated off
+// while its smoothed level stays near the floor. What passes is scaled by
+// the loudest bar's peak over its own decaying peak, so each bar is
+// measured against its recent history rather than against the bass; the
+// overall level is kept, so the normalizer still sees silence as quiet.
+// Anything held longer than the window counts as floor. Until the first
+// sub-window closes there is no floor yet and the gate stays open.
+//
+// Every pass is element-wise over the padded buffers. The cost per hop
+// is a few passes over the bars plus one kSubWindows-wide min every
+// kSubWindowFrames hops.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_SPECTRAL_WHITENER_H
+#define SPECTRUM_CPP_SPECTRAL_WHITENER_H
+
+#include "Common/Types.h"
+#include <array>
+
+namespace Spectrum {
+
+    class SpectralWhitener {
+    public:
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Public Interface
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        // State is sized on the first frame and again whenever the bar
+        // count changes.
+        void Process(SpectrumData& spectrum);
+        void Reset();
+
+        [[nodiscard]] const SpectrumData& GetNoiseFloor() const noexcept { return m_noiseFloor; }
+
+    private:
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Constants
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        static constexpr size_t kSubWindows = 8;
+        static constexpr size_t kSubWindowFrames = 24;   // ~4 s window at 1024-sample hops
+        static constexpr float kLevelSmoothing = 0.7f;
+        static constexpr float kFloorBias = 2.0f;        // the minimum sits well below the mean
+        static constexpr float kGateWidth = 2.0f;        // open once this many floors above it
+        static constexpr float kPeakDecay = 0.995f;
+        static constexpr float kRelaxation = 0.2f;       // of the loudest peak
+        static constexpr float kEpsilon = 1e-9f;
+        static constexpr float kUnset = 3.0e38f;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Processing Steps
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        void Prime(const SpectrumData& spectrum);
+        void TrackNoiseFloor(const SpectrumData& spectrum);
+        void AdvanceSubWindow();
+        void Whiten(SpectrumData& spectrum);
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Member Variables
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        SpectrumData m_level;           // smoothed input
+        SpectrumData m_currentMin;      // of m_level in the open sub-window
+        SpectrumData m_windowMin;       // over the closed sub-windows
+        SpectrumData m_noiseFloor;
+        SpectrumData m_peak;
+        std::array<SpectrumData, kSubWindows> m_subWindowMins;
+
+        size_t m_slot = 0;
+        size_t m_framesInSlot = 0;
+        bool m_hasFloor = false;        // a sub-window has closed
+        bool m_primed = false;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_SPECTRAL_WHITENER_H
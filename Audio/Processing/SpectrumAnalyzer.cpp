@@ -11,8 +11,13 @@ namespace Spectrum {
         m_sampleRate(DEFAULT_SAMPLE_RATE),
         m_fftProcessor(fftSize),
         m_frequencyMapper(barCount, DEFAULT_SAMPLE_RATE),
-        m_postProcessor(barCount) {
-        m_processBuffer.resize(fftSize);
+        m_zoomFFT(DEFAULT_SAMPLE_RATE),
+        m_postProcessor(barCount),
+        m_pendingFFTSize(0),
+        m_hasFrequencyWindow(false),
+        m_windowMinHz(0.0f),
+        m_windowMaxHz(0.0f) {
+        m_processBuffer.resize(m_fftProcessor.GetFFTSize());
     }
 
     bool SpectrumAnalyzer::ValidateAudioInput(
@@ -37,6 +42,8 @@ namespace Spectrum {
     }
 
     void SpectrumAnalyzer::Update() {
+        ApplyPendingPlan();
+
         const size_t fftSize = m_fftProcessor.GetFFTSize();
         const size_t hopSize = fftSize / 2;
 
@@ -46,6 +53,40 @@ namespace Spectrum {
         }
     }
 
+    void SpectrumAnalyzer::RequestPlan(size_t fftSize) {
+        m_pendingPlan = std::async(std::launch::async,
+            [fftSize, scale = m_scaleType, mapper = m_frequencyMapper]() mutable {
+                PreparedFFT prepared{ FFTPlanCache::Instance().Acquire(fftSize), std::move(mapper) };
+                prepared.mapper.PrepareForFFTSize(fftSize, scale);
+                return prepared;
+            });
+    }
+
+    void SpectrumAnalyzer::ApplyPendingPlan() {
+        if (!m_pendingPlan.valid()) return;
+
+        using namespace std::chrono_literals;
+        if (m_pendingPlan.wait_for(0s) != std::future_status::ready) return;
+
+        PreparedFFT prepared = m_pendingPlan.get();
+
+        // Another size was asked for while this one was being built.
+        if (prepared.plan && prepared.plan->size != m_pendingFFTSize) {
+            RequestPlan(m_pendingFFTSize);
+            return;
+        }
+
+        // Update only runs whole hops, so the FIFO is always at a hop
+        // boundary here; the new size simply reads from the same samples.
+        if (prepared.plan) {
+            m_fftProcessor.SetPlan(std::move(prepared.plan));
+            m_frequencyMapper.AdoptBinTable(std::move(prepared.mapper));
+            m_processBuffer.resize(m_fftProcessor.GetFFTSize());
+            UpdateZoomMode();
+        }
+        m_pendingFFTSize = 0;
+    }
+
     void SpectrumAnalyzer::CopyChunkToProcessBuffer() {
         m_bufferManager.CopyTo(m_processBuffer, m_fftProcessor.GetFFTSize());
     }
@@ -62,19 +103,68 @@ namespace Spectrum {
         );
     }
 
-    void SpectrumAnalyzer::ApplyPostProcessing(SpectrumData& bars) {
+    void SpectrumAnalyzer::MapZoomToBars(SpectrumData& outBars) {
+        m_zoomFFT.Compute();
+        m_frequencyMapper.MapBandToBars(
+            m_zoomFFT.GetMagnitudes(),
+            outBars,
+            m_scaleType,
+            m_zoomFFT.GetFirstBinHz(),
+            m_zoomFFT.GetBinWidthHz()
+        );
+    }
+
+    void SpectrumAnalyzer::UpdateZoomMode() {
+        if (!m_hasFrequencyWindow) {
+            m_zoomFFT.Disable();
+            return;
+        }
+
+        // Zoom only pays off once a bar is narrower than a regular bin.
+        const float binWidth = static_cast<float>(m_sampleRate) /
+            static_cast<float>(m_fftProcessor.GetFFTSize());
+        const float barWidth = (m_windowMaxHz - m_windowMinHz) /
+            static_cast<float>(m_barCount);
+
+        if (binWidth > barWidth) {
+            m_zoomFFT.Configure(m_windowMinHz, m_windowMaxHz);
+        }
+        else {
+            m_zoomFFT.Disable();
+        }
+    }
+
+    void SpectrumAnalyzer::ApplyPostProcessing(SpectrumData& bars, int64_t captureNs) {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_postProcessor.Process(bars);
+        m_sampler.Push(m_postProcessor.GetSmoothedBars(), captureNs);
+
+        if (m_frameSink)
+            m_frameSink(m_postProcessor.GetSmoothedBars(), m_postProcessor.GetPeakValues());
     }
 
     void SpectrumAnalyzer::ProcessSingleFFTChunk() {
+        // Stamped before the hop is consumed, while its samples are buffered.
+        const int64_t captureNs = m_bufferManager.CaptureTimeNs(
+            m_fftProcessor.GetFFTSize() - 1, m_sampleRate);
+
         CopyChunkToProcessBuffer();
-        ExecuteFFT();
+
+        // The zoom path sees each sample once: the hop about to be consumed.
+        if (m_zoomFFT.IsActive()) {
+            m_zoomFFT.Push(m_processBuffer.data(), m_fftProcessor.GetFFTSize() / 2);
+        }
 
         SpectrumData currentBars(m_barCount, 0.0f);
-        MapMagnitudesToBars(currentBars);
+        if (m_zoomFFT.IsActive() && m_zoomFFT.IsPrimed()) {
+            MapZoomToBars(currentBars);
+        }
+        else {
+            ExecuteFFT();
+            MapMagnitudesToBars(currentBars);
+        }
 
-        ApplyPostProcessing(currentBars);
+        ApplyPostProcessing(currentBars, captureNs);
     }
 
     SpectrumData SpectrumAnalyzer::GetSpectrum() {
@@ -82,6 +172,19 @@ namespace Spectrum {
         return m_postProcessor.GetSmoothedBars();
     }
 
+    SpectrumData SpectrumAnalyzer::GetSpectrumAt(int64_t presentNs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_sampler.HasFrames()) return m_postProcessor.GetSmoothedBars();
+
+        // By a hop plus the delivery latency ago, the frame after the one
+        // stamped then has arrived, so the sampler blends and never guesses.
+        const int64_t hopNs = m_sampleRate > 0
+            ? static_cast<int64_t>(m_fftProcessor.GetFFTSize() / 2) * 1'000'000'000
+                / static_cast<int64_t>(m_sampleRate)
+            : 0;
+        return m_sampler.Sample(presentNs - hopNs - SpectrumSampler::kDeliveryLatencyNs);
+    }
+
     void SpectrumAnalyzer::SetBarCount(size_t newBarCount) {
         if (newBarCount == 0 || newBarCount == m_barCount) return;
 
@@ -89,6 +192,8 @@ namespace Spectrum {
         m_barCount = newBarCount;
         m_frequencyMapper.SetBarCount(newBarCount);
         m_postProcessor.SetBarCount(newBarCount);
+        m_sampler.Reset();
+        UpdateZoomMode();
     }
 
     void SpectrumAnalyzer::SetAmplification(float newAmplification) {
@@ -99,15 +204,57 @@ namespace Spectrum {
         m_postProcessor.SetSmoothing(newSmoothing);
     }
 
+    void SpectrumAnalyzer::SetWhitening(bool enabled) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_postProcessor.SetWhitening(enabled);
+    }
+
+    void SpectrumAnalyzer::SetFrameSink(IAudioSource::FrameSink sink) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frameSink = std::move(sink);
+    }
+
     void SpectrumAnalyzer::SetFFTWindow(FFTWindowType windowType) {
         m_fftProcessor.SetWindowType(windowType);
+        m_zoomFFT.SetWindowType(windowType);
     }
 
     void SpectrumAnalyzer::SetScaleType(SpectrumScale scaleType) {
         m_scaleType = scaleType;
     }
 
-    const SpectrumData& SpectrumAnalyzer::GetPeakValues() const {
+    void SpectrumAnalyzer::SetFFTSize(size_t fftSize) {
+        if (!FFTPlanCache::IsSupportedSize(fftSize) || fftSize == GetFFTSize()) return;
+
+        m_pendingFFTSize = fftSize;
+
+        // A build still in flight is left to finish and dropped by
+        // ApplyPendingPlan: assigning over its future would block until
+        // the worker is done.
+        using namespace std::chrono_literals;
+        if (m_pendingPlan.valid() && m_pendingPlan.wait_for(0s) != std::future_status::ready) return;
+
+        RequestPlan(fftSize);
+    }
+
+    void SpectrumAnalyzer::SetFrequencyWindow(float minHz, float maxHz) {
+        if (!(maxHz > minHz) || minHz < 0.0f) return;
+
+        m_hasFrequencyWindow = true;
+        m_windowMinHz = minHz;
+        m_windowMaxHz = maxHz;
+        m_frequencyMapper.SetFrequencyWindow(minHz, maxHz);
+        UpdateZoomMode();
+    }
+
+    void SpectrumAnalyzer::ResetFrequencyWindow() {
+        m_hasFrequencyWindow = false;
+        m_frequencyMapper.ResetFrequencyWindow();
+        m_zoomFFT.Disable();
+    }
+
+    SpectrumData SpectrumAnalyzer::GetPeakValues() {
+        std::lock_guard<std::mutex> lock(m_mutex);
         return m_postProcessor.GetPeakValues();
     }
     size_t SpectrumAnalyzer::GetBarCount() const { return m_barCount; }
@@ -117,6 +264,12 @@ namespace Spectrum {
     float SpectrumAnalyzer::GetSmoothing() const {
         return m_postProcessor.GetSmoothing();
     }
+    bool SpectrumAnalyzer::IsWhitening() const {
+        return m_postProcessor.IsWhitening();
+    }
     SpectrumScale SpectrumAnalyzer::GetScaleType() const { return m_scaleType; }
+    size_t SpectrumAnalyzer::GetFFTSize() const {
+        return m_pendingFFTSize != 0 ? m_pendingFFTSize : m_fftProcessor.GetFFTSize();
+    }
 
 }
\ No newline at end of file
@@ -6,10 +6,14 @@
 
 #include "Common/Common.h"
 #include "Audio/Capture/AudioCapture.h"
+#include "Audio/Sources/IAudioSource.h"
 #include "AudioBuffer.h"
 #include "FFTProcessor.h"
 #include "FrequencyMapper.h"
 #include "SpectrumPostProcessor.h"
+#include "SpectrumSampler.h"
+#include "ZoomFFT.h"
+#include <future>
 
 namespace Spectrum {
 
@@ -23,23 +27,54 @@ namespace Spectrum {
         void SetBarCount(size_t newBarCount);
         void SetAmplification(float newAmplification);
         void SetSmoothing(float newSmoothing);
+        void SetWhitening(bool enabled);
         void SetFFTWindow(FFTWindowType windowType);
         void SetScaleType(SpectrumScale scaleType);
 
+        // Receives every hop's bars and peaks, on the thread that runs
+        // Update, so consumers see each analysis frame exactly once.
+        void SetFrameSink(IAudioSource::FrameSink sink);
+
+        // Takes effect at the next hop boundary once the plan and its bar
+        // table are ready. Buffered audio and smoothing state carry over.
+        void SetFFTSize(size_t fftSize);
+
+        // Spreads the bars over [minHz, maxHz]. When the regular FFT is too
+        // coarse for that window, bars come from a zoom FFT instead.
+        void SetFrequencyWindow(float minHz, float maxHz);
+        void ResetFrequencyWindow();
+
         SpectrumData GetSpectrum();
-        const SpectrumData& GetPeakValues() const;
+
+        // Bars as they should look at `presentNs` (steady clock), played a
+        // hop plus the delivery latency late; see SpectrumSampler.
+        SpectrumData GetSpectrumAt(int64_t presentNs);
+        SpectrumData GetPeakValues();
         size_t GetBarCount() const;
         float GetAmplification() const;
         float GetSmoothing() const;
+        bool IsWhitening() const;
         SpectrumScale GetScaleType() const;
+        size_t GetFFTSize() const;
 
     private:
+        // What SetFFTSize prepares on a worker thread: the plan and a bar
+        // table for it, built on a copy of the mapper.
+        struct PreparedFFT {
+            FFTPlanPtr plan;
+            FrequencyMapper mapper;
+        };
+
         // Processing pipeline
+        void RequestPlan(size_t fftSize);
+        void ApplyPendingPlan();
         void ProcessSingleFFTChunk();
         void CopyChunkToProcessBuffer();
         void ExecuteFFT();
         void MapMagnitudesToBars(SpectrumData& outBars);
-        void ApplyPostProcessing(SpectrumData& bars);
+        void MapZoomToBars(SpectrumData& outBars);
+        void UpdateZoomMode();
+        void ApplyPostProcessing(SpectrumData& bars, int64_t captureNs);
 
         // Helpers
         bool ValidateAudioInput(const float* data, size_t samples, int channels, size_t& outFrames) const;
@@ -50,11 +85,21 @@ namespace Spectrum {
 
         FFTProcessor m_fftProcessor;
         FrequencyMapper m_frequencyMapper;
+        ZoomFFT m_zoomFFT;
         SpectrumPostProcessor m_postProcessor;
+        SpectrumSampler m_sampler;
+        IAudioSource::FrameSink m_frameSink;
         ThreadSafeAudioBuffer m_bufferManager;
 
         AudioBuffer m_processBuffer;
         std::mutex m_mutex;
+
+        std::future<PreparedFFT> m_pendingPlan;
+        size_t m_pendingFFTSize;
+
+        bool m_hasFrequencyWindow;
+        float m_windowMinHz;
+        float m_windowMaxHz;
     };
 
 }
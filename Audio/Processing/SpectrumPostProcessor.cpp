@@ -21,6 +21,8 @@ namespace Spectrum {
         m_barCount(barCount),
         m_amplificationFactor(DEFAULT_AMPLIFICATION),
         m_smoothingFactor(DEFAULT_SMOOTHING),
+        m_whitening(false),
+        m_whitener(std::make_unique<SpectralWhitener>()),
         m_normalizer(std::make_unique<GainNormalizer>())
     {
         Reset();
@@ -29,6 +31,8 @@ namespace Spectrum {
     void SpectrumPostProcessor::Reset() {
         m_smoothedBars.assign(m_barCount, 0.0f);
         m_peakValues.assign(m_barCount, 0.0f);
+        if (m_whitener)
+            m_whitener->Reset();
         if (m_normalizer)
             m_normalizer->Reset();
     }
@@ -40,7 +44,9 @@ namespace Spectrum {
     void SpectrumPostProcessor::Process(SpectrumData& spectrum) {
         if (!ValidateSpectrumSize(spectrum)) return;
 
-        // Pipeline: Normalize -> Shape -> Apply Visual Effects
+        // Pipeline: [Whiten] -> Normalize -> Shape -> Apply Visual Effects
+        if (m_whitening)
+            m_whitener->Process(spectrum);
         m_normalizer->Process(spectrum);
         ApplyLogarithmicScaling(spectrum);
         ApplyAmplification(spectrum);
@@ -72,6 +78,13 @@ namespace Spectrum {
         m_smoothingFactor = Saturate(newSmoothing);
     }
 
+    // Switching on starts from fresh floor and peak estimates.
+    void SpectrumPostProcessor::SetWhitening(bool enabled) {
+        if (enabled && !m_whitening)
+            m_whitener->Reset();
+        m_whitening = enabled;
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Public Getters
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -92,6 +105,10 @@ namespace Spectrum {
         return m_smoothingFactor;
     }
 
+    [[nodiscard]] bool SpectrumPostProcessor::IsWhitening() const {
+        return m_whitening;
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Processing Pipeline
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -100,7 +117,8 @@ namespace Spectrum {
         const float sensitivity = 150.0f;
         const float invLogSensitivity = 1.0f / std::log1p(sensitivity);
 
-        for (float& val : spectrum)
+        // log1p(0) == 0 keeps the padding lanes zero.
+        for (float& val : spectrum.Padded())
             val = std::log1p(val * sensitivity) * invLogSensitivity;
     }
 
@@ -1,8 +1,9 @@
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 // This file defines the SpectrumPostProcessor, which applies final
 // shaping and visual effects to the frequency spectrum. It coordinates
-// gain normalization and then applies logarithmic scaling, user-defined
-// amplification, smoothing, and peak detection.
+// optional spectral whitening and gain normalization, then applies
+// logarithmic scaling, user-defined amplification, smoothing, and peak
+// detection.
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
 #ifndef SPECTRUM_CPP_SPECTRUM_POST_PROCESSOR_H
@@ -10,6 +11,7 @@
 
 #include "Common/Common.h"
 #include "GainNormalizer.h"
+#include "SpectralWhitener.h"
 #include <memory>
 
 namespace Spectrum {
@@ -33,6 +35,7 @@ namespace Spectrum {
         void SetBarCount(size_t newBarCount);
         void SetAmplification(float newAmplification);
         void SetSmoothing(float newSmoothing);
+        void SetWhitening(bool enabled);
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Public Getters
@@ -41,6 +44,7 @@ namespace Spectrum {
         [[nodiscard]] const SpectrumData& GetPeakValues() const;
         [[nodiscard]] float GetAmplification() const;
         [[nodiscard]] float GetSmoothing() const;
+        [[nodiscard]] bool IsWhitening() const;
 
     private:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -120,7 +124,9 @@ namespace Spectrum {
         size_t m_barCount;
         float m_amplificationFactor;
         float m_smoothingFactor;
+        bool m_whitening;
 
+        std::unique_ptr<SpectralWhitener> m_whitener;
         std::unique_ptr<GainNormalizer> m_normalizer;
 
         SpectrumData m_smoothedBars;
@@ -0,0 +1,103 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumSampler.h: Resamples the analysis frame stream at display time.
+// Analysis yields a frame per hop (about 23 ms at 2048 / 44.1 kHz), which
+// a fast display would show as steps. The sampler keeps the newest few
+// frames with the time their last sample was captured and blends the two
+// stamped either side of the requested time, so the bars move linearly
+// from one to the next. The caller asks for a time far enough back that
+// the later frame has arrived: a hop, plus kDeliveryLatencyNs because the
+// stamps are back-dated from when a capture packet came in. A frame later
+// than that is made up for by extrapolating for at most kMaxExtrapolation
+// of a hop, then holding. Costs that much latency and no extra FFTs.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_SPECTRUM_SAMPLER_H
+#define SPECTRUM_CPP_SPECTRUM_SAMPLER_H
+
+#include "Common/Types.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace Spectrum {
+
+    class SpectrumSampler final {
+    public:
+        static constexpr float kMaxExtrapolation = 0.25f;
+        // Longest a frame takes to arrive after its stamp: the event-driven
+        // capture period of 10 ms plus scheduling jitter. The 20 ms polling
+        // fallback can run over and extrapolate.
+        static constexpr int64_t kDeliveryLatencyNs = 12'000'000;
+        // Enough frames to cover a hop plus that latency at small FFT sizes.
+        static constexpr size_t kHistory = 4;
+
+        [[nodiscard]] static int64_t NowNs() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Frames must come in capture order; the oldest is recycled.
+        void Push(const SpectrumData& bars, int64_t timeNs) {
+            m_newest = (m_newest + 1) % kHistory;
+            m_history[m_newest].bars = bars;
+            m_history[m_newest].timeNs = timeNs;
+            if (m_count < kHistory) ++m_count;
+        }
+
+        [[nodiscard]] SpectrumData Sample(int64_t presentNs) const {
+            const Frame& latest = At(0);
+            if (m_count < 2) return latest.bars;
+
+            // The newest frame stamped at or before presentNs, and the one
+            // after it. Past the newest stamp that is the last pair, which
+            // then extrapolates; before the oldest it is the first, held.
+            size_t age = 1;
+            while (age + 1 < m_count && At(age).timeNs > presentNs) ++age;
+            const Frame& from = At(age);
+            const Frame& to = At(age - 1);
+
+            const int64_t interval = to.timeNs - from.timeNs;
+            if (interval <= 0 || from.bars.size() != to.bars.size() || to.bars.size() != latest.bars.size())
+                return latest.bars;
+
+            const float t = std::clamp(
+                static_cast<float>(presentNs - from.timeNs) / static_cast<float>(interval),
+                0.0f, 1.0f + kMaxExtrapolation);
+
+            // Padding lanes are zero in both inputs and stay zero.
+            SpectrumData out(to.bars.size());
+            const float* a = from.bars.data();
+            const float* b = to.bars.data();
+            float* o = out.data();
+            const size_t padded = out.PaddedSize();
+            for (size_t i = 0; i < padded; ++i)
+                o[i] = std::max(0.0f, a[i] + (b[i] - a[i]) * t);
+            return out;
+        }
+
+        [[nodiscard]] bool HasFrames() const noexcept { return m_count > 0; }
+        [[nodiscard]] const SpectrumData& GetLatest() const noexcept { return At(0).bars; }
+        [[nodiscard]] int64_t GetLatestTimeNs() const noexcept { return At(0).timeNs; }
+
+        // After a change that makes old frames incomparable, e.g. the bar count.
+        void Reset() noexcept { m_count = 0; }
+
+    private:
+        struct Frame {
+            SpectrumData bars;
+            int64_t      timeNs = 0;
+        };
+
+        // Age 0 is the newest frame.
+        [[nodiscard]] const Frame& At(size_t age) const noexcept {
+            return m_history[(m_newest + kHistory - age) % kHistory];
+        }
+
+        std::array<Frame, kHistory> m_history;
+        size_t                      m_newest = 0;
+        size_t                      m_count = 0;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_SPECTRUM_SAMPLER_H
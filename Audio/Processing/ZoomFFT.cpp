@@ -0,0 +1,179 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ZoomFFT.cpp: Demodulation, decimation and the short complex transform.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "ZoomFFT.h"
+#include "FFTProcessor.h"
+
+namespace Spectrum {
+
+    namespace {
+
+        constexpr size_t kMaxDecimation = 64;
+        constexpr size_t kTapsPerDecimation = 8;
+
+        // Output band must exceed the requested one by this factor so the
+        // window stays inside the filter's flat passband.
+        constexpr float kBandMargin = 1.25f;
+
+        // Renormalise the mixer phasor this often to stop amplitude drift.
+        constexpr size_t kOscillatorRenormMask = 1023;
+
+    } // anonymous namespace
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Lifecycle Management
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    ZoomFFT::ZoomFFT(size_t sampleRate)
+        : m_sampleRate(sampleRate)
+        , m_decimation(1)
+        , m_centerHz(0.0f)
+        , m_windowType(FFTWindowType::Hann)
+        , m_oscillator(1.0f, 0.0f)
+        , m_oscillatorStep(1.0f, 0.0f)
+        , m_historyPos(0)
+        , m_phase(0)
+        , m_decimatedPos(0)
+        , m_decimatedCount(0) {
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Public Interface
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool ZoomFFT::Configure(float minHz, float maxHz) {
+        const size_t decimation = ChooseDecimation(m_sampleRate, maxHz - minHz);
+        if (decimation <= 1) {
+            Disable();
+            return false;
+        }
+
+        if (!m_plan) m_plan = FFTPlanCache::Instance().Acquire(kFFTSize);
+
+        // Retuning alone keeps the streams: while a window is being
+        // animated the short transient is preferable to re-priming.
+        m_centerHz = 0.5f * (minHz + maxHz);
+        const float omega = -TWO_PI * m_centerHz / static_cast<float>(m_sampleRate);
+        m_oscillatorStep = std::polar(1.0f, omega);
+
+        if (decimation != m_decimation) {
+            m_decimation = decimation;
+            DesignLowPass();
+            ResetStreams();
+        }
+        return true;
+    }
+
+    void ZoomFFT::Disable() noexcept {
+        m_decimation = 1;
+        m_decimatedCount = 0;
+    }
+
+    void ZoomFFT::Push(const float* samples, size_t count) {
+        if (!IsActive() || !samples) return;
+
+        const size_t tapCount = m_taps.size();
+
+        for (size_t i = 0; i < count; ++i) {
+            const std::complex<float> mixed = samples[i] * m_oscillator;
+            m_oscillator *= m_oscillatorStep;
+            if ((++m_phase & kOscillatorRenormMask) == 0)
+                m_oscillator /= std::abs(m_oscillator);
+
+            m_history[m_historyPos] = mixed;
+            m_history[m_historyPos + tapCount] = mixed;
+            m_historyPos = (m_historyPos + 1) % tapCount;
+
+            if (m_phase % m_decimation != 0) continue;
+
+            // Oldest sample is at m_historyPos; taps are symmetric, so the
+            // order they are applied in does not matter.
+            const std::complex<float>* window = m_history.data() + m_historyPos;
+            std::complex<float> acc(0.0f, 0.0f);
+            for (size_t t = 0; t < tapCount; ++t)
+                acc += m_taps[t] * window[t];
+
+            m_decimated[m_decimatedPos] = acc;
+            m_decimatedPos = (m_decimatedPos + 1) % kFFTSize;
+            m_decimatedCount = std::min(m_decimatedCount + 1, kFFTSize);
+        }
+    }
+
+    void ZoomFFT::Compute() {
+        if (!IsActive() || !m_plan) return;
+
+        const AudioBuffer& window = m_plan->GetWindow(m_windowType);
+        for (size_t i = 0; i < kFFTSize; ++i)
+            m_work[i] = m_decimated[(m_decimatedPos + i) % kFFTSize] * window[i];
+
+        m_plan->Transform(m_work.data());
+
+        // Same scaling as FFTProcessor, so a tone reads the same height in
+        // either path. Negative frequencies go first (fft shift).
+        const float norm = 2.0f / static_cast<float>(kFFTSize);
+        const size_t half = kFFTSize / 2;
+        for (size_t i = 0; i < kFFTSize; ++i)
+            m_magnitudes[i] = std::abs(m_work[(i + half) % kFFTSize]) * norm;
+    }
+
+    float ZoomFFT::GetFirstBinHz() const noexcept {
+        const float outputRate = static_cast<float>(m_sampleRate) / static_cast<float>(m_decimation);
+        return m_centerHz - 0.5f * outputRate;
+    }
+
+    float ZoomFFT::GetBinWidthHz() const noexcept {
+        return static_cast<float>(m_sampleRate) /
+            static_cast<float>(m_decimation * kFFTSize);
+    }
+
+    size_t ZoomFFT::ChooseDecimation(size_t sampleRate, float bandwidthHz) noexcept {
+        if (bandwidthHz <= 0.0f) return 1;
+
+        size_t decimation = 1;
+        while (decimation < kMaxDecimation &&
+            static_cast<float>(sampleRate) / static_cast<float>(decimation * 2) >= bandwidthHz * kBandMargin) {
+            decimation *= 2;
+        }
+        return decimation;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Private Implementation
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void ZoomFFT::DesignLowPass() {
+        // Blackman-windowed sinc, cut off at the decimated Nyquist rate and
+        // normalised to unity gain at DC.
+        const size_t tapCount = kTapsPerDecimation * m_decimation + 1;
+        const float cutoff = 0.5f / static_cast<float>(m_decimation);
+        const float middle = 0.5f * static_cast<float>(tapCount - 1);
+
+        m_taps.resize(tapCount);
+        float sum = 0.0f;
+        for (size_t i = 0; i < tapCount; ++i) {
+            const float x = static_cast<float>(i) - middle;
+            const float sinc = x == 0.0f
+                ? 2.0f * cutoff
+                : std::sin(TWO_PI * cutoff * x) / (PI * x);
+            const float w = FFTProcessor::ApplyWindowFunction(FFTWindowType::Blackman, i, tapCount);
+            m_taps[i] = sinc * w;
+            sum += m_taps[i];
+        }
+        for (float& tap : m_taps) tap /= sum;
+    }
+
+    void ZoomFFT::ResetStreams() {
+        m_history.assign(m_taps.size() * 2, std::complex<float>(0.0f, 0.0f));
+        m_historyPos = 0;
+        m_phase = 0;
+
+        m_decimated.assign(kFFTSize, std::complex<float>(0.0f, 0.0f));
+        m_decimatedPos = 0;
+        m_decimatedCount = 0;
+
+        m_work.resize(kFFTSize);
+        m_magnitudes.assign(kFFTSize, 0.0f);
+    }
+
+} // namespace Spectrum
@@ -0,0 +1,80 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ZoomFFT.h: Band-limited spectrum for a narrow frequency window. The input
+// is shifted down by the window's centre frequency (complex demodulation),
+// low-pass filtered and decimated, and the slower complex stream is then
+// transformed with a short FFT. Bin spacing shrinks by the decimation
+// factor, so a zoomed window gets real resolution instead of a few wide
+// bins stretched across all bars.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_ZOOM_FFT_H
+#define SPECTRUM_CPP_ZOOM_FFT_H
+
+#include "Common/Common.h"
+#include "FFTPlanCache.h"
+
+namespace Spectrum {
+
+    class ZoomFFT final {
+    public:
+        explicit ZoomFFT(size_t sampleRate = DEFAULT_SAMPLE_RATE);
+
+        // Returns false and stays inactive when the band is too wide for
+        // decimation to gain anything.
+        bool Configure(float minHz, float maxHz);
+        void Disable() noexcept;
+
+        void SetWindowType(FFTWindowType type) noexcept { m_windowType = type; }
+
+        // Feeds contiguous mono samples; call with every sample exactly once.
+        void Push(const float* samples, size_t count);
+
+        // Transforms the latest kFFTSize decimated samples.
+        void Compute();
+
+        [[nodiscard]] bool IsActive() const noexcept { return m_decimation > 1; }
+        [[nodiscard]] bool IsPrimed() const noexcept { return m_decimatedCount >= kFFTSize; }
+
+        // Bin i of GetMagnitudes() sits at GetFirstBinHz() + i * GetBinWidthHz().
+        [[nodiscard]] const SpectrumData& GetMagnitudes() const noexcept { return m_magnitudes; }
+        [[nodiscard]] float GetFirstBinHz() const noexcept;
+        [[nodiscard]] float GetBinWidthHz() const noexcept;
+
+        // Largest power-of-two decimation whose output band still covers
+        // `bandwidthHz` with filter margin; 1 means no zoom is possible.
+        [[nodiscard]] static size_t ChooseDecimation(size_t sampleRate, float bandwidthHz) noexcept;
+
+        static constexpr size_t kFFTSize = 1024;
+
+    private:
+        void DesignLowPass();
+        void ResetStreams();
+
+        size_t m_sampleRate;
+        size_t m_decimation;
+        float m_centerHz;
+        FFTPlanPtr m_plan;
+        FFTWindowType m_windowType;
+
+        // Mixer: e^(-j*2*pi*fc*n/fs), advanced by one rotation per sample
+        std::complex<float> m_oscillator;
+        std::complex<float> m_oscillatorStep;
+
+        // Anti-alias FIR; history is stored twice so every dot product reads
+        // one contiguous span
+        std::vector<float> m_taps;
+        std::vector<std::complex<float>> m_history;
+        size_t m_historyPos;
+        size_t m_phase;
+
+        // Decimated ring and FFT scratch
+        std::vector<std::complex<float>> m_decimated;
+        size_t m_decimatedPos;
+        size_t m_decimatedCount;
+        std::vector<std::complex<float>> m_work;
+        SpectrumData m_magnitudes;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_ZOOM_FFT_H
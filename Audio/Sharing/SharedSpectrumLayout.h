@@ -0,0 +1,98 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SharedSpectrumLayout.h: Memory layout of the shared spectrum ring that
+// SpectrumPublisher writes and SpectrumSubscriber reads. Self-contained on
+// purpose so external consumers can include it without the rest of the
+// project.
+//
+// Each slot is guarded by a seqlock: the writer makes the slot's lock word
+// odd, fills the slot, then makes it even again. A reader copies the slot
+// and accepts the copy only if the lock word was even and unchanged across
+// the copy. The writer never waits for readers; a reader that races the
+// writer simply retries or falls back to the previous slot. WriteSlot and
+// TryReadSlot below are the two halves of the protocol.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_SHARED_SPECTRUM_LAYOUT_H
+#define SPECTRUM_CPP_SHARED_SPECTRUM_LAYOUT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Spectrum::SharedSpectrum {
+
+    inline constexpr wchar_t kDefaultName[] = L"Local\\SpectrumCpp.Spectrum";
+
+    inline constexpr uint32_t kMagic = 0x53505348; // 'SPSH'
+    inline constexpr uint32_t kVersion = 1;
+    inline constexpr uint32_t kMaxBars = 256;
+    inline constexpr uint32_t kSlotCount = 8;
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+        "Shared ring needs lock-free 64-bit atomics");
+
+    // Payload copied in and out under the seqlock.
+    struct Frame {
+        uint64_t sequence = 0;       // 1-based, increases by one per publish
+        int64_t timestampNs = 0;     // steady clock, comparable across processes
+        uint32_t barCount = 0;
+        uint32_t peakCount = 0;      // 0 when the source has no peak data
+        float bars[kMaxBars] = {};
+        float peaks[kMaxBars] = {};
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> lock;  // odd while the writer is inside
+        Frame frame;
+    };
+
+    struct alignas(64) Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t maxBars;
+        std::atomic<uint64_t> latestSequence; // 0 until the first publish
+    };
+
+    struct Region {
+        Header header;
+        Slot slots[kSlotCount];
+    };
+
+    [[nodiscard]] constexpr size_t SlotIndex(uint64_t sequence) noexcept {
+        return static_cast<size_t>(sequence % kSlotCount);
+    }
+
+    // Writer side of the seqlock; `fill(Frame&)` writes the payload. Only
+    // one writer may use a region at a time.
+    template<typename Fill>
+    void WriteSlot(Slot& slot, Fill&& fill) noexcept {
+        const uint64_t lock = slot.lock.load(std::memory_order_relaxed);
+        slot.lock.store(lock + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        fill(slot.frame);
+
+        slot.lock.store(lock + 2, std::memory_order_release);
+    }
+
+    // One read attempt; false if it overlapped a write, in which case
+    // `out` holds garbage and the caller retries.
+    [[nodiscard]] inline bool TryReadSlot(const Slot& slot, Frame& out) noexcept {
+        const uint64_t before = slot.lock.load(std::memory_order_acquire);
+        if (before & 1u) return false;
+
+        std::memcpy(&out, &slot.frame, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.lock.load(std::memory_order_relaxed) != before) return false;
+
+        out.barCount = out.barCount < kMaxBars ? out.barCount : kMaxBars;
+        out.peakCount = out.peakCount < kMaxBars ? out.peakCount : kMaxBars;
+        return true;
+    }
+
+} // namespace Spectrum::SharedSpectrum
+
+#endif // SPECTRUM_CPP_SHARED_SPECTRUM_LAYOUT_H
@@ -0,0 +1,88 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumPublisher.cpp: Shared memory creation and the seqlock writer.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "SpectrumPublisher.h"
+#include <cstring>
+
+namespace Spectrum {
+
+    using namespace SharedSpectrum;
+
+    SpectrumPublisher::~SpectrumPublisher() {
+        Shutdown();
+    }
+
+    bool SpectrumPublisher::Initialize(const wchar_t* name) {
+        Shutdown();
+
+        m_mapping = CreateFileMappingW(
+            INVALID_HANDLE_VALUE,
+            nullptr,
+            PAGE_READWRITE,
+            0,
+            static_cast<DWORD>(sizeof(Region)),
+            name
+        );
+        if (!m_mapping) {
+            LOG_ERROR("SpectrumPublisher: CreateFileMapping failed");
+            return false;
+        }
+
+        // A second writer would break the seqlock invariant.
+        if (GetLastError() == ERROR_ALREADY_EXISTS) {
+            LOG_WARNING("SpectrumPublisher: another instance is already publishing");
+            Shutdown();
+            return false;
+        }
+
+        void* view = MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Region));
+        if (!view) {
+            LOG_ERROR("SpectrumPublisher: MapViewOfFile failed");
+            Shutdown();
+            return false;
+        }
+
+        m_region = new (view) Region{};
+        m_region->header.slotCount = kSlotCount;
+        m_region->header.maxBars = kMaxBars;
+        m_region->header.version = kVersion;
+        m_region->header.latestSequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_region->header.magic = kMagic;
+
+        m_sequence = 0;
+        LOG_INFO("SpectrumPublisher: shared spectrum ring ready");
+        return true;
+    }
+
+    void SpectrumPublisher::Shutdown() noexcept {
+        if (m_region) UnmapViewOfFile(m_region);
+        if (m_mapping) CloseHandle(m_mapping);
+        m_region = nullptr;
+        m_mapping = nullptr;
+    }
+
+    void SpectrumPublisher::Publish(
+        const SpectrumData& bars,
+        const SpectrumData& peaks
+    ) noexcept {
+        if (!m_region) return;
+
+        const uint64_t sequence = ++m_sequence;
+        const int64_t timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        WriteSlot(m_region->slots[SlotIndex(sequence)], [&](Frame& frame) {
+            frame.sequence = sequence;
+            frame.timestampNs = timestampNs;
+            frame.barCount = static_cast<uint32_t>(std::min<size_t>(bars.size(), kMaxBars));
+            frame.peakCount = static_cast<uint32_t>(std::min<size_t>(peaks.size(), kMaxBars));
+            std::memcpy(frame.bars, bars.data(), frame.barCount * sizeof(float));
+            std::memcpy(frame.peaks, peaks.data(), frame.peakCount * sizeof(float));
+        });
+
+        m_region->header.latestSequence.store(sequence, std::memory_order_release);
+    }
+
+} // namespace Spectrum
@@ -0,0 +1,43 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumPublisher.h: Writes every analysis frame into a named shared
+// memory ring so LED controllers and stage software can follow the live
+// spectrum without touching the UI. See SharedSpectrumLayout.h for the
+// seqlock protocol; the publisher is the single writer.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_SPECTRUM_PUBLISHER_H
+#define SPECTRUM_CPP_SPECTRUM_PUBLISHER_H
+
+#include "Common/Common.h"
+#include "SharedSpectrumLayout.h"
+
+namespace Spectrum {
+
+    class SpectrumPublisher final {
+    public:
+        SpectrumPublisher() = default;
+        ~SpectrumPublisher();
+
+        SpectrumPublisher(const SpectrumPublisher&) = delete;
+        SpectrumPublisher& operator=(const SpectrumPublisher&) = delete;
+        SpectrumPublisher(SpectrumPublisher&&) = delete;
+        SpectrumPublisher& operator=(SpectrumPublisher&&) = delete;
+
+        [[nodiscard]] bool Initialize(const wchar_t* name = SharedSpectrum::kDefaultName);
+        void Shutdown() noexcept;
+
+        // Never blocks; bars/peaks beyond kMaxBars are dropped.
+        void Publish(const SpectrumData& bars, const SpectrumData& peaks) noexcept;
+
+        [[nodiscard]] bool IsActive() const noexcept { return m_region != nullptr; }
+        [[nodiscard]] uint64_t GetSequence() const noexcept { return m_sequence; }
+
+    private:
+        HANDLE m_mapping = nullptr;
+        SharedSpectrum::Region* m_region = nullptr;
+        uint64_t m_sequence = 0;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_SPECTRUM_PUBLISHER_H
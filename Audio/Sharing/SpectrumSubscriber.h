@@ -0,0 +1,101 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumSubscriber.h: Header-only reader for the shared spectrum ring.
+// Depends only on <windows.h> and SharedSpectrumLayout.h, so external tools
+// can drop both files into their build. Reads never block the publisher:
+// a copy that overlaps a write is detected through the slot's seqlock and
+// retried.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_SPECTRUM_SUBSCRIBER_H
+#define SPECTRUM_CPP_SPECTRUM_SUBSCRIBER_H
+
+#include <windows.h>
+#include "SharedSpectrumLayout.h"
+
+namespace Spectrum {
+
+    class SpectrumSubscriber final {
+    public:
+        SpectrumSubscriber() = default;
+        ~SpectrumSubscriber() { Close(); }
+
+        SpectrumSubscriber(const SpectrumSubscriber&) = delete;
+        SpectrumSubscriber& operator=(const SpectrumSubscriber&) = delete;
+
+        bool Open(const wchar_t* name = SharedSpectrum::kDefaultName) {
+            Close();
+
+            m_mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, name);
+            if (!m_mapping) return false;
+
+            m_region = static_cast<const SharedSpectrum::Region*>(
+                MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, sizeof(SharedSpectrum::Region)));
+
+            if (!m_region || !IsCompatible()) {
+                Close();
+                return false;
+            }
+            return true;
+        }
+
+        void Close() noexcept {
+            if (m_region) UnmapViewOfFile(m_region);
+            if (m_mapping) CloseHandle(m_mapping);
+            m_region = nullptr;
+            m_mapping = nullptr;
+        }
+
+        [[nodiscard]] bool IsOpen() const noexcept { return m_region != nullptr; }
+
+        [[nodiscard]] uint64_t GetLatestSequence() const noexcept {
+            return m_region
+                ? m_region->header.latestSequence.load(std::memory_order_acquire)
+                : 0;
+        }
+
+        // Newest complete frame. Returns false before the first publish.
+        bool ReadLatest(SharedSpectrum::Frame& out) const noexcept {
+            const uint64_t latest = GetLatestSequence();
+            if (latest == 0) return false;
+
+            // If the writer lapped the slot, it now holds a newer frame,
+            // which is just as good for a "latest" read.
+            return ReadSlot(SharedSpectrum::SlotIndex(latest), out) && out.sequence >= latest;
+        }
+
+        // A specific frame, for consumers that must not skip any. Fails once
+        // the ring has been overwritten past `sequence`.
+        bool Read(uint64_t sequence, SharedSpectrum::Frame& out) const noexcept {
+            if (sequence == 0 || sequence > GetLatestSequence()) return false;
+            return ReadSlot(SharedSpectrum::SlotIndex(sequence), out) && out.sequence == sequence;
+        }
+
+    private:
+        static constexpr int kMaxAttempts = 64;
+
+        [[nodiscard]] bool IsCompatible() const noexcept {
+            const auto& h = m_region->header;
+            return h.magic == SharedSpectrum::kMagic &&
+                h.version == SharedSpectrum::kVersion &&
+                h.slotCount == SharedSpectrum::kSlotCount &&
+                h.maxBars == SharedSpectrum::kMaxBars;
+        }
+
+        bool ReadSlot(size_t index, SharedSpectrum::Frame& out) const noexcept {
+            if (!m_region) return false;
+            const SharedSpectrum::Slot& slot = m_region->slots[index];
+
+            for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+                if (SharedSpectrum::TryReadSlot(slot, out)) return true;
+                YieldProcessor();
+            }
+            return false;
+        }
+
+        HANDLE m_mapping = nullptr;
+        const SharedSpectrum::Region* m_region = nullptr;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_SPECTRUM_SUBSCRIBER_H
@@ -38,12 +38,19 @@ namespace Spectrum {
         m_animationTime += deltaTime;
         SpectrumData testData = GenerateTestSpectrum(m_animationTime);
         m_postProcessor.Process(testData);
+
+        if (m_frameSink)
+            m_frameSink(m_postProcessor.GetSmoothedBars(), m_postProcessor.GetPeakValues());
     }
 
     [[nodiscard]] SpectrumData AnimatedAudioSource::GetSpectrum() {
         return m_postProcessor.GetSmoothedBars();
     }
 
+    [[nodiscard]] SpectrumData AnimatedAudioSource::GetPeakValues() {
+        return m_postProcessor.GetPeakValues();
+    }
+
     void AnimatedAudioSource::SetBarCount(size_t count) {
         if (m_barCount == count) return;
         m_barCount = count;
@@ -54,6 +61,10 @@ namespace Spectrum {
         m_postProcessor.SetSmoothing(smoothing);
     }
 
+    void AnimatedAudioSource::SetFrameSink(FrameSink sink) {
+        m_frameSink = std::move(sink);
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Private Implementation
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -25,9 +25,11 @@ namespace Spectrum {
         bool Initialize() override;
         void Update(float deltaTime) override;
         [[nodiscard]] SpectrumData GetSpectrum() override;
+        [[nodiscard]] SpectrumData GetPeakValues() override;
 
         void SetBarCount(size_t count) override;
         void SetSmoothing(float smoothing) override;
+        void SetFrameSink(FrameSink sink) override;
 
     private:
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -45,6 +47,7 @@ namespace Spectrum {
         float m_animationTime;
         size_t m_barCount;
         SpectrumPostProcessor m_postProcessor;
+        FrameSink m_frameSink;
     };
 
 } // namespace Spectrum
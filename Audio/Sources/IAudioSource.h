@@ -8,22 +8,38 @@
 #define SPECTRUM_CPP_IAUDIOSOURCE_H
 
 #include "Common/Common.h"
+#include <functional>
 
 namespace Spectrum {
 
     class IAudioSource {
     public:
+        // Called once for every new frame a source produces, with the bars
+        // and peaks as they are after post-processing.
+        using FrameSink = std::function<void(const SpectrumData& bars, const SpectrumData& peaks)>;
+
         virtual ~IAudioSource() = default;
 
         virtual bool Initialize() = 0;
         virtual void Update(float deltaTime) = 0;
         [[nodiscard]] virtual SpectrumData GetSpectrum() = 0;
 
+        // Bars for a frame presented at `presentNs` (steady clock). Sources
+        // that are not hop-based have nothing to interpolate.
+        [[nodiscard]] virtual SpectrumData GetSpectrumAt(int64_t /*presentNs*/) { return GetSpectrum(); }
+
+        [[nodiscard]] virtual SpectrumData GetPeakValues() { return {}; }
+
         virtual void SetAmplification(float /*amp*/) {}
         virtual void SetBarCount(size_t /*count*/) {}
         virtual void SetFFTWindow(FFTWindowType /*type*/) {}
+        virtual void SetFFTSize(size_t /*fftSize*/) {}
+        virtual void SetFrequencyWindow(float /*minHz*/, float /*maxHz*/) {}
+        virtual void ResetFrequencyWindow() {}
         virtual void SetScaleType(SpectrumScale /*type*/) {}
         virtual void SetSmoothing(float /*smoothing*/) {}
+        virtual void SetWhitening(bool /*enabled*/) {}
+        virtual void SetFrameSink(FrameSink /*sink*/) {}
 
         virtual void StartCapture() {}
         virtual void StopCapture() {}
@@ -43,6 +43,18 @@ namespace Spectrum {
         return {};
     }
 
+    [[nodiscard]] SpectrumData RealtimeAudioSource::GetSpectrumAt(int64_t presentNs) {
+        if (m_analyzer)
+            return m_analyzer->GetSpectrumAt(presentNs);
+        return {};
+    }
+
+    [[nodiscard]] SpectrumData RealtimeAudioSource::GetPeakValues() {
+        if (m_analyzer)
+            return m_analyzer->GetPeakValues();
+        return {};
+    }
+
     void RealtimeAudioSource::SetAmplification(float amp) {
         if (m_analyzer) m_analyzer->SetAmplification(amp);
     }
@@ -55,6 +67,18 @@ namespace Spectrum {
         if (m_analyzer) m_analyzer->SetFFTWindow(type);
     }
 
+    void RealtimeAudioSource::SetFFTSize(size_t fftSize) {
+        if (m_analyzer) m_analyzer->SetFFTSize(fftSize);
+    }
+
+    void RealtimeAudioSource::SetFrequencyWindow(float minHz, float maxHz) {
+        if (m_analyzer) m_analyzer->SetFrequencyWindow(minHz, maxHz);
+    }
+
+    void RealtimeAudioSource::ResetFrequencyWindow() {
+        if (m_analyzer) m_analyzer->ResetFrequencyWindow();
+    }
+
     void RealtimeAudioSource::SetScaleType(SpectrumScale type) {
         if (m_analyzer) m_analyzer->SetScaleType(type);
     }
@@ -63,6 +87,14 @@ namespace Spectrum {
         if (m_analyzer) m_analyzer->SetSmoothing(smoothing);
     }
 
+    void RealtimeAudioSource::SetWhitening(bool enabled) {
+        if (m_analyzer) m_analyzer->SetWhitening(enabled);
+    }
+
+    void RealtimeAudioSource::SetFrameSink(FrameSink sink) {
+        if (m_analyzer) m_analyzer->SetFrameSink(std::move(sink));
+    }
+
     void RealtimeAudioSource::StartCapture() {
         if (m_isCapturing) return;
 
@@ -93,6 +125,7 @@ namespace Spectrum {
         if (!m_analyzer) return;
         m_analyzer->SetAmplification(m_config.amplification);
         m_analyzer->SetSmoothing(m_config.smoothing);
+        m_analyzer->SetWhitening(m_config.whitening);
         m_analyzer->SetFFTWindow(m_config.windowType);
         m_analyzer->SetScaleType(m_config.scaleType);
     }
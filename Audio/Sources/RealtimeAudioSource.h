@@ -26,12 +26,19 @@ namespace Spectrum {
         bool Initialize() override;
         void Update(float deltaTime) override;
         [[nodiscard]] SpectrumData GetSpectrum() override;
+        [[nodiscard]] SpectrumData GetSpectrumAt(int64_t presentNs) override;
+        [[nodiscard]] SpectrumData GetPeakValues() override;
 
         void SetAmplification(float amp) override;
         void SetBarCount(size_t count) override;
         void SetFFTWindow(FFTWindowType type) override;
+        void SetFFTSize(size_t fftSize) override;
+        void SetFrequencyWindow(float minHz, float maxHz) override;
+        void ResetFrequencyWindow() override;
         void SetScaleType(SpectrumScale type) override;
         void SetSmoothing(float smoothing) override;
+        void SetWhitening(bool enabled) override;
+        void SetFrameSink(FrameSink sink) override;
 
         void StartCapture() override;
         void StopCapture() override;
@@ -0,0 +1,131 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// This file implements the TrackPlaybackSource. Playback time advances with
+// the frame delta and wraps at the end of the track; the stored bars are
+// linearly resampled when the display uses a different bar count.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "TrackPlaybackSource.h"
+
+namespace Spectrum {
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Lifecycle Management
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    TrackPlaybackSource::TrackPlaybackSource(
+        const AudioConfig& config,
+        std::filesystem::path path
+    ) :
+        m_path(std::move(path)),
+        m_barCount(config.barCount),
+        m_currentFrame(SIZE_MAX),
+        m_position(0.0)
+    {
+        m_output.assign(m_barCount, 0.0f);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Public Interface
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TrackPlaybackSource::Seek(double seconds) {
+        const double duration = GetDuration();
+        if (duration <= 0.0) return;
+
+        m_position = std::clamp(seconds, 0.0, duration);
+        LoadFrameAt(m_position);
+    }
+
+    double TrackPlaybackSource::GetDuration() const noexcept {
+        return m_reader.GetDurationSeconds();
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // IAudioSource Implementation
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool TrackPlaybackSource::Initialize() {
+        if (!m_reader.Open(m_path)) return false;
+
+        LOG_INFO("TrackPlaybackSource: " << m_reader.GetFrameCount() << " frames, "
+            << m_reader.GetBarCount() << " bars, " << GetDuration() << " s");
+
+        m_currentFrame = SIZE_MAX;
+        m_position = 0.0;
+        LoadFrameAt(0.0);
+        return true;
+    }
+
+    void TrackPlaybackSource::Update(float deltaTime) {
+        const double duration = GetDuration();
+        if (duration <= 0.0) return;
+
+        m_position = std::fmod(m_position + deltaTime, duration);
+        LoadFrameAt(m_position);
+    }
+
+    [[nodiscard]] SpectrumData TrackPlaybackSource::GetSpectrum() {
+        return m_output;
+    }
+
+    void TrackPlaybackSource::SetBarCount(size_t count) {
+        if (count == 0 || count == m_barCount) return;
+        m_barCount = count;
+        ResampleToOutput();
+    }
+
+    void TrackPlaybackSource::SetFrameSink(FrameSink sink) {
+        m_frameSink = std::move(sink);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Private Implementation
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TrackPlaybackSource::LoadFrameAt(double seconds) {
+        const size_t frameCount = m_reader.GetFrameCount();
+        if (frameCount == 0) return;
+
+        const size_t frame = std::min(
+            static_cast<size_t>(seconds * m_reader.GetFrameRate()),
+            frameCount - 1
+        );
+        if (frame == m_currentFrame) return;
+
+        if (!m_reader.ReadFrame(frame, m_trackBars)) {
+            LOG_WARNING("TrackPlaybackSource: failed to decode frame " << frame);
+            return;
+        }
+
+        m_currentFrame = frame;
+        ResampleToOutput();
+
+        // Stored tracks carry no peaks.
+        if (m_frameSink) m_frameSink(m_output, {});
+    }
+
+    void TrackPlaybackSource::ResampleToOutput() {
+        m_output.assign(m_barCount, 0.0f);
+
+        const size_t sourceCount = m_trackBars.size();
+        if (sourceCount == 0) return;
+
+        if (sourceCount == m_barCount) {
+            std::copy(m_trackBars.begin(), m_trackBars.end(), m_output.begin());
+            return;
+        }
+
+        const float step = m_barCount > 1
+            ? static_cast<float>(sourceCount - 1) / static_cast<float>(m_barCount - 1)
+            : 0.0f;
+
+        for (size_t i = 0; i < m_barCount; ++i) {
+            const float pos = static_cast<float>(i) * step;
+            const size_t lo = static_cast<size_t>(pos);
+            const size_t hi = std::min(lo + 1, sourceCount - 1);
+            const float t = pos - static_cast<float>(lo);
+            m_output[i] = m_trackBars[lo] + (m_trackBars[hi] - m_trackBars[lo]) * t;
+        }
+    }
+
+} // namespace Spectrum
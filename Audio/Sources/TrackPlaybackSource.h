@@ -0,0 +1,60 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// This file defines the TrackPlaybackSource, which replays a precomputed
+// .sptk spectral track. The file is memory mapped and frames are decoded
+// on demand by timestamp, so playback costs one small delta decode per
+// displayed frame and no FFT work at all.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#ifndef SPECTRUM_CPP_TRACKPLAYBACKSOURCE_H
+#define SPECTRUM_CPP_TRACKPLAYBACKSOURCE_H
+
+#include "IAudioSource.h"
+#include "Audio/Offline/SpectralTrackFile.h"
+
+namespace Spectrum {
+
+    class TrackPlaybackSource : public IAudioSource {
+    public:
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Public Interface
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        TrackPlaybackSource(const AudioConfig& config, std::filesystem::path path);
+
+        void Seek(double seconds);
+        [[nodiscard]] double GetPosition() const noexcept { return m_position; }
+        [[nodiscard]] double GetDuration() const noexcept;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // IAudioSource Implementation
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        bool Initialize() override;
+        void Update(float deltaTime) override;
+        [[nodiscard]] SpectrumData GetSpectrum() override;
+
+        void SetBarCount(size_t count) override;
+        void SetFrameSink(FrameSink sink) override;
+
+    private:
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Private Implementation
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        void LoadFrameAt(double seconds);
+        void ResampleToOutput();
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Member Variables
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        std::filesystem::path m_path;
+        SpectralTrackReader m_reader;
+
+        SpectrumData m_trackBars;
+        SpectrumData m_output;
+        size_t m_barCount;
+        size_t m_currentFrame;
+        double m_position;
+        FrameSink m_frameSink;
+    };
+
+} // namespace Spectrum
+
+#endif // SPECTRUM_CPP_TRACKPLAYBACKSOURCE_H
@@ -0,0 +1,228 @@
+#ifndef SPECTRUM_CPP_ALIGNED_BUFFER_H
+#define SPECTRUM_CPP_ALIGNED_BUFFER_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AlignedBuffer.h: Contiguous sample container for SIMD kernels.
+// Storage starts on a cache-line boundary and capacity is always a whole
+// number of SIMD lanes. Every slot past size() is kept at zero, so a kernel
+// may process PaddedSize() elements at full width with no scalar tail loop;
+// the extra lanes contribute nothing to sums, maxima of non-negative data
+// or element-wise products.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "Common/Span.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Spectrum {
+
+    // AVX-512 vector width; also a full cache line, which keeps two buffers
+    // written from different threads from sharing one.
+    inline constexpr size_t kSimdAlignment = 64;
+
+    template<typename T, size_t Alignment = kSimdAlignment>
+    class AlignedBuffer {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "AlignedBuffer holds plain sample data only");
+        static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+            "Alignment must be a power of two no smaller than alignof(T)");
+        static_assert(Alignment % sizeof(T) == 0,
+            "Alignment must hold a whole number of elements");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        static constexpr size_t kAlignment = Alignment;
+        static constexpr size_t kLaneCount = Alignment / sizeof(T);
+
+        [[nodiscard]] static constexpr size_t PadToLanes(size_t count) noexcept {
+            return (count + kLaneCount - 1) / kLaneCount * kLaneCount;
+        }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Construction
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        AlignedBuffer() noexcept = default;
+
+        explicit AlignedBuffer(size_t count) { resize(count); }
+
+        AlignedBuffer(size_t count, const T& value) { assign(count, value); }
+
+        template<typename InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        AlignedBuffer(InputIt first, InputIt last) { assign(first, last); }
+
+        AlignedBuffer(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+        AlignedBuffer(const AlignedBuffer& other) {
+            assign(other.begin(), other.end());
+        }
+
+        AlignedBuffer(AlignedBuffer&& other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr))
+            , m_size(std::exchange(other.m_size, 0))
+            , m_capacity(std::exchange(other.m_capacity, 0)) {
+        }
+
+        AlignedBuffer& operator=(const AlignedBuffer& other) {
+            if (this != &other) assign(other.begin(), other.end());
+            return *this;
+        }
+
+        AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+            if (this != &other) {
+                Release();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+                m_capacity = std::exchange(other.m_capacity, 0);
+            }
+            return *this;
+        }
+
+        ~AlignedBuffer() { Release(); }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Access
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        [[nodiscard]] T* data() noexcept { return m_data; }
+        [[nodiscard]] const T* data() const noexcept { return m_data; }
+
+        [[nodiscard]] size_t size()     const noexcept { return m_size; }
+        [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] bool   empty()    const noexcept { return m_size == 0; }
+
+        // Element count rounded up to whole lanes; always <= capacity().
+        [[nodiscard]] size_t PaddedSize() const noexcept { return PadToLanes(m_size); }
+
+        [[nodiscard]] T& operator[](size_t i) noexcept { return m_data[i]; }
+        [[nodiscard]] const T& operator[](size_t i) const noexcept { return m_data[i]; }
+
+        [[nodiscard]] T& front() noexcept { return m_data[0]; }
+        [[nodiscard]] const T& front() const noexcept { return m_data[0]; }
+        [[nodiscard]] T& back() noexcept { return m_data[m_size - 1]; }
+        [[nodiscard]] const T& back() const noexcept { return m_data[m_size - 1]; }
+
+        [[nodiscard]] iterator begin() noexcept { return m_data; }
+        [[nodiscard]] iterator end() noexcept { return m_data + m_size; }
+        [[nodiscard]] const_iterator begin() const noexcept { return m_data; }
+        [[nodiscard]] const_iterator end() const noexcept { return m_data + m_size; }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return m_data; }
+        [[nodiscard]] const_iterator cend() const noexcept { return m_data + m_size; }
+
+        // Full-width views: the padding lanes are readable and hold zero.
+        // Writers must leave them at zero, or call ZeroTail() afterwards.
+        [[nodiscard]] Span<T> Padded() noexcept { return { m_data, PaddedSize() }; }
+        [[nodiscard]] Span<const T> Padded() const noexcept { return { m_data, PaddedSize() }; }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Modification
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        void reserve(size_t count) {
+            if (count > m_capacity) Reallocate(count);
+        }
+
+        void resize(size_t count) {
+            if (count > m_capacity) Reallocate(count);
+            if (count < m_size) ZeroRange(count, m_size);
+            m_size = count;
+        }
+
+        void resize(size_t count, const T& value) {
+            const size_t oldSize = m_size;
+            resize(count);
+            if (count > oldSize) std::fill(m_data + oldSize, m_data + count, value);
+        }
+
+        void assign(size_t count, const T& value) {
+            clear();
+            resize(count, value);
+        }
+
+        template<typename InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        void assign(InputIt first, InputIt last) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            clear();
+            resize(count);
+            std::copy(first, last, m_data);
+        }
+
+        void clear() noexcept {
+            ZeroRange(0, m_size);
+            m_size = 0;
+        }
+
+        void push_back(const T& value) {
+            if (m_size == m_capacity) Reallocate(std::max(m_size * 2, kLaneCount));
+            m_data[m_size++] = value;
+        }
+
+        void pop_back() noexcept {
+            m_data[--m_size] = T{};
+        }
+
+        void swap(AlignedBuffer& other) noexcept {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+        }
+
+        // Restores the zero-tail invariant after a kernel wrote full width.
+        void ZeroTail() noexcept { ZeroRange(m_size, m_capacity); }
+
+        [[nodiscard]] bool operator==(const AlignedBuffer& o) const noexcept {
+            return m_size == o.m_size && std::equal(begin(), end(), o.begin());
+        }
+
+        [[nodiscard]] bool operator!=(const AlignedBuffer& o) const noexcept {
+            return !(*this == o);
+        }
+
+    private:
+        void Reallocate(size_t minCount) {
+            const size_t newCapacity = PadToLanes(minCount);
+            auto* fresh = static_cast<T*>(::operator new(
+                newCapacity * sizeof(T), std::align_val_t{ Alignment }));
+
+            if (m_size > 0) std::memcpy(fresh, m_data, m_size * sizeof(T));
+            std::memset(fresh + m_size, 0, (newCapacity - m_size) * sizeof(T));
+
+            Release();
+            m_data = fresh;
+            m_capacity = newCapacity;
+        }
+
+        void ZeroRange(size_t first, size_t last) noexcept {
+            if (last > first) std::memset(m_data + first, 0, (last - first) * sizeof(T));
+        }
+
+        void Release() noexcept {
+            if (m_data) ::operator delete(m_data, std::align_val_t{ Alignment });
+            m_data = nullptr;
+            m_capacity = 0;
+        }
+
+        T* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_capacity = 0;
+    };
+
+} // namespace Spectrum
+
+#endif
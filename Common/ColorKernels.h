@@ -0,0 +1,43 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ColorKernels.h: Batch color operations for tables rather than single
+// draws, used to bake gradient ramps. Each kernel is one flat loop over
+// packed floats with no per-element branching or segment lookup.
+// Pure functions with no graphics API dependency.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_COLOR_KERNELS_H
+#define SPECTRUM_CPP_COLOR_KERNELS_H
+
+#include "Common/Span.h"
+#include "Common/Types.h"
+
+#include <cstddef>
+
+namespace Spectrum::ColorKernels {
+
+    static_assert(sizeof(Color) == 4 * sizeof(float), "Kernels treat Color arrays as packed floats");
+
+    // out[i] = lerp(from, to, t0 + i * dt); t is not clamped.
+    inline void LerpRun(const Color& from, const Color& to, float t0, float dt, Span<Color> out) noexcept {
+        const Color d(to.r - from.r, to.g - from.g, to.b - from.b, to.a - from.a);
+        Color* o = out.data();
+        for (size_t i = 0, n = out.size(); i < n; ++i) {
+            const float t = t0 + static_cast<float>(i) * dt;
+            o[i].r = from.r + d.r * t;
+            o[i].g = from.g + d.g * t;
+            o[i].b = from.b + d.b * t;
+            o[i].a = from.a + d.a * t;
+        }
+    }
+
+    // dst[i] = average of src[2i] and src[2i + 1], for mip chains.
+    inline void AveragePairs(const Color* src, Span<Color> dst) noexcept {
+        const float* s = &src->r;
+        float* d = &dst.data()->r;
+        for (size_t i = 0, n = dst.size(); i < n; ++i)
+            for (size_t c = 0; c < 4; ++c)
+                d[4 * i + c] = (s[8 * i + c] + s[8 * i + 4 + c]) * 0.5f;
+    }
+
+} // namespace Spectrum::ColorKernels
+
+#endif
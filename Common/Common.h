@@ -48,20 +48,8 @@
 
 // Include project types
 #include "Types.h"
+#include "Log.h"
 
 namespace wrl = Microsoft::WRL;
 
-// Logging macros
-#ifdef _DEBUG
-#define LOG_DEBUG(msg) std::cout << "[DEBUG] " << msg << std::endl
-#define LOG_WARNING(msg) std::cout << "[WARNING] " << msg << std::endl
-#define LOG_ERROR(msg) std::cerr << "[ERROR] " << msg << std::endl
-#else
-#define LOG_DEBUG(msg)
-#define LOG_WARNING(msg)
-#define LOG_ERROR(msg)
-#endif
-
-#define LOG_INFO(msg) std::cout << "[INFO] " << msg << std::endl
-
 #endif // SPECTRUM_CPP_COMMON_H
\ No newline at end of file
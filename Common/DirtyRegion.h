@@ -0,0 +1,186 @@
+#ifndef SPECTRUM_CPP_DIRTY_REGION_H
+#define SPECTRUM_CPP_DIRTY_REGION_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// DirtyRegion.h: The part of a frame that drawing actually touched, kept as
+// a handful of non-overlapping rectangles. Bounds that meet or overlap are
+// merged as they arrive; once kMaxRects is reached the next rectangle is
+// folded into whichever one it grows least, so the set stays small enough
+// to clip against rect by rect. Pure value type with no graphics API
+// dependency.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "Common/Span.h"
+#include "Common/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace Spectrum {
+
+    class DirtyRegion final {
+    public:
+        static constexpr size_t kMaxRects = 8;
+
+        // Antialiased edges bleed up to a pixel past the geometric bounds.
+        static constexpr float kEdgeMargin = 1.0f;
+
+        // Share of the surface past which one full clear beats clearing
+        // rect by rect behind a clip.
+        static constexpr float kFullRedrawFraction = 0.6f;
+
+        void Add(const Rect& rect) noexcept {
+            if (!(rect.width > 0.0f) || !(rect.height > 0.0f)) return;
+            if (!std::isfinite(rect.x + rect.y + rect.width + rect.height)) return;
+
+            Insert(Snap(rect));
+        }
+
+        // The other region's rects are already snapped, so they go in as
+        // they are rather than growing by another margin.
+        void Add(const DirtyRegion& other) noexcept {
+            for (const Rect& r : other.GetRects()) Insert(r);
+        }
+
+        void Clear() noexcept { m_count = 0; }
+
+        // Trims every rect to `surface` and drops those wholly outside it,
+        // so primitives drawn partly off screen only count what shows.
+        void ClipTo(const Rect& surface) noexcept {
+            for (size_t i = 0; i < m_count;) {
+                const Rect& r = m_rects[i];
+                const float left = (std::max)(r.x, surface.x);
+                const float top = (std::max)(r.y, surface.y);
+                const float right = (std::min)(r.GetRight(), surface.GetRight());
+                const float bottom = (std::min)(r.GetBottom(), surface.GetBottom());
+
+                if (right <= left || bottom <= top) {
+                    RemoveAt(i);
+                    continue;
+                }
+                m_rects[i] = { left, top, right - left, bottom - top };
+                ++i;
+            }
+        }
+
+        // Whether the damage is large enough that the frame should be
+        // treated as a full redraw of `surface`.
+        [[nodiscard]] bool CoversMostOf(const Rect& surface) const noexcept {
+            const float surfaceArea = Area(surface);
+            return surfaceArea > 0.0f && GetArea() >= kFullRedrawFraction * surfaceArea;
+        }
+
+        [[nodiscard]] bool IsEmpty() const noexcept { return m_count == 0; }
+
+        [[nodiscard]] Span<const Rect> GetRects() const noexcept {
+            return { m_rects.data(), m_count };
+        }
+
+        [[nodiscard]] Rect GetBounds() const noexcept {
+            if (m_count == 0) return {};
+            Rect bounds = m_rects[0];
+            for (size_t i = 1; i < m_count; ++i) bounds = Union(bounds, m_rects[i]);
+            return bounds;
+        }
+
+        [[nodiscard]] float GetArea() const noexcept {
+            float area = 0.0f;
+            for (size_t i = 0; i < m_count; ++i) area += Area(m_rects[i]);
+            return area;
+        }
+
+        // How far a stroke of `width` can reach past the bounds of the path
+        // it outlines, on either axis. A miter join's tip runs out up to
+        // miterLimit half-widths from its corner (D2D treats limits below
+        // 1 as 1), a square cap's corner sqrt(2) half-widths.
+        [[nodiscard]] static float StrokeOutset(
+            float width, bool miterJoins, float miterLimit, bool squareCaps
+        ) noexcept {
+            float reach = 1.0f;
+            if (miterJoins) reach = (std::max)(reach, miterLimit);
+            if (squareCaps) reach = (std::max)(reach, 1.41421356f);
+            return 0.5f * width * reach;
+        }
+
+    private:
+        void Insert(Rect r) noexcept {
+            while (true) {
+                // Swallow everything the new rect meets; the union may meet
+                // more, so rescan until it stands alone.
+                bool merged = false;
+                for (size_t i = 0; i < m_count; ++i) {
+                    if (!Touches(m_rects[i], r)) continue;
+                    if (Contains(m_rects[i], r)) return;
+
+                    r = Union(m_rects[i], r);
+                    RemoveAt(i);
+                    merged = true;
+                    break;
+                }
+                if (merged) continue;
+
+                if (m_count < kMaxRects) break;
+
+                // Full: fold into the rect whose area grows least.
+                size_t best = 0;
+                float bestGrowth = Area(Union(m_rects[0], r)) - Area(m_rects[0]);
+                for (size_t i = 1; i < m_count; ++i) {
+                    const float growth = Area(Union(m_rects[i], r)) - Area(m_rects[i]);
+                    if (growth < bestGrowth) {
+                        bestGrowth = growth;
+                        best = i;
+                    }
+                }
+                r = Union(m_rects[best], r);
+                RemoveAt(best);
+            }
+
+            m_rects[m_count++] = r;
+        }
+
+        // Whole pixels plus the AA margin, so neighbouring primitives that
+        // share an edge collapse into one rect instead of two slivers.
+        [[nodiscard]] static Rect Snap(const Rect& r) noexcept {
+            const float left = std::floor(r.x - kEdgeMargin);
+            const float top = std::floor(r.y - kEdgeMargin);
+            const float right = std::ceil(r.GetRight() + kEdgeMargin);
+            const float bottom = std::ceil(r.GetBottom() + kEdgeMargin);
+            return { left, top, right - left, bottom - top };
+        }
+
+        [[nodiscard]] static bool Touches(const Rect& a, const Rect& b) noexcept {
+            return a.x <= b.GetRight() && b.x <= a.GetRight()
+                && a.y <= b.GetBottom() && b.y <= a.GetBottom();
+        }
+
+        [[nodiscard]] static bool Contains(const Rect& outer, const Rect& inner) noexcept {
+            return outer.x <= inner.x && outer.y <= inner.y
+                && outer.GetRight() >= inner.GetRight()
+                && outer.GetBottom() >= inner.GetBottom();
+        }
+
+        [[nodiscard]] static Rect Union(const Rect& a, const Rect& b) noexcept {
+            const float left = (std::min)(a.x, b.x);
+            const float top = (std::min)(a.y, b.y);
+            const float right = (std::max)(a.GetRight(), b.GetRight());
+            const float bottom = (std::max)(a.GetBottom(), b.GetBottom());
+            return { left, top, right - left, bottom - top };
+        }
+
+        [[nodiscard]] static float Area(const Rect& r) noexcept {
+            return r.width * r.height;
+        }
+
+        void RemoveAt(size_t index) noexcept {
+            m_rects[index] = m_rects[--m_count];
+        }
+
+        std::array<Rect, kMaxRects> m_rects{};
+        size_t m_count = 0;
+    };
+
+} // namespace Spectrum
+
+#endif
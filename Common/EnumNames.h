@@ -0,0 +1,67 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// EnumNames.h: Stable text names of the configuration enums, as written to
+// settings files, scenarios and control commands. No platform dependency,
+// so the formats that use them can be tested anywhere.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_ENUM_NAMES_H
+#define SPECTRUM_CPP_ENUM_NAMES_H
+
+#include "Common/Types.h"
+
+#include <iterator>
+#include <string_view>
+
+namespace Spectrum::Helpers::Utils {
+
+    inline std::string_view ToString(FFTWindowType type) {
+        constexpr std::string_view names[] = { "Hann", "Hamming", "Blackman", "Rectangular" };
+        return names[static_cast<size_t>(type)];
+    }
+
+    inline std::string_view ToString(SpectrumScale type) {
+        constexpr std::string_view names[] = { "Linear", "Logarithmic", "Mel" };
+        return names[static_cast<size_t>(type)];
+    }
+
+    inline std::string_view ToString(RenderStyle style) {
+        constexpr std::string_view names[] = {
+            "Bars", "Wave", "CircularWave", "Cubes", "Fire", "LedPanel", "Gauge",
+            "KenwoodBars", "Particles", "MatrixLed", "Sphere", "PolylineWave", "Plugin"
+        };
+        static_assert(std::size(names) == static_cast<size_t>(RenderStyle::Count));
+        return names[static_cast<size_t>(style)];
+    }
+
+    inline std::string_view ToString(RenderQuality quality) {
+        constexpr std::string_view names[] = { "Low", "Medium", "High", "Ultra" };
+        static_assert(std::size(names) == static_cast<size_t>(RenderQuality::Count));
+        return names[static_cast<size_t>(quality)];
+    }
+
+    inline std::string_view ToString(InputAction action) {
+        constexpr std::string_view names[] = {
+            "ToggleCapture", "ToggleAnimation", "ToggleOverlay", "SwitchRenderer",
+            "CycleQuality", "CycleSpectrumScale", "IncreaseAmplification",
+            "DecreaseAmplification", "NextFFTWindow", "PrevFFTWindow",
+            "IncreaseBarCount", "DecreaseBarCount", "ToggleLayout", "Calibrate", "Exit"
+        };
+        static_assert(std::size(names) == static_cast<size_t>(InputAction::Exit) + 1);
+        return names[static_cast<size_t>(action)];
+    }
+
+    // Inverse of ToString over the first `count` values.
+    template<typename TEnum>
+    bool FromString(std::string_view text, TEnum& out, int count = static_cast<int>(TEnum::Count)) {
+        for (int i = 0; i < count; ++i) {
+            const auto value = static_cast<TEnum>(i);
+            if (ToString(value) == text) {
+                out = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace Spectrum::Helpers::Utils
+
+#endif // SPECTRUM_CPP_ENUM_NAMES_H
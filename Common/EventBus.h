@@ -1,35 +1,220 @@
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-// EventBus.h: A simple pub/sub system for decoupling components.
+// EventBus.h: Typed pub/sub for decoupling components across threads.
+//
+// An event is any small trivially copyable struct. Publish copies it into
+// a lock-free queue owned by each matching subscriber and returns; it may
+// be called from any thread and never allocates. Handlers only run inside
+// Dispatch, which the owner calls from the main thread at a fixed point in
+// the frame, so a handler never races the code it drives no matter which
+// thread produced the event. Order is kept per subscriber, not across
+// subscribers.
+//
+// Subscribing allocates and is meant for startup; it is safe against
+// concurrent publishers but not against other subscribers.
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 #ifndef SPECTRUM_CPP_EVENT_BUS_H
 #define SPECTRUM_CPP_EVENT_BUS_H
 
-#include "Common.h"
+#include "Common/Log.h"
+#include "Common/MpscQueue.h"
+#include "Common/Types.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
 
 namespace Spectrum {
 
-    class EventBus {
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Events
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    struct ActionEvent {
+        InputAction action;
+    };
+
+    // Subscribers may narrow a type to one key (e.g. one InputAction);
+    // events without a key match every subscriber of their type.
+    inline constexpr uint64_t kAnyEventKey = ~0ull;
+
+    template<typename E>
+    [[nodiscard]] constexpr uint64_t EventKeyOf(const E&) noexcept { return kAnyEventKey; }
+
+    [[nodiscard]] constexpr uint64_t EventKeyOf(const ActionEvent& e) noexcept {
+        return static_cast<uint64_t>(e.action);
+    }
+
+    struct EventBusStats {
+        uint64_t published = 0;
+        uint64_t dispatched = 0;
+        uint64_t dropped = 0;     // a subscriber's queue was full
+    };
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // EventBus
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    class EventBus final {
     public:
-        using EventHandler = std::function<void()>;
+        static constexpr size_t kMaxPayload = 32;
+        static constexpr size_t kQueueCapacity = 256;
+        static constexpr size_t kMaxSubscribers = 64;
+
+        using SubscriptionId = size_t;
+        static constexpr SubscriptionId kInvalidSubscription = ~size_t{ 0 };
 
-        void Subscribe(InputAction action, EventHandler handler) {
-            m_subscribers[action].push_back(std::move(handler));
+        EventBus() = default;
+        EventBus(const EventBus&) = delete;
+        EventBus& operator=(const EventBus&) = delete;
+
+        // `handler` is called as handler(const E&) from Dispatch.
+        template<typename E, typename Handler>
+        SubscriptionId Subscribe(Handler&& handler, uint64_t key = kAnyEventKey) {
+            CheckEventType<E>();
+
+            auto sub = std::make_unique<Subscriber>();
+            sub->type = TypeId<E>();
+            sub->key = key;
+            sub->invoke = [fn = std::forward<Handler>(handler)](const Payload& p) {
+                E event;
+                std::memcpy(&event, p.bytes, sizeof(E));
+                fn(static_cast<const E&>(event));
+            };
+            return Add(std::move(sub));
+        }
+
+        // One action, no payload.
+        SubscriptionId Subscribe(InputAction action, std::function<void()> handler) {
+            if (!handler) return kInvalidSubscription;
+            return Subscribe<ActionEvent>(
+                [fn = std::move(handler)](const ActionEvent&) { fn(); },
+                static_cast<uint64_t>(action));
+        }
+
+        // Takes effect for events not yet dispatched. Slots are not reused.
+        void Unsubscribe(SubscriptionId id) noexcept {
+            if (id < m_count.load(std::memory_order_acquire))
+                m_subscribers[id]->active.store(false, std::memory_order_release);
         }
 
-        void Publish(InputAction action) {
-            if (m_subscribers.count(action)) {
-                for (const auto& handler : m_subscribers[action]) {
-                    if (handler) {
-                        handler();
-                    }
+        // Any thread. False if at least one subscriber's queue was full
+        // and missed the event.
+        template<typename E>
+        bool Publish(const E& event) noexcept {
+            CheckEventType<E>();
+
+            Payload payload;
+            std::memcpy(payload.bytes, &event, sizeof(E));
+
+            const uint32_t type = TypeId<E>();
+            const uint64_t key = EventKeyOf(event);
+            bool delivered = true;
+
+            const size_t count = m_count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                Subscriber& sub = *m_subscribers[i];
+                if (sub.type != type || !sub.active.load(std::memory_order_relaxed)) continue;
+                if (sub.key != kAnyEventKey && sub.key != key) continue;
+
+                if (!sub.queue.TryPush(payload)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    delivered = false;
                 }
             }
+
+            m_published.fetch_add(1, std::memory_order_relaxed);
+            return delivered;
+        }
+
+        bool Publish(InputAction action) noexcept {
+            return Publish(ActionEvent{ action });
+        }
+
+        // Main thread only. Runs every queued handler and returns how many.
+        // Events a handler publishes while dispatching may land in this
+        // pass or the next; each queue is drained at most one lap per call
+        // so a handler that re-publishes itself cannot spin forever.
+        size_t Dispatch() {
+            size_t handled = 0;
+            const size_t count = m_count.load(std::memory_order_acquire);
+
+            for (size_t i = 0; i < count; ++i) {
+                Subscriber& sub = *m_subscribers[i];
+                Payload payload;
+                for (size_t n = 0; n < kQueueCapacity && sub.queue.TryPop(payload); ++n) {
+                    if (!sub.active.load(std::memory_order_acquire)) continue;
+                    sub.invoke(payload);
+                    ++handled;
+                }
+            }
+
+            m_dispatched.fetch_add(handled, std::memory_order_relaxed);
+            return handled;
+        }
+
+        [[nodiscard]] EventBusStats GetStats() const noexcept {
+            EventBusStats stats;
+            stats.published = m_published.load(std::memory_order_relaxed);
+            stats.dispatched = m_dispatched.load(std::memory_order_relaxed);
+            stats.dropped = m_dropped.load(std::memory_order_relaxed);
+            return stats;
         }
 
     private:
-        std::map<InputAction, std::vector<EventHandler>> m_subscribers;
+        struct Payload {
+            alignas(std::max_align_t) unsigned char bytes[kMaxPayload];
+        };
+
+        struct Subscriber {
+            uint32_t                                  type = 0;
+            uint64_t                                  key = kAnyEventKey;
+            std::atomic<bool>                         active{ true };
+            std::function<void(const Payload&)>       invoke;
+            MpscQueue<Payload, kQueueCapacity>        queue;
+        };
+
+        template<typename E>
+        static constexpr void CheckEventType() noexcept {
+            static_assert(std::is_trivially_copyable_v<E> && std::is_default_constructible_v<E>,
+                "Events are copied through lock-free queues; keep them plain structs");
+            static_assert(sizeof(E) <= kMaxPayload, "Event payload exceeds EventBus::kMaxPayload");
+            static_assert(alignof(E) <= alignof(std::max_align_t), "Event is over-aligned");
+        }
+
+        // Process-wide id per event type, assigned on first use.
+        template<typename E>
+        [[nodiscard]] static uint32_t TypeId() noexcept {
+            static const uint32_t id = s_nextTypeId.fetch_add(1, std::memory_order_relaxed);
+            return id;
+        }
+
+        SubscriptionId Add(std::unique_ptr<Subscriber> sub) {
+            const size_t index = m_count.load(std::memory_order_relaxed);
+            if (index >= kMaxSubscribers) {
+                LOG_ERROR("EventBus: Subscriber limit (" << kMaxSubscribers << ") reached");
+                return kInvalidSubscription;
+            }
+
+            // Publishers only look below m_count, so the slot is complete
+            // before it becomes visible.
+            m_subscribers[index] = std::move(sub);
+            m_count.store(index + 1, std::memory_order_release);
+            return index;
+        }
+
+        static inline std::atomic<uint32_t> s_nextTypeId{ 0 };
+
+        std::array<std::unique_ptr<Subscriber>, kMaxSubscribers> m_subscribers;
+        std::atomic<size_t>   m_count{ 0 };
+        std::atomic<uint64_t> m_published{ 0 };
+        std::atomic<uint64_t> m_dispatched{ 0 };
+        std::atomic<uint64_t> m_dropped{ 0 };
     };
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,171 @@
+#ifndef SPECTRUM_CPP_FRAME_ARENA_H
+#define SPECTRUM_CPP_FRAME_ARENA_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameArena.h: Per-frame linear (bump) allocator for transient render data.
+// Everything allocated from the arena dies at Reset(), which the render
+// engine calls once per BeginDraw. If a frame overflows the current block,
+// extra blocks are chained and coalesced into one block on the next Reset,
+// so after warm-up a frame performs no heap allocations at all.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Spectrum {
+
+    class FrameArena final {
+    public:
+        static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+        explicit FrameArena(size_t capacity = kDefaultCapacity) {
+            AddBlock(capacity);
+        }
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Allocation
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        [[nodiscard]] void* Allocate(size_t bytes, size_t alignment) {
+            if (bytes == 0) bytes = 1;
+
+            Block* block = &m_blocks.back();
+            size_t offset = AlignUp(block->data.get(), m_offset, alignment);
+
+            if (offset + bytes > block->size) {
+                AddBlock(std::max(block->size * 2, bytes + alignment));
+                block = &m_blocks.back();
+                offset = AlignUp(block->data.get(), 0, alignment);
+            }
+
+            m_offset = offset + bytes;
+            m_bytesUsed += bytes;
+            if (m_bytesUsed > m_peakBytes) m_peakBytes = m_bytesUsed;
+
+            m_lastAllocation = block->data.get() + offset;
+            return m_lastAllocation;
+        }
+
+        // Only the most recent allocation can be given back, so scoped
+        // temporaries released in LIFO order return their space immediately.
+        void Deallocate(void* ptr, size_t bytes) noexcept {
+            if (ptr == nullptr || ptr != m_lastAllocation) return;
+
+            const auto* base = m_blocks.back().data.get();
+            m_offset = static_cast<size_t>(
+                static_cast<std::byte*>(ptr) - base);
+            m_bytesUsed -= bytes == 0 ? 1 : bytes;
+            m_lastAllocation = nullptr;
+        }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Frame boundary
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        void Reset() {
+            if (m_blocks.size() > 1) {
+                size_t total = 0;
+                for (const auto& b : m_blocks) total += b.size;
+                m_blocks.clear();
+                AddBlock(total);
+            }
+
+            m_offset = 0;
+            m_bytesUsed = 0;
+            m_lastAllocation = nullptr;
+        }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Diagnostics
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        [[nodiscard]] size_t GetBytesUsed()       const noexcept { return m_bytesUsed; }
+        [[nodiscard]] size_t GetPeakBytes()       const noexcept { return m_peakBytes; }
+        [[nodiscard]] size_t GetBlockCount()      const noexcept { return m_blocks.size(); }
+        [[nodiscard]] size_t GetHeapAllocations() const noexcept { return m_heapAllocations; }
+
+        [[nodiscard]] size_t GetCapacity() const noexcept {
+            size_t total = 0;
+            for (const auto& b : m_blocks) total += b.size;
+            return total;
+        }
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size = 0;
+        };
+
+        static size_t AlignUp(const std::byte* base, size_t offset, size_t alignment) noexcept {
+            const auto addr = reinterpret_cast<std::uintptr_t>(base) + offset;
+            const auto aligned = (addr + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            return offset + static_cast<size_t>(aligned - addr);
+        }
+
+        void AddBlock(size_t size) {
+            m_blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+            m_offset = 0;
+            ++m_heapAllocations;
+        }
+
+        std::vector<Block> m_blocks;
+        size_t m_offset = 0;
+        size_t m_bytesUsed = 0;
+        size_t m_peakBytes = 0;
+        size_t m_heapAllocations = 0;
+        void* m_lastAllocation = nullptr;
+    };
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // STL allocator adapter — lets standard containers live in the arena
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    template<typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+        [[nodiscard]] T* allocate(size_t n) {
+            return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_t n) noexcept {
+            m_arena->Deallocate(p, n * sizeof(T));
+        }
+
+        [[nodiscard]] FrameArena* GetArena() const noexcept { return m_arena; }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>& o) const noexcept { return m_arena == o.GetArena(); }
+
+        template<typename U>
+        bool operator!=(const ArenaAllocator<U>& o) const noexcept { return m_arena != o.GetArena(); }
+
+    private:
+        FrameArena* m_arena;
+    };
+
+    template<typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+    template<typename T>
+    [[nodiscard]] ArenaVector<T> MakeArenaVector(FrameArena& arena, size_t reserve = 0) {
+        ArenaVector<T> v{ ArenaAllocator<T>(arena) };
+        if (reserve > 0) v.reserve(reserve);
+        return v;
+    }
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef SPECTRUM_CPP_GRADIENT_RAMP_H
+#define SPECTRUM_CPP_GRADIENT_RAMP_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// GradientRamp.h: Color gradients baked into lookup tables. A ramp is
+// evaluated once into a power-of-two table of cells, each holding the color
+// at its center, plus a chain of half-resolution levels where every cell is
+// the average of the two below it. Sampling is an index computation; a
+// caller covering a large slice of the ramp with a single color (a bar a
+// few pixels tall) asks for that footprint and gets the prefiltered average
+// instead of whatever stop happens to sit under the center.
+//
+// GradientRampCache shares baked ramps between users with identical stops.
+// Pure value types with no graphics API dependency.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "Common/ColorKernels.h"
+#include "Common/Span.h"
+#include "Common/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Spectrum {
+
+    struct GradientStop {
+        float position;
+        Color color;
+
+        GradientStop() = default;
+        GradientStop(float pos, const Color& col) : position(pos), color(col) {}
+    };
+
+    // Counters shared by every gradient cache (baked ramps, D2D brushes).
+    struct GradientCacheStats {
+        uint64_t hits = 0;
+        uint64_t bakes = 0;
+        uint64_t evictions = 0;
+        size_t   entries = 0;
+
+        [[nodiscard]] float HitRate() const noexcept {
+            const uint64_t lookups = hits + bakes;
+            return lookups ? static_cast<float>(hits) / static_cast<float>(lookups) : 0.0f;
+        }
+    };
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // GradientRamp
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    class GradientRamp final {
+    public:
+        static constexpr size_t kDefaultSize = 256;
+        static constexpr size_t kFineSize = 1024;
+        static constexpr size_t kMaxSize = 4096;
+
+        GradientRamp() = default;
+
+        // `size` is rounded up to a power of two. Stops may come in any
+        // order; positions outside 0..1 clamp.
+        explicit GradientRamp(std::vector<GradientStop> stops, size_t size = kDefaultSize)
+            : m_stops(std::move(stops))
+        {
+            std::stable_sort(m_stops.begin(), m_stops.end(),
+                [](const GradientStop& a, const GradientStop& b) { return a.position < b.position; });
+            Bake(RoundSize(size));
+        }
+
+        // Evenly spaced colors, first at 0 and last at 1.
+        [[nodiscard]] static std::vector<GradientStop> EvenStops(Span<const Color> colors) {
+            std::vector<GradientStop> stops;
+            stops.reserve(colors.size());
+            const float step = colors.size() > 1 ? 1.0f / static_cast<float>(colors.size() - 1) : 0.0f;
+            for (size_t i = 0; i < colors.size(); ++i)
+                stops.emplace_back(static_cast<float>(i) * step, colors[i]);
+            return stops;
+        }
+
+        // Full-resolution lookup.
+        [[nodiscard]] Color Sample(float t) const noexcept {
+            if (m_texels.empty()) return {};
+            return m_texels[Index(0, t)];
+        }
+
+        // `footprint` is the share of the ramp (0..1) one sample stands for;
+        // picks the level whose cells are about that wide.
+        [[nodiscard]] Color Sample(float t, float footprint) const noexcept {
+            if (m_texels.empty()) return {};
+            return m_texels[Index(LevelFor(footprint), t)];
+        }
+
+        [[nodiscard]] bool   empty()         const noexcept { return m_texels.empty(); }
+        [[nodiscard]] size_t GetSize()       const noexcept { return m_size; }
+        [[nodiscard]] size_t GetLevelCount() const noexcept { return m_levelCount; }
+
+        [[nodiscard]] const std::vector<GradientStop>& GetStops() const noexcept { return m_stops; }
+
+        // Identity of the stop content, stable for the ramp's lifetime.
+        [[nodiscard]] size_t GetKey() const noexcept { return m_key; }
+
+        [[nodiscard]] static size_t HashStops(Span<const GradientStop> stops) noexcept {
+            size_t seed = stops.size();
+            for (const auto& s : stops) {
+                for (float f : { s.position, s.color.r, s.color.g, s.color.b, s.color.a })
+                    seed ^= std::hash<float>{}(f) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+
+    private:
+        static constexpr size_t kMaxLevels = 13; // log2(kMaxSize) + 1
+
+        [[nodiscard]] static size_t RoundSize(size_t size) noexcept {
+            size_t n = 1;
+            while (n < size && n < kMaxSize) n <<= 1;
+            return n;
+        }
+
+        [[nodiscard]] size_t LevelFor(float footprint) const noexcept {
+            float cells = footprint * static_cast<float>(m_size);
+            size_t level = 0;
+            while (cells >= 2.0f && level + 1 < m_levelCount) {
+                cells *= 0.5f;
+                ++level;
+            }
+            return level;
+        }
+
+        [[nodiscard]] size_t Index(size_t level, float t) const noexcept {
+            const size_t n = m_size >> level;
+            // Written so NaN lands on the first cell.
+            const float u = t > 0.0f ? (t < 1.0f ? t : 1.0f) : 0.0f;
+            return m_offsets[level] + std::min(static_cast<size_t>(u * static_cast<float>(n)), n - 1);
+        }
+
+        void Bake(size_t size) {
+            m_key = HashStops(m_stops);
+            if (m_stops.empty()) return;
+
+            m_size = size;
+            m_levelCount = 0;
+            size_t total = 0;
+            for (size_t n = size; n > 0; n >>= 1) {
+                m_offsets[m_levelCount++] = total;
+                total += n;
+            }
+            m_texels.resize(total);
+
+            BakeLevel0(size);
+
+            // Each coarser cell covers exactly two finer ones.
+            for (size_t level = 1; level < m_levelCount; ++level) {
+                ColorKernels::AveragePairs(&m_texels[m_offsets[level - 1]],
+                    Span<Color>(&m_texels[m_offsets[level]], size >> level));
+            }
+        }
+
+        // Stops evaluated at cell centers. The cells between two stops form
+        // one run with a constant step, filled in a single lerp pass; cells
+        // before the first stop or after the last hold its color.
+        void BakeLevel0(size_t size) {
+            const float scale = static_cast<float>(size);
+            const float cell = 1.0f / scale;
+            const auto center = [scale](size_t i) { return (static_cast<float>(i) + 0.5f) / scale; };
+            // First cell whose center is at or past `position`. The estimate
+            // is corrected with the exact comparison, so a center sitting on
+            // a stop always goes to the segment that starts there.
+            const auto at = [&](float position) {
+                const float estimate = position * scale - 0.5f;
+                size_t i = estimate > 0.0f ? static_cast<size_t>(std::min(estimate, scale)) : 0;
+                while (i > 0 && center(i - 1) >= position) --i;
+                while (i < size && center(i) < position) ++i;
+                return i;
+            };
+
+            size_t i = 0;
+            const auto fill = [&](size_t end, const Color& c) {
+                for (; i < end; ++i) m_texels[i] = c;
+            };
+
+            fill(at(m_stops.front().position), m_stops.front().color);
+            for (size_t s = 0; s + 1 < m_stops.size(); ++s) {
+                const GradientStop& a = m_stops[s];
+                const GradientStop& b = m_stops[s + 1];
+                const size_t end = at(b.position);
+                if (end <= i) continue;
+
+                const float span = b.position - a.position;
+                const float t0 = (center(i) - a.position) / span;
+                ColorKernels::LerpRun(a.color, b.color, t0, cell / span, Span<Color>(&m_texels[i], end - i));
+                i = end;
+            }
+            fill(size, m_stops.back().color);
+        }
+
+        std::vector<GradientStop>          m_stops;
+        std::vector<Color>                 m_texels;
+        std::array<size_t, kMaxLevels>     m_offsets{};
+        size_t                             m_size = 0;
+        size_t                             m_levelCount = 0;
+        size_t                             m_key = 0;
+    };
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // GradientRampCache
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    // Least-recently-used set of baked ramps. Holders keep their ramp alive
+    // through the shared_ptr, so eviction only costs a re-bake the next time
+    // someone asks for the same stops.
+    class GradientRampCache final {
+    public:
+        static constexpr size_t kDefaultCapacity = 32;
+
+        explicit GradientRampCache(size_t capacity = kDefaultCapacity)
+            : m_capacity(std::max<size_t>(capacity, 1))
+        {
+        }
+
+        // One cache for the whole process; renderers with the same palette
+        // share a table.
+        [[nodiscard]] static GradientRampCache& Shared() {
+            static GradientRampCache cache;
+            return cache;
+        }
+
+        [[nodiscard]] std::shared_ptr<const GradientRamp> Get(
+            std::vector<GradientStop> stops, size_t size = GradientRamp::kDefaultSize)
+        {
+            size_t key = GradientRamp::HashStops(stops);
+            key ^= std::hash<size_t>{}(size) + 0x9e3779b9 + (key << 6) + (key >> 2);
+
+            std::lock_guard lock(m_mutex);
+            if (auto it = m_index.find(key); it != m_index.end()) {
+                // A hash collision is treated as a miss and replaced.
+                if (SameStops(it->second->ramp->GetStops(), stops)) {
+                    m_lru.splice(m_lru.begin(), m_lru, it->second);
+                    ++m_stats.hits;
+                    return it->second->ramp;
+                }
+                m_lru.erase(it->second);
+                m_index.erase(it);
+            }
+
+            auto ramp = std::make_shared<const GradientRamp>(std::move(stops), size);
+            ++m_stats.bakes;
+
+            m_lru.push_front({ key, ramp });
+            m_index[key] = m_lru.begin();
+            while (m_lru.size() > m_capacity) {
+                m_index.erase(m_lru.back().key);
+                m_lru.pop_back();
+                ++m_stats.evictions;
+            }
+            return ramp;
+        }
+
+        [[nodiscard]] std::shared_ptr<const GradientRamp> Get(
+            Span<const Color> colors, size_t size = GradientRamp::kDefaultSize)
+        {
+            return Get(GradientRamp::EvenStops(colors), size);
+        }
+
+        [[nodiscard]] GradientCacheStats GetStats() const {
+            std::lock_guard lock(m_mutex);
+            GradientCacheStats stats = m_stats;
+            stats.entries = m_lru.size();
+            return stats;
+        }
+
+        void Clear() {
+            std::lock_guard lock(m_mutex);
+            m_lru.clear();
+            m_index.clear();
+        }
+
+    private:
+        struct Entry {
+            size_t                              key;
+            std::shared_ptr<const GradientRamp> ramp;
+        };
+
+        [[nodiscard]] static bool SameStops(const std::vector<GradientStop>& sorted,
+            const std::vector<GradientStop>& stops) noexcept
+        {
+            // The ramp keeps its stops sorted; callers almost always pass
+            // them sorted already, anything else just re-bakes.
+            if (sorted.size() != stops.size()) return false;
+            for (size_t i = 0; i < stops.size(); ++i) {
+                const auto& a = sorted[i];
+                const auto& b = stops[i];
+                if (a.position != b.position || a.color.r != b.color.r || a.color.g != b.color.g
+                    || a.color.b != b.color.b || a.color.a != b.color.a) return false;
+            }
+            return true;
+        }
+
+        mutable std::mutex                                      m_mutex;
+        std::list<Entry>                                        m_lru;
+        std::unordered_map<size_t, std::list<Entry>::iterator>  m_index;
+        GradientCacheStats                                      m_stats;
+        size_t                                                  m_capacity;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,23 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Log.h: Logging macros. Split from Common.h so headers that need nothing
+// else from it stay free of the Windows SDK.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_LOG_H
+#define SPECTRUM_CPP_LOG_H
+
+#include <iostream>
+
+#ifdef _DEBUG
+#define LOG_DEBUG(msg) std::cout << "[DEBUG] " << msg << std::endl
+#define LOG_WARNING(msg) std::cout << "[WARNING] " << msg << std::endl
+#define LOG_ERROR(msg) std::cerr << "[ERROR] " << msg << std::endl
+#else
+#define LOG_DEBUG(msg)
+#define LOG_WARNING(msg)
+#define LOG_ERROR(msg)
+#endif
+
+#define LOG_INFO(msg) std::cout << "[INFO] " << msg << std::endl
+
+#endif // SPECTRUM_CPP_LOG_H
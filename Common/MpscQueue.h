@@ -0,0 +1,95 @@
+#ifndef SPECTRUM_CPP_MPSC_QUEUE_H
+#define SPECTRUM_CPP_MPSC_QUEUE_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// MpscQueue.h: Bounded lock-free queue, any number of producers and one
+// consumer. Each cell carries a sequence number telling producers whether
+// it is free for this lap and the consumer whether it has been written, so
+// a push is one CAS on the head and a pop touches no shared counter at
+// all. Storage is fixed at compile time; a push into a full queue fails
+// instead of allocating.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Spectrum {
+
+    template<typename T, size_t Capacity>
+    class MpscQueue final {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+            "MpscQueue capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>,
+            "MpscQueue elements are copied into and out of shared cells");
+
+    public:
+        MpscQueue() noexcept {
+            for (size_t i = 0; i < Capacity; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread. False when the consumer has fallen a full lap behind.
+        bool TryPush(const T& value) noexcept {
+            size_t pos = m_head.load(std::memory_order_relaxed);
+            Cell* cell;
+
+            for (;;) {
+                cell = &m_cells[pos & kMask];
+                const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+                if (diff == 0) {
+                    if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) {
+                    return false;
+                }
+                else {
+                    pos = m_head.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value = value;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only.
+        bool TryPop(T& out) noexcept {
+            Cell& cell = m_cells[m_tail & kMask];
+            if (cell.sequence.load(std::memory_order_acquire) != m_tail + 1)
+                return false;
+
+            out = cell.value;
+            cell.sequence.store(m_tail + Capacity, std::memory_order_release);
+            ++m_tail;
+            return true;
+        }
+
+        [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+    private:
+        static constexpr size_t kMask = Capacity - 1;
+        static constexpr size_t kCacheLine = 64;
+
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T                   value;
+        };
+
+        // Producers hammer the head; keep it off the consumer's line.
+        alignas(kCacheLine) std::atomic<size_t> m_head{ 0 };
+        alignas(kCacheLine) size_t              m_tail = 0;
+        alignas(kCacheLine) std::array<Cell, Capacity> m_cells;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SPECTRUM_CPP_PRIMARY_PALETTE_H
+#define SPECTRUM_CPP_PRIMARY_PALETTE_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// PrimaryPalette.h: Shades of one primary color, baked when the color is set.
+// Renderers derive most of their per-element colors from the primary with
+// a single scalar - an opacity for the magnitude or a brightness factor -
+// so both channels are tabulated once and a per-bar color becomes a load.
+// Steps are fine enough to sit below 8-bit output precision, and the
+// quantization lets color-keyed batches merge elements with nearly equal
+// shades into one run.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "Common/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace Spectrum {
+
+    class PrimaryPalette final {
+    public:
+        static constexpr size_t kAlphaSteps = 256;
+        static constexpr size_t kBrightnessSteps = 512;
+        static constexpr float  kMaxBrightness = 2.0f;
+
+        explicit PrimaryPalette(const Color& primary = Color()) { Bake(primary); }
+
+        void Bake(const Color& primary) noexcept {
+            m_primary = primary;
+
+            for (size_t i = 0; i < kAlphaSteps; ++i)
+                m_alpha[i] = primary.WithAlpha(static_cast<float>(i) / (kAlphaSteps - 1));
+
+            for (size_t i = 0; i < kBrightnessSteps; ++i) {
+                const float f = kMaxBrightness * static_cast<float>(i) / (kBrightnessSteps - 1);
+                m_brightness[i] = Color(
+                    std::min(primary.r * f, 1.0f),
+                    std::min(primary.g * f, 1.0f),
+                    std::min(primary.b * f, 1.0f),
+                    primary.a);
+            }
+        }
+
+        // The primary at opacity `alpha` (0..1); its own alpha is replaced.
+        [[nodiscard]] const Color& WithAlpha(float alpha) const noexcept {
+            return m_alpha[Index(alpha, kAlphaSteps - 1)];
+        }
+
+        // The primary with RGB scaled by `factor` (0..kMaxBrightness) and
+        // saturated; alpha is kept.
+        [[nodiscard]] const Color& Brightened(float factor) const noexcept {
+            return m_brightness[Index(factor * (1.0f / kMaxBrightness), kBrightnessSteps - 1)];
+        }
+
+        [[nodiscard]] const Color& GetPrimary() const noexcept { return m_primary; }
+
+    private:
+        // Nearest step; written so NaN lands on the first.
+        [[nodiscard]] static size_t Index(float t, size_t last) noexcept {
+            const float u = t > 0.0f ? (t < 1.0f ? t : 1.0f) : 0.0f;
+            return static_cast<size_t>(u * static_cast<float>(last) + 0.5f);
+        }
+
+        Color                               m_primary;
+        std::array<Color, kAlphaSteps>      m_alpha;
+        std::array<Color, kBrightnessSteps> m_brightness;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef SPECTRUM_CPP_RECYCLED_ALLOCATION_H
+#define SPECTRUM_CPP_RECYCLED_ALLOCATION_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RecycledAllocation.h: Class-level operator new/delete that keep freed
+// objects of one type on a per-thread free list and hand them out again.
+// For small pimpl objects that are created and destroyed many times a
+// frame (Paint): after warm-up they cost no heap allocation, without the
+// type moving out of its translation unit. At most kMaxCached blocks are
+// kept per thread; the rest go back to the heap.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace Spectrum {
+
+    template<typename T>
+    class RecycledAllocation {
+    public:
+        static constexpr size_t kMaxCached = 1024;
+
+        [[nodiscard]] static void* operator new(size_t bytes) {
+            FreeList& list = Cache();
+            if (bytes == sizeof(T) && list.head) {
+                Node* node = list.head;
+                list.head = node->next;
+                --list.count;
+                return node;
+            }
+            return ::operator new(std::max(bytes, sizeof(Node)));
+        }
+
+        static void operator delete(void* p, size_t bytes) noexcept {
+            if (!p) return;
+            FreeList& list = Cache();
+            if (bytes != sizeof(T) || list.count >= kMaxCached) {
+                ::operator delete(p);
+                return;
+            }
+            list.head = ::new (p) Node{ list.head };
+            ++list.count;
+        }
+
+    private:
+        struct Node {
+            Node* next;
+        };
+
+        struct FreeList {
+            Node*  head = nullptr;
+            size_t count = 0;
+
+            ~FreeList() {
+                while (head) {
+                    Node* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        };
+
+        [[nodiscard]] static FreeList& Cache() noexcept {
+            thread_local FreeList list;
+            return list;
+        }
+    };
+
+} // namespace Spectrum
+
+#endif
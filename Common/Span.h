@@ -0,0 +1,60 @@
+#ifndef SPECTRUM_CPP_SPAN_H
+#define SPECTRUM_CPP_SPAN_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// Span.h: Non-owning view over contiguous elements (C++17 stand-in for
+// std::span). Binds implicitly to any container exposing data()/size(),
+// so APIs can accept std::vector, std::array and arena-backed vectors alike.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Spectrum {
+
+    template<typename T>
+    class Span {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using iterator = T*;
+
+        constexpr Span() noexcept = default;
+
+        constexpr Span(T* data, size_t size) noexcept
+            : m_data(data), m_size(size) {
+        }
+
+        template<typename Container,
+            typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<Container>, Span> &&
+            std::is_convertible_v<
+            decltype(std::declval<Container&>().data()), T*>>>
+            constexpr Span(Container&& c) noexcept
+            : m_data(c.data()), m_size(c.size()) {
+        }
+
+        [[nodiscard]] constexpr T* data()  const noexcept { return m_data; }
+        [[nodiscard]] constexpr size_t size()  const noexcept { return m_size; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+
+        [[nodiscard]] constexpr T* begin() const noexcept { return m_data; }
+        [[nodiscard]] constexpr T* end()   const noexcept { return m_data + m_size; }
+
+        [[nodiscard]] constexpr T& operator[](size_t i) const noexcept { return m_data[i]; }
+        [[nodiscard]] constexpr T& front() const noexcept { return m_data[0]; }
+        [[nodiscard]] constexpr T& back()  const noexcept { return m_data[m_size - 1]; }
+
+        [[nodiscard]] constexpr Span subspan(size_t offset, size_t count) const noexcept {
+            return { m_data + offset, count };
+        }
+
+    private:
+        T* m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+} // namespace Spectrum
+
+#endif
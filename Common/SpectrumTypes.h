@@ -2,7 +2,8 @@
 #define SPECTRUM_CPP_SPECTRUM_TYPES_H
 
 #include "Common.h"
-#include <vector>
+#include "Common/GradientRamp.h"
+#include <memory>
 
 namespace Spectrum {
 
@@ -11,7 +12,8 @@ namespace Spectrum {
         float spacing = 2.0f;
         float cornerRadius = 0.0f;
         bool useGradient = false;
-        std::vector<D2D1_GRADIENT_STOP> gradientStops;
+        // Bottom (0) to top (1) of the bar area.
+        std::shared_ptr<const GradientRamp> gradient;
     };
 
 } // namespace Spectrum
@@ -0,0 +1,111 @@
+#ifndef SPECTRUM_CPP_TRIG_TABLE_H
+#define SPECTRUM_CPP_TRIG_TABLE_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// TrigTable.h: Precomputed unit vectors and phase rotation. Most
+// per-element trig in the renderers is sin/cos of a fixed per-element angle
+// plus one per-frame phase. A Rotor holds (cos, sin) of an angle and
+// multiplying two rotors adds their angles, so a frame costs one sin/cos
+// for the phase and a complex multiply per element against a table that is
+// built once.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "Common/Types.h"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Spectrum {
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Rotor
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    struct Rotor {
+        float c = 1.0f;
+        float s = 0.0f;
+
+        [[nodiscard]] static Rotor FromAngle(float radians) noexcept {
+            return { std::cos(radians), std::sin(radians) };
+        }
+
+        // Angle addition: (a * b).s == sin(angleA + angleB).
+        [[nodiscard]] constexpr Rotor operator*(const Rotor& o) const noexcept {
+            return { c * o.c - s * o.s, s * o.c + c * o.s };
+        }
+
+        [[nodiscard]] constexpr Point OnCircle(const Point& center, float radius) const noexcept {
+            return { center.x + radius * c, center.y + radius * s };
+        }
+
+        [[nodiscard]] constexpr Point OnEllipse(const Point& center, float rx, float ry) const noexcept {
+            return { center.x + rx * c, center.y + ry * s };
+        }
+    };
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // TrigTable
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    class TrigTable final {
+    public:
+        TrigTable() = default;
+
+        // `count` rotors at start, start + step, start + 2 * step, ...
+        TrigTable(size_t count, float start, float step) {
+            Build(count, start, step);
+        }
+
+        void Build(size_t count, float start, float step) {
+            m_rotors.resize(count);
+            for (size_t i = 0; i < count; ++i)
+                m_rotors[i] = Rotor::FromAngle(start + static_cast<float>(i) * step);
+            m_start = start;
+            m_step = step;
+        }
+
+        // Rebuilds only when the layout actually changed.
+        void Ensure(size_t count, float start, float step) {
+            if (count != m_rotors.size() || start != m_start || step != m_step)
+                Build(count, start, step);
+        }
+
+        // Evenly spaced full circle, shared by every caller asking for the
+        // same resolution. Tables are built once and live for the process.
+        [[nodiscard]] static const TrigTable& Circle(size_t segments) {
+            static std::mutex mutex;
+            static std::map<size_t, std::unique_ptr<TrigTable>> tables;
+
+            std::lock_guard lock(mutex);
+            auto& table = tables[segments];
+            if (!table) {
+                const float step = segments ? TWO_PI / static_cast<float>(segments) : 0.0f;
+                table = std::make_unique<TrigTable>(segments, 0.0f, step);
+            }
+            return *table;
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return m_rotors.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_rotors.empty(); }
+        [[nodiscard]] const Rotor& operator[](size_t i) const noexcept { return m_rotors[i]; }
+
+        // sin(angle_i + phase) for one precomputed phase rotor.
+        [[nodiscard]] float Sin(size_t i, const Rotor& phase) const noexcept {
+            return (m_rotors[i] * phase).s;
+        }
+
+        [[nodiscard]] float Cos(size_t i, const Rotor& phase) const noexcept {
+            return (m_rotors[i] * phase).c;
+        }
+
+    private:
+        std::vector<Rotor> m_rotors;
+        float m_start = 0.0f;
+        float m_step = 0.0f;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -10,6 +10,7 @@
 #include <array>
 #include <cmath>
 #include <tuple>
+#include "Common/AlignedBuffer.h"
 
 namespace Spectrum {
 
@@ -26,6 +27,8 @@ namespace Spectrum {
     // Default configuration values
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     inline constexpr size_t DEFAULT_FFT_SIZE = 2048;
+    inline constexpr size_t MIN_FFT_SIZE = 512;
+    inline constexpr size_t MAX_FFT_SIZE = 32768;
     inline constexpr size_t DEFAULT_BAR_COUNT = 64;
     inline constexpr float DEFAULT_SMOOTHING = 0.8f;
     inline constexpr float DEFAULT_AMPLIFICATION = 1.0f;
@@ -131,6 +134,7 @@ namespace Spectrum {
         MatrixLed,
         Sphere,
         PolylineWave,
+        Plugin,         // loaded from the plugins folder, if one is there
         Count
     };
 
@@ -163,6 +167,8 @@ namespace Spectrum {
         PrevFFTWindow,
         IncreaseBarCount,
         DecreaseBarCount,
+        ToggleLayout,
+        Calibrate,
         Exit
     };
 
@@ -174,6 +180,7 @@ namespace Spectrum {
         size_t barCount = DEFAULT_BAR_COUNT;
         float amplification = DEFAULT_AMPLIFICATION;
         float smoothing = DEFAULT_SMOOTHING;
+        bool whitening = false;
         FFTWindowType windowType = FFTWindowType::Hann;
         SpectrumScale scaleType = SpectrumScale::Logarithmic;
     };
@@ -181,8 +188,8 @@ namespace Spectrum {
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Type aliases
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
-    using SpectrumData = std::vector<float>;
-    using AudioBuffer = std::vector<float>;
+    using SpectrumData = AlignedBuffer<float>;
+    using AudioBuffer = AlignedBuffer<float>;
     using ColorPalette = std::array<Color, 8>;
 
 } // namespace Spectrum
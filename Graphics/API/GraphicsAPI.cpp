@@ -1,12 +1,16 @@
 #include "Graphics/API/GraphicsAPI.h"
 #include "Graphics/API/GraphicsHelpers.h"
+#include "Common/RecycledAllocation.h"
+#include "Common/TrigTable.h"
 
 #include <d3d11.h>
 #include <dwmapi.h>
 #include <dxgi.h>
 
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
+#include <list>
 #include <numeric>
 #include <shared_mutex>
 
@@ -82,6 +86,52 @@ namespace Spectrum {
             return collection;
         }
 
+        // Axis-aligned device-space bounds of a local rect under `m`.
+        Rect TransformBounds(const Rect& rect, const D2D1_MATRIX_3X2_F& m) {
+            const D2D1_POINT_2F corners[4] = {
+                { rect.x, rect.y },
+                { rect.GetRight(), rect.y },
+                { rect.x, rect.GetBottom() },
+                { rect.GetRight(), rect.GetBottom() }
+            };
+
+            float left = FLT_MAX, top = FLT_MAX, right = -FLT_MAX, bottom = -FLT_MAX;
+            for (const auto& c : corners) {
+                const float x = c.x * m._11 + c.y * m._21 + m._31;
+                const float y = c.x * m._12 + c.y * m._22 + m._32;
+                left = std::min(left, x);
+                top = std::min(top, y);
+                right = std::max(right, x);
+                bottom = std::max(bottom, y);
+            }
+            return { left, top, right - left, bottom - top };
+        }
+
+        float StrokeWidthOf(const Paint& paint) {
+            return paint.IsStroked() ? paint.GetStrokeWidth() : 0.0f;
+        }
+
+        // Reach of the paint's stroke past a path's bounds, joins and caps
+        // included; DrawPolyline strokes whatever the style says.
+        float StrokeOutsetOf(const Paint& paint) {
+            const StrokeOptions stroke = paint.GetStrokeOptions();
+            return DirtyRegion::StrokeOutset(
+                stroke.width, stroke.join == StrokeJoin::Miter, stroke.miterLimit,
+                stroke.cap == StrokeCap::Square);
+        }
+
+        float FilledStrokeOutsetOf(const Paint& paint) {
+            return paint.IsStroked() ? StrokeOutsetOf(paint) : 0.0f;
+        }
+
+        // Largest axis scale of `m`; strokes widen by half their width
+        // times this in device space.
+        float MaxScale(const D2D1_MATRIX_3X2_F& m) {
+            return std::sqrt(std::max(
+                m._11 * m._11 + m._12 * m._12,
+                m._21 * m._21 + m._22 * m._22));
+        }
+
         template <typename DrawFunc>
         void DrawGlowEffect(
             DrawFunc&& drawFunc,
@@ -101,59 +151,104 @@ namespace Spectrum {
             }
         }
 
+        // Keyed by stop content only: the caller sets the brush geometry
+        // (start/end, center/radii) on every use. Least recently used
+        // entries make room once full, so a long session with changing
+        // colors keeps caching instead of falling back to a build per draw.
         template <typename TBrush>
         class GradientBrushCache {
         public:
             explicit GradientBrushCache(size_t maxSize = Constants::Cache::kMaxGradientBrushes)
-                : m_maxSize(maxSize) {
+                : m_maxSize(std::max<size_t>(maxSize, 1)) {
             }
 
             template <typename CreateFunc>
             wrl::ComPtr<TBrush> GetOrCreate(size_t hash, CreateFunc&& createFunc) {
                 {
-                    std::shared_lock lock(m_mutex);
-                    if (auto it = m_cache.find(hash); it != m_cache.end()) {
-                        return it->second;
+                    std::lock_guard lock(m_mutex);
+                    if (auto it = m_index.find(hash); it != m_index.end()) {
+                        m_lru.splice(m_lru.begin(), m_lru, it->second);
+                        ++m_stats.hits;
+                        return it->second->second;
                     }
                 }
 
                 auto brush = createFunc();
+                if (!brush) {
+                    return brush;
+                }
 
-                {
-                    std::unique_lock lock(m_mutex);
+                std::lock_guard lock(m_mutex);
+                ++m_stats.bakes;
 
-                    if (auto it = m_cache.find(hash); it != m_cache.end()) {
-                        return it->second;
-                    }
+                if (auto it = m_index.find(hash); it != m_index.end()) {
+                    return it->second->second;
+                }
 
-                    if (brush && m_cache.size() < m_maxSize) {
-                        m_cache[hash] = brush;
-                    }
+                m_lru.emplace_front(hash, brush);
+                m_index[hash] = m_lru.begin();
+                while (m_lru.size() > m_maxSize) {
+                    m_index.erase(m_lru.back().first);
+                    m_lru.pop_back();
+                    ++m_stats.evictions;
                 }
 
                 return brush;
             }
 
             void Clear() {
-                std::unique_lock lock(m_mutex);
-                m_cache.clear();
+                std::lock_guard lock(m_mutex);
+                m_lru.clear();
+                m_index.clear();
+            }
+
+            [[nodiscard]] GradientCacheStats GetStats() const {
+                std::lock_guard lock(m_mutex);
+                GradientCacheStats stats = m_stats;
+                stats.entries = m_lru.size();
+                return stats;
             }
 
         private:
-            std::unordered_map<size_t, wrl::ComPtr<TBrush>> m_cache;
-            mutable std::shared_mutex m_mutex;
+            using Entry = std::pair<size_t, wrl::ComPtr<TBrush>>;
+
+            std::list<Entry> m_lru;
+            std::unordered_map<size_t, typename std::list<Entry>::iterator> m_index;
+            GradientCacheStats m_stats;
+            mutable std::mutex m_mutex;
             size_t m_maxSize;
         };
 
+        [[nodiscard]] GradientCacheStats Combine(GradientCacheStats a, const GradientCacheStats& b) noexcept {
+            a.hits += b.hits;
+            a.bakes += b.bakes;
+            a.evictions += b.evictions;
+            a.entries += b.entries;
+            return a;
+        }
+
+        [[nodiscard]] Rect Inflate(const Rect& rect, float by) noexcept {
+            return Rect(rect.x - by, rect.y - by, rect.width + 2.0f * by, rect.height + 2.0f * by);
+        }
+
+        // Window pixels one offscreen pixel spans at `scale`: how far an
+        // antialiased edge, or the upscale filter, reaches past the damage.
+        [[nodiscard]] float ScaledPixelSpan(float scale) noexcept {
+            return std::ceil(1.0f / scale);
+        }
+
     }
 
-    struct Paint::Impl {
+    // Paints are built and copied many times a frame; recycling their
+    // state keeps a warmed-up frame off the heap.
+    struct Paint::Impl : RecycledAllocation<Paint::Impl> {
         BrushType m_brushType = BrushType::Solid;
         Color m_solidColor = Color(1, 1, 1, 1);
         Point m_linearStart{}, m_linearEnd{}, m_radialCenter{};
         float m_radialRadiusX = 0.0f;
         float m_radialRadiusY = 0.0f;
         std::vector<GradientStop> m_gradientStops;
+        size_t m_gradientKey = 0;
         PaintStyle m_style = PaintStyle::Fill;
         float m_strokeWidth = 1.0f;
         StrokeCap m_strokeCap = StrokeCap::Flat;
@@ -200,6 +295,7 @@ namespace Spectrum {
         p.m_impl->m_linearStart = start;
         p.m_impl->m_linearEnd = end;
         p.m_impl->m_gradientStops = stops;
+        p.m_impl->m_gradientKey = GradientRamp::HashStops(stops);
         return p;
     }
 
@@ -210,6 +306,7 @@ namespace Spectrum {
         p.m_impl->m_radialRadiusX = radiusX;
         p.m_impl->m_radialRadiusY = radiusY;
         p.m_impl->m_gradientStops = stops;
+        p.m_impl->m_gradientKey = GradientRamp::HashStops(stops);
         return p;
     }
 
@@ -270,6 +367,7 @@ namespace Spectrum {
     float Paint::GetStrokeWidth() const { return m_impl->m_strokeWidth; }
     float Paint::GetAlpha() const { return m_impl->m_globalAlpha; }
     const std::vector<GradientStop>& Paint::GetGradientStops() const { return m_impl->m_gradientStops; }
+    size_t Paint::GetGradientKey() const { return m_impl->m_gradientKey; }
     Point Paint::GetLinearStart() const { return m_impl->m_linearStart; }
     Point Paint::GetLinearEnd() const { return m_impl->m_linearEnd; }
     Point Paint::GetRadialCenter() const { return m_impl->m_radialCenter; }
@@ -304,6 +402,11 @@ namespace Spectrum {
         wrl::ComPtr<ID2D1Factory> m_d2dFactory;
         wrl::ComPtr<IDWriteFactory> m_dwriteFactory;
         wrl::ComPtr<ID2D1RenderTarget> m_renderTarget;
+        // BeginScaledDraw's surface; m_windowTarget holds the real target
+        // while m_renderTarget points at it.
+        wrl::ComPtr<ID2D1BitmapRenderTarget> m_scaledTarget;
+        wrl::ComPtr<ID2D1RenderTarget> m_windowTarget;
+        D2D1_SIZE_U m_scaledSize = {};
         Helpers::Gdi::AlphaDC m_alphaDC;
         wrl::ComPtr<ID3D11Device> m_d3dDevice;
         wrl::ComPtr<ID3D11DeviceContext> m_d3dContext;
@@ -463,6 +566,7 @@ namespace Spectrum {
         ClearCache();
 
         if (m_impl->m_d2dFactory) {
+            m_impl->m_scaledTarget.Reset();
             m_impl->m_renderTarget.Reset();
             m_impl->m_alphaDC.Reset();
             return m_impl->CreateRenderTarget();
@@ -513,11 +617,15 @@ namespace Spectrum {
         return true;
     }
 
-    HRESULT GraphicsCore::EndDraw() {
+    HRESULT GraphicsCore::EndDraw(const Rect* dirtyBounds) {
         if (!m_impl->m_isDrawing) {
             return S_OK;
         }
 
+        if (m_impl->m_windowTarget) {
+            (void)EndScaledDraw(dirtyBounds);
+        }
+
         HRESULT hr = m_impl->m_renderTarget->EndDraw();
         m_impl->m_isDrawing = false;
 
@@ -526,9 +634,29 @@ namespace Spectrum {
             SIZE wndSize = { m_impl->m_width, m_impl->m_height };
             BLENDFUNCTION blend = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
 
-            if (!::UpdateLayeredWindow(m_impl->m_hwnd, nullptr, nullptr, &wndSize,
-                m_impl->m_alphaDC.GetDC(), &srcPos, 0, &blend, ULW_ALPHA)) {
-                hr = HRESULT_FROM_WIN32(::GetLastError());
+            // Only the dirty rectangle is read back from the DIB and
+            // recomposited; the rest of the layered window keeps its pixels.
+            RECT dirty = { 0, 0, m_impl->m_width, m_impl->m_height };
+            if (dirtyBounds) {
+                dirty.left = std::max(0L, static_cast<LONG>(std::floor(dirtyBounds->x)));
+                dirty.top = std::max(0L, static_cast<LONG>(std::floor(dirtyBounds->y)));
+                dirty.right = std::min(static_cast<LONG>(m_impl->m_width), static_cast<LONG>(std::ceil(dirtyBounds->GetRight())));
+                dirty.bottom = std::min(static_cast<LONG>(m_impl->m_height), static_cast<LONG>(std::ceil(dirtyBounds->GetBottom())));
+            }
+
+            if (dirty.left < dirty.right && dirty.top < dirty.bottom) {
+                UPDATELAYEREDWINDOWINFO info = {};
+                info.cbSize = sizeof(info);
+                info.psize = &wndSize;
+                info.hdcSrc = m_impl->m_alphaDC.GetDC();
+                info.pptSrc = &srcPos;
+                info.pblend = &blend;
+                info.dwFlags = ULW_ALPHA;
+                info.prcDirty = &dirty;
+
+                if (!::UpdateLayeredWindowIndirect(m_impl->m_hwnd, &info)) {
+                    hr = HRESULT_FROM_WIN32(::GetLastError());
+                }
             }
         }
 
@@ -549,6 +677,101 @@ namespace Spectrum {
         return m_impl->m_isDrawing;
     }
 
+    bool GraphicsCore::BeginScaledDraw(float scale) {
+        if (!m_impl->m_isDrawing || m_impl->m_windowTarget || !(scale > 0.0f)) {
+            return false;
+        }
+
+        const D2D1_SIZE_U pixelSize = D2D1::SizeU(
+            static_cast<UINT32>(std::max(1L, std::lround(m_impl->m_width * scale))),
+            static_cast<UINT32>(std::max(1L, std::lround(m_impl->m_height * scale)))
+        );
+
+        if (!m_impl->m_scaledTarget ||
+            m_impl->m_scaledSize.width != pixelSize.width ||
+            m_impl->m_scaledSize.height != pixelSize.height) {
+            m_impl->m_scaledTarget.Reset();
+
+            // Same DIP size as the window at a lower DPI: everything drawn
+            // in window coordinates rasterizes at the reduced resolution.
+            const D2D1_SIZE_F dipSize = m_impl->m_renderTarget->GetSize();
+            if (FAILED(m_impl->m_renderTarget->CreateCompatibleRenderTarget(
+                &dipSize, &pixelSize, nullptr,
+                D2D1_COMPATIBLE_RENDER_TARGET_OPTIONS_NONE,
+                &m_impl->m_scaledTarget))) {
+                LOG_WARNING("GraphicsCore: Cannot create scaled render target");
+                return false;
+            }
+
+            // ClearType needs an opaque destination.
+            m_impl->m_scaledTarget->SetTextAntialiasMode(D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE);
+            m_impl->m_scaledTarget->SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+            m_impl->m_scaledSize = pixelSize;
+        }
+
+        D2D1_MATRIX_3X2_F transform;
+        m_impl->m_renderTarget->GetTransform(&transform);
+
+        m_impl->m_windowTarget = m_impl->m_renderTarget;
+        m_impl->m_renderTarget = m_impl->m_scaledTarget;
+        m_impl->m_renderTarget->BeginDraw();
+        m_impl->m_renderTarget->SetTransform(transform);
+        return true;
+    }
+
+    HRESULT GraphicsCore::EndScaledDraw(const Rect* dirtyBounds) {
+        if (!m_impl->m_windowTarget) {
+            return S_OK;
+        }
+
+        HRESULT hr = m_impl->m_scaledTarget->EndDraw();
+        m_impl->m_renderTarget = std::move(m_impl->m_windowTarget);
+        if (FAILED(hr)) {
+            return hr;
+        }
+
+        wrl::ComPtr<ID2D1Bitmap> bitmap;
+        if (FAILED(hr = m_impl->m_scaledTarget->GetBitmap(&bitmap))) {
+            return hr;
+        }
+
+        auto* target = m_impl->m_renderTarget.Get();
+        const D2D1_SIZE_F size = target->GetSize();
+        D2D1_RECT_F area = D2D1::RectF(0.0f, 0.0f, size.width, size.height);
+        if (dirtyBounds) {
+            area.left = std::max(area.left, std::floor(dirtyBounds->x));
+            area.top = std::max(area.top, std::floor(dirtyBounds->y));
+            area.right = std::min(area.right, std::ceil(dirtyBounds->GetRight()));
+            area.bottom = std::min(area.bottom, std::ceil(dirtyBounds->GetBottom()));
+        }
+        if (area.left >= area.right || area.top >= area.bottom) {
+            return S_OK;
+        }
+
+        D2D1_MATRIX_3X2_F transform;
+        target->GetTransform(&transform);
+        target->SetTransform(D2D1::Matrix3x2F::Identity());
+
+        // Clear first so the upscale replaces rather than blends over the
+        // previous frame; the overlay's transparent pixels stay transparent.
+        target->PushAxisAlignedClip(area, D2D1_ANTIALIAS_MODE_ALIASED);
+        target->Clear(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.0f));
+        target->DrawBitmap(bitmap.Get(), D2D1::RectF(0.0f, 0.0f, size.width, size.height),
+            1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+        target->PopAxisAlignedClip();
+
+        target->SetTransform(transform);
+        return S_OK;
+    }
+
+    bool GraphicsCore::IsScaledDrawing() const noexcept {
+        return m_impl->m_windowTarget != nullptr;
+    }
+
+    bool GraphicsCore::IsOverlay() const noexcept {
+        return m_impl->m_windowMode == WindowMode::Overlay;
+    }
+
     void GraphicsCore::PushTransform() {
         VALIDATE_PTR_OR_RETURN(m_impl->m_renderTarget.Get(), "GraphicsCore");
 
@@ -637,7 +860,7 @@ namespace Spectrum {
         const Point& start, const Point& end, const std::vector<GradientStop>& stops) {
         const size_t hash = m_impl->HashGradientStops(stops);
 
-        return m_impl->m_linearGradientCache.GetOrCreate(hash, [&] {
+        auto brush = m_impl->m_linearGradientCache.GetOrCreate(hash, [&] {
             auto collection = Internal::CreateGradientStopCollection(m_impl->m_renderTarget.Get(), stops);
             if (!collection) {
                 return wrl::ComPtr<ID2D1LinearGradientBrush>();
@@ -650,14 +873,21 @@ namespace Spectrum {
             );
             m_impl->m_renderTarget->CreateLinearGradientBrush(props, collection.Get(), &brush);
             return brush;
-            }).Get();
+            });
+
+        // Cached by stops alone; the geometry is this caller's.
+        if (brush) {
+            brush->SetStartPoint(Helpers::TypeConversion::ToD2DPoint(start));
+            brush->SetEndPoint(Helpers::TypeConversion::ToD2DPoint(end));
+        }
+        return brush.Get();
     }
 
     ID2D1RadialGradientBrush* GraphicsCore::GetRadialGradient(
         const Point& center, float radiusX, float radiusY, const std::vector<GradientStop>& stops) {
         const size_t hash = m_impl->HashGradientStops(stops);
 
-        return m_impl->m_radialGradientCache.GetOrCreate(hash, [&] {
+        auto brush = m_impl->m_radialGradientCache.GetOrCreate(hash, [&] {
             auto collection = Internal::CreateGradientStopCollection(m_impl->m_renderTarget.Get(), stops);
             if (!collection) {
                 return wrl::ComPtr<ID2D1RadialGradientBrush>();
@@ -671,7 +901,14 @@ namespace Spectrum {
             );
             m_impl->m_renderTarget->CreateRadialGradientBrush(props, collection.Get(), &brush);
             return brush;
-            }).Get();
+            });
+
+        if (brush) {
+            brush->SetCenter(Helpers::TypeConversion::ToD2DPoint(center));
+            brush->SetRadiusX(radiusX);
+            brush->SetRadiusY(radiusY);
+        }
+        return brush.Get();
     }
 
     ID2D1Brush* GraphicsCore::GetBrushFromPaint(const Paint& paint, float globalAlpha) {
@@ -817,8 +1054,10 @@ namespace Spectrum {
                 D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)
             );
 
+            // Retained contents let RenderEngine::Clear touch only what the
+            // previous frame drew.
             D2D1_HWND_RENDER_TARGET_PROPERTIES hwndProps = D2D1::HwndRenderTargetProperties(
-                m_hwnd, D2D1::SizeU(m_width, m_height)
+                m_hwnd, D2D1::SizeU(m_width, m_height), D2D1_PRESENT_OPTIONS_RETAIN_CONTENTS
             );
 
             wrl::ComPtr<ID2D1HwndRenderTarget> hwndTarget;
@@ -913,6 +1152,8 @@ namespace Spectrum {
     }
 
     void GraphicsCore::Impl::HandleDeviceLost() {
+        m_scaledTarget.Reset();
+        m_windowTarget.Reset();
         m_solidBrush.Reset();
         m_linearGradientCache.Clear();
         m_radialGradientCache.Clear();
@@ -1023,10 +1264,11 @@ namespace Spectrum {
         std::vector<Point> points;
         points.reserve(static_cast<size_t>(segments) + 1);
 
-        const float angleStep = Constants::Geometry::TWO_PI / static_cast<float>(segments);
-        for (int i = 0; i <= segments; ++i) {
-            points.push_back(Helpers::Geometry::PointOnCircle(center, radius, static_cast<float>(i) * angleStep));
+        const TrigTable& circle = TrigTable::Circle(static_cast<size_t>(segments));
+        for (size_t i = 0; i < circle.size(); ++i) {
+            points.push_back(circle[i].OnCircle(center, radius));
         }
+        points.push_back(points.front());
 
         return points;
     }
@@ -1098,10 +1340,31 @@ namespace Spectrum {
         WindowMode m_windowMode;
         RenderMode m_renderMode;
 
+        // What the last presented frame drew; valid only while the target
+        // still holds that frame.
+        DirtyRegion m_lastDamage;
+        bool m_lastDamageValid = false;
+
+        // Resolution the frame is drawn at; m_frameScaled says whether the
+        // current (or last) frame really went through the offscreen pass.
+        float m_renderScale = 1.0f;
+        bool m_frameScaled = false;
+
         Impl(HWND hwnd, WindowMode windowMode, RenderMode renderMode)
             : m_hwnd(hwnd), m_windowMode(windowMode), m_renderMode(renderMode) {
         }
 
+        [[nodiscard]] float DamageMargin() const noexcept {
+            return m_frameScaled ? Internal::ScaledPixelSpan(m_renderScale) : 0.0f;
+        }
+
+        // The scaled offscreen target keeps the window's DIP size, so
+        // damage is in window coordinates either way.
+        [[nodiscard]] Rect Surface() const noexcept {
+            return Rect(0.0f, 0.0f,
+                static_cast<float>(m_core.GetWidth()), static_cast<float>(m_core.GetHeight()));
+        }
+
         void CreateComponents() {
             auto* factory = m_core.GetFactory();
             auto* dwriteFactory = m_core.GetDWriteFactory();
@@ -1157,6 +1420,7 @@ namespace Spectrum {
         }
 
         m_impl->m_core.RecreateResources(width, height);
+        m_impl->m_lastDamageValid = false;
 
         if (m_impl->m_renderer) {
             m_impl->m_renderer->SetRenderTarget(m_impl->m_core.GetRenderTarget());
@@ -1164,11 +1428,99 @@ namespace Spectrum {
     }
 
     bool RenderEngine::BeginDraw() {
-        return m_impl->m_renderMode == RenderMode::Direct2D ? m_impl->m_core.BeginDraw() : false;
+        if (m_impl->m_renderMode != RenderMode::Direct2D || !m_impl->m_core.BeginDraw()) {
+            return false;
+        }
+
+        // What the retained frame holds depends on which surface it was
+        // drawn into, so switching between them repaints in full.
+        const bool scaled = m_impl->m_renderScale < 1.0f && m_impl->m_renderer &&
+            m_impl->m_core.BeginScaledDraw(m_impl->m_renderScale);
+        if (scaled != m_impl->m_frameScaled) {
+            m_impl->m_lastDamageValid = false;
+            m_impl->m_frameScaled = scaled;
+        }
+        if (scaled) {
+            m_impl->m_renderer->SetCompatibleRenderTarget(m_impl->m_core.GetRenderTarget());
+        }
+
+        if (m_impl->m_canvas) {
+            m_impl->m_canvas->ResetFrameArena();
+            m_impl->m_canvas->ResetDamage();
+        }
+        return true;
     }
 
     HRESULT RenderEngine::EndDraw() {
-        return m_impl->m_renderMode == RenderMode::Direct2D ? m_impl->m_core.EndDraw() : E_FAIL;
+        if (m_impl->m_renderMode != RenderMode::Direct2D) {
+            return E_FAIL;
+        }
+
+        if (!m_impl->m_canvas) {
+            m_impl->m_lastDamageValid = false;
+            return m_impl->m_core.EndDraw();
+        }
+
+        ResolveScaled();
+
+        // The overlay must push both what was erased and what was drawn.
+        const DirtyRegion& damage = m_impl->m_canvas->GetDamage();
+        DirtyRegion changed = damage;
+        changed.Add(m_impl->m_lastDamage);
+
+        // A scaled frame changed window pixels as far out as an antialiased
+        // offscreen edge plus the upscale filter reach.
+        const float margin = m_impl->DamageMargin();
+        const Rect bounds = Internal::Inflate(changed.GetBounds(), margin > 0.0f ? 2.0f * margin + 1.0f : 0.0f);
+        const bool partial = m_impl->m_lastDamageValid;
+        const HRESULT hr = m_impl->m_core.EndDraw(partial ? &bounds : nullptr);
+
+        m_impl->m_lastDamage = damage;
+        m_impl->m_lastDamage.ClipTo(m_impl->Surface());
+        m_impl->m_lastDamageValid = SUCCEEDED(hr);
+        return hr;
+    }
+
+    void RenderEngine::InvalidateAll() noexcept {
+        m_impl->m_lastDamageValid = false;
+    }
+
+    void RenderEngine::SetRenderScale(float scale) noexcept {
+        scale = scale > 0.0f ? std::clamp(scale, 0.25f, 1.0f) : 1.0f;
+        if (scale != m_impl->m_renderScale) {
+            m_impl->m_renderScale = scale;
+            m_impl->m_lastDamageValid = false;
+        }
+    }
+
+    float RenderEngine::GetRenderScale() const noexcept {
+        return m_impl->m_renderScale;
+    }
+
+    void RenderEngine::ResolveScaled() {
+        if (!m_impl->m_core.IsScaledDrawing()) {
+            return;
+        }
+
+        Rect bounds;
+        const Rect* dirty = nullptr;
+        if (m_impl->m_lastDamageValid && m_impl->m_canvas) {
+            DirtyRegion changed = m_impl->m_canvas->GetDamage();
+            changed.Add(m_impl->m_lastDamage);
+            bounds = Internal::Inflate(changed.GetBounds(), 2.0f * m_impl->DamageMargin() + 1.0f);
+            dirty = &bounds;
+        }
+
+        if (FAILED(m_impl->m_core.EndScaledDraw(dirty))) {
+            m_impl->m_lastDamageValid = false;
+        }
+        if (m_impl->m_renderer) {
+            m_impl->m_renderer->SetCompatibleRenderTarget(m_impl->m_core.GetRenderTarget());
+        }
+    }
+
+    bool RenderEngine::HasRetainedFrame() const noexcept {
+        return m_impl->m_lastDamageValid && !m_impl->m_core.IsOverlay();
     }
 
     RenderEngine::DrawScope RenderEngine::CreateDrawScope() {
@@ -1176,7 +1528,22 @@ namespace Spectrum {
     }
 
     void RenderEngine::Clear(const Color& color) {
-        if (m_impl->m_renderMode == RenderMode::Direct2D) {
+        if (m_impl->m_renderMode != RenderMode::Direct2D) {
+            return;
+        }
+
+        // The DC target behind the overlay does not promise to keep its
+        // pixels between frames, so it is always cleared in full.
+        if (!m_impl->m_lastDamageValid || m_impl->m_core.IsOverlay() ||
+            m_impl->m_lastDamage.CoversMostOf(m_impl->Surface())) {
+            m_impl->m_core.Clear(color);
+            return;
+        }
+
+        // Everything outside the last frame's damage is already `color`.
+        const float margin = m_impl->DamageMargin();
+        for (const Rect& rect : m_impl->m_lastDamage.GetRects()) {
+            GraphicsCore::ClipRectScope clip(&m_impl->m_core, Internal::Inflate(rect, margin));
             m_impl->m_core.Clear(color);
         }
     }
@@ -1231,8 +1598,11 @@ namespace Spectrum {
         wrl::ComPtr<IDWriteFactory> m_dwriteFactory;
         Helpers::Rendering::RenderResourceCache<uint32_t, ID2D1SolidColorBrush> m_brushCache;
         Helpers::Rendering::RenderResourceCache<size_t, IDWriteTextFormat> m_formatCache;
+        Internal::GradientBrushCache<ID2D1LinearGradientBrush> m_linearCache;
+        Internal::GradientBrushCache<ID2D1RadialGradientBrush> m_radialCache;
 
         [[nodiscard]] wrl::ComPtr<ID2D1Brush> GetBrush(const Paint& paint);
+        void ClearCaches();
         [[nodiscard]] wrl::ComPtr<ID2D1SolidColorBrush> GetSolidBrush(const Color& color);
         [[nodiscard]] wrl::ComPtr<IDWriteTextFormat> GetTextFormat(const TextStyle& style);
         void DrawShape(const std::function<void(ID2D1RenderTarget*, ID2D1Brush*)>& drawFunc, const Paint& paint);
@@ -1248,18 +1618,24 @@ namespace Spectrum {
 
     void Renderer::SetRenderTarget(ID2D1RenderTarget* renderTarget) {
         if (m_impl->m_renderTarget.Get() != renderTarget) {
-            m_impl->m_brushCache.Clear();
-            m_impl->m_formatCache.Clear();
+            m_impl->ClearCaches();
             m_impl->m_renderTarget = renderTarget;
         }
     }
 
+    void Renderer::SetCompatibleRenderTarget(ID2D1RenderTarget* renderTarget) {
+        m_impl->m_renderTarget = renderTarget;
+    }
+
     void Renderer::OnDeviceLost() {
-        m_impl->m_brushCache.Clear();
-        m_impl->m_formatCache.Clear();
+        m_impl->ClearCaches();
         m_impl->m_renderTarget.Reset();
     }
 
+    GradientCacheStats Renderer::GetGradientCacheStats() const {
+        return Internal::Combine(m_impl->m_linearCache.GetStats(), m_impl->m_radialCache.GetStats());
+    }
+
     void Renderer::DrawText(const std::wstring& text, const Rect& rect, const TextStyle& style) {
         if (!Helpers::Rendering::RenderValidation::ValidateTextRenderingContext(m_impl->m_renderTarget.Get(), m_impl->m_dwriteFactory.Get(), text)) {
             return;
@@ -1341,7 +1717,7 @@ namespace Spectrum {
         return m_impl->GetSolidBrush(color);
     }
 
-    wrl::ComPtr<ID2D1PathGeometry> Renderer::CreatePath(const std::vector<Point>& points, bool closed) {
+    wrl::ComPtr<ID2D1PathGeometry> Renderer::CreatePath(Span<const Point> points, bool closed) {
         if (!Helpers::Rendering::RenderValidation::ValidatePointArray(points, closed ? 3 : 2)) {
             return nullptr;
         }
@@ -1357,10 +1733,45 @@ namespace Spectrum {
             }, "Renderer");
     }
 
-    wrl::ComPtr<ID2D1PathGeometry> Renderer::CreatePathFromLines(const std::vector<Point>& points) {
+    wrl::ComPtr<ID2D1PathGeometry> Renderer::CreatePathFromLines(Span<const Point> points) {
         return CreatePath(points, false);
     }
 
+    wrl::ComPtr<ID2D1PathGeometry> Renderer::CreateMesh(Span<const Point> vertices, Span<const uint32_t> indices) {
+        if (indices.size() < 3) {
+            return nullptr;
+        }
+
+        return Internal::CreatePathGeometry(m_impl->m_d2dFactory.Get(), [&](ID2D1GeometrySink* sink) {
+            // Winding fill unions triangles that turn the same way, so the
+            // ones wound the other way round are emitted reversed.
+            sink->SetFillMode(D2D1_FILL_MODE_WINDING);
+
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size()) {
+                    continue;
+                }
+
+                const Point& a = vertices[indices[i]];
+                Point b = vertices[indices[i + 1]];
+                Point c = vertices[indices[i + 2]];
+
+                const float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+                if (!(std::abs(cross) > 0.0f)) {
+                    continue;
+                }
+                if (cross < 0.0f) {
+                    std::swap(b, c);
+                }
+
+                sink->BeginFigure(Helpers::TypeConversion::ToD2DPoint(a), D2D1_FIGURE_BEGIN_FILLED);
+                sink->AddLine(Helpers::TypeConversion::ToD2DPoint(b));
+                sink->AddLine(Helpers::TypeConversion::ToD2DPoint(c));
+                sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+            }
+            }, "Renderer");
+    }
+
     ID2D1Factory* Renderer::GetFactory() const noexcept { return m_impl->m_d2dFactory.Get(); }
     ID2D1RenderTarget* Renderer::GetRenderTarget() const noexcept { return m_impl->m_renderTarget.Get(); }
     IDWriteFactory* Renderer::GetWriteFactory() const noexcept { return m_impl->m_dwriteFactory.Get(); }
@@ -1375,38 +1786,53 @@ namespace Spectrum {
             return GetSolidBrush(paint.GetColor().WithAlpha(paint.GetAlpha()));
 
         case BrushType::LinearGradient: {
-            auto collection = Internal::CreateGradientStopCollection(
-                m_renderTarget.Get(), paint.GetGradientStops(), paint.GetAlpha()
-            );
-            if (!collection) {
-                return nullptr;
-            }
+            // The stop collection is the expensive part and only depends on
+            // the stops and alpha; geometry is set per use.
+            const size_t key = Helpers::Rendering::HashGenerator::GenerateHash(
+                paint.GetGradientKey(), paint.GetAlpha());
+
+            auto brush = m_linearCache.GetOrCreate(key, [&] {
+                wrl::ComPtr<ID2D1LinearGradientBrush> created;
+                auto collection = Internal::CreateGradientStopCollection(
+                    m_renderTarget.Get(), paint.GetGradientStops(), paint.GetAlpha()
+                );
+                if (collection) {
+                    m_renderTarget->CreateLinearGradientBrush(
+                        D2D1::LinearGradientBrushProperties(D2D1::Point2F(), D2D1::Point2F()),
+                        collection.Get(), &created);
+                }
+                return created;
+                });
 
-            wrl::ComPtr<ID2D1LinearGradientBrush> brush;
-            D2D1_LINEAR_GRADIENT_BRUSH_PROPERTIES props = D2D1::LinearGradientBrushProperties(
-                Helpers::TypeConversion::ToD2DPoint(paint.GetLinearStart()),
-                Helpers::TypeConversion::ToD2DPoint(paint.GetLinearEnd())
-            );
-            m_renderTarget->CreateLinearGradientBrush(props, collection.Get(), &brush);
+            if (brush) {
+                brush->SetStartPoint(Helpers::TypeConversion::ToD2DPoint(paint.GetLinearStart()));
+                brush->SetEndPoint(Helpers::TypeConversion::ToD2DPoint(paint.GetLinearEnd()));
+            }
             return brush;
         }
 
         case BrushType::RadialGradient: {
-            auto collection = Internal::CreateGradientStopCollection(
-                m_renderTarget.Get(), paint.GetGradientStops(), paint.GetAlpha()
-            );
-            if (!collection) {
-                return nullptr;
-            }
+            const size_t key = Helpers::Rendering::HashGenerator::GenerateHash(
+                paint.GetGradientKey(), paint.GetAlpha());
+
+            auto brush = m_radialCache.GetOrCreate(key, [&] {
+                wrl::ComPtr<ID2D1RadialGradientBrush> created;
+                auto collection = Internal::CreateGradientStopCollection(
+                    m_renderTarget.Get(), paint.GetGradientStops(), paint.GetAlpha()
+                );
+                if (collection) {
+                    m_renderTarget->CreateRadialGradientBrush(
+                        D2D1::RadialGradientBrushProperties(D2D1::Point2F(), D2D1::Point2F(), 0.0f, 0.0f),
+                        collection.Get(), &created);
+                }
+                return created;
+                });
 
-            wrl::ComPtr<ID2D1RadialGradientBrush> brush;
-            D2D1_RADIAL_GRADIENT_BRUSH_PROPERTIES props = D2D1::RadialGradientBrushProperties(
-                Helpers::TypeConversion::ToD2DPoint(paint.GetRadialCenter()),
-                D2D1::Point2F(0.0f, 0.0f),
-                paint.GetRadialRadiusX(),
-                paint.GetRadialRadiusY()
-            );
-            m_renderTarget->CreateRadialGradientBrush(props, collection.Get(), &brush);
+            if (brush) {
+                brush->SetCenter(Helpers::TypeConversion::ToD2DPoint(paint.GetRadialCenter()));
+                brush->SetRadiusX(paint.GetRadialRadiusX());
+                brush->SetRadiusY(paint.GetRadialRadiusY());
+            }
             return brush;
         }
         }
@@ -1414,6 +1840,13 @@ namespace Spectrum {
         return nullptr;
     }
 
+    void Renderer::Impl::ClearCaches() {
+        m_brushCache.Clear();
+        m_formatCache.Clear();
+        m_linearCache.Clear();
+        m_radialCache.Clear();
+    }
+
     wrl::ComPtr<ID2D1SolidColorBrush> Renderer::Impl::GetSolidBrush(const Color& color) {
         if (!m_renderTarget) {
             return nullptr;
@@ -1480,58 +1913,191 @@ namespace Spectrum {
         return m_core ? m_core->GetRenderTarget() : nullptr;
     }
 
+    FrameArena& Canvas::GetFrameArena() const noexcept {
+        return m_frameArena;
+    }
+
+    void Canvas::ResetFrameArena() const {
+        m_frameArena.Reset();
+        m_geometryBuilds = 0;
+    }
+
+    size_t Canvas::GetGeometryBuildCount() const noexcept {
+        return m_geometryBuilds;
+    }
+
+    GradientCacheStats Canvas::GetGradientCacheStats() const {
+        return m_renderer ? m_renderer->GetGradientCacheStats() : GradientCacheStats{};
+    }
+
+    const DirtyRegion& Canvas::GetDamage() const noexcept {
+        return m_damage;
+    }
+
+    void Canvas::ResetDamage() const noexcept {
+        m_damage.Clear();
+    }
+
+    void Canvas::MarkDirty(const Rect& rect, float strokeWidth) const {
+        auto* rt = GetRenderTarget();
+        if (!rt) {
+            return;
+        }
+
+        const float pad = strokeWidth * 0.5f;
+        const Rect padded{ rect.x - pad, rect.y - pad, rect.width + 2.0f * pad, rect.height + 2.0f * pad };
+
+        D2D1_MATRIX_3X2_F transform;
+        rt->GetTransform(&transform);
+        m_damage.Add(Internal::TransformBounds(padded, transform));
+    }
+
+    void Canvas::MarkDirty(ID2D1Geometry* geometry, float strokeOutset) const {
+        auto* rt = GetRenderTarget();
+        if (!rt || !geometry) {
+            return;
+        }
+
+        D2D1_MATRIX_3X2_F transform;
+        rt->GetTransform(&transform);
+
+        D2D1_RECT_F bounds;
+        if (FAILED(geometry->GetBounds(&transform, &bounds))) {
+            return;
+        }
+
+        // An upper bound on GetWidenedBounds without widening the path:
+        // the outset covers miter tips and square caps, MaxScale the
+        // transform stretching it.
+        const float pad = strokeOutset * Internal::MaxScale(transform);
+
+        m_damage.Add({
+            bounds.left - pad, bounds.top - pad,
+            bounds.right - bounds.left + 2.0f * pad,
+            bounds.bottom - bounds.top + 2.0f * pad
+            });
+    }
+
     void Canvas::DrawRectangle(const Rect& rect, const Paint& paint) const {
         if (m_renderer) {
             m_renderer->DrawRectangle(rect, paint);
+            MarkDirty(rect, Internal::StrokeWidthOf(paint));
         }
     }
 
     void Canvas::DrawRoundedRectangle(const Rect& rect, float radius, const Paint& paint) const {
         if (m_renderer) {
             m_renderer->DrawRoundedRectangle(rect, radius, paint);
+            MarkDirty(rect, Internal::StrokeWidthOf(paint));
         }
     }
 
     void Canvas::DrawCircle(const Point& center, float radius, const Paint& paint) const {
-        if (m_renderer) {
-            m_renderer->DrawEllipse(center, radius, radius, paint);
-        }
+        DrawEllipse(center, radius, radius, paint);
     }
 
     void Canvas::DrawEllipse(const Point& center, float radiusX, float radiusY, const Paint& paint) const {
         if (m_renderer) {
             m_renderer->DrawEllipse(center, radiusX, radiusY, paint);
+            MarkDirty({ center.x - radiusX, center.y - radiusY, 2.0f * radiusX, 2.0f * radiusY },
+                Internal::StrokeWidthOf(paint));
         }
     }
 
     void Canvas::DrawLine(const Point& start, const Point& end, const Paint& paint) const {
         if (m_renderer) {
             m_renderer->DrawLine(start, end, paint);
+
+            // Lines are stroked whatever the paint style says.
+            const float left = std::min(start.x, end.x);
+            const float top = std::min(start.y, end.y);
+            MarkDirty({
+                left, top,
+                std::max(start.x, end.x) - left,
+                std::max(start.y, end.y) - top
+                }, paint.GetStrokeWidth());
         }
     }
 
-    void Canvas::DrawPolyline(const std::vector<Point>& points, const Paint& paint) const {
+    void Canvas::DrawPolyline(Span<const Point> points, const Paint& paint) const {
         if (!m_renderer || points.size() < 2) {
             return;
         }
 
-        if (auto path = m_renderer->CreatePathFromLines(points)) {
+        if (auto path = BuildPolyline(points)) {
             m_renderer->DrawGeometry(path.Get(), paint);
+            MarkDirty(path.Get(), Internal::StrokeOutsetOf(paint));
         }
     }
 
-    void Canvas::DrawPolygon(const std::vector<Point>& points, const Paint& paint) const {
+    void Canvas::DrawPolygon(Span<const Point> points, const Paint& paint) const {
         if (!m_renderer || points.size() < 3) {
             return;
         }
 
+        ++m_geometryBuilds;
         if (auto path = m_renderer->CreatePath(points, true)) {
             if (paint.IsFilled()) m_renderer->FillGeometry(path.Get(), paint);
             if (paint.IsStroked()) m_renderer->DrawGeometry(path.Get(), paint);
+            MarkDirty(path.Get(), Internal::FilledStrokeOutsetOf(paint));
         }
     }
 
-    void Canvas::DrawArc(const Point& center, float radius, float startAngle, float sweepAngle, const Paint& paint) const {
+    void Canvas::DrawMesh(Span<const Point> vertices, Span<const uint32_t> indices, const Paint& paint) const {
+        if (!m_renderer || indices.size() < 3) {
+            return;
+        }
+
+        ++m_geometryBuilds;
+        if (auto mesh = m_renderer->CreateMesh(vertices, indices)) {
+            m_renderer->FillGeometry(mesh.Get(), paint);
+            MarkDirty(mesh.Get(), 0.0f);
+        }
+    }
+
+    PathGeometry Canvas::BuildPolyline(Span<const Point> points) const {
+        if (!m_renderer || points.size() < 2) {
+            return nullptr;
+        }
+
+        ++m_geometryBuilds;
+        return m_renderer->CreatePathFromLines(points);
+    }
+
+    PathGeometry Canvas::BuildWaveform(const SpectrumData& spectrum, const Rect& bounds) const {
+        if (spectrum.size() < 2) {
+            return nullptr;
+        }
+
+        auto points = MakeArenaVector<Point>(m_frameArena, spectrum.size());
+
+        const float dx = bounds.width / (spectrum.size() - 1);
+        const float midY = bounds.y + bounds.height * 0.5f;
+        const float amplitude = bounds.height * 0.5f;
+
+        for (size_t i = 0; i < spectrum.size(); ++i) {
+            points.push_back({
+                bounds.x + i * dx,
+                midY - Helpers::Sanitize::NormalizedFloat(spectrum[i]) * amplitude
+                });
+        }
+
+        return BuildPolyline(points);
+    }
+
+    void Canvas::DrawPath(const PathGeometry& path, const Paint& paint) const {
+        if (!m_renderer || !path) {
+            return;
+        }
+
+        if (paint.IsFilled()) m_renderer->FillGeometry(path.Get(), paint);
+        if (paint.IsStroked()) m_renderer->DrawGeometry(path.Get(), paint);
+        MarkDirty(path.Get(), Internal::FilledStrokeOutsetOf(paint));
+    }
+
+    ArenaVector<Point> Canvas::BuildArcPoints(
+        const Point& center, float radius, float startAngle, float sweepAngle, bool fromCenter
+    ) const {
         using namespace Constants::Geometry;
 
         const int segments = Helpers::Math::Clamp(
@@ -1539,17 +2105,26 @@ namespace Spectrum {
             kMinCircleSegments, kMaxCircleSegments
         );
 
-        std::vector<Point> points;
-        points.reserve(static_cast<size_t>(segments) + 1);
+        auto points = MakeArenaVector<Point>(m_frameArena, static_cast<size_t>(segments) + 2);
+        if (fromCenter) points.push_back(center);
 
         const float angleStep = Helpers::Math::DegreesToRadians(sweepAngle) / static_cast<float>(segments);
         const float startRad = Helpers::Math::DegreesToRadians(startAngle);
 
+        // Step a unit vector around the arc: two trig calls per arc
+        // instead of two per segment.
+        const Rotor step = Rotor::FromAngle(angleStep);
+        Rotor direction = Rotor::FromAngle(startRad);
         for (int i = 0; i <= segments; ++i) {
-            points.push_back(Helpers::Geometry::PointOnCircle(center, radius, startRad + static_cast<float>(i) * angleStep));
+            points.push_back(direction.OnCircle(center, radius));
+            direction = direction * step;
         }
 
-        DrawPolyline(points, paint);
+        return points;
+    }
+
+    void Canvas::DrawArc(const Point& center, float radius, float startAngle, float sweepAngle, const Paint& paint) const {
+        DrawPolyline(BuildArcPoints(center, radius, startAngle, sweepAngle, false), paint);
     }
 
     void Canvas::DrawRing(const Point& center, float innerRadius, float outerRadius, const Paint& paint) const {
@@ -1564,25 +2139,7 @@ namespace Spectrum {
     }
 
     void Canvas::DrawSector(const Point& center, float radius, float startAngle, float sweepAngle, const Paint& paint) const {
-        using namespace Constants::Geometry;
-
-        const int segments = Helpers::Math::Clamp(
-            static_cast<int>(std::abs(sweepAngle) / kDegreesPerSegment),
-            kMinCircleSegments, kMaxCircleSegments
-        );
-
-        std::vector<Point> points;
-        points.reserve(static_cast<size_t>(segments) + 2);
-        points.push_back(center);
-
-        const float angleStep = Helpers::Math::DegreesToRadians(sweepAngle) / static_cast<float>(segments);
-        const float startRad = Helpers::Math::DegreesToRadians(startAngle);
-
-        for (int i = 0; i <= segments; ++i) {
-            points.push_back(Helpers::Geometry::PointOnCircle(center, radius, startRad + static_cast<float>(i) * angleStep));
-        }
-
-        DrawPolygon(points, paint);
+        DrawPolygon(BuildArcPoints(center, radius, startAngle, sweepAngle, true), paint);
     }
 
     void Canvas::DrawRegularPolygon(const Point& center, float radius, int sides, float rotation, const Paint& paint) const {
@@ -1662,13 +2219,13 @@ namespace Spectrum {
         drawCallback();
     }
 
-    void Canvas::DrawCircleBatch(const std::vector<Point>& centers, float radius, const Paint& paint) const {
+    void Canvas::DrawCircleBatch(Span<const Point> centers, float radius, const Paint& paint) const {
         for (const auto& center : centers) {
             DrawCircle(center, radius, paint);
         }
     }
 
-    void Canvas::DrawRectangleBatch(const std::vector<Rect>& rects, const Paint& paint) const {
+    void Canvas::DrawRectangleBatch(Span<const Rect> rects, const Paint& paint) const {
         for (const auto& rect : rects) {
             DrawRectangle(rect, paint);
         }
@@ -1743,6 +2300,9 @@ namespace Spectrum {
     void Canvas::DrawText(const std::wstring& text, const Rect& layoutRect, const TextStyle& style) const {
         if (m_renderer) {
             m_renderer->DrawText(text, layoutRect, style);
+            // Glyph overhang can leave the layout box; a quarter em covers
+            // italics and descenders.
+            MarkDirty(layoutRect, style.fontSize * 0.5f);
         }
     }
 
@@ -1768,54 +2328,53 @@ namespace Spectrum {
 
         const float barWidth = availableWidth / barCount;
 
-        const Paint paint = Paint::Fill(color);
+        const GradientRamp* ramp = style.useGradient && style.gradient && !style.gradient->empty()
+            ? style.gradient.get()
+            : nullptr;
+
+        // One brush spans the whole area, so a bar's top color tracks its
+        // level and every tall bar shares the same cached brush.
+        const Paint paint = ramp
+            ? Paint::LinearGradient(
+                { bounds.x, bounds.y + bounds.height }, { bounds.x, bounds.y }, ramp->GetStops())
+            : Paint::Fill(color);
 
         for (size_t i = 0; i < barCount; ++i) {
             const float height = std::max(spectrum[i] * bounds.height, kMinBarHeight);
             const float x = bounds.x + style.spacing + i * (barWidth + style.spacing);
             const float y = bounds.y + bounds.height - height;
+            const Rect rect{ x, y, barWidth, height };
+
+            if (ramp && height < kMinGradientBarHeight) {
+                // The bar covers [0, share] of the ramp; fill with its average.
+                const float share = bounds.height > 0.0f ? height / bounds.height : 1.0f;
+                DrawRoundedRectangle(rect, style.cornerRadius,
+                    Paint::Fill(ramp->Sample(share * 0.5f, share)));
+                continue;
+            }
 
-            DrawRoundedRectangle({ x, y, barWidth, height }, style.cornerRadius, paint);
+            DrawRoundedRectangle(rect, style.cornerRadius, paint);
         }
     }
 
     void Canvas::DrawWaveform(const SpectrumData& spectrum, const Rect& bounds, const Paint& paint, bool mirror) const {
-        if (spectrum.size() < 2) {
+        const PathGeometry path = BuildWaveform(spectrum, bounds);
+        if (!path) {
             return;
         }
 
-        using namespace Constants::Rendering;
-
-        std::vector<Point> topPoints;
-        topPoints.reserve(spectrum.size());
-
-        const float dx = bounds.width / (spectrum.size() - 1);
-        const float midY = bounds.y + bounds.height * 0.5f;
-        const float amplitude = bounds.height * 0.5f;
-
-        for (size_t i = 0; i < spectrum.size(); ++i) {
-            topPoints.push_back({
-                bounds.x + i * dx,
-                midY - Helpers::Sanitize::NormalizedFloat(spectrum[i]) * amplitude
-                });
-        }
-
-        DrawPolyline(topPoints, paint);
+        DrawPath(path, paint);
 
         if (mirror) {
-            std::vector<Point> bottomPoints;
-            bottomPoints.reserve(spectrum.size());
-
-            for (size_t i = 0; i < spectrum.size(); ++i) {
-                bottomPoints.push_back({
-                    bounds.x + i * dx,
-                    midY + Helpers::Sanitize::NormalizedFloat(spectrum[i]) * amplitude
-                    });
-            }
+            using namespace Constants::Rendering;
 
             Paint mirrorPaint = paint;
             mirrorPaint.WithAlpha(paint.GetAlpha() * kMirrorAlphaFactor);
-            DrawPolyline(bottomPoints, mirrorPaint);
+
+            PushTransform();
+            ScaleAt({ bounds.x, bounds.y + bounds.height * 0.5f }, 1.0f, -1.0f);
+            DrawPath(path, mirrorPaint);
+            PopTransform();
         }
     }
 
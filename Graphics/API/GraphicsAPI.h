@@ -2,7 +2,11 @@
 #define SPECTRUM_GRAPHICS_API_H
 
 #include "Common/Common.h"
+#include "Common/DirtyRegion.h"
+#include "Common/GradientRamp.h"
 #include "Common/SpectrumTypes.h"
+#include "Common/FrameArena.h"
+#include "Common/Span.h"
 
 #include <d2d1.h>
 #include <d3d11.h>
@@ -176,6 +180,8 @@ namespace Spectrum {
 
         namespace Rendering {
             constexpr float kMinBarHeight = 1.0f;
+            // Shorter gradient bars are filled flat with the ramp's prefiltered average.
+            constexpr float kMinGradientBarHeight = 4.0f;
             constexpr float kMirrorAlphaFactor = 0.6f;
             constexpr int kMinSize = 1;
             constexpr int kMaxSize = 16384;
@@ -192,14 +198,6 @@ namespace Spectrum {
         }
     }
 
-    struct GradientStop {
-        float position;
-        Color color;
-
-        GradientStop() = default;
-        GradientStop(float pos, const Color& col) : position(pos), color(col) {}
-    };
-
     struct StrokeOptions {
         float width = 1.0f;
         StrokeCap cap = StrokeCap::Flat;
@@ -325,6 +323,7 @@ namespace Spectrum {
         [[nodiscard]] float GetAlpha() const;
         [[nodiscard]] StrokeOptions GetStrokeOptions() const;
         [[nodiscard]] const std::vector<GradientStop>& GetGradientStops() const;
+        [[nodiscard]] size_t GetGradientKey() const;
         [[nodiscard]] Point GetLinearStart() const;
         [[nodiscard]] Point GetLinearEnd() const;
         [[nodiscard]] Point GetRadialCenter() const;
@@ -393,10 +392,21 @@ namespace Spectrum {
         bool RecreateResources(int width, int height);
 
         bool BeginDraw();
-        HRESULT EndDraw();
+        // `dirtyBounds` limits the overlay's layered-window update to the
+        // pixels that changed; nullptr pushes the whole surface.
+        HRESULT EndDraw(const Rect* dirtyBounds = nullptr);
         void Clear(const Color& color);
         [[nodiscard]] bool IsDrawing() const noexcept;
 
+        // Between BeginDraw and EndDraw: redirects drawing into an offscreen
+        // surface with `scale` times the window's pixels but the same size
+        // in DIPs, so callers keep window coordinates. EndScaledDraw draws
+        // it back with a linear filter, limited to `dirtyBounds` if given.
+        bool BeginScaledDraw(float scale);
+        HRESULT EndScaledDraw(const Rect* dirtyBounds = nullptr);
+        [[nodiscard]] bool IsScaledDrawing() const noexcept;
+        [[nodiscard]] bool IsOverlay() const noexcept;
+
         void PushTransform();
         void PopTransform();
         void Rotate(const Point& center, float degrees);
@@ -494,8 +504,28 @@ namespace Spectrum {
         [[nodiscard]] bool BeginDraw();
         [[nodiscard]] HRESULT EndDraw();
         [[nodiscard]] DrawScope CreateDrawScope();
+
+        // Clears only what the previous frame drew when the target kept
+        // its contents; falls back to a full clear after a resize, device
+        // loss or a failed present.
         void Clear(const Color& color);
 
+        // Forces the next Clear and overlay update to cover the whole target.
+        void InvalidateAll() noexcept;
+
+        // Fraction of the window's resolution the next frames are drawn at
+        // (clamped to 0.25..1). Below 1, BeginDraw redirects the canvas to
+        // an offscreen surface that ResolveScaled, or else EndDraw,
+        // upscales into the window; whatever is drawn after ResolveScaled
+        // lands at full resolution. A change repaints everything.
+        void SetRenderScale(float scale) noexcept;
+        [[nodiscard]] float GetRenderScale() const noexcept;
+        void ResolveScaled();
+
+        // True while the target still shows the last presented frame, so a
+        // caller may repaint only part of it.
+        [[nodiscard]] bool HasRetainedFrame() const noexcept;
+
         void ClearD3D11(const Color& color);
         void Present();
 
@@ -532,6 +562,9 @@ namespace Spectrum {
         Renderer& operator=(Renderer&&) = delete;
 
         void SetRenderTarget(ID2D1RenderTarget* renderTarget);
+        // For a target made by CreateCompatibleRenderTarget from the current
+        // one (or back): they share device resources, so caches are kept.
+        void SetCompatibleRenderTarget(ID2D1RenderTarget* renderTarget);
         void OnDeviceLost();
 
         void DrawText(const std::wstring& text, const Rect& rect, const TextStyle& style);
@@ -545,9 +578,11 @@ namespace Spectrum {
 
         [[nodiscard]] wrl::ComPtr<ID2D1Brush> GetBrush(const Paint& paint);
         [[nodiscard]] wrl::ComPtr<ID2D1SolidColorBrush> GetSolidBrush(const Color& color);
+        [[nodiscard]] GradientCacheStats GetGradientCacheStats() const;
 
-        [[nodiscard]] wrl::ComPtr<ID2D1PathGeometry> CreatePath(const std::vector<Point>& points, bool closed);
-        [[nodiscard]] wrl::ComPtr<ID2D1PathGeometry> CreatePathFromLines(const std::vector<Point>& points);
+        [[nodiscard]] wrl::ComPtr<ID2D1PathGeometry> CreatePath(Span<const Point> points, bool closed);
+        [[nodiscard]] wrl::ComPtr<ID2D1PathGeometry> CreatePathFromLines(Span<const Point> points);
+        [[nodiscard]] wrl::ComPtr<ID2D1PathGeometry> CreateMesh(Span<const Point> vertices, Span<const uint32_t> indices);
 
         [[nodiscard]] ID2D1Factory* GetFactory() const noexcept;
         [[nodiscard]] ID2D1RenderTarget* GetRenderTarget() const noexcept;
@@ -558,6 +593,10 @@ namespace Spectrum {
         std::unique_ptr<Impl> m_impl;
     };
 
+    // Geometry built once and drawn any number of times, so multi-pass
+    // effects (glow layers, reflections) share a single tessellation.
+    using PathGeometry = wrl::ComPtr<ID2D1PathGeometry>;
+
     class Canvas final {
     public:
         Canvas(Renderer* renderer, GraphicsCore* core);
@@ -570,13 +609,37 @@ namespace Spectrum {
 
         [[nodiscard]] ID2D1RenderTarget* GetRenderTarget() const noexcept;
 
+        // Scratch memory for the current frame; reset by RenderEngine::BeginDraw.
+        [[nodiscard]] FrameArena& GetFrameArena() const noexcept;
+        void ResetFrameArena() const;
+
+        // Path geometries created since the last ResetFrameArena.
+        [[nodiscard]] size_t GetGeometryBuildCount() const noexcept;
+
+        // Gradient brushes reused vs. built since the render target was set.
+        [[nodiscard]] GradientCacheStats GetGradientCacheStats() const;
+
+        // Device-space bounds of everything drawn since the last
+        // ResetDamage; RenderEngine::BeginDraw resets it.
+        [[nodiscard]] const DirtyRegion& GetDamage() const noexcept;
+        void ResetDamage() const noexcept;
+
         void DrawRectangle(const Rect& rect, const Paint& paint) const;
         void DrawRoundedRectangle(const Rect& rect, float radius, const Paint& paint) const;
         void DrawCircle(const Point& center, float radius, const Paint& paint) const;
         void DrawEllipse(const Point& center, float radiusX, float radiusY, const Paint& paint) const;
         void DrawLine(const Point& start, const Point& end, const Paint& paint) const;
-        void DrawPolyline(const std::vector<Point>& points, const Paint& paint) const;
-        void DrawPolygon(const std::vector<Point>& points, const Paint& paint) const;
+        void DrawPolyline(Span<const Point> points, const Paint& paint) const;
+        void DrawPolygon(Span<const Point> points, const Paint& paint) const;
+
+        // Fills a triangle list (three indices per triangle) as a single
+        // geometry in one draw. Overlapping triangles cover once, so shared
+        // edges neither seam nor blend twice.
+        void DrawMesh(Span<const Point> vertices, Span<const uint32_t> indices, const Paint& paint) const;
+
+        [[nodiscard]] PathGeometry BuildPolyline(Span<const Point> points) const;
+        [[nodiscard]] PathGeometry BuildWaveform(const SpectrumData& spectrum, const Rect& bounds) const;
+        void DrawPath(const PathGeometry& path, const Paint& paint) const;
 
         void DrawArc(const Point& center, float radius, float startAngle, float sweepAngle, const Paint& paint) const;
         void DrawRing(const Point& center, float innerRadius, float outerRadius, const Paint& paint) const;
@@ -590,8 +653,8 @@ namespace Spectrum {
         void DrawRoundedRectangleGlow(const Rect& rect, float cornerRadius, const Color& glowColor, float intensity = 1.0f, int layers = Constants::Effects::kDefaultGlowLayers) const;
         void DrawWithShadow(std::function<void()> drawCallback, const Point& offset, const Color& shadowColor) const;
 
-        void DrawCircleBatch(const std::vector<Point>& centers, float radius, const Paint& paint) const;
-        void DrawRectangleBatch(const std::vector<Rect>& rects, const Paint& paint) const;
+        void DrawCircleBatch(Span<const Point> centers, float radius, const Paint& paint) const;
+        void DrawRectangleBatch(Span<const Rect> rects, const Paint& paint) const;
 
         void BeginOpacityLayer(float opacity) const;
         void EndOpacityLayer() const;
@@ -613,8 +676,20 @@ namespace Spectrum {
         void DrawWaveform(const SpectrumData& spectrum, const Rect& bounds, const Paint& paint, bool mirror = false) const;
 
     private:
+        void MarkDirty(const Rect& rect, float strokeWidth) const;
+        void MarkDirty(ID2D1Geometry* geometry, float strokeOutset) const;
+
+        // Points along an arc, on the frame arena; a sector starts them at
+        // the center.
+        [[nodiscard]] ArenaVector<Point> BuildArcPoints(
+            const Point& center, float radius, float startAngle, float sweepAngle, bool fromCenter
+        ) const;
+
         Renderer* m_renderer;
         GraphicsCore* m_core;
+        mutable FrameArena m_frameArena;
+        mutable size_t m_geometryBuilds = 0;
+        mutable DirtyRegion m_damage;
     };
 
 }
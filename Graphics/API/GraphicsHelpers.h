@@ -6,6 +6,7 @@
 // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
 #include "GraphicsAPI.h"
+#include "Common/EnumNames.h"
 #include <cmath>
 #include <algorithm>
 #include <d2d1.h>
@@ -15,6 +16,7 @@
 #include <shared_mutex>
 #include <optional>
 #include <string_view>
+#include <iterator>
 
 namespace Spectrum::Helpers {
 
@@ -214,8 +216,8 @@ namespace Spectrum::Helpers {
             return condition;
         }
 
-        template<typename T>
-        [[nodiscard]] inline bool ArraySize(const std::vector<T>& array, size_t minSize) noexcept {
+        template<typename Container>
+        [[nodiscard]] inline bool ArraySize(const Container& array, size_t minSize) noexcept {
             return array.size() >= minSize;
         }
 
@@ -715,7 +717,7 @@ namespace Spectrum::Helpers {
                 return brush != nullptr;
             }
 
-            [[nodiscard]] static bool ValidatePointArray(const std::vector<Point>& points, size_t minSize = 2) noexcept {
+            [[nodiscard]] static bool ValidatePointArray(Span<const Point> points, size_t minSize = 2) noexcept {
                 return Validate::ArraySize(points, minSize);
             }
 
@@ -877,16 +879,6 @@ namespace Spectrum::Helpers {
             return static_cast<TEnum>((next % count + count) % count);
         }
 
-        inline std::string_view ToString(FFTWindowType type) {
-            constexpr std::string_view names[] = { "Hann", "Hamming", "Blackman", "Rectangular" };
-            return names[static_cast<size_t>(type)];
-        }
-
-        inline std::string_view ToString(SpectrumScale type) {
-            constexpr std::string_view names[] = { "Linear", "Logarithmic", "Mel" };
-            return names[static_cast<size_t>(type)];
-        }
-
         class Timer {
         public:
             Timer() : m_startTime(std::chrono::steady_clock::now()) {}
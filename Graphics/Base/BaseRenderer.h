@@ -10,11 +10,15 @@
 #include "Graphics/Base/PeakTracker.h"
 #include "Graphics/API/GraphicsHelpers.h"
 #include "Common/Common.h"
+#include "Common/FrameArena.h"
+#include "Common/GradientRamp.h"
+#include "Common/PrimaryPalette.h"
+#include "Common/Span.h"
+#include "Common/TrigTable.h"
 #include <optional>
 #include <functional>
 #include <algorithm>
 #include <vector>
-#include <map>
 
 namespace Spectrum {
 
@@ -24,11 +28,64 @@ namespace Spectrum {
         template<typename T> struct QualityTraits;
     }
 
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Color-keyed draw batch living in the frame arena.
+    // Items are appended unordered and sorted by color once on flush, so
+    // each color is drawn as one contiguous run (insertion order is kept).
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    template<typename T>
+    class ColorBatch {
+    public:
+        explicit ColorBatch(FrameArena& arena, size_t reserve = 0)
+            : m_entries(MakeArenaVector<Entry>(arena, reserve))
+            , m_run(MakeArenaVector<T>(arena))
+        {
+        }
+
+        void Add(const Color& color, const T& item) {
+            m_entries.push_back({ color, m_entries.size(), item });
+        }
+
+        [[nodiscard]] bool   empty() const noexcept { return m_entries.empty(); }
+        [[nodiscard]] size_t size()  const noexcept { return m_entries.size(); }
+
+        template<typename Fn>
+        void ForEachRun(Fn&& fn) {
+            std::sort(m_entries.begin(), m_entries.end(),
+                [](const Entry& a, const Entry& b) {
+                    if (a.color < b.color) return true;
+                    if (b.color < a.color) return false;
+                    return a.order < b.order;
+                });
+
+            m_run.reserve(m_entries.size());
+            for (size_t i = 0; i < m_entries.size();) {
+                const Color color = m_entries[i].color;
+                m_run.clear();
+                for (; i < m_entries.size() && !(color < m_entries[i].color); ++i)
+                    m_run.push_back(m_entries[i].item);
+                fn(color, Span<const T>(m_run));
+            }
+        }
+
+    private:
+        struct Entry {
+            Color  color;
+            size_t order;
+            T      item;
+        };
+
+        ArenaVector<Entry> m_entries;
+        ArenaVector<T>     m_run;
+    };
+
     template<typename Derived>
     class BaseRenderer : public IRenderer {
     public:
         static constexpr float kTimeResetThreshold = 1e6f;
-        static constexpr float kDefaultFrameTime = 1.0f / 60.0f;
+        static constexpr float kMaxFrameTime = 0.1f;
+        static constexpr float kSettleEpsilon = 1e-3f;
 
         enum class RoundingMode { None, All, Top, Bottom };
 
@@ -40,6 +97,7 @@ namespace Spectrum {
             , m_aspectRatio(0.0f)
             , m_padding(1.0f)
             , m_time(0.0f)
+            , m_palette(m_primaryColor)
         {
         }
 
@@ -58,7 +116,14 @@ namespace Spectrum {
             UpdateSettings();
         }
 
-        void SetPrimaryColor(const Color& c) override { m_primaryColor = c; }
+        // The palette is rebaked only when the color visibly changes, so a
+        // color picker re-sending the same value costs nothing.
+        void SetPrimaryColor(const Color& c) override {
+            m_primaryColor = c;
+            if (ColorToARGB(c) == ColorToARGB(m_palette.GetPrimary())) return;
+            m_palette.Bake(c);
+            OnPrimaryColorChanged();
+        }
 
         void SetOverlayMode(bool overlay) override {
             if (m_isOverlay == overlay) return;
@@ -71,11 +136,14 @@ namespace Spectrum {
             m_height = std::max(h, 0);
         }
 
-        void Render(Canvas& canvas, const SpectrumData& spectrum) override {
+        // The step is capped so a stall, such as a dragged window, resumes
+        // the animation instead of jumping it forward.
+        void Render(Canvas& canvas, const SpectrumData& spectrum, float deltaTime) override {
             if (spectrum.empty() || m_width <= 0 || m_height <= 0) return;
-            m_time += kDefaultFrameTime;
+            const float dt = std::clamp(deltaTime, 0.0f, kMaxFrameTime);
+            m_time += dt;
             if (m_time > kTimeResetThreshold) m_time = 0.0f;
-            UpdateAnimation(spectrum, kDefaultFrameTime);
+            UpdateAnimation(spectrum, dt);
             DoRender(canvas, spectrum);
         }
 
@@ -87,6 +155,7 @@ namespace Spectrum {
         virtual void UpdateSettings() = 0;
         virtual void UpdateAnimation(const SpectrumData&, float) {}
         virtual void DoRender(Canvas& canvas, const SpectrumData& spectrum) = 0;
+        virtual void OnPrimaryColorChanged() {}
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Quality settings helper
@@ -106,10 +175,19 @@ namespace Spectrum {
         [[nodiscard]] float GetMaxDimension() const noexcept { return static_cast<float>(std::max(m_width, m_height)); }
         [[nodiscard]] float GetMaxRadius()    const noexcept { return GetMinDimension() * 0.45f; }
 
+        // Smoothed values closer than this to their target no longer move
+        // visibly, which lets renderers report IsAnimating() == false.
+        [[nodiscard]] static bool IsSettled(float current, float target) noexcept {
+            return std::abs(current - target) <= kSettleEpsilon;
+        }
+
         [[nodiscard]] RenderQuality GetQuality()     const noexcept { return m_quality; }
         [[nodiscard]] bool          IsOverlay()      const noexcept { return m_isOverlay; }
         [[nodiscard]] Color         GetPrimaryColor() const noexcept { return m_primaryColor; }
 
+        // Opacity and brightness shades of the primary; see PrimaryPalette.
+        [[nodiscard]] const PrimaryPalette& GetPalette() const noexcept { return m_palette; }
+
         [[nodiscard]] Rect  GetViewportBounds() const noexcept {
             return { 0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height) };
         }
@@ -194,11 +272,11 @@ namespace Spectrum {
 
         [[nodiscard]] std::vector<Point> GetCircularPoints(const Point& c, float r, size_t n) const {
             if (n == 0) return {};
+            const TrigTable& circle = TrigTable::Circle(n);
             std::vector<Point> pts;
             pts.reserve(n);
-            const float step = TWO_PI / n;
             for (size_t i = 0; i < n; ++i)
-                pts.push_back(GetPointOnCircle(c, r, i * step));
+                pts.push_back(circle[i].OnCircle(c, r));
             return pts;
         }
 
@@ -234,26 +312,31 @@ namespace Spectrum {
         // Gradient
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-        using ColorGradient = std::vector<Color>;
+        // Baked once per distinct set of colors and shared through
+        // GradientRampCache; sampling is a table lookup.
+        using ColorGradient = std::shared_ptr<const GradientRamp>;
+
+        // Evenly spaced colors, first at 0 and last at 1.
+        [[nodiscard]] static ColorGradient BakeGradient(
+            std::initializer_list<Color> colors, size_t size = GradientRamp::kDefaultSize)
+        {
+            return GradientRampCache::Shared().Get(
+                Span<const Color>(colors.begin(), colors.size()), size);
+        }
 
         [[nodiscard]] Color SampleGradient(const ColorGradient& g, float t) const {
-            if (g.empty()) return {};
-            if (g.size() == 1) return g[0];
-            const float s = std::clamp(t, 0.0f, 1.0f) * (g.size() - 1);
-            const size_t i = static_cast<size_t>(s);
-            const size_t j = std::min(i + 1, g.size() - 1);
-            return InterpolateColors(g[i], g[j], s - i);
-        }
-
-        [[nodiscard]] ColorGradient CreateGradient(const Color& a, const Color& b, size_t steps) const {
-            if (steps == 0) return {};
-            ColorGradient g;
-            g.reserve(steps);
-            for (size_t i = 0; i < steps; ++i) {
-                const float t = steps > 1 ? static_cast<float>(i) / (steps - 1) : 0.0f;
-                g.push_back(InterpolateColors(a, b, t));
-            }
-            return g;
+            return g ? g->Sample(t) : Color{};
+        }
+
+        // `footprint`: share of the gradient one sample covers (see GradientRamp).
+        [[nodiscard]] Color SampleGradient(const ColorGradient& g, float t, float footprint) const {
+            return g ? g->Sample(t, footprint) : Color{};
+        }
+
+        [[nodiscard]] ColorGradient CreateGradient(const Color& a, const Color& b,
+            size_t size = GradientRamp::kDefaultSize) const
+        {
+            return BakeGradient({ a, b }, size);
         }
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -338,15 +421,19 @@ namespace Spectrum {
         // Batch rendering
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-        using RectBatch = std::map<Color, std::vector<Rect>>;
-        using PointBatch = std::map<Color, std::vector<Point>>;
+        using RectBatch = ColorBatch<Rect>;
+        using PointBatch = ColorBatch<Point>;
+
+        template<typename T>
+        [[nodiscard]] static ArenaVector<T> MakeFrameVector(Canvas& canvas, size_t reserve = 0) {
+            return MakeArenaVector<T>(canvas.GetFrameArena(), reserve);
+        }
 
         void RenderRectBatches(
-            Canvas& canvas, const RectBatch& batches,
+            Canvas& canvas, RectBatch& batches,
             float cornerRadius = 0.0f, RoundingMode mode = RoundingMode::All) const
         {
-            for (const auto& [color, rects] : batches) {
-                if (rects.empty()) continue;
+            batches.ForEachRun([&](const Color& color, Span<const Rect> rects) {
                 const Paint paint = Paint::Fill(color);
                 if (cornerRadius > 0.0f || mode != RoundingMode::None) {
                     for (const auto& r : rects)
@@ -355,13 +442,13 @@ namespace Spectrum {
                 else {
                     canvas.DrawRectangleBatch(rects, paint);
                 }
-            }
+                });
         }
 
-        void RenderCircleBatches(Canvas& canvas, const PointBatch& batches, float radius) const {
-            for (const auto& [color, pts] : batches)
-                if (!pts.empty())
-                    canvas.DrawCircleBatch(pts, radius, Paint::Fill(color));
+        void RenderCircleBatches(Canvas& canvas, PointBatch& batches, float radius) const {
+            batches.ForEachRun([&](const Color& color, Span<const Point> pts) {
+                canvas.DrawCircleBatch(pts, radius, Paint::Fill(color));
+                });
         }
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -399,6 +486,7 @@ namespace Spectrum {
         float         m_aspectRatio;
         float         m_padding;
         mutable float m_time;
+        PrimaryPalette m_palette;
 
     private:
         std::optional<PeakTracker> m_peakTracker;
@@ -41,6 +41,7 @@ namespace Spectrum {
 
         void Update(const SpectrumData& values, float deltaTime) {
             const size_t count = std::min(values.size(), m_peaks.size());
+            m_isAnimating = false;
 
             for (size_t i = 0; i < count; ++i) {
                 const float v = Helpers::Math::Saturate(values[i]);
@@ -55,12 +56,17 @@ namespace Spectrum {
                 else {
                     m_peaks[i] *= m_config.decayRate;
                 }
+
+                // A visible peak above its bar is held or falling.
+                if (v < m_peaks[i] && m_peaks[i] > m_config.minVisible)
+                    m_isAnimating = true;
             }
         }
 
         void Reset() {
             std::fill(m_peaks.begin(), m_peaks.end(), 0.0f);
             std::fill(m_holdTimers.begin(), m_holdTimers.end(), 0.0f);
+            m_isAnimating = false;
         }
 
         void Resize(size_t newSize) {
@@ -89,6 +95,11 @@ namespace Spectrum {
             return m_peaks.size();
         }
 
+        // True while any visible peak will still move for unchanged input.
+        [[nodiscard]] bool IsAnimating() const {
+            return m_isAnimating;
+        }
+
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Config
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -101,6 +112,7 @@ namespace Spectrum {
         Config            m_config;
         SpectrumData      m_peaks;
         std::vector<float> m_holdTimers;
+        bool               m_isAnimating = false;
     };
 
 } // namespace Spectrum
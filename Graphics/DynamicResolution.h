@@ -0,0 +1,118 @@
+#ifndef SPECTRUM_CPP_DYNAMIC_RESOLUTION_H
+#define SPECTRUM_CPP_DYNAMIC_RESOLUTION_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// DynamicResolution - picks the visualization's render scale from its
+// measured cost. Fill-bound styles cost roughly in proportion to the
+// pixels they touch, so a frame over budget drops the scale by the square
+// root of the overrun in one go; headroom raises it one step at a time
+// and only once the prediction fits. A drop that saved less than half of
+// what the pixel count promised means the style is not fill-bound; it is
+// undone and the scale left alone for a while. Scales are quantized so
+// the offscreen surface is only reallocated on a real change.
+// Header-only.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <algorithm>
+#include <cmath>
+
+namespace Spectrum {
+
+    class DynamicResolution final {
+    public:
+        static constexpr float kMinScale = 0.5f;
+        static constexpr float kMaxScale = 1.0f;
+        static constexpr float kScaleStep = 1.0f / 16.0f;
+
+        explicit DynamicResolution(float budgetMs) noexcept : m_budgetMs(budgetMs) {}
+
+        // Feeds one frame's cost at the current scale; returns the scale
+        // for the next frame.
+        float Update(float frameMs) noexcept {
+            if (!(frameMs >= 0.0f)) return m_scale;
+
+            m_averageMs = m_frames == 0 ? frameMs : m_averageMs + (frameMs - m_averageMs) * kSmoothing;
+            ++m_frames;
+
+            if (m_holdFrames > 0) --m_holdFrames;
+            if (m_frames < kSettleFrames) return m_scale;
+
+            // Judge the last drop once the average reflects it.
+            if (m_probeMs > 0.0f) {
+                const float ratio = m_scale / m_probeScale;
+                const float promised = 1.0f - ratio * ratio;
+                const float saved = 1.0f - m_averageMs / m_probeMs;
+                if (saved < promised * kMinUsefulSaving) {
+                    SetScale(m_probeScale);
+                    m_holdFrames = kBackoffFrames;
+                }
+                m_probeMs = 0.0f;
+                return m_scale;
+            }
+
+            if (m_averageMs > m_budgetMs) {
+                if (m_holdFrames > 0 || m_scale <= kMinScale) return m_scale;
+
+                const float target = m_scale * std::sqrt(m_budgetMs / m_averageMs);
+                const float next = Quantize(std::floor(target / kScaleStep) * kScaleStep);
+                if (next < m_scale) {
+                    const float before = m_averageMs;
+                    m_probeScale = m_scale;
+                    SetScale(next);
+                    m_probeMs = before;
+                }
+                return m_scale;
+            }
+
+            if (m_scale < kMaxScale && m_averageMs < m_budgetMs * kRaiseHeadroom) {
+                const float next = Quantize(m_scale + kScaleStep);
+                const float ratio = next / m_scale;
+                if (m_averageMs * ratio * ratio < m_budgetMs * kRaiseFit)
+                    SetScale(next);
+            }
+            return m_scale;
+        }
+
+        // Back to full resolution, e.g. after a style or window change made
+        // the measurements meaningless.
+        void Reset() noexcept {
+            SetScale(kMaxScale);
+            m_holdFrames = 0;
+        }
+
+        void SetBudget(float budgetMs) noexcept { m_budgetMs = budgetMs; }
+
+        [[nodiscard]] float GetScale()     const noexcept { return m_scale; }
+        [[nodiscard]] float GetAverageMs() const noexcept { return m_averageMs; }
+        [[nodiscard]] float GetBudgetMs()  const noexcept { return m_budgetMs; }
+
+    private:
+        static constexpr float kSmoothing = 0.2f;
+        static constexpr int   kSettleFrames = 12;
+        static constexpr int   kBackoffFrames = 300;
+        static constexpr float kMinUsefulSaving = 0.5f;
+        static constexpr float kRaiseHeadroom = 0.7f;
+        static constexpr float kRaiseFit = 0.85f;
+
+        [[nodiscard]] static float Quantize(float scale) noexcept {
+            return std::clamp(std::round(scale / kScaleStep) * kScaleStep, kMinScale, kMaxScale);
+        }
+
+        void SetScale(float scale) noexcept {
+            m_scale = Quantize(scale);
+            m_frames = 0;
+            m_probeMs = 0.0f;
+        }
+
+        float m_budgetMs;
+        float m_scale = kMaxScale;
+        float m_averageMs = 0.0f;
+        float m_probeMs = 0.0f;
+        float m_probeScale = kMaxScale;
+        int   m_frames = 0;
+        int   m_holdFrames = 0;
+    };
+
+} // namespace Spectrum
+
+#endif
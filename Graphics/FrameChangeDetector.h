@@ -0,0 +1,80 @@
+#ifndef SPECTRUM_CPP_FRAME_CHANGE_DETECTOR_H
+#define SPECTRUM_CPP_FRAME_CHANGE_DETECTOR_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// FrameChangeDetector - decides whether the next visualization frame would
+// be identical to the one already on screen. That is the case when the
+// spectrum is unchanged within kSpectrumEpsilon, nothing else that feeds
+// the frame changed, and the renderer reports its animation as settled.
+// Header-only.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Common.h"
+#include "Graphics/IRenderer.h"
+
+namespace Spectrum {
+
+    class FrameChangeDetector final {
+    public:
+        // Well below one pixel of bar height at any window size we support.
+        static constexpr float kSpectrumEpsilon = 5e-4f;
+
+        // Everything besides the spectrum that changes what a frame shows.
+        struct FrameKey {
+            const IRenderer* renderer = nullptr;
+            RenderQuality    quality = RenderQuality::Medium;
+            Color            color;
+            int              width = 0;
+            int              height = 0;
+            bool             overlay = false;
+            bool             buttonHovered = false;
+        };
+
+        // Returns false when the frame can be skipped. Otherwise remembers
+        // `key` and `spectrum` as the state now on screen.
+        [[nodiscard]] bool ShouldRender(const FrameKey& key, const SpectrumData& spectrum) {
+            if (m_hasFrame && key.renderer && !key.renderer->IsAnimating() &&
+                SameKey(key, m_key) && SameSpectrum(spectrum, m_spectrum))
+            {
+                ++m_skippedFrames;
+                return false;
+            }
+
+            m_key = key;
+            m_spectrum.assign(spectrum.begin(), spectrum.end());
+            m_hasFrame = true;
+            return true;
+        }
+
+        // Forces the next frame to render, e.g. after the target was lost.
+        void Invalidate() noexcept { m_hasFrame = false; }
+
+        [[nodiscard]] uint64_t GetSkippedFrames() const noexcept { return m_skippedFrames; }
+
+    private:
+        [[nodiscard]] static bool SameKey(const FrameKey& a, const FrameKey& b) noexcept {
+            return a.renderer == b.renderer
+                && a.quality == b.quality
+                && a.color.r == b.color.r && a.color.g == b.color.g
+                && a.color.b == b.color.b && a.color.a == b.color.a
+                && a.width == b.width && a.height == b.height
+                && a.overlay == b.overlay
+                && a.buttonHovered == b.buttonHovered;
+        }
+
+        [[nodiscard]] static bool SameSpectrum(const SpectrumData& a, const SpectrumData& b) noexcept {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i)
+                if (std::abs(a[i] - b[i]) > kSpectrumEpsilon) return false;
+            return true;
+        }
+
+        FrameKey     m_key;
+        SpectrumData m_spectrum;
+        uint64_t     m_skippedFrames = 0;
+        bool         m_hasFrame = false;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -16,7 +16,9 @@ namespace Spectrum {
     public:
         virtual ~IRenderer() = default;
 
-        virtual void Render(Canvas& canvas, const SpectrumData& spectrum) = 0;
+        // `deltaTime` is the time in seconds since this renderer last drew,
+        // which is longer than a frame for a view updated at a lower rate.
+        virtual void Render(Canvas& canvas, const SpectrumData& spectrum, float deltaTime) = 0;
         virtual void SetQuality(RenderQuality quality) = 0;
         virtual void SetPrimaryColor(const Color&) {}
         virtual void SetOverlayMode(bool) {}
@@ -25,6 +27,11 @@ namespace Spectrum {
         [[nodiscard]] virtual std::string_view  GetName()  const = 0;
         [[nodiscard]] virtual bool SupportsPrimaryColor()  const { return true; }
 
+        // False once the renderer's own animation has settled, i.e. the same
+        // spectrum would draw the same frame again. Renderers that do not
+        // opt in are treated as always animating.
+        [[nodiscard]] virtual bool IsAnimating() const { return true; }
+
         virtual void OnActivate(int, int) {}
         virtual void OnResize(int w, int h) { OnActivate(w, h); }
         virtual void OnDeactivate() {}
@@ -0,0 +1,268 @@
+#include "PluginRenderer.h"
+#include "Graphics/API/GraphicsAPI.h"
+
+#include <cwctype>
+
+namespace Spectrum {
+
+    static_assert(sizeof(SpPoint) == sizeof(Point) && alignof(SpPoint) == alignof(Point),
+        "SpPoint must alias Point so polylines cross the ABI without a copy");
+
+    namespace {
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Drawing thunks: context is the frame's Canvas
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        Canvas& ToCanvas(void* context) { return *static_cast<Canvas*>(context); }
+        Color ToColor(SpColor c) { return Color(c.r, c.g, c.b, c.a); }
+
+        Span<const Point> ToPoints(const SpPoint* points, uint32_t count) {
+            return { reinterpret_cast<const Point*>(points), points ? count : 0u };
+        }
+
+        void FillRect(void* ctx, float x, float y, float w, float h, SpColor c) {
+            ToCanvas(ctx).DrawRectangle({ x, y, w, h }, Paint::Fill(ToColor(c)));
+        }
+
+        void StrokeRect(void* ctx, float x, float y, float w, float h, float width, SpColor c) {
+            ToCanvas(ctx).DrawRectangle({ x, y, w, h }, Paint::Stroke(ToColor(c), width));
+        }
+
+        void FillRoundedRect(void* ctx, float x, float y, float w, float h, float radius, SpColor c) {
+            ToCanvas(ctx).DrawRoundedRectangle({ x, y, w, h }, radius, Paint::Fill(ToColor(c)));
+        }
+
+        void FillCircle(void* ctx, float cx, float cy, float radius, SpColor c) {
+            ToCanvas(ctx).DrawCircle({ cx, cy }, radius, Paint::Fill(ToColor(c)));
+        }
+
+        void StrokeCircle(void* ctx, float cx, float cy, float radius, float width, SpColor c) {
+            ToCanvas(ctx).DrawCircle({ cx, cy }, radius, Paint::Stroke(ToColor(c), width));
+        }
+
+        void Line(void* ctx, float x0, float y0, float x1, float y1, float width, SpColor c) {
+            ToCanvas(ctx).DrawLine({ x0, y0 }, { x1, y1 }, Paint::Stroke(ToColor(c), width));
+        }
+
+        void Polyline(void* ctx, const SpPoint* points, uint32_t count, float width, SpColor c) {
+            ToCanvas(ctx).DrawPolyline(ToPoints(points, count), Paint::Stroke(ToColor(c), width));
+        }
+
+        void FillPolygon(void* ctx, const SpPoint* points, uint32_t count, SpColor c) {
+            ToCanvas(ctx).DrawPolygon(ToPoints(points, count), Paint::Fill(ToColor(c)));
+        }
+
+        constexpr SpDraw kDrawTable = {
+            nullptr,
+            FillRect, StrokeRect, FillRoundedRect,
+            FillCircle, StrokeCircle,
+            Line, Polyline, FillPolygon
+        };
+
+        // Shared by every instance, so two views of the same plugin never
+        // pick the same shadow name.
+        std::atomic<uint32_t> g_shadowCounter{ 0 };
+
+        bool IsDll(const std::filesystem::path& path) {
+            std::wstring ext = path.extension().wstring();
+            for (auto& ch : ext) ch = static_cast<wchar_t>(std::towlower(ch));
+            return ext == L".dll";
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Discovery
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    std::unique_ptr<PluginRenderer> PluginRenderer::LoadFirst(const std::filesystem::path& directory) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory, ec)) return nullptr;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            if (!entry.is_regular_file(ec) || !IsDll(entry.path())) continue;
+
+            auto plugin = std::make_unique<PluginRenderer>(entry.path());
+            if (plugin->Load()) return plugin;
+        }
+        return nullptr;
+    }
+
+    std::filesystem::path PluginRenderer::DefaultDirectory() {
+        wchar_t exe[MAX_PATH] = {};
+        const DWORD len = ::GetModuleFileNameW(nullptr, exe, MAX_PATH);
+        if (len == 0 || len >= MAX_PATH) return L"plugins";
+        return std::filesystem::path(exe).parent_path() / L"plugins";
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Lifecycle
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    PluginRenderer::PluginRenderer(std::filesystem::path path)
+        : m_path(std::move(path))
+    {
+    }
+
+    PluginRenderer::~PluginRenderer() {
+        Unload(m_module);
+    }
+
+    bool PluginRenderer::Load() {
+        std::error_code ec;
+        m_loadedWriteTime = std::filesystem::last_write_time(m_path, ec);
+
+        std::filesystem::path shadow;
+        if (!CopyShadow(shadow) || !LoadModule(m_module, shadow, {})) return false;
+
+        m_name = m_module.api->name ? m_module.api->name : m_path.stem().string();
+        LOG_INFO("PluginRenderer: Loaded " << m_name << " from " << m_path.string());
+        return true;
+    }
+
+    void PluginRenderer::OnActivate(int w, int h) {
+        m_width = std::max(w, 0);
+        m_height = std::max(h, 0);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Rendering
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    void PluginRenderer::Render(Canvas& canvas, const SpectrumData& spectrum, float deltaTime) {
+        if (++m_frame % kPollFrames == 0) PollForReload();
+        if (!m_module.instance || m_width <= 0 || m_height <= 0) return;
+
+        SpFrame frame;
+        frame.bins = spectrum.data();
+        frame.binCount = static_cast<uint32_t>(spectrum.size());
+        frame.width = static_cast<float>(m_width);
+        frame.height = static_cast<float>(m_height);
+        // The time since this instance last drew, capped like the built-in
+        // renderers' so a stall does not jump the plugin's animation.
+        frame.deltaTime = std::clamp(deltaTime, 0.0f, kMaxFrameTime);
+        frame.quality = static_cast<uint32_t>(m_quality);
+        frame.overlay = m_isOverlay ? 1u : 0u;
+        frame.primary = { m_primaryColor.r, m_primaryColor.g, m_primaryColor.b, m_primaryColor.a };
+
+        SpDraw draw = kDrawTable;
+        draw.context = &canvas;
+
+        m_module.api->render(m_module.instance, &frame, &draw);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+    // Module handling
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+    bool PluginRenderer::CopyShadow(std::filesystem::path& shadow) {
+        std::error_code ec;
+
+        // A fresh name per load: the previous copy is still mapped and
+        // cannot be overwritten.
+        const std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / L"SpectrumCpp";
+        std::filesystem::create_directories(dir, ec);
+
+        shadow = dir / (m_path.stem().wstring()
+            + L"." + std::to_wstring(::GetCurrentProcessId())
+            + L"." + std::to_wstring(++g_shadowCounter) + L".dll");
+
+        if (!std::filesystem::copy_file(m_path, shadow,
+            std::filesystem::copy_options::overwrite_existing, ec))
+        {
+            LOG_WARNING("PluginRenderer: Cannot copy " << m_path.string() << ": " << ec.message());
+            std::filesystem::remove(shadow, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool PluginRenderer::LoadModule(Module& out, const std::filesystem::path& shadow,
+        const std::vector<uint8_t>& state)
+    {
+        Module module;
+        module.shadow = shadow;
+        module.handle = ::LoadLibraryW(shadow.c_str());
+        if (!module.handle) {
+            LOG_WARNING("PluginRenderer: LoadLibrary failed for " << m_path.string());
+            Unload(module);
+            return false;
+        }
+
+        const auto getApi = reinterpret_cast<SpPluginGetApiFn>(
+            ::GetProcAddress(module.handle, SPECTRUM_PLUGIN_ENTRY));
+        module.api = getApi ? getApi() : nullptr;
+
+        if (!module.api ||
+            module.api->abiVersion != SPECTRUM_PLUGIN_ABI_VERSION ||
+            module.api->structSize < sizeof(SpPluginApi) ||
+            !module.api->create || !module.api->destroy || !module.api->render)
+        {
+            LOG_WARNING("PluginRenderer: " << m_path.string() << " is not a compatible plugin");
+            module.api = nullptr;
+            Unload(module);
+            return false;
+        }
+
+        module.instance = module.api->create(
+            state.empty() ? nullptr : state.data(),
+            static_cast<uint32_t>(state.size()));
+
+        if (!module.instance) {
+            LOG_WARNING("PluginRenderer: " << m_path.string() << " failed to create an instance");
+            Unload(module);
+            return false;
+        }
+
+        out = std::move(module);
+        return true;
+    }
+
+    void PluginRenderer::Unload(Module& module) noexcept {
+        if (module.instance && module.api) module.api->destroy(module.instance);
+        if (module.handle) ::FreeLibrary(module.handle);
+
+        std::error_code ec;
+        if (!module.shadow.empty()) std::filesystem::remove(module.shadow, ec);
+
+        module = Module{};
+    }
+
+    std::vector<uint8_t> PluginRenderer::SaveState() const {
+        const SpPluginApi* api = m_module.api;
+        if (!api || !api->saveState || !m_module.instance) return {};
+
+        const uint32_t size = api->saveState(m_module.instance, nullptr, 0);
+        std::vector<uint8_t> state(size);
+        if (size > 0) {
+            const uint32_t written = api->saveState(m_module.instance, state.data(), size);
+            state.resize(std::min(written, size));
+        }
+        return state;
+    }
+
+    void PluginRenderer::PollForReload() {
+        std::error_code ec;
+        const auto writeTime = std::filesystem::last_write_time(m_path, ec);
+        if (ec || writeTime == m_loadedWriteTime) return;
+
+        // While the linker still holds the file the copy fails; leave the
+        // timestamp alone so the next poll tries again.
+        std::filesystem::path shadow;
+        if (!CopyShadow(shadow)) return;
+
+        // A build that copies but will not load is not retried until it
+        // changes again; the running one stays.
+        m_loadedWriteTime = writeTime;
+
+        Module next;
+        if (!LoadModule(next, shadow, SaveState())) return;
+
+        Unload(m_module);
+        m_module = std::move(next);
+        m_name = m_module.api->name ? m_module.api->name : m_path.stem().string();
+
+        LOG_INFO("PluginRenderer: Reloaded " << m_name);
+    }
+
+} // namespace Spectrum
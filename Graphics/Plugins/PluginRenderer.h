@@ -0,0 +1,88 @@
+#ifndef SPECTRUM_CPP_PLUGIN_RENDERER_H
+#define SPECTRUM_CPP_PLUGIN_RENDERER_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// PluginRenderer - hosts a renderer plugin (SpectrumPlugin.h) behind the
+// regular IRenderer interface.
+//
+// The DLL is never loaded in place: a shadow copy is, so the build can
+// overwrite the original while it runs. Render polls the original's write
+// time every kPollFrames; on a change the new build is loaded next to the
+// old one, handed the old instance's state, and only swapped in once it
+// created an instance. A broken build leaves the running one untouched.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Common.h"
+#include "Graphics/IRenderer.h"
+#include "Graphics/Plugins/SpectrumPlugin.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Spectrum {
+
+    class PluginRenderer final : public IRenderer {
+    public:
+        // Loads the first usable plugin in `directory`; nullptr if none.
+        [[nodiscard]] static std::unique_ptr<PluginRenderer> LoadFirst(
+            const std::filesystem::path& directory);
+
+        // <exe dir>\plugins
+        [[nodiscard]] static std::filesystem::path DefaultDirectory();
+
+        explicit PluginRenderer(std::filesystem::path path);
+        ~PluginRenderer() override;
+
+        PluginRenderer(const PluginRenderer&) = delete;
+        PluginRenderer& operator=(const PluginRenderer&) = delete;
+
+        bool Load();
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // IRenderer
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        void Render(Canvas& canvas, const SpectrumData& spectrum, float deltaTime) override;
+        void SetQuality(RenderQuality quality) override { m_quality = quality; }
+        void SetPrimaryColor(const Color& color) override { m_primaryColor = color; }
+        void SetOverlayMode(bool overlay) override { m_isOverlay = overlay; }
+        void OnActivate(int w, int h) override;
+
+        [[nodiscard]] RenderStyle      GetStyle() const override { return RenderStyle::Plugin; }
+        [[nodiscard]] std::string_view GetName()  const override { return m_name; }
+
+    private:
+        struct Module {
+            HMODULE               handle = nullptr;
+            const SpPluginApi*    api = nullptr;
+            void*                 instance = nullptr;
+            std::filesystem::path shadow;
+        };
+
+        static constexpr uint64_t kPollFrames = 30;
+        static constexpr float    kMaxFrameTime = 0.1f;
+
+        bool CopyShadow(std::filesystem::path& shadow);
+        bool LoadModule(Module& out, const std::filesystem::path& shadow,
+            const std::vector<uint8_t>& state);
+        static void Unload(Module& module) noexcept;
+        [[nodiscard]] std::vector<uint8_t> SaveState() const;
+        void PollForReload();
+
+        std::filesystem::path           m_path;
+        std::filesystem::file_time_type m_loadedWriteTime{};
+        Module                          m_module;
+        std::string                     m_name = "Plugin";
+        uint64_t                        m_frame = 0;
+
+        RenderQuality m_quality = RenderQuality::Medium;
+        Color         m_primaryColor = Color::FromRGB(33, 150, 243);
+        bool          m_isOverlay = false;
+        int           m_width = 0;
+        int           m_height = 0;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,95 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumPlugin.h: Stable C ABI for renderer plugins. Self-contained and
+// plain C on purpose, so a plugin can be built with any compiler and
+// without the rest of the project.
+//
+// A plugin is a DLL that exports SpectrumPluginGetApi. The host calls it
+// once after loading and keeps the returned table for the lifetime of the
+// module. Each frame the plugin's render callback gets the spectrum and a
+// table of drawing callbacks; coordinates are pixels in the plugin's own
+// viewport, origin top-left. Callbacks must not throw or unwind across
+// the boundary.
+//
+// Hot reload: when the DLL on disk changes, the host asks the running
+// instance for its state (saveState), loads the new build, and passes that
+// blob to the new create. The blob is opaque to the host; a plugin that
+// changes its state layout should version the blob itself.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_SPECTRUM_PLUGIN_H
+#define SPECTRUM_CPP_SPECTRUM_PLUGIN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPECTRUM_PLUGIN_ABI_VERSION 1u
+#define SPECTRUM_PLUGIN_ENTRY       "SpectrumPluginGetApi"
+
+#if defined(_WIN32)
+#define SPECTRUM_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define SPECTRUM_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+typedef struct SpColor {
+    float r, g, b, a;
+} SpColor;
+
+typedef struct SpPoint {
+    float x, y;
+} SpPoint;
+
+// Everything the plugin sees of the current frame. Pointers are valid for
+// the duration of the render call only.
+typedef struct SpFrame {
+    const float* bins;          // normalized magnitudes, 0..1
+    uint32_t     binCount;
+    float        width;         // viewport size in pixels
+    float        height;
+    float        deltaTime;     // seconds since the previous render call
+    uint32_t     quality;       // 0 = Low, 1 = Medium, 2 = High, 3 = Ultra
+    uint32_t     overlay;       // nonzero in the transparent overlay window
+    SpColor      primary;       // user-selected accent color
+} SpFrame;
+
+// Drawing callbacks. `context` is the host's and goes back as the first
+// argument of every call.
+typedef struct SpDraw {
+    void* context;
+    void (*fillRect)(void* context, float x, float y, float w, float h, SpColor color);
+    void (*strokeRect)(void* context, float x, float y, float w, float h, float width, SpColor color);
+    void (*fillRoundedRect)(void* context, float x, float y, float w, float h, float radius, SpColor color);
+    void (*fillCircle)(void* context, float cx, float cy, float radius, SpColor color);
+    void (*strokeCircle)(void* context, float cx, float cy, float radius, float width, SpColor color);
+    void (*line)(void* context, float x0, float y0, float x1, float y1, float width, SpColor color);
+    void (*polyline)(void* context, const SpPoint* points, uint32_t count, float width, SpColor color);
+    void (*fillPolygon)(void* context, const SpPoint* points, uint32_t count, SpColor color);
+} SpDraw;
+
+typedef struct SpPluginApi {
+    uint32_t    abiVersion;     // SPECTRUM_PLUGIN_ABI_VERSION
+    uint32_t    structSize;     // sizeof(SpPluginApi) as the plugin saw it
+    const char* name;           // shown in the renderer list
+
+    // `state` is NULL on first load, or the blob saveState produced from
+    // the previous build on hot reload. Returns NULL on failure.
+    void* (*create)(const void* state, uint32_t stateSize);
+    void  (*destroy)(void* instance);
+    void  (*render)(void* instance, const SpFrame* frame, const SpDraw* draw);
+
+    // Optional (may be NULL). Writes up to `capacity` bytes and returns the
+    // size the full state needs; the host calls it once with a NULL buffer
+    // to size it.
+    uint32_t (*saveState)(void* instance, void* buffer, uint32_t capacity);
+} SpPluginApi;
+
+typedef const SpPluginApi* (*SpPluginGetApiFn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPECTRUM_CPP_SPECTRUM_PLUGIN_H
@@ -0,0 +1,198 @@
+#ifndef SPECTRUM_CPP_RENDER_CALIBRATOR_H
+#define SPECTRUM_CPP_RENDER_CALIBRATOR_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// RenderCalibrator - measures every renderer on the live target.
+//
+// One configuration (style, quality, bar count, viewport) per sweep step;
+// each step draws a few untimed frames to settle caches and animation,
+// then times Render plus a Flush of the render target on a synthetic
+// spectrum and keeps the median. The caller owns BeginDraw/EndDraw and
+// calls Step once per app frame, so the window stays responsive and the
+// vsync-paced loop is what the numbers are measured under. The Flush
+// makes D2D do its CPU-side work inside the timed span; GPU raster time
+// is not visible from here.
+// Header-only.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Common.h"
+#include "Graphics/API/GraphicsAPI.h"
+#include "Graphics/IRenderer.h"
+#include "Graphics/RenderCostProfile.h"
+#include "Graphics/RendererManager.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace Spectrum {
+
+    class RenderCalibrator final {
+    public:
+        static constexpr int kWarmupFrames = 2;
+        static constexpr int kMeasuredFrames = 6;
+        static constexpr std::array<size_t, 3> kBarCounts = { 32, 96, 256 };
+        static constexpr std::array<float, 2>  kViewportScales = { 0.5f, 1.0f };
+
+        // Styles are measured in the given order, each on an instance of
+        // its own so the live renderers keep their state.
+        explicit RenderCalibrator(const std::vector<RenderStyle>& styles) {
+            for (RenderStyle style : styles)
+                for (size_t q = 0; q < static_cast<size_t>(RenderQuality::Count); ++q)
+                    for (size_t bars : kBarCounts)
+                        for (float scale : kViewportScales)
+                            m_jobs.push_back({ style, static_cast<RenderQuality>(q), bars, scale });
+
+            m_times.reserve(kMeasuredFrames);
+        }
+
+        ~RenderCalibrator() noexcept { ReleaseRenderer(); }
+
+        RenderCalibrator(const RenderCalibrator&) = delete;
+        RenderCalibrator& operator=(const RenderCalibrator&) = delete;
+
+        // Draws one frame of the sweep into `canvas` (width x height is the
+        // whole target). False once every configuration is measured.
+        bool Step(Canvas& canvas, int width, int height) {
+            if (IsDone() || width <= 0 || height <= 0) return !IsDone();
+
+            const Job& job = m_jobs[m_job];
+            const int vw = std::max(1, static_cast<int>(std::lround(width * job.scale)));
+            const int vh = std::max(1, static_cast<int>(std::lround(height * job.scale)));
+
+            bool clipped = false;
+            try {
+                if (m_frame == 0) BeginJob(job, vw, vh);
+
+                if (m_renderer) {
+                    FillSpectrum(job.bars);
+
+                    canvas.PushClipRect(Rect(0.0f, 0.0f, static_cast<float>(vw), static_cast<float>(vh)));
+                    clipped = true;
+                    const auto start = std::chrono::steady_clock::now();
+
+                    m_renderer->Render(canvas, m_spectrum, FRAME_TIME);
+                    if (auto* rt = canvas.GetRenderTarget()) rt->Flush();
+
+                    const float ms = std::chrono::duration<float, std::milli>(
+                        std::chrono::steady_clock::now() - start).count();
+                    canvas.PopClipRect();
+                    clipped = false;
+
+                    if (m_frame >= kWarmupFrames) m_times.push_back(ms);
+                }
+            }
+            catch (...) {
+                if (clipped) canvas.PopClipRect();
+                LOG_WARNING("RenderCalibrator: Renderer failed, skipping configuration");
+                m_times.clear();
+                m_frame = kWarmupFrames + kMeasuredFrames - 1;
+            }
+
+            DrawProgress(canvas, width, height);
+
+            if (++m_frame >= kWarmupFrames + kMeasuredFrames) EndJob(job, vw, vh);
+            return !IsDone();
+        }
+
+        [[nodiscard]] bool  IsDone()      const noexcept { return m_job >= m_jobs.size(); }
+        [[nodiscard]] float GetProgress() const noexcept {
+            return m_jobs.empty() ? 1.0f : static_cast<float>(m_job) / static_cast<float>(m_jobs.size());
+        }
+
+        [[nodiscard]] const std::vector<CostSample>& GetSamples() const noexcept { return m_samples; }
+        [[nodiscard]] RenderCostProfile BuildProfile() const { return RenderCostProfile::Fit(m_samples); }
+
+    private:
+        struct Job {
+            RenderStyle   style;
+            RenderQuality quality;
+            size_t        bars;
+            float         scale;
+        };
+
+        void BeginJob(const Job& job, int vw, int vh) {
+            if (!m_renderer || m_rendererStyle != job.style) {
+                ReleaseRenderer();
+                m_renderer = RendererManager::CreateRenderer(job.style);
+                m_rendererStyle = job.style;
+                if (m_renderer) m_renderer->OnActivate(vw, vh);
+            }
+            if (!m_renderer) return;
+
+            m_renderer->OnResize(vw, vh);
+            m_renderer->SetQuality(job.quality);
+            m_times.clear();
+        }
+
+        void EndJob(const Job& job, int vw, int vh) {
+            if (!m_times.empty()) {
+                // Median: one frame caught by a context switch or a
+                // compositor hiccup must not move the fit.
+                auto mid = m_times.begin() + m_times.size() / 2;
+                std::nth_element(m_times.begin(), mid, m_times.end());
+                m_samples.push_back({ job.style, job.quality, job.bars, vw, vh, *mid });
+            }
+
+            m_frame = 0;
+            ++m_job;
+            if (IsDone()) {
+                ReleaseRenderer();
+                LOG_INFO("RenderCalibrator: Measured " << m_samples.size() << " configurations");
+            }
+        }
+
+        void ReleaseRenderer() noexcept {
+            if (!m_renderer) return;
+            try { m_renderer->OnDeactivate(); }
+            catch (...) {}
+            m_renderer.reset();
+        }
+
+        // Deterministic and moving: a travelling wave over a falling
+        // slope, so animated renderers see a changing frame every time.
+        void FillSpectrum(size_t bars) {
+            if (m_spectrum.size() != bars) m_spectrum = SpectrumData(bars);
+
+            const float phase = static_cast<float>(m_frame) * 0.7f;
+            const float inv = bars > 1 ? 1.0f / static_cast<float>(bars - 1) : 0.0f;
+            for (size_t i = 0; i < bars; ++i) {
+                const float x = static_cast<float>(i) * inv;
+                const float wave = 0.5f + 0.5f * std::sin(x * 18.0f + phase);
+                m_spectrum[i] = std::clamp((1.0f - 0.6f * x) * (0.35f + 0.6f * wave), 0.0f, 1.0f);
+            }
+        }
+
+        void DrawProgress(Canvas& canvas, int width, int height) const {
+            const float w = static_cast<float>(width);
+            const float y = static_cast<float>(height) - kProgressHeight;
+
+            canvas.DrawRectangle(Rect(0.0f, y, w, kProgressHeight), Paint::Fill(Color(1.0f, 1.0f, 1.0f, 0.15f)));
+            canvas.DrawRectangle(Rect(0.0f, y, w * GetProgress(), kProgressHeight), Paint::Fill(Color(1.0f, 1.0f, 1.0f, 0.8f)));
+
+            const TextStyle style = TextStyle::Default()
+                .WithSize(kLabelSize)
+                .WithAlign(TextAlign::Center)
+                .WithColor(Color(1.0f, 1.0f, 1.0f, 0.8f));
+            canvas.DrawText(L"Calibrating renderers... (C to cancel)",
+                Rect(0.0f, y - kLabelSize * 2.0f, w, kLabelSize * 1.5f), style);
+        }
+
+        static constexpr float kProgressHeight = 4.0f;
+        static constexpr float kLabelSize = 14.0f;
+
+        std::vector<Job>           m_jobs;
+        std::vector<CostSample>    m_samples;
+        std::vector<float>         m_times;
+        std::unique_ptr<IRenderer> m_renderer;
+        RenderStyle                m_rendererStyle = RenderStyle::Count;
+        SpectrumData               m_spectrum;
+        size_t                     m_job = 0;
+        int                        m_frame = 0;
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef SPECTRUM_CPP_RENDER_COST_PROFILE_H
+#define SPECTRUM_CPP_RENDER_COST_PROFILE_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// RenderCostProfile - what each renderer costs on this machine.
+//
+// RenderCalibrator measures every style and quality tier at a few bar
+// counts and viewport sizes; per (style, quality) the samples are fitted
+// to ms = base + perBar * bars + perMegapixel * megapixels. That is coarse
+// but monotonic in both inputs, which is all Recommend needs to pick the
+// best quality, and if necessary the bar count, that fits a frame budget.
+// Header-only.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Common.h"
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Spectrum {
+
+    struct CostSample {
+        RenderStyle   style = RenderStyle::Bars;
+        RenderQuality quality = RenderQuality::Medium;
+        size_t        bars = 0;
+        int           width = 0;
+        int           height = 0;
+        float         ms = 0.0f;
+    };
+
+    struct CostModel {
+        float base = 0.0f;
+        float perBar = 0.0f;
+        float perMegapixel = 0.0f;
+        bool  valid = false;
+
+        [[nodiscard]] static float Megapixels(int width, int height) noexcept {
+            return static_cast<float>(width) * static_cast<float>(height) * 1e-6f;
+        }
+
+        [[nodiscard]] float Predict(size_t bars, int width, int height) const noexcept {
+            return base + perBar * static_cast<float>(bars) + perMegapixel * Megapixels(width, height);
+        }
+    };
+
+    struct CostRecommendation {
+        RenderQuality quality = RenderQuality::Medium;
+        size_t        bars = 0;
+        float         predictedMs = 0.0f;
+    };
+
+    class RenderCostProfile final {
+    public:
+        static constexpr size_t kMinBars = 16;
+        static constexpr int    kFormatVersion = 1;
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Fitting
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        // Least squares per (style, quality). Groups with fewer than three
+        // samples, or whose inputs do not vary enough to separate the
+        // terms, stay invalid.
+        [[nodiscard]] static RenderCostProfile Fit(const std::vector<CostSample>& samples) {
+            RenderCostProfile profile;
+
+            for (size_t s = 0; s < kStyles; ++s) {
+                for (size_t q = 0; q < kQualities; ++q) {
+                    // Normal equations for features (1, bars, megapixels).
+                    double ata[3][3] = {};
+                    double atb[3] = {};
+                    size_t n = 0;
+
+                    for (const auto& smp : samples) {
+                        if (static_cast<size_t>(smp.style) != s || static_cast<size_t>(smp.quality) != q)
+                            continue;
+                        const double x[3] = { 1.0, static_cast<double>(smp.bars),
+                                              CostModel::Megapixels(smp.width, smp.height) };
+                        for (int i = 0; i < 3; ++i) {
+                            for (int j = 0; j < 3; ++j) ata[i][j] += x[i] * x[j];
+                            atb[i] += x[i] * smp.ms;
+                        }
+                        ++n;
+                    }
+
+                    double c[3];
+                    if (n < 3 || !Solve3(ata, atb, c)) continue;
+
+                    // A negative slope is noise, not a renderer getting
+                    // cheaper with more work. Clamping it moves the line,
+                    // so base is refitted as the mean of what the slopes
+                    // leave unexplained; unclamped, that is the fitted base.
+                    const double perBar = std::max(0.0, c[1]);
+                    const double perMegapixel = std::max(0.0, c[2]);
+                    double residual = 0.0;
+                    for (const auto& smp : samples) {
+                        if (static_cast<size_t>(smp.style) != s || static_cast<size_t>(smp.quality) != q)
+                            continue;
+                        residual += smp.ms - perBar * static_cast<double>(smp.bars)
+                            - perMegapixel * CostModel::Megapixels(smp.width, smp.height);
+                    }
+
+                    CostModel& m = profile.m_models[s][q];
+                    m.base = static_cast<float>(residual / static_cast<double>(n));
+                    m.perBar = static_cast<float>(perBar);
+                    m.perMegapixel = static_cast<float>(perMegapixel);
+                    m.valid = std::isfinite(m.base);
+                }
+            }
+            return profile;
+        }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Queries
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        [[nodiscard]] const CostModel& Get(RenderStyle style, RenderQuality quality) const noexcept {
+            static const CostModel kNone;
+            const auto s = static_cast<size_t>(style);
+            const auto q = static_cast<size_t>(quality);
+            return s < kStyles && q < kQualities ? m_models[s][q] : kNone;
+        }
+
+        [[nodiscard]] bool Has(RenderStyle style) const noexcept {
+            for (size_t q = 0; q < kQualities; ++q)
+                if (Get(style, static_cast<RenderQuality>(q)).valid) return true;
+            return false;
+        }
+
+        [[nodiscard]] bool IsEmpty() const noexcept {
+            for (size_t s = 0; s < kStyles; ++s)
+                if (Has(static_cast<RenderStyle>(s))) return false;
+            return true;
+        }
+
+        // Highest quality up to `ceiling` that renders `bars` within
+        // `budgetMs`; tuning only ever trades quality away, never adds it.
+        // When even the lowest tier does not fit, keeps Low and lowers the
+        // bar count (never below kMinBars). Styles without a model keep
+        // `bars` at `ceiling`.
+        [[nodiscard]] CostRecommendation Recommend(RenderStyle style, int width, int height,
+            size_t bars, float budgetMs, RenderQuality ceiling = RenderQuality::Ultra) const noexcept
+        {
+            const size_t top = std::min(static_cast<size_t>(ceiling) + 1, kQualities);
+            for (size_t q = top; q-- > 0;) {
+                const auto quality = static_cast<RenderQuality>(q);
+                const CostModel& m = Get(style, quality);
+                if (!m.valid) continue;
+
+                const float ms = m.Predict(bars, width, height);
+                if (ms <= budgetMs) return { quality, bars, ms };
+            }
+
+            const CostModel& low = Get(style, RenderQuality::Low);
+            if (!low.valid) return { ceiling, bars, 0.0f };
+
+            size_t fit = bars;
+            if (low.perBar > 0.0f) {
+                const float room = budgetMs - low.base
+                    - low.perMegapixel * CostModel::Megapixels(width, height);
+                fit = room > 0.0f ? static_cast<size_t>(room / low.perBar) : 0;
+            }
+            fit = std::clamp(fit, std::min(kMinBars, bars), bars);
+            return { RenderQuality::Low, fit, low.Predict(fit, width, height) };
+        }
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Persistence
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        [[nodiscard]] std::string Serialize() const {
+            std::ostringstream out;
+            out.imbue(std::locale::classic());
+            out << "# SpectrumCpp render cost profile (ms = base + per_bar * bars + per_mpx * megapixels)\n"
+                << "version = " << kFormatVersion << "\n"
+                << "# model = style quality base per_bar per_mpx\n";
+
+            for (size_t s = 0; s < kStyles; ++s)
+                for (size_t q = 0; q < kQualities; ++q) {
+                    const CostModel& m = m_models[s][q];
+                    if (!m.valid) continue;
+                    out << "model = " << s << " " << q << " "
+                        << m.base << " " << m.perBar << " " << m.perMegapixel << "\n";
+                }
+            return out.str();
+        }
+
+        static bool Deserialize(const std::string& text, RenderCostProfile& profile) {
+            RenderCostProfile result;
+            int version = 0;
+
+            std::istringstream in(text);
+            in.imbue(std::locale::classic());
+            std::string line;
+
+            while (std::getline(in, line)) {
+                const size_t eq = line.find('=');
+                if (line.empty() || line[0] == '#' || eq == std::string::npos) continue;
+
+                std::istringstream key(line.substr(0, eq));
+                std::istringstream value(line.substr(eq + 1));
+                key.imbue(std::locale::classic());
+                value.imbue(std::locale::classic());
+
+                std::string name;
+                key >> name;
+
+                if (name == "version") {
+                    value >> version;
+                }
+                else if (name == "model") {
+                    size_t s = 0, q = 0;
+                    CostModel m;
+                    if (!(value >> s >> q >> m.base >> m.perBar >> m.perMegapixel)) continue;
+                    if (s >= kStyles || q >= kQualities) continue;
+                    m.valid = std::isfinite(m.base) && std::isfinite(m.perBar) && std::isfinite(m.perMegapixel);
+                    result.m_models[s][q] = m;
+                }
+            }
+
+            if (version < 1 || version > kFormatVersion) return false;
+            profile = result;
+            return true;
+        }
+
+        bool Load(const std::filesystem::path& path) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) return false;
+
+            std::ostringstream text;
+            text << file.rdbuf();
+            if (!Deserialize(text.str(), *this)) {
+                LOG_WARNING("RenderCostProfile: Unreadable profile " << path.string());
+                return false;
+            }
+            LOG_INFO("RenderCostProfile: Loaded " << path.string());
+            return true;
+        }
+
+        bool Save(const std::filesystem::path& path) const {
+            std::error_code ec;
+            if (path.has_parent_path())
+                std::filesystem::create_directories(path.parent_path(), ec);
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file || !(file << Serialize()).flush()) {
+                LOG_WARNING("RenderCostProfile: Cannot write " << path.string());
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        static constexpr size_t kStyles = static_cast<size_t>(RenderStyle::Count);
+        static constexpr size_t kQualities = static_cast<size_t>(RenderQuality::Count);
+
+        // Gaussian elimination with partial pivoting; false if singular.
+        static bool Solve3(double a[3][3], double b[3], double x[3]) noexcept {
+            for (int col = 0; col < 3; ++col) {
+                int pivot = col;
+                for (int r = col + 1; r < 3; ++r)
+                    if (std::abs(a[r][col]) > std::abs(a[pivot][col])) pivot = r;
+                if (std::abs(a[pivot][col]) < 1e-12) return false;
+
+                if (pivot != col) {
+                    for (int k = 0; k < 3; ++k) std::swap(a[col][k], a[pivot][k]);
+                    std::swap(b[col], b[pivot]);
+                }
+
+                for (int r = col + 1; r < 3; ++r) {
+                    const double f = a[r][col] / a[col][col];
+                    for (int k = col; k < 3; ++k) a[r][k] -= f * a[col][k];
+                    b[r] -= f * b[col];
+                }
+            }
+
+            for (int r = 2; r >= 0; --r) {
+                double sum = b[r];
+                for (int k = r + 1; k < 3; ++k) sum -= a[r][k] * x[k];
+                x[r] = sum / a[r][r];
+            }
+            return true;
+        }
+
+        std::array<std::array<CostModel, kQualities>, kStyles> m_models{};
+    };
+
+} // namespace Spectrum
+
+#endif
@@ -7,9 +7,11 @@
 
 #include "Common/Common.h"
 #include "Graphics/IRenderer.h"
+#include "Graphics/ViewLayout.h"
 #include <map>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 namespace Spectrum {
 
@@ -28,7 +30,11 @@ namespace Spectrum {
         RendererManager(const RendererManager&) = delete;
         RendererManager& operator=(const RendererManager&) = delete;
 
-        [[nodiscard]] bool Initialize();
+        // Builds every renderer and activates `style` at `quality` directly,
+        // so restored settings never cost a second activation.
+        [[nodiscard]] bool Initialize(
+            RenderStyle style = RenderStyle::Bars,
+            RenderQuality quality = RenderQuality::Medium);
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Renderer control
@@ -37,7 +43,25 @@ namespace Spectrum {
         void SetCurrentRenderer(RenderStyle style);
         void SwitchToNextRenderer();
         void CycleQuality(int direction = 1);
+        void SetQuality(RenderQuality quality);
         void OnResize(int w, int h);
+        void SetPrimaryColor(const Color& color);
+        void SetOverlayMode(bool overlay);
+
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+        // Multi-view layout
+        // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+        // Replaces the single current renderer with one view per spec; each
+        // view gets a renderer instance of its own. An empty list returns
+        // to single-renderer mode.
+        bool SetLayout(const std::vector<ViewSpec>& views);
+        void ToggleLayout();
+
+        [[nodiscard]] ViewLayout* GetLayout() const noexcept { return m_layout.get(); }
+
+        [[nodiscard]] static std::unique_ptr<IRenderer> CreateRenderer(RenderStyle style);
+        [[nodiscard]] static std::vector<ViewSpec> ControlRoomLayout();
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // Queries
@@ -49,10 +73,15 @@ namespace Spectrum {
         [[nodiscard]] std::string_view GetCurrentRendererName() const noexcept;
         [[nodiscard]] std::string_view GetQualityName()         const noexcept;
 
+        // False for styles with nothing behind them, e.g. Plugin when no
+        // plugin was found.
+        [[nodiscard]] bool IsAvailable(RenderStyle style) const noexcept;
+
     private:
         bool CreateRenderers();
         bool Activate(RenderStyle style);
         bool GetDimensions(int& w, int& h) const;
+        void InvalidateTarget() const;
 
         // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
         // State
@@ -62,6 +91,9 @@ namespace Spectrum {
         IRenderer* m_current = nullptr;
         RenderStyle               m_style = RenderStyle::Bars;
         RenderQuality             m_quality = RenderQuality::Medium;
+        std::unique_ptr<ViewLayout> m_layout;
+        Color                     m_primaryColor = Color::FromRGB(33, 150, 243);
+        bool                      m_isOverlay = false;
         Platform::WindowManager* m_wm;
     };
 
@@ -87,6 +119,7 @@ namespace Spectrum {
 #include "Graphics/Visualizers/PolylineWaveRenderer.h"
 #include "Graphics/Visualizers/SphereRenderer.h"
 #include "Graphics/Visualizers/WaveRenderer.h"
+#include "Graphics/Plugins/PluginRenderer.h"
 
 namespace Spectrum {
 
@@ -100,6 +133,7 @@ namespace Spectrum {
         if (bus) {
             bus->Subscribe(InputAction::SwitchRenderer, [this] { SwitchToNextRenderer(); });
             bus->Subscribe(InputAction::CycleQuality, [this] { CycleQuality(); });
+            bus->Subscribe(InputAction::ToggleLayout, [this] { ToggleLayout(); });
         }
     }
 
@@ -110,29 +144,42 @@ namespace Spectrum {
         }
     }
 
-    inline bool RendererManager::Initialize() {
+    inline bool RendererManager::Initialize(RenderStyle style, RenderQuality quality) {
         if (!m_wm || !CreateRenderers()) return false;
-        return Activate(RenderStyle::Bars);
+        if (quality < RenderQuality::Count) m_quality = quality;
+        // A saved style can be gone by now (a removed plugin); fall back.
+        return (style < RenderStyle::Count && Activate(style)) || Activate(RenderStyle::Bars);
     }
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Renderer creation
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
+    inline std::unique_ptr<IRenderer> RendererManager::CreateRenderer(RenderStyle style) {
+        switch (style) {
+        case RenderStyle::Bars:         return std::make_unique<BarsRenderer>();
+        case RenderStyle::Wave:         return std::make_unique<WaveRenderer>();
+        case RenderStyle::CircularWave: return std::make_unique<CircularWaveRenderer>();
+        case RenderStyle::Cubes:        return std::make_unique<CubesRenderer>();
+        case RenderStyle::Fire:         return std::make_unique<FireRenderer>();
+        case RenderStyle::LedPanel:     return std::make_unique<LedPanelRenderer>();
+        case RenderStyle::Gauge:        return std::make_unique<GaugeRenderer>();
+        case RenderStyle::KenwoodBars:  return std::make_unique<KenwoodBarsRenderer>();
+        case RenderStyle::Particles:    return std::make_unique<ParticlesRenderer>();
+        case RenderStyle::MatrixLed:    return std::make_unique<MatrixLedRenderer>();
+        case RenderStyle::Sphere:       return std::make_unique<SphereRenderer>();
+        case RenderStyle::PolylineWave: return std::make_unique<PolylineWaveRenderer>();
+        case RenderStyle::Plugin:       return PluginRenderer::LoadFirst(PluginRenderer::DefaultDirectory());
+        default:                        return nullptr;
+        }
+    }
+
     inline bool RendererManager::CreateRenderers() {
         try {
-            m_renderers[RenderStyle::Bars] = std::make_unique<BarsRenderer>();
-            m_renderers[RenderStyle::Wave] = std::make_unique<WaveRenderer>();
-            m_renderers[RenderStyle::CircularWave] = std::make_unique<CircularWaveRenderer>();
-            m_renderers[RenderStyle::Cubes] = std::make_unique<CubesRenderer>();
-            m_renderers[RenderStyle::Fire] = std::make_unique<FireRenderer>();
-            m_renderers[RenderStyle::LedPanel] = std::make_unique<LedPanelRenderer>();
-            m_renderers[RenderStyle::Gauge] = std::make_unique<GaugeRenderer>();
-            m_renderers[RenderStyle::KenwoodBars] = std::make_unique<KenwoodBarsRenderer>();
-            m_renderers[RenderStyle::Particles] = std::make_unique<ParticlesRenderer>();
-            m_renderers[RenderStyle::MatrixLed] = std::make_unique<MatrixLedRenderer>();
-            m_renderers[RenderStyle::Sphere] = std::make_unique<SphereRenderer>();
-            m_renderers[RenderStyle::PolylineWave] = std::make_unique<PolylineWaveRenderer>();
+            for (int i = 0; i < static_cast<int>(RenderStyle::Count); ++i) {
+                const auto style = static_cast<RenderStyle>(i);
+                m_renderers[style] = CreateRenderer(style);
+            }
             return true;
         }
         catch (...) {
@@ -188,11 +235,21 @@ namespace Spectrum {
     }
 
     inline void RendererManager::SwitchToNextRenderer() {
-        SetCurrentRenderer(Helpers::Utils::CycleEnum(m_style, 1));
+        RenderStyle next = m_style;
+        for (int i = 0; i < static_cast<int>(RenderStyle::Count); ++i) {
+            next = Helpers::Utils::CycleEnum(next, 1);
+            if (IsAvailable(next)) break;
+        }
+        SetCurrentRenderer(next);
     }
 
     inline void RendererManager::CycleQuality(int direction) {
-        m_quality = Helpers::Utils::CycleEnum(m_quality, direction);
+        SetQuality(Helpers::Utils::CycleEnum(m_quality, direction));
+    }
+
+    inline void RendererManager::SetQuality(RenderQuality quality) {
+        if (quality >= RenderQuality::Count) return;
+        m_quality = quality;
 
         for (auto& [_, r] : m_renderers)
             if (r) try { r->SetQuality(m_quality); }
@@ -200,14 +257,85 @@ namespace Spectrum {
     }
 
     inline void RendererManager::OnResize(int w, int h) {
-        if (!m_current || w <= 0 || h <= 0) return;
+        if (w <= 0 || h <= 0) return;
         try {
+            if (m_layout) m_layout->OnResize(w, h);
+            if (!m_current) return;
             m_current->OnResize(w, h);
             m_current->SetQuality(m_quality);
         }
         catch (...) {}
     }
 
+    inline void RendererManager::SetPrimaryColor(const Color& color) {
+        m_primaryColor = color;
+        if (m_current) m_current->SetPrimaryColor(color);
+        if (m_layout) m_layout->SetPrimaryColor(color);
+    }
+
+    inline void RendererManager::SetOverlayMode(bool overlay) {
+        m_isOverlay = overlay;
+        if (m_current) m_current->SetOverlayMode(overlay);
+        if (m_layout) m_layout->SetOverlayMode(overlay);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Multi-view layout
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    inline bool RendererManager::SetLayout(const std::vector<ViewSpec>& views) {
+        // Views that stop redrawing leave their pixels behind, so any change
+        // of layout repaints the whole target once.
+        InvalidateTarget();
+
+        if (views.empty()) {
+            m_layout.reset();
+            return true;
+        }
+
+        int w = 0, h = 0;
+        if (!GetDimensions(w, h)) return false;
+
+        try {
+            auto layout = std::make_unique<ViewLayout>();
+            for (const auto& spec : views) {
+                auto r = CreateRenderer(spec.style);
+                if (!r) continue;
+                r->SetPrimaryColor(m_primaryColor);
+                r->SetOverlayMode(m_isOverlay);
+                layout->AddView(spec, std::move(r));
+            }
+            if (layout->IsEmpty()) return false;
+
+            layout->OnResize(w, h);
+            m_layout = std::move(layout);
+            return true;
+        }
+        catch (...) {
+            LOG_ERROR("RendererManager: Failed to build layout");
+            return false;
+        }
+    }
+
+    inline void RendererManager::ToggleLayout() {
+        SetLayout(m_layout ? std::vector<ViewSpec>{} : ControlRoomLayout());
+    }
+
+    // Full-rate bars on the left; the gauge and the expensive fire view
+    // share the right column at half rate.
+    inline std::vector<ViewSpec> RendererManager::ControlRoomLayout() {
+        return {
+            { RenderStyle::Bars,  { 0.00f, 0.0f, 0.60f, 1.0f }, RenderQuality::High,   0.0f,  4.0f },
+            { RenderStyle::Gauge, { 0.60f, 0.0f, 0.40f, 0.5f }, RenderQuality::Medium, 30.0f, 2.0f },
+            { RenderStyle::Fire,  { 0.60f, 0.5f, 0.40f, 0.5f }, RenderQuality::Low,    30.0f, 4.0f }
+        };
+    }
+
+    inline void RendererManager::InvalidateTarget() const {
+        if (auto* e = m_wm ? m_wm->GetVisualizationEngine() : nullptr)
+            e->InvalidateAll();
+    }
+
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
     // Name queries
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
@@ -218,6 +346,11 @@ namespace Spectrum {
         catch (...) { return "Error"; }
     }
 
+    inline bool RendererManager::IsAvailable(RenderStyle style) const noexcept {
+        const auto it = m_renderers.find(style);
+        return it != m_renderers.end() && it->second != nullptr;
+    }
+
     inline std::string_view RendererManager::GetQualityName() const noexcept {
         constexpr const char* k[] = { "Low", "Medium", "High", "Ultra" };
         const auto i = static_cast<size_t>(m_quality);
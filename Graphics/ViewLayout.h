@@ -0,0 +1,192 @@
+#ifndef SPECTRUM_CPP_VIEW_LAYOUT_H
+#define SPECTRUM_CPP_VIEW_LAYOUT_H
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+// ViewLayout - several visualizers side by side in one frame, all fed the
+// same spectrum. Each view owns its renderer instance, quality tier and
+// update rate. A view that is not due keeps last frame's pixels, which
+// relies on a target that retains its contents; the caller passes
+// redrawAll whenever it does not, and every view draws.
+// Header-only.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "Common/Common.h"
+#include "Graphics/API/GraphicsAPI.h"
+#include "Graphics/IRenderer.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Spectrum {
+
+    struct ViewSpec {
+        RenderStyle   style = RenderStyle::Bars;
+        Rect          area{ 0.0f, 0.0f, 1.0f, 1.0f };   // fraction of the window
+        RenderQuality quality = RenderQuality::Medium;
+        float         updateHz = 0.0f;                   // 0 = every frame
+        float         budgetMs = 0.0f;                   // 0 = not tracked
+    };
+
+    // Per-view cost of Render as seen by the CPU; D2D defers most GPU work
+    // to EndDraw, so this is submission cost, not raster time.
+    struct ViewStats {
+        float    lastMs = 0.0f;
+        float    averageMs = 0.0f;
+        uint64_t updates = 0;
+        uint64_t skipped = 0;
+        uint64_t overBudget = 0;
+    };
+
+    class ViewLayout final {
+    public:
+        static constexpr float kGap = 4.0f;
+        static constexpr float kAverageWeight = 0.1f;
+
+        struct View {
+            ViewSpec                   spec;
+            std::unique_ptr<IRenderer> renderer;
+            Rect                       bounds;
+            ViewStats                  stats;
+            float                      sinceUpdate = 0.0f;
+            bool                       due = true;
+            bool                       drewThisFrame = false;
+        };
+
+        void AddView(const ViewSpec& spec, std::unique_ptr<IRenderer> renderer) {
+            if (!renderer) return;
+            renderer->SetQuality(spec.quality);
+
+            View view;
+            view.spec = spec;
+            view.renderer = std::move(renderer);
+            m_views.push_back(std::move(view));
+        }
+
+        void OnResize(int width, int height) {
+            for (auto& v : m_views) {
+                const Rect& a = v.spec.area;
+                const float x = std::floor(a.x * width);
+                const float y = std::floor(a.y * height);
+                const float right = std::floor(a.GetRight() * width);
+                const float bottom = std::floor(a.GetBottom() * height);
+
+                // Interior edges give up half the gap each; window edges none.
+                const float left = x + (a.x > 0.0f ? kGap * 0.5f : 0.0f);
+                const float top = y + (a.y > 0.0f ? kGap * 0.5f : 0.0f);
+                const float r = right - (a.GetRight() < 1.0f ? kGap * 0.5f : 0.0f);
+                const float b = bottom - (a.GetBottom() < 1.0f ? kGap * 0.5f : 0.0f);
+
+                v.bounds = { left, top, std::max(0.0f, r - left), std::max(0.0f, b - top) };
+                v.renderer->OnResize(static_cast<int>(v.bounds.width), static_cast<int>(v.bounds.height));
+                v.renderer->SetQuality(v.spec.quality);
+                v.due = true;
+            }
+        }
+
+        void SetPrimaryColor(const Color& color) {
+            for (auto& v : m_views) {
+                v.renderer->SetPrimaryColor(color);
+                v.due = true;
+            }
+        }
+
+        void SetOverlayMode(bool overlay) {
+            for (auto& v : m_views) {
+                v.renderer->SetOverlayMode(overlay);
+                v.due = true;
+            }
+        }
+
+        // Views under `area` draw on the next frame, e.g. to restore what
+        // a hover highlight covered.
+        void InvalidateArea(const Rect& area) noexcept {
+            for (auto& v : m_views)
+                if (Overlaps(v.bounds, area)) v.due = true;
+        }
+
+        // Draws every view that is due. `dt` is the frame step the caller
+        // ticks at; a view's rate can only divide it, never exceed it. Each
+        // renderer is handed the time since its view last drew, so a view
+        // throttled to 30 Hz animates at the same speed as one at 60.
+        void Render(Canvas& canvas, const SpectrumData& spectrum, float dt,
+            bool redrawAll, const Color& background)
+        {
+            m_redrewAll = redrawAll;
+
+            for (auto& v : m_views) {
+                v.drewThisFrame = false;
+                v.sinceUpdate += dt;
+
+                const float period = v.spec.updateHz > 0.0f ? 1.0f / v.spec.updateHz : 0.0f;
+                if (!redrawAll && !v.due && v.sinceUpdate + dt * 0.5f < period) {
+                    ++v.stats.skipped;
+                    continue;
+                }
+                if (v.bounds.width < 1.0f || v.bounds.height < 1.0f) continue;
+
+                const auto start = std::chrono::steady_clock::now();
+
+                canvas.PushClipRect(v.bounds);
+                if (!redrawAll)
+                    canvas.DrawRectangle(v.bounds, Paint::Fill(background));
+
+                canvas.PushTransform();
+                canvas.TranslateBy(v.bounds.x, v.bounds.y);
+                v.renderer->Render(canvas, spectrum, v.sinceUpdate);
+                canvas.PopTransform();
+                canvas.PopClipRect();
+
+                const float ms = std::chrono::duration<float, std::milli>(
+                    std::chrono::steady_clock::now() - start).count();
+                Account(v, ms);
+
+                // Keep the phase instead of restarting it, so 30 Hz on a
+                // 60 Hz loop stays every other frame rather than drifting.
+                v.sinceUpdate = period > 0.0f && v.sinceUpdate < 2.0f * period
+                    ? std::max(0.0f, v.sinceUpdate - period)
+                    : 0.0f;
+                v.due = false;
+                v.drewThisFrame = true;
+            }
+        }
+
+        // True when `area` was repainted this frame, so anything drawn on
+        // top lands on fresh pixels instead of blending over itself.
+        [[nodiscard]] bool WasRedrawn(const Rect& area) const noexcept {
+            if (m_redrewAll) return true;
+            for (const auto& v : m_views)
+                if (v.drewThisFrame && Overlaps(v.bounds, area)) return true;
+            return false;
+        }
+
+        [[nodiscard]] const std::vector<View>& GetViews() const noexcept { return m_views; }
+        [[nodiscard]] bool IsEmpty() const noexcept { return m_views.empty(); }
+
+    private:
+        static void Account(View& v, float ms) noexcept {
+            ViewStats& s = v.stats;
+            s.lastMs = ms;
+            s.averageMs = s.updates == 0
+                ? ms
+                : s.averageMs + (ms - s.averageMs) * kAverageWeight;
+            ++s.updates;
+
+            if (v.spec.budgetMs > 0.0f && ms > v.spec.budgetMs) {
+                if (s.overBudget++ == 0)
+                    LOG_WARNING("ViewLayout: " << v.renderer->GetName()
+                        << " over budget (" << ms << " ms > " << v.spec.budgetMs << " ms)");
+            }
+        }
+
+        [[nodiscard]] static bool Overlaps(const Rect& a, const Rect& b) noexcept {
+            return a.x < b.GetRight() && b.x < a.GetRight()
+                && a.y < b.GetBottom() && b.y < a.GetBottom();
+        }
+
+        std::vector<View> m_views;
+        bool              m_redrewAll = true;
+    };
+
+} // namespace Spectrum
+
+#endif
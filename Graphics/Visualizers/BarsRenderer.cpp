@@ -26,7 +26,7 @@ namespace Spectrum {
 
         if (layout.barWidth <= 0.0f) return;
 
-        const auto bars = CollectVisibleBars(spectrum, layout);
+        const auto bars = CollectVisibleBars(canvas, spectrum, layout);
         if (bars.empty()) return;
 
         if (m_settings.useShadow) {
@@ -40,12 +40,12 @@ namespace Spectrum {
         }
     }
 
-    std::vector<BarsRenderer::BarData> BarsRenderer::CollectVisibleBars(
+    BarsRenderer::BarList BarsRenderer::CollectVisibleBars(
+        Canvas& canvas,
         const SpectrumData& spectrum,
         const BarLayout& layout
     ) const {
-        std::vector<BarData> bars;
-        bars.reserve(spectrum.size());
+        auto bars = MakeFrameVector<BarData>(canvas, spectrum.size());
 
         for (size_t i = 0; i < spectrum.size(); ++i) {
             const float magnitude = NormalizedFloat(spectrum[i]);
@@ -70,9 +70,9 @@ namespace Spectrum {
 
     void BarsRenderer::RenderBarShadows(
         Canvas& canvas,
-        const std::vector<BarData>& bars
+        const BarList& bars
     ) const {
-        RectBatch shadowBatches;
+        RectBatch shadowBatches(canvas.GetFrameArena(), bars.size());
         const Color shadowColor = AdjustAlpha(
             Color::Black(),
             kShadowAlpha
@@ -83,7 +83,7 @@ namespace Spectrum {
             shadowRect.x += kShadowOffsetX;
             shadowRect.y += kShadowOffsetY;
 
-            shadowBatches[shadowColor].push_back(shadowRect);
+            shadowBatches.Add(shadowColor, shadowRect);
         }
 
         RenderRectBatches(
@@ -96,12 +96,12 @@ namespace Spectrum {
 
     void BarsRenderer::RenderBarBodies(
         Canvas& canvas,
-        const std::vector<BarData>& bars
+        const BarList& bars
     ) const {
-        RectBatch barBatches;
+        RectBatch barBatches(canvas.GetFrameArena(), bars.size());
 
         for (const auto& bar : bars) {
-            barBatches[bar.color].push_back(bar.rect);
+            barBatches.Add(bar.color, bar.rect);
         }
 
         RenderRectBatches(
@@ -114,7 +114,7 @@ namespace Spectrum {
 
     void BarsRenderer::RenderBarHighlights(
         Canvas& canvas,
-        const std::vector<BarData>& bars
+        const BarList& bars
     ) const {
         for (const auto& bar : bars) {
             const Rect highlightRect = CalculateHighlightRect(bar.rect);
@@ -140,7 +140,7 @@ namespace Spectrum {
         const float brightness = kBrightnessMin +
             kBrightnessRange * magnitude;
 
-        return AdjustBrightness(GetPrimaryColor(), brightness);
+        return GetPalette().Brightened(brightness);
     }
 
     Rect BarsRenderer::CalculateHighlightRect(
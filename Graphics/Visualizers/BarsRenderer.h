@@ -3,7 +3,6 @@
 
 #include "Graphics/Base/BaseRenderer.h"
 #include "Graphics/Visualizers/Settings/QualityTraits.h"
-#include <vector>
 
 namespace Spectrum {
 
@@ -23,6 +22,11 @@ namespace Spectrum {
             return "Bars";
         }
 
+        // Draws the spectrum as-is, with no state of its own.
+        [[nodiscard]] bool IsAnimating() const override {
+            return false;
+        }
+
     protected:
         void UpdateSettings() override;
 
@@ -50,24 +54,27 @@ namespace Spectrum {
             Color color;
         };
 
-        [[nodiscard]] std::vector<BarData> CollectVisibleBars(
+        using BarList = ArenaVector<BarData>;
+
+        [[nodiscard]] BarList CollectVisibleBars(
+            Canvas& canvas,
             const SpectrumData& spectrum,
             const BarLayout& layout
         ) const;
 
         void RenderBarShadows(
             Canvas& canvas,
-            const std::vector<BarData>& bars
+            const BarList& bars
         ) const;
 
         void RenderBarBodies(
             Canvas& canvas,
-            const std::vector<BarData>& bars
+            const BarList& bars
         ) const;
 
         void RenderBarHighlights(
             Canvas& canvas,
-            const std::vector<BarData>& bars
+            const BarList& bars
         ) const;
 
         void DrawRoundedTopBar(
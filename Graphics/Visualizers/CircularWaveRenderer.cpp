@@ -42,6 +42,7 @@ namespace Spectrum {
         if (m_angle > TWO_PI) m_angle -= TWO_PI;
 
         m_waveTime += m_settings.waveSpeed * deltaTime;
+        if (m_waveTime > TWO_PI) m_waveTime -= TWO_PI;
     }
 
     void CircularWaveRenderer::DoRender(
@@ -55,15 +56,23 @@ namespace Spectrum {
             m_settings.maxRings
         );
 
+        // Rotation only shows through visible rings.
+        m_isAnimating = false;
         if (ringCount == 0) return;
 
         const float ringStep = (maxRadius - kCenterRadius) / ringCount;
 
+        // One sin/cos per frame; each ring's own offset is a rotation of it.
+        m_ringPhases.Ensure(static_cast<size_t>(ringCount), 0.0f, kWavePhaseOffset);
+        const Rotor wavePhase = Rotor::FromAngle(m_waveTime + m_angle);
+
         for (int i = ringCount - 1; i >= 0; --i) {
             const float magnitude = GetRingMagnitude(spectrum, i, ringCount);
             if (magnitude < kMinMagnitudeThreshold) continue;
 
-            const float radius = CalculateRingRadius(i, ringStep, magnitude);
+            m_isAnimating = true;
+
+            const float radius = CalculateRingRadius(i, ringStep, magnitude, wavePhase);
             if (radius <= 0.0f || radius > maxRadius) continue;
 
             const float distanceFactor = 1.0f - radius / maxRadius;
@@ -77,7 +86,7 @@ namespace Spectrum {
                 magnitude * kAlphaMultiplier * distanceFactor
             );
 
-            const Color ringColor = AdjustAlpha(GetPrimaryColor(), alpha);
+            const Color& ringColor = GetPalette().WithAlpha(alpha);
 
             if (m_settings.useGlow && magnitude > kGlowThreshold) {
                 const Color glowColor = AdjustAlpha(
@@ -110,12 +119,12 @@ namespace Spectrum {
     float CircularWaveRenderer::CalculateRingRadius(
         int index,
         float ringStep,
-        float magnitude
+        float magnitude,
+        const Rotor& wavePhase
     ) const {
         const float baseRadius = kCenterRadius + index * ringStep;
-        const float waveOffset = std::sin(
-            m_waveTime + index * kWavePhaseOffset + m_angle
-        ) * magnitude * ringStep * kWaveInfluence;
+        const float waveOffset = m_ringPhases.Sin(static_cast<size_t>(index), wavePhase)
+            * magnitude * ringStep * kWaveInfluence;
 
         return baseRadius + waveOffset;
     }
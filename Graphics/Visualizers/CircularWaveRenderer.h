@@ -2,6 +2,7 @@
 #define SPECTRUM_CPP_CIRCULAR_WAVE_RENDERER_H
 
 #include "Graphics/Base/BaseRenderer.h"
+#include "Common/TrigTable.h"
 #include "Graphics/Visualizers/Settings/QualityTraits.h"
 
 namespace Spectrum {
@@ -22,6 +23,10 @@ namespace Spectrum {
             return "Circular Wave";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_isAnimating;
+        }
+
     protected:
         void UpdateSettings() override;
 
@@ -38,7 +43,8 @@ namespace Spectrum {
         [[nodiscard]] float CalculateRingRadius(
             int index,
             float ringStep,
-            float magnitude
+            float magnitude,
+            const Rotor& wavePhase
         ) const;
 
         [[nodiscard]] static float GetRingMagnitude(
@@ -48,8 +54,10 @@ namespace Spectrum {
         );
 
         Settings m_settings;
+        TrigTable m_ringPhases;
         float m_angle;
         float m_waveTime;
+        bool m_isAnimating = true;
     };
 
 } // namespace Spectrum
@@ -1,11 +1,20 @@
 #include "Graphics/Visualizers/CubesRenderer.h"
 #include "Graphics/API/GraphicsHelpers.h"
-#include "Graphics/Base/RenderUtils.h"
+#include <algorithm>
+#include <array>
 
 namespace Spectrum {
 
-    using namespace Helpers::Sanitize;
-    using namespace Helpers::Geometry;
+    namespace {
+
+        // Corners of each face kind within a cube's vertices, clockwise.
+        constexpr std::array<std::array<uint32_t, 4>, 3> kFaceQuads = { {
+            { 1, 5, 6, 2 },     // Side
+            { 0, 1, 5, 4 },     // Top
+            { 0, 1, 2, 3 }      // Front
+        } };
+
+    } // namespace
 
     CubesRenderer::CubesRenderer() {
         UpdateSettings();
@@ -22,182 +31,161 @@ namespace Spectrum {
         const auto layout = CalculateBarLayout(spectrum.size(), kSpacing);
         if (layout.barWidth <= 0.0f) return;
 
-        const auto cubes = CollectVisibleCubes(spectrum, layout);
-        if (cubes.empty()) return;
-
-        if (m_settings.useShadow) {
-            RenderCubeShadows(canvas, cubes);
-        }
-
-        if (m_settings.useSideFace) {
-            RenderCubeSides(canvas, cubes);
-        }
-
-        if (m_settings.useTopFace) {
-            RenderCubeTops(canvas, cubes);
-        }
+        const auto mesh = BuildMesh(canvas.GetFrameArena(), spectrum, layout);
+        if (mesh.indices.empty()) return;
 
-        RenderCubeFronts(canvas, cubes);
+        RenderMesh(canvas, mesh);
     }
 
-    std::vector<CubesRenderer::CubeData> CubesRenderer::CollectVisibleCubes(
+    // Three passes: heights and opacity buckets for every bar in one
+    // branch-free loop over the padded spectrum, a counting sort of the
+    // visible cubes by bucket, then vertex and index emission. Sorting
+    // first makes every (face, bucket) pair a contiguous index range, i.e.
+    // a single draw.
+    CubesRenderer::CubeMesh CubesRenderer::BuildMesh(
+        FrameArena& arena,
         const SpectrumData& spectrum,
         const BarLayout& layout
     ) const {
-        std::vector<CubeData> cubes;
-        cubes.reserve(spectrum.size());
+        const size_t count = spectrum.size();
+        const size_t padded = spectrum.PaddedSize();
+        const float viewWidth = static_cast<float>(GetWidth());
+        const float viewHeight = static_cast<float>(GetHeight());
+        const float maxHeight = viewHeight * kHeightScale;
+        const float bucketScale = static_cast<float>(kAlphaBuckets - 1);
+
+        // Bars below kMinMagnitude land in bucket kAlphaBuckets, which is
+        // never drawn. max(0, x) is written so that NaN comes out as 0.
+        auto tops = MakeArenaVector<float>(arena);
+        auto buckets = MakeArenaVector<uint32_t>(arena);
+        tops.resize(padded);
+        buckets.resize(padded);
+
+        const float* magnitudes = spectrum.data();
+        for (size_t i = 0; i < padded; ++i) {
+            const float m = std::min(1.0f, std::max(0.0f, magnitudes[i]));
+            tops[i] = viewHeight - m * maxHeight;
+
+            // Hidden bars are moved to the last bucket by arithmetic.
+            const auto level = static_cast<int32_t>(m * bucketScale + 0.5f);
+            const auto hidden = static_cast<int32_t>(m < kMinMagnitude);
+            buckets[i] = static_cast<uint32_t>(level + hidden * (static_cast<int32_t>(kAlphaBuckets) - level));
+        }
 
-        for (size_t i = 0; i < spectrum.size(); ++i) {
-            const float magnitude = NormalizedFloat(spectrum[i]);
+        std::array<uint32_t, kAlphaBuckets + 1> bucketStart{};
+        for (size_t i = 0; i < count; ++i)
+            if (buckets[i] < kAlphaBuckets) ++bucketStart[buckets[i] + 1];
+        for (size_t b = 1; b <= kAlphaBuckets; ++b)
+            bucketStart[b] += bucketStart[b - 1];
 
-            if (magnitude >= kMinMagnitude) {
-                cubes.push_back(CreateCubeData(i, magnitude, layout));
-            }
+        const uint32_t visible = bucketStart[kAlphaBuckets];
+
+        auto order = MakeArenaVector<uint32_t>(arena);
+        order.resize(visible);
+        auto cursor = bucketStart;
+        for (size_t i = 0; i < count; ++i)
+            if (buckets[i] < kAlphaBuckets) order[cursor[buckets[i]]++] = static_cast<uint32_t>(i);
+
+        CubeMesh mesh{
+            MakeArenaVector<Point>(arena),
+            MakeArenaVector<uint32_t>(arena),
+            MakeArenaVector<MeshRun>(arena)
+        };
+        if (visible == 0) return mesh;
+
+        const float depthX = layout.barWidth * m_settings.perspective;
+        const float depthY = layout.barWidth * m_settings.topHeightRatio;
+
+        mesh.vertices.resize(static_cast<size_t>(visible) * kVerticesPerCube);
+        for (uint32_t k = 0; k < visible; ++k) {
+            const float left = order[k] * layout.totalBarWidth + layout.spacing * 0.5f;
+            const float right = left + layout.barWidth;
+            const float top = tops[order[k]];
+
+            Point* v = &mesh.vertices[static_cast<size_t>(k) * kVerticesPerCube];
+            v[0] = { left, top };
+            v[1] = { right, top };
+            v[2] = { right, viewHeight };
+            v[3] = { left, viewHeight };
+            v[4] = { left + depthX, top - depthY };
+            v[5] = { right + depthX, top - depthY };
+            v[6] = { right + depthX, viewHeight - depthY };
         }
 
-        return cubes;
-    }
+        // Culled: faces the quality tier turns off, faces thinner than a
+        // pixel, and side faces that start past the right edge.
+        const bool drawSides = m_settings.useSideFace && depthX >= kMinFaceExtent;
+        const bool drawTops = m_settings.useTopFace && depthY >= kMinFaceExtent;
 
-    void CubesRenderer::RenderCubeShadows(
-        Canvas& canvas,
-        const std::vector<CubeData>& cubes
-    ) const {
-        const Color shadowColor = AdjustAlpha(
-            Color::Black(),
-            kShadowAlpha
-        );
-        const Paint shadowPaint = Paint::Fill(shadowColor);
-
-        for (const auto& cube : cubes) {
-            Rect shadowRect = cube.frontFace;
-            shadowRect.x += kShadowOffsetX;
-            shadowRect.y += kShadowOffsetY;
-
-            canvas.DrawRectangle(shadowRect, shadowPaint);
-
-            if (m_settings.useSideFace) {
-                auto sidePoints = GetSideFacePoints(cube);
-                for (auto& point : sidePoints) {
-                    point.x += kShadowOffsetX;
-                    point.y += kShadowOffsetY;
-                }
-                canvas.DrawPolygon(sidePoints, shadowPaint);
-            }
+        mesh.indices.reserve(static_cast<size_t>(visible) * kIndicesPerFace * static_cast<size_t>(Face::Count));
+        mesh.runs.reserve(kAlphaBuckets * static_cast<size_t>(Face::Count));
+
+        for (size_t f = 0; f < static_cast<size_t>(Face::Count); ++f) {
+            const auto face = static_cast<Face>(f);
+            if ((face == Face::Side && !drawSides) || (face == Face::Top && !drawTops)) continue;
+
+            const auto& quad = kFaceQuads[f];
+            for (size_t b = 0; b < kAlphaBuckets; ++b) {
+                const auto first = static_cast<uint32_t>(mesh.indices.size());
 
-            if (m_settings.useTopFace) {
-                auto topPoints = GetTopFacePoints(cube);
-                for (auto& point : topPoints) {
-                    point.x += kShadowOffsetX;
-                    point.y += kShadowOffsetY;
+                for (uint32_t k = bucketStart[b]; k < bucketStart[b + 1]; ++k) {
+                    const uint32_t base = k * kVerticesPerCube;
+                    if (face == Face::Side && mesh.vertices[base + 1].x >= viewWidth) continue;
+
+                    mesh.indices.insert(mesh.indices.end(), {
+                        base + quad[0], base + quad[1], base + quad[2],
+                        base + quad[0], base + quad[2], base + quad[3]
+                        });
                 }
-                canvas.DrawPolygon(topPoints, shadowPaint);
+
+                const auto added = static_cast<uint32_t>(mesh.indices.size()) - first;
+                if (added > 0) mesh.runs.push_back({ FaceColor(face, b), first, added });
             }
         }
+
+        return mesh;
     }
 
-    void CubesRenderer::RenderCubeSides(
+    void CubesRenderer::RenderMesh(
         Canvas& canvas,
-        const std::vector<CubeData>& cubes
+        const CubeMesh& mesh
     ) const {
-        for (const auto& cube : cubes) {
-            canvas.DrawPolygon(
-                GetSideFacePoints(cube),
-                Paint::Fill(cube.sideColor)
+        // One silhouette of every drawn face, offset beneath the cubes.
+        if (m_settings.useShadow) {
+            canvas.PushTransform();
+            canvas.TranslateBy(kShadowOffsetX, kShadowOffsetY);
+            canvas.DrawMesh(
+                mesh.vertices,
+                mesh.indices,
+                Paint::Fill(AdjustAlpha(Color::Black(), kShadowAlpha))
             );
+            canvas.PopTransform();
         }
-    }
 
-    void CubesRenderer::RenderCubeTops(
-        Canvas& canvas,
-        const std::vector<CubeData>& cubes
-    ) const {
-        for (const auto& cube : cubes) {
-            canvas.DrawPolygon(
-                GetTopFacePoints(cube),
-                Paint::Fill(cube.topColor)
+        for (const auto& run : mesh.runs) {
+            canvas.DrawMesh(
+                mesh.vertices,
+                Span<const uint32_t>(mesh.indices.data() + run.first, run.count),
+                Paint::Fill(run.color)
             );
         }
     }
 
-    void CubesRenderer::RenderCubeFronts(
-        Canvas& canvas,
-        const std::vector<CubeData>& cubes
+    Color CubesRenderer::FaceColor(
+        Face face,
+        size_t bucket
     ) const {
-        RectBatch frontBatches;
-
-        for (const auto& cube : cubes) {
-            frontBatches[cube.baseColor].push_back(cube.frontFace);
+        const float alpha = kAlphaBase + kAlphaRange
+            * static_cast<float>(bucket) / static_cast<float>(kAlphaBuckets - 1);
+
+        switch (face) {
+        case Face::Side:
+            return GetPalette().Brightened(m_settings.sideFaceBrightness).WithAlpha(alpha);
+        case Face::Top:
+            return GetPalette().Brightened(kTopBrightness).WithAlpha(alpha);
+        default:
+            return GetPalette().WithAlpha(alpha);
         }
-
-        for (const auto& [color, rects] : frontBatches) {
-            if (!rects.empty()) {
-                canvas.DrawRectangleBatch(rects, Paint::Fill(color));
-            }
-        }
-    }
-
-    CubesRenderer::CubeData CubesRenderer::CreateCubeData(
-        size_t index,
-        float magnitude,
-        const BarLayout& layout
-    ) const {
-        const float height = RenderUtils::MagnitudeToHeight(
-            magnitude,
-            GetHeight(),
-            kHeightScale
-        );
-
-        CubeData cube;
-        cube.frontFace = GetBarRect(layout, index, height);
-        cube.topHeight = layout.barWidth * m_settings.topHeightRatio;
-        cube.sideWidth = layout.barWidth * m_settings.perspective;
-        cube.magnitude = magnitude;
-        cube.baseColor = CalculateBaseColor(magnitude);
-        cube.sideColor = AdjustBrightness(
-            cube.baseColor,
-            m_settings.sideFaceBrightness
-        );
-        cube.topColor = AdjustBrightness(
-            cube.baseColor,
-            kTopBrightness
-        );
-
-        return cube;
-    }
-
-    std::vector<Point> CubesRenderer::GetSideFacePoints(
-        const CubeData& cube
-    ) const {
-        const Point topRight = GetTopRight(cube.frontFace);
-        const Point bottomRight = GetBottomRight(cube.frontFace);
-
-        return {
-            topRight,
-            Add(topRight, {cube.sideWidth, -cube.topHeight}),
-            Add(bottomRight, {cube.sideWidth, -cube.topHeight}),
-            bottomRight
-        };
-    }
-
-    std::vector<Point> CubesRenderer::GetTopFacePoints(
-        const CubeData& cube
-    ) const {
-        const Point topLeft = GetTopLeft(cube.frontFace);
-        const Point topRight = GetTopRight(cube.frontFace);
-
-        return {
-            topLeft,
-            topRight,
-            Add(topRight, {cube.sideWidth, -cube.topHeight}),
-            Add(topLeft, {cube.sideWidth, -cube.topHeight})
-        };
-    }
-
-    Color CubesRenderer::CalculateBaseColor(
-        float magnitude
-    ) const {
-        const float alpha = kAlphaBase + kAlphaRange * magnitude;
-        return AdjustAlpha(GetPrimaryColor(), alpha);
     }
 
-} // namespace Spectrum
\ No newline at end of file
+} // namespace Spectrum
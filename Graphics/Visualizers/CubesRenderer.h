@@ -3,7 +3,7 @@
 
 #include "Graphics/Base/BaseRenderer.h"
 #include "Graphics/Visualizers/Settings/QualityTraits.h"
-#include <vector>
+#include <cstdint>
 
 namespace Spectrum {
 
@@ -23,6 +23,11 @@ namespace Spectrum {
             return "Cubes";
         }
 
+        // Draws the spectrum as-is, with no state of its own.
+        [[nodiscard]] bool IsAnimating() const override {
+            return false;
+        }
+
     protected:
         void UpdateSettings() override;
 
@@ -44,57 +49,48 @@ namespace Spectrum {
         static constexpr float kShadowOffsetY = 2.0f;
         static constexpr float kShadowAlpha = 0.3f;
 
-        struct CubeData {
-            Rect frontFace;
-            float topHeight;
-            float sideWidth;
-            float magnitude;
-            Color baseColor;
-            Color sideColor;
-            Color topColor;
-        };
+        // Opacity levels cubes are bucketed into; each bucket is one draw
+        // per face kind, whatever the bar count.
+        static constexpr size_t kAlphaBuckets = 32;
 
-        [[nodiscard]] std::vector<CubeData> CollectVisibleCubes(
-            const SpectrumData& spectrum,
-            const BarLayout& layout
-        ) const;
+        // Faces thinner than this (in pixels) are culled.
+        static constexpr float kMinFaceExtent = 0.5f;
 
-        void RenderCubeShadows(
-            Canvas& canvas,
-            const std::vector<CubeData>& cubes
-        ) const;
+        // Per cube: front TL, TR, BR, BL, then the receded TL, TR, BR.
+        static constexpr uint32_t kVerticesPerCube = 7;
+        static constexpr uint32_t kIndicesPerFace = 6;
 
-        void RenderCubeSides(
-            Canvas& canvas,
-            const std::vector<CubeData>& cubes
-        ) const;
+        // In draw order: fronts last, over their neighbours' faces.
+        enum class Face : size_t { Side, Top, Front, Count };
 
-        void RenderCubeTops(
-            Canvas& canvas,
-            const std::vector<CubeData>& cubes
-        ) const;
+        struct MeshRun {
+            Color    color;
+            uint32_t first;
+            uint32_t count;
+        };
 
-        void RenderCubeFronts(
-            Canvas& canvas,
-            const std::vector<CubeData>& cubes
-        ) const;
+        // Every visible face of every cube; runs are contiguous index
+        // ranges of one face kind and one color.
+        struct CubeMesh {
+            ArenaVector<Point>    vertices;
+            ArenaVector<uint32_t> indices;
+            ArenaVector<MeshRun>  runs;
+        };
 
-        [[nodiscard]] CubeData CreateCubeData(
-            size_t index,
-            float magnitude,
+        [[nodiscard]] CubeMesh BuildMesh(
+            FrameArena& arena,
+            const SpectrumData& spectrum,
             const BarLayout& layout
         ) const;
 
-        [[nodiscard]] std::vector<Point> GetSideFacePoints(
-            const CubeData& cube
-        ) const;
-
-        [[nodiscard]] std::vector<Point> GetTopFacePoints(
-            const CubeData& cube
+        void RenderMesh(
+            Canvas& canvas,
+            const CubeMesh& mesh
         ) const;
 
-        [[nodiscard]] Color CalculateBaseColor(
-            float magnitude
+        [[nodiscard]] Color FaceColor(
+            Face face,
+            size_t bucket
         ) const;
 
         Settings m_settings;
@@ -10,6 +10,7 @@ namespace Spectrum {
     namespace {
         constexpr float kWindSpeed = 2.0f;
         constexpr float kWindAmplitude = 2.0f;
+        constexpr float kWindColumnPhase = 0.5f;
         constexpr float kSmoothingCenter = 0.5f;
         constexpr float kSmoothingSide = 0.25f;
         constexpr float kMinVisibleIntensity = 0.01f;
@@ -37,6 +38,7 @@ namespace Spectrum {
         const SpectrumData& spectrum,
         float
     ) {
+        m_isAnimating = false;
         if (m_gridWidth <= 0 || m_gridHeight <= 0) return;
 
         for (float& value : m_fireGrid) {
@@ -45,6 +47,11 @@ namespace Spectrum {
 
         InjectHeat(spectrum);
         PropagateFire();
+
+        // Heat only decays, so once every cell is invisible the frame stays
+        // empty until new heat is injected.
+        m_isAnimating = std::any_of(m_fireGrid.begin(), m_fireGrid.end(),
+            [](float v) { return v >= kMinVisibleIntensity; });
     }
 
     void FireRenderer::DoRender(Canvas& canvas, const SpectrumData&) {
@@ -90,10 +97,13 @@ namespace Spectrum {
 
         const size_t gridSize = static_cast<size_t>(m_gridWidth) * m_gridHeight;
         m_fireGrid.assign(gridSize, 0.0f);
+
+        m_windPhases.Ensure(static_cast<size_t>(m_gridWidth), 0.0f, kWindColumnPhase);
+        m_windOffsets.assign(static_cast<size_t>(m_gridWidth), 0);
     }
 
     void FireRenderer::CreateFirePalette() {
-        m_firePalette = {
+        m_firePalette = BakeGradient({
             Color(0.0f, 0.0f, 0.0f, 0.0f),
             Color(0.2f, 0.0f, 0.0f, 1.0f),
             Color(0.5f, 0.0f, 0.0f, 1.0f),
@@ -102,7 +112,7 @@ namespace Spectrum {
             Color(1.0f, 0.8f, 0.0f, 1.0f),
             Color(1.0f, 1.0f, 0.5f, 1.0f),
             Color(1.0f, 1.0f, 1.0f, 1.0f)
-        };
+        });
     }
 
     void FireRenderer::InjectHeat(const SpectrumData& spectrum) {
@@ -129,21 +139,31 @@ namespace Spectrum {
         }
     }
 
+    void FireRenderer::UpdateWindOffsets() {
+        // The wind depends only on the column, so it is evaluated once per
+        // column rather than once per cell.
+        const Rotor phase = Rotor::FromAngle(GetTime() * kWindSpeed);
+        const size_t columns = std::min(m_windOffsets.size(), m_windPhases.size());
+
+        for (size_t x = 0; x < columns; ++x) {
+            const int srcX = static_cast<int>(x) +
+                static_cast<int>(m_windPhases.Sin(x, phase) * kWindAmplitude);
+            m_windOffsets[x] = Clamp(srcX, 0, m_gridWidth - 1);
+        }
+    }
+
     void FireRenderer::PropagateFire() {
-        const std::vector<float> readGrid = m_fireGrid;
+        // Reuse the snapshot buffer; assign() keeps its capacity across frames
+        m_readGrid.assign(m_fireGrid.begin(), m_fireGrid.end());
+        const auto& readGrid = m_readGrid;
+
+        if (m_settings.useWind) UpdateWindOffsets();
 
         for (int y = 0; y < m_gridHeight - 1; ++y) {
             for (int x = 0; x < m_gridWidth; ++x) {
-                int srcX = x;
+                const int srcX = m_settings.useWind ? m_windOffsets[x] : x;
                 const int srcY = y + 1;
 
-                if (m_settings.useWind) {
-                    srcX += static_cast<int>(
-                        std::sin(GetTime() * kWindSpeed + x * 0.5f) * kWindAmplitude
-                        );
-                    srcX = Clamp(srcX, 0, m_gridWidth - 1);
-                }
-
                 const size_t srcIdx = srcY * m_gridWidth + srcX;
                 float value = (srcIdx < readGrid.size()) ? readGrid[srcIdx] : 0.0f;
 
@@ -2,6 +2,7 @@
 #define SPECTRUM_CPP_FIRE_RENDERER_H
 
 #include "Graphics/Base/BaseRenderer.h"
+#include "Common/TrigTable.h"
 #include "Graphics/Visualizers/Settings/QualityTraits.h"
 #include <vector>
 
@@ -23,6 +24,10 @@ namespace Spectrum {
             return "Fire";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_isAnimating;
+        }
+
         [[nodiscard]] bool SupportsPrimaryColor() const override {
             return false;
         }
@@ -47,11 +52,16 @@ namespace Spectrum {
         void CreateFirePalette();
         void InjectHeat(const SpectrumData& spectrum);
         void PropagateFire();
+        void UpdateWindOffsets();
 
         Settings m_settings;
         int m_gridWidth;
         int m_gridHeight;
         std::vector<float> m_fireGrid;
+        std::vector<float> m_readGrid;
+        TrigTable m_windPhases;
+        std::vector<int> m_windOffsets;
+        bool m_isAnimating = true;
         ColorGradient m_firePalette;
     };
 
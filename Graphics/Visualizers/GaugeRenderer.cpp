@@ -40,6 +40,11 @@ namespace Spectrum {
     {
         m_aspectRatio = 2.0f;
         m_padding = 0.8f;
+
+        m_tickDirections.reserve(std::size(kMajorMarks));
+        for (const auto& mark : kMajorMarks)
+            m_tickDirections.push_back(Rotor::FromAngle(DegreesToRadians(DbToAngle(mark.db))));
+
         UpdateSettings();
     }
 
@@ -74,6 +79,12 @@ namespace Spectrum {
         else {
             m_peakActive = false;
         }
+
+        // A peak lamp held by a quiet signal is still counting down.
+        m_isAnimating =
+            !IsSettled(m_currentDbValue, targetDb) ||
+            !IsSettled(m_currentNeedleAngle, DbToAngle(m_currentDbValue)) ||
+            (m_peakActive && targetDb < kDbPeakThreshold);
     }
 
     void GaugeRenderer::DoRender(Canvas& canvas, const SpectrumData&) {
@@ -125,19 +136,18 @@ namespace Spectrum {
         const float radiusX = rect.width * (IsOverlay() ? 0.4f : 0.45f);
         const float radiusY = rect.height * (IsOverlay() ? 0.45f : 0.5f);
 
-        for (const auto& mark : kMajorMarks) {
-            const float angle = DbToAngle(mark.db);
-            const float rad = DegreesToRadians(angle);
+        for (size_t i = 0; i < std::size(kMajorMarks); ++i) {
+            const auto& mark = kMajorMarks[i];
+            const Rotor& direction = m_tickDirections[i];
             const float tickLength = (mark.db == 0.0f ? 0.15f : 0.08f) * radiusY;
 
-            const Point start = PointOnEllipse(
+            const Point start = direction.OnEllipse(
                 center,
                 radiusX - tickLength,
-                radiusY - tickLength,
-                rad
+                radiusY - tickLength
             );
 
-            const Point end = PointOnEllipse(center, radiusX, radiusY, rad);
+            const Point end = direction.OnEllipse(center, radiusX, radiusY);
 
             const Color tickColor = (mark.db >= 0.0f)
                 ? Color::FromRGB(220, 0, 0)
@@ -146,11 +156,10 @@ namespace Spectrum {
             canvas.DrawLine(start, end, Paint::Stroke(tickColor, 1.8f));
 
             if (mark.label) {
-                const Point labelPos = PointOnEllipse(
+                const Point labelPos = direction.OnEllipse(
                     center,
                     radiusX + radiusY * 0.12f,
-                    radiusY + radiusY * 0.12f,
-                    rad
+                    radiusY + radiusY * 0.12f
                 );
 
                 const float textSize = rect.height * (IsOverlay() ? 0.08f : 0.1f) *
@@ -177,11 +186,11 @@ namespace Spectrum {
         const float needleLength = std::min(rect.width, rect.height) *
             (IsOverlay() ? 0.64f : 0.7f);
 
-        const std::vector<Point> needlePoints = {
+        const std::array<Point, 3> needlePoints = { {
             {0.0f, -needleLength},
             {-kNeedleBaseWidth, 0.0f},
             {kNeedleBaseWidth, 0.0f}
-        };
+        } };
 
         auto drawNeedle = [&]() {
             canvas.PushTransform();
@@ -2,6 +2,7 @@
 #define SPECTRUM_CPP_GAUGE_RENDERER_H
 
 #include "Graphics/Base/BaseRenderer.h"
+#include "Common/TrigTable.h"
 
 namespace Spectrum {
 
@@ -20,6 +21,10 @@ namespace Spectrum {
             return "Gauge";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_isAnimating;
+        }
+
     protected:
         void UpdateSettings() override;
         void UpdateAnimation(
@@ -61,10 +66,12 @@ namespace Spectrum {
         [[nodiscard]] Rect CalculatePaddedRect() const;
 
         Settings::GaugeSettings m_settings;
+        std::vector<Rotor> m_tickDirections; // one per major mark, fixed angles
         float m_currentDbValue;
         float m_currentNeedleAngle;
         int m_peakHoldCounter;
         bool m_peakActive;
+        bool m_isAnimating = true;
     };
 
 } // namespace Spectrum
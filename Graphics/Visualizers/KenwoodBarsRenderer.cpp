@@ -9,7 +9,6 @@ namespace Spectrum {
         constexpr float kPeakDecayRate = 0.95f;
         constexpr float kPeakHeight = 3.0f;
         constexpr float kPeakHeightOverlay = 2.0f;
-        constexpr int kGradientSteps = 8;
     }
 
     KenwoodBarsRenderer::KenwoodBarsRenderer() {
@@ -19,6 +18,11 @@ namespace Spectrum {
 
     void KenwoodBarsRenderer::UpdateSettings() {
         m_settings = GetQualitySettings<Settings>();
+        RefreshGradient();
+    }
+
+    void KenwoodBarsRenderer::OnPrimaryColorChanged() {
+        RefreshGradient();
     }
 
     void KenwoodBarsRenderer::UpdateAnimation(
@@ -101,30 +105,29 @@ namespace Spectrum {
         style.useGradient = m_settings.useGradient;
 
         if (style.useGradient) {
-            const auto gradient = CreateGradient(
-                AdjustBrightness(
-                    AdjustSaturation(GetPrimaryColor(), 0.8f),
-                    0.5f
-                ),
-                AdjustBrightness(
-                    AdjustSaturation(GetPrimaryColor(), 1.0f),
-                    1.2f
-                ),
-                kGradientSteps
-            );
-
-            style.gradientStops.reserve(gradient.size());
-            for (size_t i = 0; i < gradient.size(); ++i) {
-                const float t = static_cast<float>(i) / (gradient.size() - 1);
-                const auto& c = gradient[i];
-                style.gradientStops.push_back({
-                    t,
-                    D2D1::ColorF(c.r, c.g, c.b, c.a)
-                    });
-            }
+            style.gradient = m_gradient;
         }
 
         return style;
     }
 
+    void KenwoodBarsRenderer::RefreshGradient() {
+        if (!m_settings.useGradient) {
+            m_gradient.reset();
+            return;
+        }
+
+        m_gradient = CreateGradient(
+            AdjustBrightness(
+                AdjustSaturation(GetPrimaryColor(), 0.8f),
+                0.5f
+            ),
+            AdjustBrightness(
+                AdjustSaturation(GetPrimaryColor(), 1.0f),
+                1.2f
+            ),
+            GradientRamp::kFineSize
+        );
+    }
+
 } // namespace Spectrum
\ No newline at end of file
@@ -22,6 +22,10 @@ namespace Spectrum {
             return "Kenwood Bars";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return HasPeakTracker() && GetPeakTracker().IsAnimating();
+        }
+
     protected:
         void UpdateSettings() override;
 
@@ -31,13 +35,19 @@ namespace Spectrum {
         ) override;
 
         void DoRender(Canvas& canvas, const SpectrumData& spectrum) override;
+        void OnPrimaryColorChanged() override;
 
     private:
         using Settings = Settings::KenwoodBarsSettings;
 
         [[nodiscard]] BarStyle CreateBarStyle() const;
 
+        // Baked when the settings or the primary color change, never
+        // from the render path.
+        void RefreshGradient();
+
         Settings m_settings;
+        ColorGradient m_gradient;
     };
 
 } // namespace Spectrum
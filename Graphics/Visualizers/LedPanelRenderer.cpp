@@ -22,7 +22,7 @@ namespace Spectrum {
         m_settings = GetQualitySettings<Settings>();
         m_grid = {};
 
-        m_gradient = {
+        m_gradient = BakeGradient({
             Color::FromRGB(0, 200, 100),
             Color::FromRGB(0, 255, 0),
             Color::FromRGB(128, 255, 0),
@@ -32,7 +32,11 @@ namespace Spectrum {
             Color::FromRGB(255, 64, 0),
             Color::FromRGB(255, 0, 0),
             Color::FromRGB(200, 0, 50)
-        };
+        });
+    }
+
+    void LedPanelRenderer::OnPrimaryColorChanged() {
+        RefreshRowColors();
     }
 
     void LedPanelRenderer::UpdateAnimation(
@@ -81,6 +85,7 @@ namespace Spectrum {
         if (m_grid.columns != newGrid.columns ||
             m_grid.rows != newGrid.rows) {
             m_grid = newGrid;
+            RefreshRowColors();
 
             if (HasPeakTracker()) {
                 GetPeakTracker().Resize(m_grid.columns);
@@ -88,9 +93,43 @@ namespace Spectrum {
         }
     }
 
+    void LedPanelRenderer::RefreshRowColors() {
+        const int rows = std::max(m_grid.rows, 0);
+        m_rowColors.resize(static_cast<size_t>(rows));
+
+        const Color& primary = GetPrimaryColor();
+        const bool hasPrimaryColor = (
+            primary.r != 1.0f ||
+            primary.g != 1.0f ||
+            primary.b != 1.0f
+            );
+
+        for (int row = 0; row < rows; ++row) {
+            const float rowNorm = static_cast<float>(row) /
+                std::max(1, rows - 1);
+
+            // Each LED stands for one row's slice of the gradient.
+            Color ledColor = SampleGradient(
+                m_gradient, rowNorm, 1.0f / std::max(1, rows));
+
+            if (hasPrimaryColor) {
+                const float blendFactor = rowNorm *
+                    (1.0f - kColorBlendAmount) + kColorBlendAmount;
+
+                ledColor = InterpolateColors(
+                    primary,
+                    ledColor,
+                    blendFactor
+                );
+            }
+
+            m_rowColors[static_cast<size_t>(row)] = ledColor;
+        }
+    }
+
     void LedPanelRenderer::RenderInactiveLeds(Canvas& canvas) {
-        std::vector<Point> inactivePositions;
-        inactivePositions.reserve(
+        auto inactivePositions = MakeFrameVector<Point>(
+            canvas,
             static_cast<size_t>(m_grid.columns) * m_grid.rows
         );
 
@@ -118,7 +157,7 @@ namespace Spectrum {
         Canvas& canvas,
         const SpectrumData& spectrum
     ) {
-        PointBatch activeBatches;
+        PointBatch activeBatches(canvas.GetFrameArena());
         const size_t columnCount = std::min(
             static_cast<size_t>(m_grid.columns),
             spectrum.size()
@@ -137,12 +176,9 @@ namespace Spectrum {
             );
 
             for (int row = 0; row < activeLeds; ++row) {
-                const float rowNorm = static_cast<float>(row) /
-                    std::max(1, m_grid.rows - 1);
-
                 const bool isTopLed = (row == activeLeds - 1);
                 const Color ledColor = CalculateLedColor(
-                    rowNorm,
+                    row,
                     brightness,
                     isTopLed
                 );
@@ -152,7 +188,7 @@ namespace Spectrum {
                     row
                 );
 
-                activeBatches[ledColor].push_back(center);
+                activeBatches.Add(ledColor, center);
             }
         }
 
@@ -208,35 +244,18 @@ namespace Spectrum {
     }
 
     Color LedPanelRenderer::CalculateLedColor(
-        float rowNorm,
+        int row,
         float brightness,
         bool isTopLed
     ) const {
-        Color ledColor = SampleGradient(m_gradient, rowNorm);
-
-        const Color& primary = GetPrimaryColor();
-        const bool hasPrimaryColor = (
-            primary.r != 1.0f ||
-            primary.g != 1.0f ||
-            primary.b != 1.0f
-            );
-
-        if (hasPrimaryColor) {
-            const float blendFactor = rowNorm *
-                (1.0f - kColorBlendAmount) + kColorBlendAmount;
-
-            ledColor = InterpolateColors(
-                primary,
-                ledColor,
-                blendFactor
-            );
-        }
-
         const float finalBrightness = isTopLed
             ? brightness * kTopLedBoost
             : brightness;
 
-        return AdjustAlpha(ledColor, Saturate(finalBrightness));
+        return AdjustAlpha(
+            m_rowColors[static_cast<size_t>(row)],
+            Saturate(finalBrightness)
+        );
     }
 
     int LedPanelRenderer::CalculateActiveLeds(
@@ -22,6 +22,10 @@ namespace Spectrum {
             return "LED Panel";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_settings.usePeakHold && HasPeakTracker() && GetPeakTracker().IsAnimating();
+        }
+
         void OnActivate(int width, int height) override;
 
     protected:
@@ -37,6 +41,8 @@ namespace Spectrum {
             const SpectrumData& spectrum
         ) override;
 
+        void OnPrimaryColorChanged() override;
+
     private:
         using Settings = Settings::LedPanelSettings;
 
@@ -52,6 +58,10 @@ namespace Spectrum {
 
         void UpdateGridConfiguration(size_t requiredColumns);
 
+        // One color per row: the gradient slice blended towards the
+        // primary. Rebuilt when the rows or the primary change.
+        void RefreshRowColors();
+
         void RenderInactiveLeds(Canvas& canvas);
 
         void RenderActiveLeds(
@@ -70,7 +80,7 @@ namespace Spectrum {
         ) const;
 
         [[nodiscard]] Color CalculateLedColor(
-            float rowNorm,
+            int row,
             float brightness,
             bool isTopLed
         ) const;
@@ -82,6 +92,7 @@ namespace Spectrum {
         Settings m_settings;
         GridConfig m_grid;
         ColorGradient m_gradient;
+        std::vector<Color> m_rowColors;
     };
 
 } // namespace Spectrum
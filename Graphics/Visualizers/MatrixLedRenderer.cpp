@@ -22,7 +22,7 @@ namespace Spectrum {
         m_settings = GetQualitySettings<Settings>();
         m_grid = {};
 
-        m_gradient = {
+        m_gradient = BakeGradient({
             Color::FromRGB(0, 200, 100),
             Color::FromRGB(0, 255, 0),
             Color::FromRGB(128, 255, 0),
@@ -32,7 +32,7 @@ namespace Spectrum {
             Color::FromRGB(255, 64, 0),
             Color::FromRGB(255, 0, 0),
             Color::FromRGB(200, 0, 50)
-        };
+        });
     }
 
     void MatrixLedRenderer::UpdateAnimation(
@@ -89,8 +89,8 @@ namespace Spectrum {
     }
 
     void MatrixLedRenderer::RenderInactiveLeds(Canvas& canvas) {
-        std::vector<Rect> inactiveRects;
-        inactiveRects.reserve(
+        auto inactiveRects = MakeFrameVector<Rect>(
+            canvas,
             static_cast<size_t>(m_grid.columns) * m_grid.rows
         );
 
@@ -122,7 +122,7 @@ namespace Spectrum {
         Canvas& canvas,
         const SpectrumData& spectrum
     ) {
-        RectBatch activeBatches;
+        RectBatch activeBatches(canvas.GetFrameArena());
         const size_t columnCount = std::min(
             static_cast<size_t>(m_grid.columns),
             spectrum.size()
@@ -148,7 +148,8 @@ namespace Spectrum {
                     isTopLed
                 );
 
-                activeBatches[ledColor].push_back(
+                activeBatches.Add(
+                    ledColor,
                     GetLedRect(static_cast<int>(col), row)
                 );
             }
@@ -161,7 +162,7 @@ namespace Spectrum {
         Canvas& canvas,
         size_t columnCount
     ) {
-        std::vector<Rect> peakRects;
+        auto peakRects = MakeFrameVector<Rect>(canvas, columnCount);
         const auto& tracker = GetPeakTracker();
 
         for (size_t col = 0; col < columnCount; ++col) {
@@ -223,7 +224,9 @@ namespace Spectrum {
         const float rowNorm = static_cast<float>(row) /
             std::max(1, m_grid.rows - 1);
 
-        Color ledColor = SampleGradient(m_gradient, rowNorm);
+        // Each LED stands for one row's slice of the gradient.
+        Color ledColor = SampleGradient(
+            m_gradient, rowNorm, 1.0f / std::max(1, m_grid.rows));
 
         const float finalBrightness = isTopLed
             ? brightness * kTopLedBoost
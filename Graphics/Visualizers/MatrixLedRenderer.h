@@ -22,6 +22,10 @@ namespace Spectrum {
             return "Matrix LED";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_settings.enableGlow && HasPeakTracker() && GetPeakTracker().IsAnimating();
+        }
+
         void OnActivate(int width, int height) override;
 
     protected:
@@ -47,10 +47,7 @@ namespace Spectrum {
     void ParticlesRenderer::DoRender(Canvas& canvas, const SpectrumData&) {
         for (const auto& particle : m_particles) {
             if (particle.alpha > 0.0f && particle.size > 0.0f) {
-                const Color color = AdjustAlpha(
-                    GetPrimaryColor(),
-                    particle.alpha
-                );
+                const Color& color = GetPalette().WithAlpha(particle.alpha);
                 canvas.DrawCircle(
                     particle.position,
                     particle.size * 0.5f,
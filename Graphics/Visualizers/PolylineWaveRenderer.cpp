@@ -35,6 +35,8 @@ namespace Spectrum {
         const SpectrumData& spectrum,
         float deltaTime
     ) {
+        m_isAnimating = false;
+
         if (m_settings.useFill && !spectrum.empty()) {
             float sum = 0.0f;
             for (float magnitude : spectrum) {
@@ -55,6 +57,7 @@ namespace Spectrum {
                 m_targetCoreRadius,
                 smoothingFactor
             );
+            m_isAnimating = !IsSettled(m_currentCoreRadius, m_targetCoreRadius);
         }
     }
 
@@ -80,7 +83,7 @@ namespace Spectrum {
             canvas.DrawCircle(
                 center,
                 coreRadius,
-                Paint::Fill(AdjustAlpha(GetPrimaryColor(), 0.3f))
+                Paint::Fill(GetPalette().WithAlpha(0.3f))
             );
         }
 
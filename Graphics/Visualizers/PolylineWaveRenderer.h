@@ -23,6 +23,10 @@ namespace Spectrum {
             return "Sunburst";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_isAnimating;
+        }
+
     protected:
         void UpdateSettings() override;
 
@@ -55,6 +59,7 @@ namespace Spectrum {
         std::vector<Point> m_barDirections;
         float m_currentCoreRadius;
         float m_targetCoreRadius;
+        bool m_isAnimating = true;
     };
 
 } // namespace Spectrum
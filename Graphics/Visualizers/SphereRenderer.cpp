@@ -26,6 +26,7 @@ namespace Spectrum {
         const size_t requiredCount = CalculateSphereCount(spectrum);
         UpdateConfiguration(requiredCount);
 
+        m_isAnimating = false;
         if (m_sphereCount == 0) return;
 
         const size_t count = std::min(m_sphereCount, spectrum.size());
@@ -41,6 +42,9 @@ namespace Spectrum {
                 m_settings.rotationSpeed,
                 0.95f
             );
+
+            if (!IsSettled(m_currentAlphas[i], targetAlpha))
+                m_isAnimating = true;
         }
     }
 
@@ -50,24 +54,22 @@ namespace Spectrum {
     ) {
         if (m_sphereCount == 0) return;
 
-        const auto spheres = CollectVisibleSpheres(spectrum);
+        const auto spheres = CollectVisibleSpheres(canvas, spectrum);
         if (spheres.empty()) return;
 
-        PointBatch sphereBatches;
+        PointBatch sphereBatches(canvas.GetFrameArena(), spheres.size());
         for (const auto& sphere : spheres) {
-            sphereBatches[sphere.color].push_back(sphere.position);
+            sphereBatches.Add(sphere.color, sphere.position);
         }
 
-        for (const auto& [color, positions] : sphereBatches) {
-            if (!positions.empty()) {
-                const float radius = CalculateSphereSize(color.a);
-                canvas.DrawCircleBatch(
-                    positions,
-                    radius,
-                    Paint::Fill(color)
-                );
-            }
-        }
+        sphereBatches.ForEachRun([&](const Color& color, Span<const Point> positions) {
+            const float radius = CalculateSphereSize(color.a);
+            canvas.DrawCircleBatch(
+                positions,
+                radius,
+                Paint::Fill(color)
+            );
+            });
     }
 
     void SphereRenderer::UpdateConfiguration(
@@ -94,12 +96,12 @@ namespace Spectrum {
         );
     }
 
-    std::vector<SphereRenderer::SphereData>
+    ArenaVector<SphereRenderer::SphereData>
         SphereRenderer::CollectVisibleSpheres(
+            Canvas& canvas,
             const SpectrumData& spectrum
         ) const {
-        std::vector<SphereData> spheres;
-        spheres.reserve(m_sphereCount);
+        auto spheres = MakeFrameVector<SphereData>(canvas, m_sphereCount);
 
         const size_t count = std::min(m_sphereCount, spectrum.size());
 
@@ -158,7 +160,7 @@ namespace Spectrum {
     Color SphereRenderer::CalculateSphereColor(
         float alpha
     ) const {
-        return AdjustAlpha(GetPrimaryColor(), alpha);
+        return GetPalette().WithAlpha(alpha);
     }
 
 } // namespace Spectrum
\ No newline at end of file
@@ -23,6 +23,10 @@ namespace Spectrum {
             return "Sphere";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_isAnimating;
+        }
+
     protected:
         void UpdateSettings() override;
 
@@ -55,7 +59,8 @@ namespace Spectrum {
 
         void UpdateConfiguration(size_t requiredCount);
 
-        [[nodiscard]] std::vector<SphereData> CollectVisibleSpheres(
+        [[nodiscard]] ArenaVector<SphereData> CollectVisibleSpheres(
+            Canvas& canvas,
             const SpectrumData& spectrum
         ) const;
 
@@ -81,6 +86,7 @@ namespace Spectrum {
         float m_sphereRadius;
         std::vector<Point> m_orbitPositions;
         std::vector<float> m_currentAlphas;
+        bool m_isAnimating = true;
     };
 
 } // namespace Spectrum
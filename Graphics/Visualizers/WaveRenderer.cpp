@@ -46,6 +46,7 @@ namespace Spectrum {
             targetIntensity,
             smoothing
         );
+        m_isAnimating = !IsSettled(m_smoothedIntensity, targetIntensity);
     }
 
     void WaveRenderer::DoRender(
@@ -68,13 +69,20 @@ namespace Spectrum {
                 1.0f
             );
             const float boost = Lerp(1.0f, kBrightnessBoostMax, intensityRatio);
-            mainColor = AdjustBrightness(mainColor, boost);
+            mainColor = GetPalette().Brightened(boost);
         }
 
+        // The curve is tessellated once and every pass below restrokes it;
+        // reflections are the same geometry flipped about the centre line.
+        const PathGeometry wave = canvas.BuildWaveform(spectrum, bounds);
+        if (!wave) return;
+
+        const Point mirrorAxis = { bounds.x, bounds.y + bounds.height * 0.5f };
+
         // Render shadow
         if (m_settings.useFill && m_settings.useMirror) {
             auto drawShadow = [&]() {
-                RenderWaveform(canvas, spectrum, bounds, mainColor, lineWidth, false);
+                StrokeWaveform(canvas, wave, mirrorAxis, mainColor, lineWidth, false);
                 };
             RenderWithShadow(canvas, drawShadow, { 0.0f, 3.0f }, 0.5f);
         }
@@ -86,15 +94,15 @@ namespace Spectrum {
                 const Color glowColor = CalculateGlowColor(i);
                 const float glowWidth = CalculateGlowWidth(i);
 
-                RenderWaveform(canvas, spectrum, bounds, glowColor, glowWidth, false);
+                StrokeWaveform(canvas, wave, mirrorAxis, glowColor, glowWidth, false);
 
                 if (m_settings.useMirror) {
                     Color reflectionGlowColor = glowColor;
                     reflectionGlowColor.a *= kReflectionGlowAlpha;
-                    RenderWaveform(
+                    StrokeWaveform(
                         canvas,
-                        spectrum,
-                        bounds,
+                        wave,
+                        mirrorAxis,
                         reflectionGlowColor,
                         glowWidth,
                         true
@@ -104,20 +112,20 @@ namespace Spectrum {
         }
 
         // Render main waveform
-        RenderWaveform(canvas, spectrum, bounds, mainColor, lineWidth, false);
+        StrokeWaveform(canvas, wave, mirrorAxis, mainColor, lineWidth, false);
 
         // Render reflection
         if (m_settings.useMirror) {
             Color reflectionColor = mainColor;
             reflectionColor.a *= kReflectionAlpha;
-            RenderWaveform(canvas, spectrum, bounds, reflectionColor, lineWidth, true);
+            StrokeWaveform(canvas, wave, mirrorAxis, reflectionColor, lineWidth, true);
         }
     }
 
-    void WaveRenderer::RenderWaveform(
+    void WaveRenderer::StrokeWaveform(
         Canvas& canvas,
-        const SpectrumData& spectrum,
-        const Rect& bounds,
+        const PathGeometry& wave,
+        const Point& mirrorAxis,
         const Color& color,
         float width,
         bool reflected
@@ -125,7 +133,18 @@ namespace Spectrum {
         Paint paint = Paint::Stroke(color, width)
             .WithStrokeCap(StrokeCap::Round)
             .WithStrokeJoin(StrokeJoin::Round);
-        canvas.DrawWaveform(spectrum, bounds, paint, reflected);
+
+        if (!reflected) {
+            canvas.DrawPath(wave, paint);
+            return;
+        }
+
+        paint.WithAlpha(paint.GetAlpha() * Constants::Rendering::kMirrorAlphaFactor);
+
+        canvas.PushTransform();
+        canvas.ScaleAt(mirrorAxis, 1.0f, -1.0f);
+        canvas.DrawPath(wave, paint);
+        canvas.PopTransform();
     }
 
     Color WaveRenderer::CalculateGlowColor(int layerIndex) const {
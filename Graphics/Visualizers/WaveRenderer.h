@@ -22,6 +22,10 @@ namespace Spectrum {
             return "Wave";
         }
 
+        [[nodiscard]] bool IsAnimating() const override {
+            return m_isAnimating;
+        }
+
     protected:
         void UpdateSettings() override;
 
@@ -35,10 +39,10 @@ namespace Spectrum {
     private:
         using Settings = Settings::WaveSettings;
 
-        void RenderWaveform(
+        void StrokeWaveform(
             Canvas& canvas,
-            const SpectrumData& spectrum,
-            const Rect& bounds,
+            const PathGeometry& wave,
+            const Point& mirrorAxis,
             const Color& color,
             float width,
             bool reflected
@@ -51,6 +55,7 @@ namespace Spectrum {
 
         Settings m_settings;
         float m_smoothedIntensity;
+        bool m_isAnimating = true;
     };
 
 } // namespace Spectrum
@@ -0,0 +1,268 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ControlDecoder.h: Turns the control pipe's byte stream (see
+// ControlProtocol.h) into EventBus events. Reads may split or batch
+// messages arbitrarily; a partial message waits for the next read.
+//
+// A controller can send far faster than frames are drawn, and only the
+// last value of a setting matters, so each read is coalesced before it is
+// published: actions go out in order, then at most one ControlEvent per
+// setting. However fast the client, the frame sees a bounded amount of
+// work.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_CONTROL_DECODER_H
+#define SPECTRUM_CPP_CONTROL_DECODER_H
+
+#include "Common/EnumNames.h"
+#include "Common/EventBus.h"
+#include "Common/Types.h"
+#include "ControlProtocol.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Spectrum::Platform {
+
+    // One setting from outside the process; handled on the frame thread.
+    struct ControlEvent {
+        ControlProtocol::Setting setting = ControlProtocol::Setting::Style;
+        uint32_t value = 0;         // enum index, bar count or 0/1
+        float    amount = 0.0f;     // Amplification
+        Color    color;             // Color
+    };
+
+    struct ControlDecoderStats {
+        uint64_t messages = 0;
+        uint64_t coalesced = 0;     // superseded by a later value in the same read
+        uint64_t malformed = 0;
+        uint64_t dropped = 0;       // the event bus was full
+    };
+
+    class ControlDecoder final {
+    public:
+        ControlDecoder() {
+            m_buffer.reserve(ControlProtocol::kMaxLineLength * 4);
+        }
+
+        void Feed(const char* data, size_t size, EventBus& bus) {
+            using namespace ControlProtocol;
+
+            m_buffer.append(data, size);
+            size_t pos = 0;
+
+            while (pos < m_buffer.size()) {
+                if (m_discarding) {
+                    const size_t end = m_buffer.find('\n', pos);
+                    pos = end == std::string::npos ? m_buffer.size() : end + 1;
+                    m_discarding = end == std::string::npos;
+                    continue;
+                }
+
+                if (static_cast<uint8_t>(m_buffer[pos]) == kBinaryMarker) {
+                    if (m_buffer.size() - pos < kRecordSize) break;
+                    DecodeRecord(reinterpret_cast<const uint8_t*>(m_buffer.data() + pos));
+                    pos += kRecordSize;
+                    continue;
+                }
+
+                const size_t end = m_buffer.find('\n', pos);
+                if (end == std::string::npos) {
+                    // No newline in sight: skip the line rather than buffer it.
+                    if (m_buffer.size() - pos > kMaxLineLength) {
+                        ++m_stats.malformed;
+                        m_discarding = true;
+                        pos = m_buffer.size();
+                    }
+                    break;
+                }
+
+                if (end - pos > kMaxLineLength) ++m_stats.malformed;
+                else DecodeLine(std::string_view(m_buffer).substr(pos, end - pos));
+                pos = end + 1;
+            }
+
+            m_buffer.erase(0, pos);
+            Publish(bus);
+        }
+
+        [[nodiscard]] const ControlDecoderStats& GetStats() const noexcept { return m_stats; }
+
+    private:
+        static constexpr size_t kSettings = static_cast<size_t>(ControlProtocol::Setting::Count);
+        static constexpr uint32_t kActions = static_cast<uint32_t>(InputAction::Exit) + 1;
+
+        static std::string_view Trim(std::string_view s) noexcept {
+            const size_t first = s.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos) return {};
+            const size_t last = s.find_last_not_of(" \t\r");
+            return s.substr(first, last - first + 1);
+        }
+
+        template<typename TEnum>
+        static bool ParseIndex(std::string_view text, uint32_t& out) {
+            TEnum value;
+            if (!Helpers::Utils::FromString(text, value)) return false;
+            out = static_cast<uint32_t>(value);
+            return true;
+        }
+
+        // Same number format as the settings file.
+        static bool ParseFloats(std::string_view text, float* out, size_t count) {
+            std::istringstream in{ std::string(text) };
+            in.imbue(std::locale::classic());
+            for (size_t i = 0; i < count; ++i) {
+                char sep = ',';
+                if (i > 0) in >> sep;
+                if (sep != ',' || !(in >> out[i]) || !std::isfinite(out[i])) return false;
+            }
+            return true;
+        }
+
+        void DecodeLine(std::string_view line) {
+            line = Trim(line);
+            if (line.empty()) return;
+
+            const size_t space = line.find_first_of(" \t");
+            const std::string_view name = line.substr(0, space);
+            const std::string_view arg = space == std::string_view::npos
+                ? std::string_view{} : Trim(line.substr(space));
+
+            if (name == ControlProtocol::kActionName) {
+                InputAction action;
+                if (Helpers::Utils::FromString(arg, action, static_cast<int>(kActions))) {
+                    ++m_stats.messages;
+                    m_actions.push_back(action);
+                }
+                else ++m_stats.malformed;
+                return;
+            }
+
+            size_t s = 0;
+            while (s < kSettings && name != ControlProtocol::kSettingNames[s]) ++s;
+
+            ControlEvent e;
+            e.setting = static_cast<ControlProtocol::Setting>(s);
+            if (s < kSettings && ParseArgument(arg, e)) Store(e);
+            else ++m_stats.malformed;
+        }
+
+        static bool ParseArgument(std::string_view arg, ControlEvent& e) {
+            using ControlProtocol::Setting;
+
+            switch (e.setting) {
+            case Setting::Style:         return ParseIndex<RenderStyle>(arg, e.value);
+            case Setting::Quality:       return ParseIndex<RenderQuality>(arg, e.value);
+            case Setting::FFTWindow:     return ParseIndex<FFTWindowType>(arg, e.value);
+            case Setting::SpectrumScale: return ParseIndex<SpectrumScale>(arg, e.value);
+            case Setting::BarCount: {
+                const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), e.value);
+                return ec == std::errc() && end == arg.data() + arg.size() && e.value > 0;
+            }
+            case Setting::Animation:
+                e.value = arg == "on" || arg == "1";
+                return e.value || arg == "off" || arg == "0";
+            case Setting::Amplification:
+                return ParseFloats(arg, &e.amount, 1) && e.amount > 0.0f;
+            case Setting::Color: {
+                float rgb[3];
+                if (!ParseFloats(arg, rgb, 3)) return false;
+                e.color = Color(
+                    std::clamp(rgb[0], 0.0f, 1.0f),
+                    std::clamp(rgb[1], 0.0f, 1.0f),
+                    std::clamp(rgb[2], 0.0f, 1.0f),
+                    1.0f);
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        void DecodeRecord(const uint8_t* record) {
+            using ControlProtocol::Setting;
+
+            const uint8_t opcode = record[1];
+            const uint32_t value = static_cast<uint32_t>(record[4])
+                | static_cast<uint32_t>(record[5]) << 8
+                | static_cast<uint32_t>(record[6]) << 16
+                | static_cast<uint32_t>(record[7]) << 24;
+
+            if (opcode & ControlProtocol::kActionOpcode) {
+                const uint32_t action = opcode & ~ControlProtocol::kActionOpcode;
+                if (action < kActions) {
+                    ++m_stats.messages;
+                    m_actions.push_back(static_cast<InputAction>(action));
+                }
+                else ++m_stats.malformed;
+                return;
+            }
+
+            ControlEvent e;
+            e.setting = static_cast<Setting>(opcode);
+            e.value = value;
+
+            bool valid = true;
+            switch (e.setting) {
+            case Setting::Style:         valid = value < static_cast<uint32_t>(RenderStyle::Count); break;
+            case Setting::Quality:       valid = value < static_cast<uint32_t>(RenderQuality::Count); break;
+            case Setting::FFTWindow:     valid = value < static_cast<uint32_t>(FFTWindowType::Count); break;
+            case Setting::SpectrumScale: valid = value < static_cast<uint32_t>(SpectrumScale::Count); break;
+            case Setting::BarCount:      valid = value > 0; break;
+            case Setting::Animation:     valid = value <= 1; break;
+            case Setting::Amplification:
+                std::memcpy(&e.amount, &value, sizeof(e.amount));
+                valid = std::isfinite(e.amount) && e.amount > 0.0f;
+                break;
+            case Setting::Color:
+                e.color = Color::FromRGB(
+                    static_cast<uint8_t>(value >> 16),
+                    static_cast<uint8_t>(value >> 8),
+                    static_cast<uint8_t>(value));
+                break;
+            default:
+                valid = false;
+            }
+
+            if (valid) Store(e);
+            else ++m_stats.malformed;
+        }
+
+        void Store(const ControlEvent& e) {
+            const auto s = static_cast<size_t>(e.setting);
+            if (m_pending[s]) ++m_stats.coalesced;
+            m_latest[s] = e;
+            m_pending[s] = true;
+            ++m_stats.messages;
+        }
+
+        void Publish(EventBus& bus) {
+            for (const InputAction action : m_actions)
+                if (!bus.Publish(action)) ++m_stats.dropped;
+            m_actions.clear();
+
+            for (size_t s = 0; s < kSettings; ++s) {
+                if (!m_pending[s]) continue;
+                if (!bus.Publish(m_latest[s])) ++m_stats.dropped;
+                m_pending[s] = false;
+            }
+        }
+
+        std::string                           m_buffer;
+        std::vector<InputAction>              m_actions;
+        std::array<ControlEvent, kSettings>   m_latest{};
+        std::array<bool, kSettings>           m_pending{};
+        ControlDecoderStats                   m_stats;
+        bool                                  m_discarding = false;
+    };
+
+} // namespace Spectrum::Platform
+
+#endif // SPECTRUM_CPP_CONTROL_DECODER_H
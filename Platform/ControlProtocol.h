@@ -0,0 +1,84 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ControlProtocol.h: Wire format of the control pipe that ControlServer
+// listens on, so lighting desks and show scripts can drive the visualizer
+// without focusing its window. Self-contained on purpose so external
+// clients can include it without the rest of the project.
+//
+// A client writes a byte stream mixing two kinds of message:
+//
+//   Text    one command per '\n'-terminated line, at most kMaxLineLength
+//           bytes, e.g. "style Cubes", "bars 96", "color 1,0.5,0",
+//           "amplification 1.5", "action SwitchRenderer". Names are the
+//           ones the settings file uses.
+//   Binary  kRecordSize bytes: kBinaryMarker, an opcode, two zero bytes
+//           and a little-endian 32-bit value. Opcodes below kActionOpcode
+//           are a Setting; kActionOpcode | n fires InputAction n. Values
+//           are enum indices, counts, 0/1, the bits of a float
+//           (Amplification) or 0x00RRGGBB (Color).
+//
+// Text lines never start with a zero byte, so the first byte of each
+// message tells the two apart. Nothing is sent back.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_CONTROL_PROTOCOL_H
+#define SPECTRUM_CPP_CONTROL_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Spectrum::ControlProtocol {
+
+    inline constexpr wchar_t kDefaultPipeName[] = L"\\\\.\\pipe\\SpectrumCpp.Control";
+
+    inline constexpr uint8_t kBinaryMarker = 0x00;
+    inline constexpr uint8_t kActionOpcode = 0x80;
+    inline constexpr size_t  kRecordSize = 8;
+    inline constexpr size_t  kMaxLineLength = 256;
+
+    enum class Setting : uint8_t {
+        Style,          // RenderStyle index
+        Quality,        // RenderQuality index
+        BarCount,
+        FFTWindow,      // FFTWindowType index
+        SpectrumScale,  // SpectrumScale index
+        Animation,      // 0 or 1
+        Amplification,  // float bits
+        Color,          // 0x00RRGGBB
+        Count
+    };
+
+    // Keywords of the text form, indexed by Setting.
+    inline constexpr const char* kSettingNames[] = {
+        "style", "quality", "bars", "window", "scale", "animation", "amplification", "color"
+    };
+    static_assert(sizeof(kSettingNames) / sizeof(kSettingNames[0]) == static_cast<size_t>(Setting::Count));
+
+    inline constexpr const char* kActionName = "action";
+
+    inline void EncodeRecord(uint8_t opcode, uint32_t value, uint8_t (&out)[kRecordSize]) noexcept {
+        out[0] = kBinaryMarker;
+        out[1] = opcode;
+        out[2] = 0;
+        out[3] = 0;
+        for (int i = 0; i < 4; ++i)
+            out[4 + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    inline void EncodeSetting(Setting setting, uint32_t value, uint8_t (&out)[kRecordSize]) noexcept {
+        EncodeRecord(static_cast<uint8_t>(setting), value, out);
+    }
+
+    inline void EncodeSetting(Setting setting, float value, uint8_t (&out)[kRecordSize]) noexcept {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        EncodeRecord(static_cast<uint8_t>(setting), bits, out);
+    }
+
+    inline void EncodeAction(uint32_t action, uint8_t (&out)[kRecordSize]) noexcept {
+        EncodeRecord(static_cast<uint8_t>(kActionOpcode | action), 0, out);
+    }
+
+} // namespace Spectrum::ControlProtocol
+
+#endif // SPECTRUM_CPP_CONTROL_PROTOCOL_H
@@ -0,0 +1,132 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ControlServer.cpp: Named pipe lifetime and the overlapped read loop.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "ControlServer.h"
+#include "ControlDecoder.h"
+
+namespace Spectrum::Platform {
+
+    ControlServer::~ControlServer() {
+        Shutdown();
+    }
+
+    bool ControlServer::Initialize(const wchar_t* name) {
+        Shutdown();
+
+        // The first instance flag makes a second copy of the app fail here
+        // instead of silently sharing the name.
+        m_pipe = CreateNamedPipeW(
+            name,
+            PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+            1,
+            0,
+            kBufferSize,
+            0,
+            nullptr
+        );
+        if (m_pipe == INVALID_HANDLE_VALUE) {
+            LOG_WARNING("ControlServer: cannot create control pipe (another instance running?)");
+            return false;
+        }
+
+        m_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!m_stopEvent) {
+            LOG_ERROR("ControlServer: CreateEvent failed");
+            Shutdown();
+            return false;
+        }
+
+        m_thread = std::thread([this] { Run(); });
+        LOG_INFO("ControlServer: listening on control pipe");
+        return true;
+    }
+
+    void ControlServer::Shutdown() noexcept {
+        if (m_stopEvent) SetEvent(m_stopEvent);
+        if (m_thread.joinable()) m_thread.join();
+
+        if (m_pipe != INVALID_HANDLE_VALUE) CloseHandle(m_pipe);
+        if (m_stopEvent) CloseHandle(m_stopEvent);
+        m_pipe = INVALID_HANDLE_VALUE;
+        m_stopEvent = nullptr;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Worker thread
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void ControlServer::Run() {
+        OVERLAPPED ov{};
+        ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!ov.hEvent) {
+            LOG_ERROR("ControlServer: CreateEvent failed");
+            return;
+        }
+
+        // One pipe instance, reused for each client in turn.
+        while (ServeClient(ov))
+            DisconnectNamedPipe(m_pipe);
+
+        DisconnectNamedPipe(m_pipe);
+        CloseHandle(ov.hEvent);
+    }
+
+    bool ControlServer::ServeClient(OVERLAPPED& ov) {
+        DWORD transferred = 0;
+
+        if (!ConnectNamedPipe(m_pipe, &ov)) {
+            const DWORD error = GetLastError();
+            if (error == ERROR_IO_PENDING) {
+                if (!Wait(ov)) return false;
+                if (!GetOverlappedResult(m_pipe, &ov, &transferred, FALSE)) return true;
+            }
+            else if (error != ERROR_PIPE_CONNECTED) {
+                // A client that left before we saw it, or a transient error.
+                return WaitForSingleObject(m_stopEvent, kRetryMs) == WAIT_TIMEOUT;
+            }
+        }
+
+        LOG_INFO("ControlServer: client connected");
+
+        ControlDecoder decoder;
+        char buffer[kBufferSize];
+        bool running = true;
+
+        for (;;) {
+            if (!ReadFile(m_pipe, buffer, kBufferSize, nullptr, &ov)
+                && GetLastError() != ERROR_IO_PENDING)
+                break;
+
+            if (!Wait(ov)) {
+                running = false;
+                break;
+            }
+
+            if (!GetOverlappedResult(m_pipe, &ov, &transferred, FALSE) || transferred == 0)
+                break;
+
+            decoder.Feed(buffer, transferred, *m_bus);
+        }
+
+        const auto& stats = decoder.GetStats();
+        LOG_INFO("ControlServer: client gone after " << stats.messages << " messages ("
+            << stats.coalesced << " coalesced, " << stats.malformed << " malformed, "
+            << stats.dropped << " dropped)");
+        return running;
+    }
+
+    bool ControlServer::Wait(OVERLAPPED& ov) const {
+        const HANDLE handles[] = { m_stopEvent, ov.hEvent };
+        if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1)
+            return true;
+
+        // The kernel may still write into `ov` until the cancel lands.
+        DWORD ignored = 0;
+        CancelIoEx(m_pipe, &ov);
+        GetOverlappedResult(m_pipe, &ov, &ignored, TRUE);
+        return false;
+    }
+
+} // namespace Spectrum::Platform
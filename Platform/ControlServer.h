@@ -0,0 +1,61 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ControlServer.h: Listens on a local named pipe for control messages (see
+// ControlProtocol.h) and publishes them on the EventBus, so they are
+// handled in the frame loop exactly like keyboard actions. One client at a
+// time; a new one can connect as soon as the previous one hangs up. All
+// pipe I/O is overlapped on a worker thread that waits on the pipe and a
+// stop event together, so Shutdown never hangs on a silent client.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#ifndef SPECTRUM_CPP_CONTROL_SERVER_H
+#define SPECTRUM_CPP_CONTROL_SERVER_H
+
+#include "Common/Common.h"
+#include "ControlProtocol.h"
+#include <thread>
+
+namespace Spectrum {
+    class EventBus;
+}
+
+namespace Spectrum::Platform {
+
+    class ControlServer final {
+    public:
+        explicit ControlServer(EventBus* bus) : m_bus(bus) {}
+        ~ControlServer();
+
+        ControlServer(const ControlServer&) = delete;
+        ControlServer& operator=(const ControlServer&) = delete;
+        ControlServer(ControlServer&&) = delete;
+        ControlServer& operator=(ControlServer&&) = delete;
+
+        // False if the pipe cannot be created, e.g. because another
+        // instance already owns the name.
+        [[nodiscard]] bool Initialize(const wchar_t* name = ControlProtocol::kDefaultPipeName);
+        void Shutdown() noexcept;
+
+        [[nodiscard]] bool IsActive() const noexcept { return m_thread.joinable(); }
+
+    private:
+        static constexpr DWORD kBufferSize = 4096;
+        static constexpr DWORD kRetryMs = 250;
+
+        void Run();
+
+        // Accepts one client and reads until it hangs up; false once
+        // Shutdown asked to stop.
+        bool ServeClient(OVERLAPPED& ov);
+
+        // True once `ov` completes; false if Shutdown asked to stop.
+        [[nodiscard]] bool Wait(OVERLAPPED& ov) const;
+
+        EventBus*    m_bus;
+        HANDLE       m_pipe = INVALID_HANDLE_VALUE;
+        HANDLE       m_stopEvent = nullptr;
+        std::thread  m_thread;
+    };
+
+} // namespace Spectrum::Platform
+
+#endif // SPECTRUM_CPP_CONTROL_SERVER_H
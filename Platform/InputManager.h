@@ -29,6 +29,8 @@ namespace Spectrum::Platform {
                 { VK_OEM_PLUS,  InputAction::IncreaseBarCount      },
                 { 'R',          InputAction::SwitchRenderer        },
                 { 'Q',          InputAction::CycleQuality          },
+                { 'L',          InputAction::ToggleLayout          },
+                { 'C',          InputAction::Calibrate             },
                 { 'O',          InputAction::ToggleOverlay         },
                 { VK_ESCAPE,    InputAction::Exit                  },
             };
@@ -321,8 +321,7 @@ namespace Spectrum::Platform {
         if (!m_controller) return;
 
         if (auto* rm = m_controller->GetRendererManager())
-            if (auto* r = rm->GetCurrentRenderer())
-                r->SetOverlayMode(m_isOverlay);
+            rm->SetOverlayMode(m_isOverlay);
     }
 
     // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
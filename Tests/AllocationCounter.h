@@ -0,0 +1,37 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// AllocationCounter.h: Replaces global operator new with one that counts
+// calls, for tests that check a steady frame stays off the heap. Include it
+// in exactly one file of a test executable.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_ALLOCATION_COUNTER_H
+#define SPECTRUM_CPP_ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace Spectrum::Tests {
+
+    inline std::atomic<size_t> g_heapAllocations{ 0 };
+
+    [[nodiscard]] inline size_t HeapAllocations() noexcept { return g_heapAllocations.load(); }
+
+} // namespace Spectrum::Tests
+
+void* operator new(std::size_t bytes) {
+    ++Spectrum::Tests::g_heapAllocations;
+    if (void* p = std::malloc(bytes == 0 ? 1 : bytes)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t bytes) {
+    return operator new(bytes);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#endif // SPECTRUM_CPP_ALLOCATION_COUNTER_H
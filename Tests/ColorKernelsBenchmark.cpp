@@ -0,0 +1,189 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ColorKernelsBenchmark.cpp: Checks the color kernels and the gradient bake
+// built on them against the plain per-color loops they replaced, then
+// times both: a lerp run, a mip level of pair averages, and a full ramp
+// bake, where the scalar version searches for the segment of every cell.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Common/ColorKernels.h"
+#include "Common/GradientRamp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    constexpr size_t kColors = 4096;
+
+    [[nodiscard]] Color Lerp(const Color& a, const Color& b, float t) noexcept {
+        return { a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t,
+                 a.b + (b.b - a.b) * t, a.a + (b.a - a.a) * t };
+    }
+
+    [[nodiscard]] float MaxDifference(const Color& a, const Color& b) noexcept {
+        return std::max({ std::fabs(a.r - b.r), std::fabs(a.g - b.g),
+                          std::fabs(a.b - b.b), std::fabs(a.a - b.a) });
+    }
+
+    std::vector<GradientStop> MakeStops() {
+        return {
+            { 0.0f,  Color(0.0f, 0.0f, 0.2f, 1.0f) },
+            { 0.3f,  Color(0.1f, 0.6f, 0.9f, 0.8f) },
+            { 0.3f,  Color(0.9f, 0.9f, 0.1f, 1.0f) },
+            { 0.55f, Color(1.0f, 0.4f, 0.0f, 0.6f) },
+            { 1.0f,  Color(1.0f, 1.0f, 1.0f, 1.0f) }
+        };
+    }
+
+    // Level 0 the way GradientRamp baked it before the kernels: stops
+    // evaluated at cell centers, segment found per cell.
+    void ScalarBake(const std::vector<GradientStop>& stops, Span<Color> out) {
+        const size_t size = out.size();
+        size_t seg = 0;
+        for (size_t i = 0; i < size; ++i) {
+            const float t = (static_cast<float>(i) + 0.5f) / static_cast<float>(size);
+            while (seg + 1 < stops.size() && stops[seg + 1].position <= t) ++seg;
+
+            const GradientStop& a = stops[seg];
+            if (t <= a.position || seg + 1 == stops.size()) {
+                out[i] = a.color;
+                continue;
+            }
+            const GradientStop& b = stops[seg + 1];
+            const float span = b.position - a.position;
+            out[i] = span > 0.0f ? Lerp(a.color, b.color, (t - a.position) / span) : b.color;
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Accuracy
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TestLerpRunMatchesLerp() {
+        const Color from(0.1f, 0.2f, 0.9f, 1.0f);
+        const Color to(0.8f, 0.0f, 0.3f, 0.5f);
+        std::vector<Color> run(kColors);
+        const float dt = 1.0f / static_cast<float>(kColors);
+        ColorKernels::LerpRun(from, to, 0.5f * dt, dt, Span<Color>(run));
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < kColors; ++i)
+            maxError = std::max(maxError, MaxDifference(run[i], Lerp(from, to, (static_cast<float>(i) + 0.5f) * dt)));
+        CHECK(maxError < 1e-6f);
+    }
+
+    void TestAveragePairsIsExact() {
+        std::vector<Color> src(kColors);
+        for (size_t i = 0; i < kColors; ++i)
+            src[i] = Color(static_cast<float>(i % 7) / 6.0f, 0.25f, static_cast<float>(i) / kColors, 1.0f);
+
+        std::vector<Color> dst(kColors / 2);
+        ColorKernels::AveragePairs(src.data(), Span<Color>(dst));
+        for (size_t i = 0; i < dst.size(); ++i)
+            CHECK(MaxDifference(dst[i], Lerp(src[2 * i], src[2 * i + 1], 0.5f)) == 0.0f);
+    }
+
+    // Coincident stops make a hard edge; both bakes must put it on the
+    // same cell.
+    void TestRampMatchesScalarBake() {
+        const auto stops = MakeStops();
+        for (const size_t size : { size_t{ 16 }, GradientRamp::kDefaultSize, GradientRamp::kMaxSize }) {
+            const GradientRamp ramp(stops, size);
+            std::vector<Color> reference(size);
+            ScalarBake(stops, Span<Color>(reference));
+
+            float maxError = 0.0f;
+            for (size_t i = 0; i < size; ++i) {
+                const float t = (static_cast<float>(i) + 0.5f) / static_cast<float>(size);
+                maxError = std::max(maxError, MaxDifference(ramp.Sample(t), reference[i]));
+            }
+            std::printf("  ramp %4zu max difference vs scalar bake: %.2g\n", size, maxError);
+            CHECK(maxError < 1e-6f);
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Timing
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void BenchmarkKernels(int iterations) {
+        const Color from(0.1f, 0.2f, 0.9f, 1.0f);
+        const Color to(0.8f, 0.0f, 0.3f, 0.5f);
+        const float dt = 1.0f / static_cast<float>(kColors);
+        std::vector<Color> run(kColors);
+
+        const double scalarLerp = Tests::Measure(iterations, [&] {
+            for (size_t i = 0; i < kColors; ++i)
+                run[i] = Lerp(from, to, static_cast<float>(i) * dt);
+            Tests::KeepAlive(run[kColors / 2]);
+        });
+        const double kernelLerp = Tests::Measure(iterations, [&] {
+            ColorKernels::LerpRun(from, to, 0.0f, dt, Span<Color>(run));
+            Tests::KeepAlive(run[kColors / 2]);
+        });
+
+        std::vector<Color> half(kColors / 2);
+        const double scalarAverage = Tests::Measure(iterations, [&] {
+            for (size_t i = 0; i < half.size(); ++i)
+                half[i] = Lerp(run[2 * i], run[2 * i + 1], 0.5f);
+            Tests::KeepAlive(half[half.size() / 2]);
+        });
+        const double kernelAverage = Tests::Measure(iterations, [&] {
+            ColorKernels::AveragePairs(run.data(), Span<Color>(half));
+            Tests::KeepAlive(half[half.size() / 2]);
+        });
+
+        Tests::Report("lerp 4096, scalar loop", scalarLerp);
+        Tests::Report("lerp 4096, LerpRun", kernelLerp);
+        Tests::Report("average 4096 -> 2048, scalar loop", scalarAverage);
+        Tests::Report("average 4096 -> 2048, AveragePairs", kernelAverage);
+    }
+
+    // Both sides allocate their tables; the ramp also sorts and hashes its
+    // stops, which is part of what a bake costs.
+    void BenchmarkRampBake(int iterations) {
+        const auto stops = MakeStops();
+
+        for (const size_t size : { GradientRamp::kDefaultSize, GradientRamp::kMaxSize }) {
+            const double scalar = Tests::Measure(iterations, [&] {
+                std::vector<Color> texels(2 * size);
+                ScalarBake(stops, Span<Color>(texels.data(), size));
+
+                size_t offset = 0;
+                for (size_t n = size; n > 1; n >>= 1) {
+                    for (size_t i = 0; i < n / 2; ++i)
+                        texels[offset + n + i] = Lerp(texels[offset + 2 * i], texels[offset + 2 * i + 1], 0.5f);
+                    offset += n;
+                }
+                Tests::KeepAlive(texels[size / 2]);
+            });
+            const double kernel = Tests::Measure(iterations, [&] {
+                const GradientRamp ramp(stops, size);
+                Tests::KeepAlive(ramp.Sample(0.5f));
+            });
+
+            const bool large = size == GradientRamp::kMaxSize;
+            Tests::Report(large ? "ramp 4096, scalar bake" : "ramp 256, scalar bake", scalar);
+            Tests::Report(large ? "ramp 4096, GradientRamp" : "ramp 256, GradientRamp", kernel);
+        }
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main(int argc, char** argv) {
+    using namespace Spectrum;
+    const bool quick = Tests::IsQuickRun(argc, argv);
+
+    TestLerpRunMatchesLerp();
+    TestAveragePairsIsExact();
+    TestRampMatchesScalarBake();
+
+    BenchmarkKernels(quick ? 10 : 20000);
+    BenchmarkRampBake(quick ? 10 : 20000);
+    return Tests::Finish("ColorKernelsBenchmark");
+}
@@ -0,0 +1,241 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ControlDecoderBenchmark.cpp: Checks how ControlDecoder reassembles,
+// coalesces and rejects control messages, then measures its throughput on
+// 4 KB reads of text and of binary records, and the latency from a client
+// thread's Feed to the frame thread's Dispatch running the handler.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Common/EventBus.h"
+#include "Platform/ControlDecoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    using Platform::ControlDecoder;
+    using Platform::ControlEvent;
+    using ControlProtocol::Setting;
+
+    constexpr size_t kReadSize = 4096;
+
+    // Collects what a frame would see after Dispatch.
+    struct Sink {
+        std::vector<ControlEvent> settings;
+        std::vector<InputAction>  actions;
+
+        explicit Sink(EventBus& bus) {
+            bus.Subscribe<ControlEvent>([this](const ControlEvent& e) { settings.push_back(e); });
+            bus.Subscribe<ActionEvent>([this](const ActionEvent& e) { actions.push_back(e.action); });
+        }
+    };
+
+    void Feed(ControlDecoder& decoder, EventBus& bus, const std::string& text) {
+        decoder.Feed(text.data(), text.size(), bus);
+    }
+
+    std::string Record(Setting setting, uint32_t value) {
+        uint8_t bytes[ControlProtocol::kRecordSize];
+        ControlProtocol::EncodeSetting(setting, value, bytes);
+        return std::string(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Decoding
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TestSplitReadsReassemble() {
+        EventBus bus;
+        Sink sink(bus);
+        ControlDecoder decoder;
+
+        Feed(decoder, bus, "style Cu");
+        bus.Dispatch();
+        CHECK(sink.settings.empty());
+
+        const std::string record = Record(Setting::BarCount, 96);
+        Feed(decoder, bus, "bes\n" + record.substr(0, 3));
+        Feed(decoder, bus, record.substr(3));
+        bus.Dispatch();
+
+        CHECK(sink.settings.size() == 2);
+        CHECK(sink.settings[0].setting == Setting::Style);
+        CHECK(sink.settings[0].value == static_cast<uint32_t>(RenderStyle::Cubes));
+        CHECK(sink.settings[1].setting == Setting::BarCount);
+        CHECK(sink.settings[1].value == 96);
+    }
+
+    void TestReadIsCoalesced() {
+        EventBus bus;
+        Sink sink(bus);
+        ControlDecoder decoder;
+
+        std::string text = "action SwitchRenderer\n";
+        for (int i = 1; i <= 100; ++i) text += "bars " + std::to_string(i) + "\n";
+        text += "color 2,0.5,-1\naction Exit\n";
+        Feed(decoder, bus, text);
+        bus.Dispatch();
+
+        CHECK(sink.actions.size() == 2);
+        CHECK(sink.actions[0] == InputAction::SwitchRenderer);
+        CHECK(sink.actions[1] == InputAction::Exit);
+
+        CHECK(sink.settings.size() == 2);
+        CHECK(sink.settings[0].setting == Setting::BarCount);
+        CHECK(sink.settings[0].value == 100);
+        CHECK(sink.settings[1].setting == Setting::Color);
+        CHECK(sink.settings[1].color.r == 1.0f && sink.settings[1].color.b == 0.0f);
+
+        CHECK(decoder.GetStats().messages == 103);
+        CHECK(decoder.GetStats().coalesced == 99);
+    }
+
+    void TestMalformedIsSkipped() {
+        EventBus bus;
+        Sink sink(bus);
+        ControlDecoder decoder;
+
+        Feed(decoder, bus, "bars 0\nbars 12x\ncolor 1,1\nstyle Nope\nfoo 1\naction Nope\n");
+        Feed(decoder, bus, Record(Setting::Quality, 99));
+
+        // Overlong: dropped up to its newline even across reads.
+        Feed(decoder, bus, std::string(ControlProtocol::kMaxLineLength + 10, 'x'));
+        Feed(decoder, bus, "yyyy\nquality High\n");
+        bus.Dispatch();
+
+        CHECK(decoder.GetStats().malformed == 8);
+        CHECK(sink.actions.empty());
+        CHECK(sink.settings.size() == 1);
+        CHECK(sink.settings[0].value == static_cast<uint32_t>(RenderQuality::High));
+    }
+
+    void TestFullBusCountsDrops() {
+        EventBus bus;
+        Sink sink(bus);
+        ControlDecoder decoder;
+
+        std::string text;
+        for (size_t i = 0; i < EventBus::kQueueCapacity + 10; ++i) text += "action Calibrate\n";
+        Feed(decoder, bus, text);
+
+        CHECK(decoder.GetStats().dropped == 10);
+        CHECK(bus.Dispatch() == EventBus::kQueueCapacity);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Throughput
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    // Whole messages only, so every read decodes the same.
+    std::string FillRead(const std::vector<std::string>& messages, size_t& count) {
+        std::string read;
+        count = 0;
+        for (size_t i = 0; read.size() + messages[i % messages.size()].size() <= kReadSize; ++i, ++count)
+            read += messages[i % messages.size()];
+        return read;
+    }
+
+    void BenchmarkThroughput(int iterations) {
+        const std::vector<std::string> text = {
+            "bars 96\n", "color 1,0.5,0\n", "amplification 1.5\n", "style Cubes\n", "quality High\n"
+        };
+
+        uint32_t bits = 0;
+        const float amount = 1.5f;
+        std::memcpy(&bits, &amount, sizeof(bits));
+        const std::vector<std::string> binary = {
+            Record(Setting::BarCount, 96), Record(Setting::Color, 0xFF8000),
+            Record(Setting::Amplification, bits), Record(Setting::Style, 3), Record(Setting::Quality, 2)
+        };
+
+        for (const auto* kind : { &text, &binary }) {
+            size_t messages = 0;
+            const std::string read = FillRead(*kind, messages);
+
+            EventBus bus;
+            Sink sink(bus);
+            ControlDecoder decoder;
+
+            const double perRead = Tests::Measure(iterations, [&] {
+                decoder.Feed(read.data(), read.size(), bus);
+                bus.Dispatch();
+                sink.settings.clear();
+            });
+
+            const double perMessage = perRead / static_cast<double>(messages);
+            std::printf("  %-6s %4zu msg per read  %8.1f ns/msg  %6.1f M msg/s\n",
+                kind == &text ? "text" : "binary", messages, perMessage, 1e3 / perMessage);
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Latency
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    // One line per read, as a client sending single commands produces.
+    // The client stays a few messages ahead so the bus never fills.
+    void BenchmarkLatency(uint32_t messages) {
+        using Clock = std::chrono::steady_clock;
+        constexpr uint32_t kInFlight = 64;
+
+        EventBus bus;
+        ControlDecoder decoder;
+        std::vector<Clock::time_point> sent(messages + 1);
+        std::vector<double> latencyUs;
+        latencyUs.reserve(messages);
+        std::atomic<uint32_t> received{ 0 };
+
+        bus.Subscribe<ControlEvent>([&](const ControlEvent& e) {
+            const std::chrono::duration<double, std::micro> d = Clock::now() - sent[e.value];
+            latencyUs.push_back(d.count());
+            received.fetch_add(1, std::memory_order_release);
+        });
+
+        std::thread client([&] {
+            std::string line;
+            for (uint32_t i = 1; i <= messages; ++i) {
+                while (i - received.load(std::memory_order_acquire) > kInFlight)
+                    std::this_thread::yield();
+                line = "bars " + std::to_string(i) + "\n";
+                sent[i] = Clock::now();
+                decoder.Feed(line.data(), line.size(), bus);
+            }
+        });
+
+        while (received.load(std::memory_order_acquire) < messages) {
+            if (bus.Dispatch() == 0) std::this_thread::yield();
+        }
+        client.join();
+
+        CHECK(latencyUs.size() == messages);
+        CHECK(decoder.GetStats().dropped == 0);
+
+        std::sort(latencyUs.begin(), latencyUs.end());
+        std::printf("  Feed -> Dispatch latency over %u messages: p50 %.1f us, p99 %.1f us\n",
+            messages, latencyUs[latencyUs.size() / 2], latencyUs[latencyUs.size() * 99 / 100]);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main(int argc, char** argv) {
+    using namespace Spectrum;
+    const bool quick = Tests::IsQuickRun(argc, argv);
+
+    TestSplitReadsReassemble();
+    TestReadIsCoalesced();
+    TestMalformedIsSkipped();
+    TestFullBusCountsDrops();
+
+    BenchmarkThroughput(quick ? 10 : 20000);
+    BenchmarkLatency(quick ? 2000 : 100000);
+    return Tests::Finish("ControlDecoderBenchmark");
+}
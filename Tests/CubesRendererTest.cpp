@@ -0,0 +1,115 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// CubesRendererTest.cpp: Runs CubesRenderer against the recording canvas
+// and checks that a frame issues one mesh draw per opacity bucket and face
+// kind, however many bars there are, plus one shadow mesh when enabled.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "RecordingCanvas.h"
+#include "Graphics/Visualizers/CubesRenderer.h"
+#include "Graphics/Visualizers/Settings/QualityPresets.h"
+
+namespace Spectrum {
+namespace {
+
+    // CubesRenderer's opacity levels; a ramp over enough bars hits each.
+    constexpr size_t kAlphaBuckets = 32;
+    constexpr float kMinMagnitude = 0.01f;
+
+    // Wide enough per bar that no face is culled as thinner than a pixel.
+    constexpr int kWidthPerBar = 20;
+    constexpr int kHeight = 600;
+
+    SpectrumData MakeRamp(size_t bars) {
+        SpectrumData spectrum(bars, 0.0f);
+        for (size_t i = 0; i < bars; ++i)
+            spectrum[i] = static_cast<float>(i) / static_cast<float>(bars - 1);
+        return spectrum;
+    }
+
+    size_t VisibleCubes(const SpectrumData& spectrum) {
+        size_t n = 0;
+        for (size_t i = 0; i < spectrum.size(); ++i)
+            if (spectrum[i] >= kMinMagnitude) ++n;
+        return n;
+    }
+
+    size_t FaceKinds(RenderQuality quality) {
+        const auto settings = QualityPresets::Get<CubesRenderer>(quality);
+        return 1 + (settings.useSideFace ? 1 : 0) + (settings.useTopFace ? 1 : 0);
+    }
+
+    void TestOneDrawPerBucketAndFace() {
+        for (const size_t bars : { size_t{ 128 }, size_t{ 512 }, size_t{ 2048 } }) {
+            CubesRenderer renderer;
+            renderer.OnActivate(static_cast<int>(bars) * kWidthPerBar, kHeight);
+            Canvas canvas(nullptr, nullptr);
+            const SpectrumData spectrum = MakeRamp(bars);
+
+            for (int q = 0; q < static_cast<int>(RenderQuality::Count); ++q) {
+                const auto quality = static_cast<RenderQuality>(q);
+                renderer.SetQuality(quality);
+
+                canvas.ResetFrameArena();
+                Tests::Recording().Clear();
+                renderer.Render(canvas, spectrum, FRAME_TIME);
+
+                const auto& recording = Tests::Recording();
+                const size_t faces = FaceKinds(quality);
+                CHECK(recording.Count(Tests::DrawKind::Mesh, 0) == kAlphaBuckets * faces);
+                CHECK(recording.transformDepth == 0);
+
+                // Every visible face of every cube is in exactly one draw.
+                size_t indices = 0;
+                for (const auto& d : recording.draws)
+                    if (d.transformDepth == 0) indices += d.indexCount;
+                CHECK(indices == VisibleCubes(spectrum) * faces * 6);
+
+                const bool shadow = QualityPresets::Get<CubesRenderer>(quality).useShadow;
+                CHECK(recording.Count(Tests::DrawKind::Mesh, 1) == (shadow ? 1u : 0u));
+                CHECK(recording.draws.size() == kAlphaBuckets * faces + (shadow ? 1 : 0));
+            }
+        }
+    }
+
+    bool SameColor(const Color& a, const Color& b) {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+
+    // No two draws share a color, i.e. no bucket was split across draws.
+    void TestDrawsHaveDistinctColors() {
+        CubesRenderer renderer;
+        renderer.OnActivate(256 * kWidthPerBar, kHeight);
+        renderer.SetQuality(RenderQuality::Ultra);
+        Canvas canvas(nullptr, nullptr);
+
+        Tests::Recording().Clear();
+        renderer.Render(canvas, MakeRamp(256), FRAME_TIME);
+
+        const auto& draws = Tests::Recording().draws;
+        for (size_t i = 0; i < draws.size(); ++i)
+            for (size_t j = i + 1; j < draws.size(); ++j)
+                if (draws[i].transformDepth == 0 && draws[j].transformDepth == 0)
+                    CHECK(!SameColor(draws[i].color, draws[j].color));
+    }
+
+    void TestSilenceDrawsNothing() {
+        CubesRenderer renderer;
+        renderer.OnActivate(800, kHeight);
+        Canvas canvas(nullptr, nullptr);
+
+        Tests::Recording().Clear();
+        renderer.Render(canvas, SpectrumData(64, 0.0f), FRAME_TIME);
+        CHECK(Tests::Recording().draws.empty());
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestOneDrawPerBucketAndFace();
+    TestDrawsHaveDistinctColors();
+    TestSilenceDrawsNothing();
+    return Tests::Finish("CubesRendererTest");
+}
@@ -0,0 +1,239 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// DirtyRegionTest.cpp: Merging, snapping, capacity folding, clipping to the
+// surface and the full-redraw threshold of the damage tracker, and the
+// stroke outset that pads path bounds before they are added.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Common/DirtyRegion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Spectrum {
+namespace {
+
+    bool Equals(const Rect& a, const Rect& b) {
+        return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+    }
+
+    bool Overlap(const Rect& a, const Rect& b) {
+        return a.x < b.GetRight() && b.x < a.GetRight()
+            && a.y < b.GetBottom() && b.y < a.GetBottom();
+    }
+
+    bool NoneOverlap(const DirtyRegion& region) {
+        const auto rects = region.GetRects();
+        for (size_t i = 0; i < rects.size(); ++i)
+            for (size_t j = i + 1; j < rects.size(); ++j)
+                if (Overlap(rects[i], rects[j])) return false;
+        return true;
+    }
+
+    void TestEmptyRegion() {
+        DirtyRegion region;
+        CHECK(region.IsEmpty());
+        CHECK(region.GetRects().empty());
+        CHECK(region.GetArea() == 0.0f);
+        CHECK(Equals(region.GetBounds(), Rect{}));
+        CHECK(!region.CoversMostOf({ 0, 0, 100, 100 }));
+
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const float inf = std::numeric_limits<float>::infinity();
+        region.Add({ 10, 10, 0, 5 });
+        region.Add({ 10, 10, 5, -1 });
+        region.Add({ nan, 10, 5, 5 });
+        region.Add({ 10, 10, inf, 5 });
+        region.Add({ 10, 10, nan, 5 });
+        CHECK(region.IsEmpty());
+
+        region.ClipTo({ 0, 0, 100, 100 });
+        CHECK(region.IsEmpty());
+    }
+
+    void TestSnapsOutwardWithEdgeMargin() {
+        DirtyRegion region;
+        region.Add({ 10.2f, 20.7f, 5.0f, 5.0f });
+
+        CHECK(region.GetRects().size() == 1);
+        CHECK(Equals(region.GetRects()[0], Rect(9, 19, 8, 8)));
+    }
+
+    void TestOverlappingAndTouchingRectsMerge() {
+        DirtyRegion region;
+        region.Add({ 10, 10, 20, 20 });
+        region.Add({ 25, 15, 20, 10 });
+        CHECK(region.GetRects().size() == 1);
+        CHECK(Equals(region.GetRects()[0], Rect(9, 9, 37, 22)));
+
+        // Abutting after snapping: one rect, not two slivers.
+        DirtyRegion bars;
+        bars.Add({ 0, 50, 10, 50 });
+        bars.Add({ 10, 50, 10, 50 });
+        CHECK(bars.GetRects().size() == 1);
+
+        // Already covered: nothing changes.
+        const Rect before = region.GetRects()[0];
+        region.Add({ 20, 20, 2, 2 });
+        CHECK(region.GetRects().size() == 1);
+        CHECK(Equals(region.GetRects()[0], before));
+    }
+
+    void TestBridgeMergesTransitively() {
+        DirtyRegion region;
+        region.Add({ 0, 0, 10, 10 });
+        region.Add({ 100, 0, 10, 10 });
+        region.Add({ 200, 0, 10, 10 });
+        CHECK(region.GetRects().size() == 3);
+
+        // Meets the first and, once grown, all the others.
+        region.Add({ 5, 2, 200, 4 });
+        CHECK(region.GetRects().size() == 1);
+        CHECK(Equals(region.GetBounds(), Rect(-1, -1, 212, 12)));
+    }
+
+    void TestCapacityFoldsIntoCheapestRect() {
+        DirtyRegion region;
+        for (int i = 0; i < 20; ++i)
+            region.Add({ static_cast<float>(i) * 50.0f, static_cast<float>(i % 3) * 40.0f, 10, 10 });
+
+        CHECK(region.GetRects().size() == DirtyRegion::kMaxRects);
+        CHECK(NoneOverlap(region));
+
+        const Rect bounds = region.GetBounds();
+        CHECK(bounds.x <= -1.0f);
+        CHECK(bounds.GetRight() >= 19 * 50.0f + 11.0f);
+        CHECK(bounds.GetBottom() >= 2 * 40.0f + 11.0f);
+    }
+
+    void TestAddRegion() {
+        DirtyRegion a;
+        a.Add({ 0, 0, 10, 10 });
+
+        DirtyRegion b;
+        b.Add({ 5, 5, 10, 10 });
+        b.Add({ 100, 100, 10, 10 });
+
+        a.Add(b);
+        CHECK(a.GetRects().size() == 2);
+        CHECK(Equals(a.GetBounds(), Rect(-1, -1, 112, 112)));
+    }
+
+    void TestClipToSurface() {
+        const Rect surface(0, 0, 100, 80);
+
+        DirtyRegion region;
+        region.Add({ -20, 10, 40, 10 });     // hangs off the left edge
+        region.Add({ 90, 70, 40, 40 });      // hangs off the bottom right
+        region.Add({ 300, 300, 10, 10 });    // entirely off screen
+        region.Add({ 40, -50, 10, 20 });     // entirely above
+        CHECK(region.GetRects().size() == 4);
+
+        region.ClipTo(surface);
+        CHECK(region.GetRects().size() == 2);
+        for (const Rect& r : region.GetRects()) {
+            CHECK(r.x >= surface.x && r.y >= surface.y);
+            CHECK(r.GetRight() <= surface.GetRight());
+            CHECK(r.GetBottom() <= surface.GetBottom());
+            CHECK(r.width > 0.0f && r.height > 0.0f);
+        }
+        CHECK(Equals(region.GetBounds(), Rect(0, 9, 100, 71)));
+
+        region.ClipTo({ 500, 500, 10, 10 });
+        CHECK(region.IsEmpty());
+    }
+
+    void TestFullRedrawThreshold() {
+        const Rect surface(0, 0, 100, 100);
+
+        // Snapped to whole rows of the surface: 50% and 60% of it.
+        DirtyRegion half;
+        half.Add({ 1, 1, 98, 48 });
+        CHECK(half.GetArea() == 5000.0f);
+        CHECK(!half.CoversMostOf(surface));
+
+        DirtyRegion most;
+        most.Add({ 1, 1, 98, 58 });
+        CHECK(most.GetArea() == 6000.0f);
+        CHECK(most.CoversMostOf(surface));
+
+        // Scattered rects count by their summed area.
+        DirtyRegion scattered;
+        for (int i = 0; i < 4; ++i)
+            scattered.Add({ static_cast<float>(i) * 25.0f + 1.0f, 1, 18, 98 });
+        CHECK(scattered.GetRects().size() == 4);
+        CHECK(scattered.CoversMostOf(surface));
+
+        CHECK(!most.CoversMostOf({ 0, 0, 0, 0 }));
+    }
+
+    // Tip of the miter join at `v` between segments from `a` and to `b`,
+    // clipped at the miter limit the way D2D does.
+    Point MiterTip(Point a, Point v, Point b, float width, float miterLimit) {
+        const auto unit = [](float x, float y) {
+            const float len = std::sqrt(x * x + y * y);
+            return Point{ x / len, y / len };
+        };
+        const Point in = unit(v.x - a.x, v.y - a.y);
+        const Point out = unit(b.x - v.x, b.y - v.y);
+        const Point bisector = unit(in.x - out.x, in.y - out.y);
+
+        // Half the angle between the two segments at the corner.
+        const float cosAngle = -(in.x * out.x + in.y * out.y);
+        const float sinHalf = std::sqrt(0.5f * (1.0f - cosAngle));
+        const float reach = 0.5f * width * (std::min)(1.0f / sinHalf, miterLimit);
+        return { v.x + bisector.x * reach, v.y + bisector.y * reach };
+    }
+
+    // A zig-zag polyline with ever sharper corners, stroked with the
+    // default Paint::Stroke join (miter, limit 10): its bounds padded by
+    // the outset must still hold every miter tip. Half the stroke width,
+    // the old pad, misses all but the widest.
+    void TestStrokeOutsetCoversMiterTips() {
+        constexpr float kWidth = 4.0f;
+        constexpr float kMiterLimit = 10.0f;
+        const float outset = DirtyRegion::StrokeOutset(kWidth, true, kMiterLimit, false);
+        CHECK(outset == 0.5f * kWidth * kMiterLimit);
+
+        size_t missedByHalfWidth = 0;
+        for (const float rise : { 80.0f, 30.0f, 12.0f, 4.0f, 1.0f }) {
+            const Point a{ 0.0f, 0.0f };
+            const Point v{ 100.0f, rise };
+            const Point b{ 0.0f, 2.0f * rise };
+            const Point tip = MiterTip(a, v, b, kWidth, kMiterLimit);
+
+            const Rect bounds(0.0f, 0.0f, 100.0f, 2.0f * rise);
+            DirtyRegion region;
+            region.Add({ bounds.x - outset, bounds.y - outset,
+                         bounds.width + 2.0f * outset, bounds.height + 2.0f * outset });
+            const Rect covered = region.GetBounds();
+            CHECK(tip.x <= covered.GetRight() && tip.y >= covered.y && tip.y <= covered.GetBottom());
+
+            if (tip.x > bounds.GetRight() + 0.5f * kWidth + DirtyRegion::kEdgeMargin) ++missedByHalfWidth;
+        }
+        CHECK(missedByHalfWidth >= 3);
+
+        // Round and bevel joins stay within half the width; a square
+        // cap's corner does not.
+        CHECK(DirtyRegion::StrokeOutset(kWidth, false, kMiterLimit, false) == 0.5f * kWidth);
+        CHECK(DirtyRegion::StrokeOutset(kWidth, false, kMiterLimit, true) > 0.5f * kWidth * 1.41f);
+        CHECK(DirtyRegion::StrokeOutset(kWidth, true, 0.5f, false) == 0.5f * kWidth);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestEmptyRegion();
+    TestSnapsOutwardWithEdgeMargin();
+    TestOverlappingAndTouchingRectsMerge();
+    TestBridgeMergesTransitively();
+    TestCapacityFoldsIntoCheapestRect();
+    TestAddRegion();
+    TestClipToSurface();
+    TestFullRedrawThreshold();
+    TestStrokeOutsetCoversMiterTips();
+    return Tests::Finish("DirtyRegionTest");
+}
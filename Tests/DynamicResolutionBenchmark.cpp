@@ -0,0 +1,199 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// DynamicResolutionBenchmark.cpp: Drives DynamicResolution with synthetic
+// frame costs, one that follows pixel count and one that does not, then
+// times a fill-bound CPU stand-in for a visualizer at several scales
+// together with the bilinear upscale back to the window size. The tree has
+// no software Canvas backend, so the stand-in blends bars and a trail fade
+// into a plain BGRA buffer the way the fill-heavy styles touch pixels.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Graphics/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    constexpr float kBudgetMs = 8.0f;
+    constexpr int   kFrames = 2000;
+
+    constexpr int    kWindowWidth = 1920;
+    constexpr int    kWindowHeight = 1080;
+    constexpr size_t kBars = 128;
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Controller
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    // `fullMs` at scale 1, `fillShare` of it proportional to pixel count.
+    float RunFrames(DynamicResolution& res, float fullMs, float fillShare, int frames) {
+        for (int i = 0; i < frames; ++i) {
+            const float s = res.GetScale();
+            res.Update(fullMs * (1.0f - fillShare + fillShare * s * s));
+        }
+        return res.GetScale();
+    }
+
+    void TestFillBoundDropsIntoBudget() {
+        DynamicResolution res(kBudgetMs);
+        const float scale = RunFrames(res, 16.0f, 1.0f, kFrames);
+
+        std::printf("  fill-bound 16 ms -> scale %.4f, %.2f ms\n", scale, res.GetAverageMs());
+        CHECK(scale < DynamicResolution::kMaxScale);
+        CHECK(scale >= DynamicResolution::kMinScale);
+        CHECK(res.GetAverageMs() <= kBudgetMs);
+    }
+
+    void TestUnderBudgetStaysAtFullScale() {
+        DynamicResolution res(kBudgetMs);
+        CHECK(RunFrames(res, 4.0f, 1.0f, kFrames) == DynamicResolution::kMaxScale);
+    }
+
+    // A style bound by something other than fill gains nothing from a
+    // drop, which is undone.
+    void TestUselessDropIsReverted() {
+        DynamicResolution res(kBudgetMs);
+        CHECK(RunFrames(res, 16.0f, 0.0f, kFrames) == DynamicResolution::kMaxScale);
+    }
+
+    void TestRecoversWhenLoadGoes() {
+        DynamicResolution res(kBudgetMs);
+        RunFrames(res, 16.0f, 1.0f, kFrames);
+        CHECK(res.GetScale() < DynamicResolution::kMaxScale);
+        CHECK(RunFrames(res, 2.0f, 1.0f, kFrames) == DynamicResolution::kMaxScale);
+    }
+
+    void TestScalesAreQuantized() {
+        DynamicResolution res(kBudgetMs);
+        for (float ms = 4.0f; ms < 40.0f; ms += 1.5f) {
+            const float scale = RunFrames(res, ms, 1.0f, 50);
+            const float steps = scale / DynamicResolution::kScaleStep;
+            CHECK_NEAR(steps, std::round(steps), 1e-4f);
+        }
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Fill cost
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    struct Surface {
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> pixels;
+
+        Surface(int w, int h) : width(w), height(h), pixels(static_cast<size_t>(w) * h) {}
+    };
+
+    [[nodiscard]] uint32_t Channel(uint32_t c, int shift) noexcept { return (c >> shift) & 0xFF; }
+
+    [[nodiscard]] uint32_t Blend(uint32_t dst, uint32_t src, uint32_t alpha) noexcept {
+        uint32_t out = 0xFF000000u;
+        for (int shift = 0; shift < 24; shift += 8) {
+            const uint32_t d = Channel(dst, shift);
+            const uint32_t s = Channel(src, shift);
+            out |= ((d * (255 - alpha) + s * alpha) / 255) << shift;
+        }
+        return out;
+    }
+
+    // Trail fade over the whole surface, then one translucent bar per band
+    // with a vertical alpha ramp. Coordinates are in window units, so a
+    // smaller surface covers the same picture with fewer pixels.
+    void DrawFrame(Surface& target, float time) {
+        for (uint32_t& p : target.pixels) p = Blend(p, 0xFF000000u, 40);
+
+        const float sx = static_cast<float>(target.width) / kWindowWidth;
+        const float sy = static_cast<float>(target.height) / kWindowHeight;
+        const float barWidth = static_cast<float>(kWindowWidth) / kBars;
+
+        for (size_t b = 0; b < kBars; ++b) {
+            const float level = 0.5f + 0.5f * std::sin(time + static_cast<float>(b) * 0.2f);
+            const int x0 = static_cast<int>(b * barWidth * sx);
+            const int x1 = std::max(x0 + 1, static_cast<int>((b + 1) * barWidth * sx) - 1);
+            const int top = static_cast<int>((1.0f - level) * kWindowHeight * sy);
+
+            for (int y = top; y < target.height; ++y) {
+                const uint32_t alpha = 64 + static_cast<uint32_t>(191 * (y - top) / std::max(1, target.height - top));
+                uint32_t* row = &target.pixels[static_cast<size_t>(y) * target.width];
+                for (int x = x0; x < x1; ++x) row[x] = Blend(row[x], 0xFF40C0FFu, alpha);
+            }
+        }
+    }
+
+    // 16.16 fixed-point bilinear, the filter the GPU path uses.
+    void Upscale(const Surface& src, Surface& dst) {
+        const uint32_t stepX = static_cast<uint32_t>((static_cast<uint64_t>(src.width - 1) << 16) / std::max(1, dst.width - 1));
+        const uint32_t stepY = static_cast<uint32_t>((static_cast<uint64_t>(src.height - 1) << 16) / std::max(1, dst.height - 1));
+
+        for (int y = 0; y < dst.height; ++y) {
+            const uint32_t fy = static_cast<uint32_t>(y) * stepY;
+            const int y0 = static_cast<int>(fy >> 16);
+            const int y1 = std::min(y0 + 1, src.height - 1);
+            const uint32_t wy = (fy >> 8) & 0xFF;
+            const uint32_t* r0 = &src.pixels[static_cast<size_t>(y0) * src.width];
+            const uint32_t* r1 = &src.pixels[static_cast<size_t>(y1) * src.width];
+            uint32_t* out = &dst.pixels[static_cast<size_t>(y) * dst.width];
+
+            for (int x = 0; x < dst.width; ++x) {
+                const uint32_t fx = static_cast<uint32_t>(x) * stepX;
+                const int x0 = static_cast<int>(fx >> 16);
+                const int x1 = std::min(x0 + 1, src.width - 1);
+                const uint32_t wx = (fx >> 8) & 0xFF;
+
+                const uint32_t top = Blend(r0[x0], r0[x1], wx);
+                const uint32_t bottom = Blend(r1[x0], r1[x1], wx);
+                out[x] = Blend(top, bottom, wy);
+            }
+        }
+    }
+
+    void BenchmarkScales(int iterations) {
+        Surface window(kWindowWidth, kWindowHeight);
+        double fullNs = 0.0;
+
+        for (const float scale : { 1.0f, 0.75f, 0.5f }) {
+            Surface surface(static_cast<int>(kWindowWidth * scale), static_cast<int>(kWindowHeight * scale));
+            float time = 0.0f;
+
+            const double renderNs = Tests::Measure(iterations, [&] {
+                time += 0.016f;
+                DrawFrame(surface, time);
+                Tests::KeepAlive(surface.pixels[surface.pixels.size() / 2]);
+            });
+            if (scale == 1.0f) fullNs = renderNs;
+
+            double upscaleNs = 0.0;
+            if (scale < 1.0f) {
+                upscaleNs = Tests::Measure(iterations, [&] {
+                    Upscale(surface, window);
+                    Tests::KeepAlive(window.pixels[window.pixels.size() / 2]);
+                });
+            }
+
+            const double pixels = static_cast<double>(surface.pixels.size());
+            std::printf("  scale %.3f  %5.2fM px  render %7.2f ms (%3.0f%% of full)  upscale %6.2f ms\n",
+                scale, pixels * 1e-6, renderNs * 1e-6, 100.0 * renderNs / fullNs, upscaleNs * 1e-6);
+        }
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main(int argc, char** argv) {
+    using namespace Spectrum;
+    const bool quick = Tests::IsQuickRun(argc, argv);
+
+    TestFillBoundDropsIntoBudget();
+    TestUnderBudgetStaysAtFullScale();
+    TestUselessDropIsReverted();
+    TestRecoversWhenLoadGoes();
+    TestScalesAreQuantized();
+
+    BenchmarkScales(quick ? 1 : 20);
+    return Tests::Finish("DynamicResolutionBenchmark");
+}
@@ -0,0 +1,104 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// FrameArenaTest.cpp: Counts global operator new calls to check that a
+// warmed-up arena serves a whole frame without touching the heap, and
+// that an overflowing frame costs allocations only until the next Reset.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "AllocationCounter.h"
+#include "Common/FrameArena.h"
+
+namespace Spectrum {
+namespace {
+
+    // What a renderer does with the arena in one frame: a few batches
+    // grown one element at a time, as the batch types do.
+    void SimulateFrame(FrameArena& arena, size_t elements) {
+        auto points = MakeArenaVector<float>(arena);
+        for (size_t i = 0; i < elements; ++i) points.push_back(static_cast<float>(i));
+
+        auto indices = MakeArenaVector<uint32_t>(arena, elements);
+        for (size_t i = 0; i < elements; ++i) indices.push_back(static_cast<uint32_t>(i));
+
+        CHECK(points.size() == elements);
+        CHECK(indices.back() == elements - 1);
+    }
+
+    void TestSteadyFrameDoesNotAllocate() {
+        FrameArena arena(4 * 1024);
+
+        for (int frame = 0; frame < 3; ++frame) {
+            arena.Reset();
+            SimulateFrame(arena, 2000);
+        }
+
+        const size_t arenaBlocks = arena.GetHeapAllocations();
+        const size_t before = Tests::HeapAllocations();
+        for (int frame = 0; frame < 100; ++frame) {
+            arena.Reset();
+            SimulateFrame(arena, 2000);
+        }
+
+        CHECK(Tests::HeapAllocations() == before);
+        CHECK(arena.GetHeapAllocations() == arenaBlocks);
+        CHECK(arena.GetBlockCount() == 1);
+    }
+
+    void TestOverflowCoalescesOnReset() {
+        FrameArena arena(1024);
+        const size_t initial = arena.GetHeapAllocations();
+
+        for (int i = 0; i < 10; ++i)
+            (void)arena.Allocate(512, alignof(std::max_align_t));
+
+        CHECK(arena.GetBlockCount() > 1);
+        CHECK(arena.GetHeapAllocations() > initial);
+
+        const size_t capacity = arena.GetCapacity();
+        arena.Reset();
+        CHECK(arena.GetBlockCount() == 1);
+        CHECK(arena.GetCapacity() == capacity);
+
+        const size_t afterReset = arena.GetHeapAllocations();
+        for (int i = 0; i < 10; ++i)
+            (void)arena.Allocate(512, alignof(std::max_align_t));
+        CHECK(arena.GetHeapAllocations() == afterReset);
+        CHECK(arena.GetPeakBytes() >= 10 * 512);
+    }
+
+    void TestLastAllocationIsReturned() {
+        FrameArena arena(1024);
+
+        void* first = arena.Allocate(100, 16);
+        void* second = arena.Allocate(200, 16);
+        CHECK(arena.GetBytesUsed() == 300);
+
+        arena.Deallocate(first, 100);   // not the last one: ignored
+        CHECK(arena.GetBytesUsed() == 300);
+
+        arena.Deallocate(second, 200);
+        CHECK(arena.GetBytesUsed() == 100);
+        CHECK(arena.Allocate(200, 16) == second);
+    }
+
+    void TestAlignment() {
+        FrameArena arena(1024);
+        (void)arena.Allocate(1, 1);
+
+        for (size_t alignment : { 2u, 4u, 8u, 16u, 32u, 64u }) {
+            const auto addr = reinterpret_cast<std::uintptr_t>(arena.Allocate(3, alignment));
+            CHECK(addr % alignment == 0);
+        }
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestSteadyFrameDoesNotAllocate();
+    TestOverflowCoalescesOnReset();
+    TestLastAllocationIsReturned();
+    TestAlignment();
+    return Tests::Finish("FrameArenaTest");
+}
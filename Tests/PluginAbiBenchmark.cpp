@@ -0,0 +1,161 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// PluginAbiBenchmark.cpp: Cost of drawing through the plugin ABI. The
+// sample plugin is loaded as a module, the way PluginRenderer loads it,
+// and rendered into a sink that only counts the draw calls; the same
+// source is also linked into this executable and called directly. Both
+// must issue the same draws, and the difference in time per frame is the
+// ABI's overhead.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Graphics/Plugins/SpectrumPlugin.h"
+
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+// The copy of the sample plugin linked into this executable.
+extern "C" const SpPluginApi* SpectrumPluginGetApi(void);
+
+namespace Spectrum {
+namespace {
+
+    constexpr uint32_t kBins = 128;
+
+    struct Sink {
+        uint64_t calls = 0;
+        double   checksum = 0.0;
+    };
+
+    void CountRect(void* context, float x, float y, float w, float h, SpColor c) {
+        auto* sink = static_cast<Sink*>(context);
+        ++sink->calls;
+        sink->checksum += x + y * 3.0 + w * 5.0 + h * 7.0 + c.a;
+    }
+
+    void IgnoreStrokeRect(void*, float, float, float, float, float, SpColor) {}
+    void IgnoreRoundedRect(void*, float, float, float, float, float, SpColor) {}
+    void IgnoreCircle(void*, float, float, float, SpColor) {}
+    void IgnoreStrokeCircle(void*, float, float, float, float, SpColor) {}
+    void IgnoreLine(void*, float, float, float, float, float, SpColor) {}
+    void IgnorePolyline(void*, const SpPoint*, uint32_t, float, SpColor) {}
+    void IgnorePolygon(void*, const SpPoint*, uint32_t, SpColor) {}
+
+    // Loads the module the build placed next to this executable.
+    class Module {
+    public:
+        explicit Module(const char* path) {
+#if defined(_WIN32)
+            m_handle = ::LoadLibraryA(path);
+            if (m_handle)
+                m_getApi = reinterpret_cast<SpPluginGetApiFn>(
+                    ::GetProcAddress(m_handle, SPECTRUM_PLUGIN_ENTRY));
+#else
+            m_handle = ::dlopen(path, RTLD_NOW | RTLD_LOCAL);
+            if (m_handle)
+                m_getApi = reinterpret_cast<SpPluginGetApiFn>(
+                    ::dlsym(m_handle, SPECTRUM_PLUGIN_ENTRY));
+#endif
+        }
+
+        ~Module() {
+#if defined(_WIN32)
+            if (m_handle) ::FreeLibrary(m_handle);
+#else
+            if (m_handle) ::dlclose(m_handle);
+#endif
+        }
+
+        Module(const Module&) = delete;
+        Module& operator=(const Module&) = delete;
+
+        [[nodiscard]] const SpPluginApi* GetApi() const { return m_getApi ? m_getApi() : nullptr; }
+
+    private:
+#if defined(_WIN32)
+        HMODULE m_handle = nullptr;
+#else
+        void* m_handle = nullptr;
+#endif
+        SpPluginGetApiFn m_getApi = nullptr;
+    };
+
+    struct Run {
+        Sink   sink;
+        double nsPerFrame = 0.0;
+    };
+
+    Run RenderFrames(const SpPluginApi& api, int iterations) {
+        std::vector<float> bins(kBins);
+        for (uint32_t i = 0; i < kBins; ++i)
+            bins[i] = 0.1f + 0.8f * static_cast<float>(i % 13) / 12.0f;
+
+        SpFrame frame{};
+        frame.bins = bins.data();
+        frame.binCount = kBins;
+        frame.width = 1280.0f;
+        frame.height = 720.0f;
+        frame.deltaTime = 1.0f / 60.0f;
+        frame.primary = { 0.2f, 0.6f, 0.9f, 1.0f };
+
+        Run run;
+        const SpDraw draw = {
+            &run.sink,
+            CountRect, IgnoreStrokeRect, IgnoreRoundedRect,
+            IgnoreCircle, IgnoreStrokeCircle,
+            IgnoreLine, IgnorePolyline, IgnorePolygon
+        };
+
+        void* instance = api.create(nullptr, 0);
+        CHECK(instance != nullptr);
+        if (!instance) return run;
+
+        // One frame on its own, so both runs are compared on equal work.
+        api.render(instance, &frame, &draw);
+        const Sink firstFrame = run.sink;
+
+        run.nsPerFrame = Tests::Measure(iterations, [&] {
+            api.render(instance, &frame, &draw);
+        });
+        api.destroy(instance);
+
+        run.sink = firstFrame;
+        return run;
+    }
+
+    void BenchmarkAbiOverhead(int iterations) {
+        Module module(SPECTRUM_BENCH_PLUGIN);
+        const SpPluginApi* loaded = module.GetApi();
+        CHECK(loaded != nullptr);
+        if (!loaded) return;
+
+        const SpPluginApi* linked = SpectrumPluginGetApi();
+        CHECK(loaded != linked);
+        CHECK(loaded->abiVersion == SPECTRUM_PLUGIN_ABI_VERSION);
+
+        const Run direct = RenderFrames(*linked, iterations);
+        const Run viaAbi = RenderFrames(*loaded, iterations);
+
+        // Bar and peak dot per bin, identical either way.
+        CHECK(direct.sink.calls == 2 * kBins);
+        CHECK(viaAbi.sink.calls == direct.sink.calls);
+        CHECK(viaAbi.sink.checksum == direct.sink.checksum);
+
+        Tests::Report("128 bins, linked into the host", direct.nsPerFrame);
+        Tests::Report("128 bins, loaded module", viaAbi.nsPerFrame);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main(int argc, char** argv) {
+    using namespace Spectrum;
+    const bool quick = Tests::IsQuickRun(argc, argv);
+
+    BenchmarkAbiOverhead(quick ? 100 : 100000);
+    return Tests::Finish("PluginAbiBenchmark");
+}
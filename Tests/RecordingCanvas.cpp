@@ -0,0 +1,185 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RecordingCanvas.cpp: Logging definitions of the Canvas and Paint members
+// the renderer tests reach. Geometry is real (a D2D factory needs no
+// device), so renderers that test a path for null behave as in the app.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "RecordingCanvas.h"
+#include "Common/RecycledAllocation.h"
+
+namespace Spectrum {
+
+    namespace Tests {
+
+        CanvasRecording& Recording() {
+            static CanvasRecording recording;
+            return recording;
+        }
+
+    } // namespace Tests
+
+    namespace {
+
+        ID2D1Factory* Factory() {
+            static wrl::ComPtr<ID2D1Factory> factory;
+            if (!factory) {
+                D2D1CreateFactory(
+                    D2D1_FACTORY_TYPE_SINGLE_THREADED,
+                    __uuidof(ID2D1Factory),
+                    nullptr,
+                    reinterpret_cast<void**>(factory.GetAddressOf()));
+            }
+            return factory.Get();
+        }
+
+        void Record(Tests::DrawKind kind, const Paint& paint, size_t indexCount) {
+            auto& recording = Tests::Recording();
+            recording.draws.push_back({
+                kind,
+                paint.GetColor(),
+                paint.GetAlpha(),
+                paint.IsStroked() ? paint.GetStrokeWidth() : 0.0f,
+                indexCount,
+                recording.transformDepth
+                });
+        }
+
+    } // namespace
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Paint
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    struct Paint::Impl : RecycledAllocation<Paint::Impl> {
+        PaintStyle style = PaintStyle::Fill;
+        Color color = Color(1, 1, 1, 1);
+        float strokeWidth = 1.0f;
+        float alpha = 1.0f;
+        StrokeCap cap = StrokeCap::Flat;
+        StrokeJoin join = StrokeJoin::Miter;
+    };
+
+    Paint::Paint() : m_impl(std::make_unique<Impl>()) {}
+    Paint::~Paint() = default;
+    Paint::Paint(const Paint& other) : m_impl(std::make_unique<Impl>(*other.m_impl)) {}
+    Paint::Paint(Paint&&) noexcept = default;
+    Paint& Paint::operator=(Paint&&) noexcept = default;
+
+    Paint& Paint::operator=(const Paint& other) {
+        if (this != &other) *m_impl = *other.m_impl;
+        return *this;
+    }
+
+    Paint Paint::Fill(const Color& color) {
+        Paint paint;
+        paint.m_impl->style = PaintStyle::Fill;
+        paint.m_impl->color = color;
+        return paint;
+    }
+
+    Paint Paint::Stroke(const Color& color, float width) {
+        Paint paint;
+        paint.m_impl->style = PaintStyle::Stroke;
+        paint.m_impl->color = color;
+        paint.m_impl->strokeWidth = width;
+        return paint;
+    }
+
+    Paint& Paint::WithAlpha(float alpha) { m_impl->alpha = alpha; return *this; }
+    Paint& Paint::WithStrokeCap(StrokeCap cap) { m_impl->cap = cap; return *this; }
+    Paint& Paint::WithStrokeJoin(StrokeJoin join) { m_impl->join = join; return *this; }
+
+    PaintStyle Paint::GetStyle() const { return m_impl->style; }
+    Color Paint::GetColor() const { return m_impl->color; }
+    float Paint::GetStrokeWidth() const { return m_impl->strokeWidth; }
+    float Paint::GetAlpha() const { return m_impl->alpha; }
+
+    bool Paint::IsFilled() const {
+        return m_impl->style == PaintStyle::Fill || m_impl->style == PaintStyle::FillAndStroke;
+    }
+
+    bool Paint::IsStroked() const {
+        return m_impl->style == PaintStyle::Stroke || m_impl->style == PaintStyle::FillAndStroke;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Canvas
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    Canvas::Canvas(Renderer* renderer, GraphicsCore* core)
+        : m_renderer(renderer)
+        , m_core(core)
+    {
+    }
+
+    Canvas::~Canvas() noexcept = default;
+
+    FrameArena& Canvas::GetFrameArena() const noexcept { return m_frameArena; }
+
+    void Canvas::ResetFrameArena() const {
+        m_frameArena.Reset();
+        m_geometryBuilds = 0;
+    }
+
+    size_t Canvas::GetGeometryBuildCount() const noexcept { return m_geometryBuilds; }
+
+    PathGeometry Canvas::BuildWaveform(const SpectrumData& spectrum, const Rect&) const {
+        if (spectrum.size() < 2) return nullptr;
+
+        PathGeometry path;
+        if (ID2D1Factory* factory = Factory()) factory->CreatePathGeometry(path.GetAddressOf());
+
+        ++m_geometryBuilds;
+        ++Tests::Recording().geometryBuilds;
+        return path;
+    }
+
+    void Canvas::DrawPath(const PathGeometry& path, const Paint& paint) const {
+        if (path) Record(Tests::DrawKind::Path, paint, 0);
+    }
+
+    void Canvas::DrawRectangle(const Rect&, const Paint& paint) const {
+        Record(Tests::DrawKind::Rect, paint, 0);
+    }
+
+    void Canvas::DrawRoundedRectangle(const Rect&, float, const Paint& paint) const {
+        Record(Tests::DrawKind::RoundedRect, paint, 0);
+    }
+
+    void Canvas::DrawCircle(const Point&, float, const Paint& paint) const {
+        Record(Tests::DrawKind::Circle, paint, 0);
+    }
+
+    void Canvas::DrawRectangleBatch(Span<const Rect> rects, const Paint& paint) const {
+        for (const auto& rect : rects) DrawRectangle(rect, paint);
+    }
+
+    void Canvas::DrawCircleBatch(Span<const Point> centers, float radius, const Paint& paint) const {
+        for (const auto& center : centers) DrawCircle(center, radius, paint);
+    }
+
+    void Canvas::DrawMesh(Span<const Point>, Span<const uint32_t> indices, const Paint& paint) const {
+        if (indices.size() < 3) return;
+
+        ++m_geometryBuilds;
+        Record(Tests::DrawKind::Mesh, paint, indices.size());
+    }
+
+    // Same order as the real one: the offset shadow pass, then the drawing.
+    void Canvas::DrawWithShadow(std::function<void()> drawCallback, const Point&, const Color&) const {
+        if (!drawCallback) return;
+
+        ++Tests::Recording().shadowPasses;
+        PushTransform();
+        drawCallback();
+        PopTransform();
+
+        drawCallback();
+    }
+
+    void Canvas::PushTransform() const { ++Tests::Recording().transformDepth; }
+    void Canvas::PopTransform() const { --Tests::Recording().transformDepth; }
+    void Canvas::ScaleAt(const Point&, float, float) const {}
+    void Canvas::TranslateBy(float, float) const {}
+
+} // namespace Spectrum
@@ -0,0 +1,56 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RecordingCanvas.h: Backend for renderer tests. A test links
+// RecordingCanvas.cpp in place of GraphicsAPI.cpp; its Canvas and Paint
+// definitions log every call instead of drawing, so a renderer can run
+// without a device and the test inspects what it asked for. Only the
+// members the tested renderers use are defined, so a renderer that starts
+// using another one fails to link rather than silently drawing nothing.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_RECORDING_CANVAS_H
+#define SPECTRUM_CPP_RECORDING_CANVAS_H
+
+#include "Graphics/API/GraphicsAPI.h"
+#include <vector>
+
+namespace Spectrum::Tests {
+
+    enum class DrawKind { Path, Mesh, Rect, RoundedRect, Circle };
+
+    struct RecordedDraw {
+        DrawKind kind;
+        Color color;
+        float alpha;
+        float strokeWidth;
+        size_t indexCount;      // meshes only
+        int transformDepth;     // pushes open at the time of the draw
+    };
+
+    struct CanvasRecording {
+        std::vector<RecordedDraw> draws;
+        size_t geometryBuilds = 0;
+        size_t shadowPasses = 0;
+        int transformDepth = 0;
+
+        // Keeps the draw list's capacity, so a warmed-up recording does
+        // not show up in allocation counts.
+        void Clear() {
+            draws.clear();
+            geometryBuilds = 0;
+            shadowPasses = 0;
+            transformDepth = 0;
+        }
+
+        [[nodiscard]] size_t Count(DrawKind kind, int depth) const {
+            size_t n = 0;
+            for (const auto& d : draws)
+                if (d.kind == kind && d.transformDepth == depth) ++n;
+            return n;
+        }
+    };
+
+    // Shared by every Canvas; clear it before each frame under test.
+    CanvasRecording& Recording();
+
+} // namespace Spectrum::Tests
+
+#endif // SPECTRUM_CPP_RECORDING_CANVAS_H
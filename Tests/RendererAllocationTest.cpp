@@ -0,0 +1,79 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// RendererAllocationTest.cpp: Runs the batch-drawing renderers against the
+// recording canvas with operator new counted, and checks that once a few
+// frames have warmed up the frame arena and the renderers' own buffers, a
+// frame at any quality makes no heap allocation at all.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "AllocationCounter.h"
+#include "RecordingCanvas.h"
+#include "Graphics/Visualizers/BarsRenderer.h"
+#include "Graphics/Visualizers/CubesRenderer.h"
+#include "Graphics/Visualizers/LedPanelRenderer.h"
+#include "Graphics/Visualizers/MatrixLedRenderer.h"
+#include "Graphics/Visualizers/SphereRenderer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    constexpr size_t kBars = 128;
+    constexpr int kWarmUpFrames = 8;
+    constexpr int kCountedFrames = 60;
+
+    // Moving content, so peaks rise and fall and every code path of a
+    // frame runs; built up front, as the analyzer's buffers are.
+    std::vector<SpectrumData> MakeSpectra(size_t count) {
+        std::vector<SpectrumData> spectra;
+        for (size_t f = 0; f < count; ++f) {
+            SpectrumData spectrum(kBars, 0.0f);
+            for (size_t i = 0; i < kBars; ++i)
+                spectrum[i] = 0.5f + 0.45f * std::sin(0.3f * static_cast<float>(f) + 0.2f * static_cast<float>(i));
+            spectra.push_back(std::move(spectrum));
+        }
+        return spectra;
+    }
+
+    template<typename TRenderer>
+    void TestSteadyFramesDoNotAllocate(const char* name) {
+        const auto spectra = MakeSpectra(kWarmUpFrames + kCountedFrames);
+        TRenderer renderer;
+        renderer.OnActivate(1280, 720);
+        Canvas canvas(nullptr, nullptr);
+
+        for (int q = 0; q < static_cast<int>(RenderQuality::Count); ++q) {
+            renderer.SetQuality(static_cast<RenderQuality>(q));
+
+            size_t before = 0;
+            for (int frame = 0; frame < kWarmUpFrames + kCountedFrames; ++frame) {
+                if (frame == kWarmUpFrames) before = Tests::HeapAllocations();
+
+                canvas.ResetFrameArena();
+                Tests::Recording().Clear();
+                renderer.Render(canvas, spectra[static_cast<size_t>(frame)], FRAME_TIME);
+            }
+
+            const size_t allocations = Tests::HeapAllocations() - before;
+            if (allocations != 0)
+                std::printf("  %s at quality %d: %zu allocations in %d frames\n", name, q, allocations, kCountedFrames);
+            CHECK(allocations == 0);
+            CHECK(!Tests::Recording().draws.empty());
+        }
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestSteadyFramesDoNotAllocate<BarsRenderer>("Bars");
+    TestSteadyFramesDoNotAllocate<CubesRenderer>("Cubes");
+    TestSteadyFramesDoNotAllocate<SphereRenderer>("Sphere");
+    TestSteadyFramesDoNotAllocate<LedPanelRenderer>("LedPanel");
+    TestSteadyFramesDoNotAllocate<MatrixLedRenderer>("MatrixLed");
+    return Tests::Finish("RendererAllocationTest");
+}
@@ -0,0 +1,198 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// ScenarioRunnerTest.cpp: Parses scenario scripts, replays them frame by
+// frame and checks the exact text of the JSON report, which is meant to be
+// diffed between builds.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "App/ScenarioRunner.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    namespace fs = std::filesystem;
+
+    constexpr float kFrame60 = 1.0f / 60.0f;
+
+    bool Contains(const std::string& text, const std::string& part) {
+        return text.find(part) != std::string::npos;
+    }
+
+    fs::path WriteScript(const char* name, const std::string& text) {
+        const fs::path path = fs::temp_directory_path() / name;
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+        return path;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Parsing
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TestParse() {
+        const std::string script =
+            "# seconds  command  argument\n"
+            "0          segment  bars high\n"
+            "\n"
+            "0          style    Bars      # trailing comment\n"
+            "0.024      quality  Ultra\r\n"
+            "0.026      bars     96\n"
+            "10         action   SwitchRenderer\n"
+            "10         window   Blackman\n"
+            "10         scale    Mel\n"
+            "12.5       animation off\n"
+            "20         end\n";
+
+        std::vector<ScenarioCommand> commands;
+        std::string error;
+        CHECK(ScenarioRunner::Parse(script, kFrame60, commands, error));
+        CHECK(error.empty());
+        CHECK(commands.size() == 9);
+        if (commands.size() != 9) return;
+
+        CHECK(commands[0].type == ScenarioCommandType::Segment);
+        CHECK(commands[0].text == "bars high");
+        CHECK(commands[1].style == RenderStyle::Bars);
+        CHECK(commands[2].quality == RenderQuality::Ultra);
+        CHECK(commands[3].count == 96);
+        CHECK(commands[4].action == InputAction::SwitchRenderer);
+        CHECK(commands[5].text == "Blackman");
+        CHECK(commands[6].text == "Mel");
+        CHECK(commands[7].type == ScenarioCommandType::Animation);
+        CHECK(!commands[7].enabled);
+        CHECK(commands[8].type == ScenarioCommandType::End);
+
+        // Seconds round to the nearest frame: 1.44 -> 1, 1.56 -> 2.
+        const uint64_t frames[] = { 0, 0, 1, 2, 600, 600, 600, 750, 1200 };
+        for (size_t i = 0; i < commands.size(); ++i) CHECK(commands[i].frame == frames[i]);
+
+        // The frame interval is the caller's, not a fixed 60 Hz.
+        CHECK(ScenarioRunner::Parse("0.5 end\n", 1.0f / 144.0f, commands, error));
+        CHECK(commands.size() == 1 && commands[0].frame == 72);
+    }
+
+    void TestParseErrorsNameTheLine() {
+        const std::vector<ScenarioCommand> sentinel(3);
+        std::vector<ScenarioCommand> commands = sentinel;
+        std::string error;
+
+        const char* const bad[] = {
+            "0 segment a\n0 explode now\n",        // unknown command
+            "0 segment a\n0 style Wobbly\n",       // unknown enum name
+            "0 segment a\n0 action Jump\n",
+            "0 segment a\n0 bars 0\n",
+            "0 segment a\n0 animation maybe\n",
+            "0 segment a\n0 end now\n",
+            "0 segment a\n-1 end\n",
+            "0 segment a\nsoon end\n",
+        };
+        for (const char* text : bad) {
+            error.clear();
+            CHECK(!ScenarioRunner::Parse(text, kFrame60, commands, error));
+            CHECK(Contains(error, "line 2: cannot parse"));
+            CHECK(commands.size() == sentinel.size());
+        }
+
+        error.clear();
+        CHECK(!ScenarioRunner::Parse("1 segment a\n# note\n2 style Bars\n1.5 end\n", kFrame60, commands, error));
+        CHECK(error == "line 4: time goes backwards");
+        CHECK(commands.size() == sentinel.size());
+
+        // Same frame after rounding is not going backwards.
+        CHECK(ScenarioRunner::Parse("1 segment a\n0.999 end\n", kFrame60, commands, error));
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Running
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TestFinishesWithoutEnd() {
+        const fs::path path = WriteScript("ScenarioRunnerTest_noend.scenario",
+            "0 segment a\n0.5 style Wave\n0.5 quality Low\n");
+
+        ScenarioRunner runner(kFrame60);
+        CHECK(runner.Load(path));
+        CHECK(!runner.IsFinished());
+
+        CHECK(runner.TakeDue(0).size() == 1);
+        CHECK(!runner.IsFinished());
+        CHECK(runner.TakeDue(29).size() == 0);
+        CHECK(!runner.IsFinished());
+
+        const auto due = runner.TakeDue(30);
+        CHECK(due.size() == 2);
+        CHECK(due.size() == 2 && due[0].type == ScenarioCommandType::Style);
+        CHECK(runner.IsFinished());
+        fs::remove(path);
+    }
+
+    void TestEndStopsBeforeLaterCommands() {
+        const fs::path path = WriteScript("ScenarioRunnerTest_end.scenario",
+            "0 segment a\n1 end\n2 style Wave\n");
+
+        ScenarioRunner runner(kFrame60);
+        CHECK(runner.Load(path));
+        CHECK(runner.TakeDue(59).size() == 1);
+        CHECK(!runner.IsFinished());
+        CHECK(runner.TakeDue(60).size() == 1);
+        CHECK(runner.IsFinished());
+        fs::remove(path);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Report
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TestReportShape() {
+        ScenarioRunner empty(kFrame60);
+        CHECK(empty.BuildReport(16.667f) ==
+            "{\n"
+            "  \"version\": 1,\n"
+            "  \"scenario\": \"\",\n"
+            "  \"frame_budget_ms\": 16.667,\n"
+            "  \"segments\": []\n"
+            "}\n");
+
+        // Frames timed before any segment command go to "default".
+        const fs::path path = WriteScript("ScenarioRunnerTest_report.scenario",
+            "0 segment \"quoted\"\n0 style Bars\n");
+
+        ScenarioRunner runner(kFrame60);
+        CHECK(runner.Load(path));
+        runner.RecordFrame(5.0f);
+        (void)runner.TakeDue(0);
+        for (const float ms : { 10.0f, 20.0f, 30.0f }) runner.RecordFrame(ms);
+
+        CHECK(runner.BuildReport(16.667f) ==
+            "{\n"
+            "  \"version\": 1,\n"
+            "  \"scenario\": \"ScenarioRunnerTest_report.scenario\",\n"
+            "  \"frame_budget_ms\": 16.667,\n"
+            "  \"segments\": [\n"
+            "    { \"name\": \"default\", \"frames\": 1, \"mean_ms\": 5.000, \"p50_ms\": 5.000,"
+            " \"p95_ms\": 5.000, \"p99_ms\": 5.000, \"max_ms\": 5.000, \"over_budget\": 0 },\n"
+            "    { \"name\": \"\\\"quoted\\\"\", \"frames\": 3, \"mean_ms\": 20.000, \"p50_ms\": 20.000,"
+            " \"p95_ms\": 30.000, \"p99_ms\": 30.000, \"max_ms\": 30.000, \"over_budget\": 2 }\n"
+            "  ]\n"
+            "}\n");
+
+        CHECK(ScenarioRunner::DefaultReportPath(path).filename() == "ScenarioRunnerTest_report.report.json");
+        fs::remove(path);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestParse();
+    TestParseErrorsNameTheLine();
+    TestFinishesWithoutEnd();
+    TestEndStopsBeforeLaterCommands();
+    TestReportShape();
+    return Tests::Finish("ScenarioRunnerTest");
+}
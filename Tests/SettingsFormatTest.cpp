@@ -0,0 +1,109 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SettingsFormatTest.cpp: Round-trips settings through their text form and
+// checks that a damaged file costs only the lines that are wrong.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "App/SettingsFormat.h"
+
+namespace Spectrum {
+namespace {
+
+    AppSettings MakeCustomSettings() {
+        AppSettings s;
+        s.audio.fftSize = 8192;
+        s.audio.barCount = 137;
+        s.audio.amplification = 2.25f;
+        s.audio.smoothing = 0.625f;
+        s.audio.whitening = true;
+        s.audio.windowType = FFTWindowType::Blackman;
+        s.audio.scaleType = SpectrumScale::Mel;
+        s.frequencyZoomed = true;
+        s.windowMinHz = 440.5f;
+        s.windowMaxHz = 3520.0f;
+        s.style = RenderStyle::Sphere;
+        s.quality = RenderQuality::Ultra;
+        s.primaryColor = Color(0.25f, 0.5f, 0.75f, 1.0f);
+        return s;
+    }
+
+    void TestRoundTrip() {
+        const AppSettings defaults;
+        AppSettings loaded = MakeCustomSettings();
+        CHECK(DeserializeSettings(SerializeSettings(defaults), loaded));
+        CHECK(loaded == defaults);
+
+        const AppSettings custom = MakeCustomSettings();
+        loaded = AppSettings{};
+        CHECK(DeserializeSettings(SerializeSettings(custom), loaded));
+        CHECK(loaded == custom);
+    }
+
+    void TestEnumsAreWrittenByName() {
+        const std::string text = SerializeSettings(MakeCustomSettings());
+        CHECK(text.find("fft_window = Blackman") != std::string::npos);
+        CHECK(text.find("scale = Mel") != std::string::npos);
+    }
+
+    void TestBadLinesAreSkippedOneByOne() {
+        const std::string text =
+            "version = 1\n"
+            "[audio]\n"
+            "fft_size = lots\n"
+            "bar_count = 96\n"
+            "fft_window = Triangle\n"
+            "scale = Linear\n"
+            "no equals sign here\n"
+            "unknown_key = 5\n"
+            "[renderer]\n"
+            "quality = 99\n"
+            "style = 2\n"
+            "color = 2.0, -1.0, 0.5\n";
+
+        const AppSettings defaults;
+        AppSettings s;
+        CHECK(DeserializeSettings(text, s));
+        CHECK(s.audio.fftSize == defaults.audio.fftSize);
+        CHECK(s.audio.barCount == 96);
+        CHECK(s.audio.windowType == defaults.audio.windowType);
+        CHECK(s.audio.scaleType == SpectrumScale::Linear);
+        CHECK(s.quality == defaults.quality);
+        CHECK(s.style == static_cast<RenderStyle>(2));
+        CHECK(s.primaryColor.r == 1.0f);
+        CHECK(s.primaryColor.g == 0.0f);
+        CHECK(s.primaryColor.b == 0.5f);
+    }
+
+    void TestUnknownVersionIsRejected() {
+        const AppSettings custom = MakeCustomSettings();
+
+        AppSettings s = custom;
+        CHECK(!DeserializeSettings("[audio]\nbar_count = 12\n", s));
+        CHECK(s == custom);
+
+        CHECK(!DeserializeSettings("version = 2\n[audio]\nbar_count = 12\n", s));
+        CHECK(s == custom);
+
+        CHECK(!DeserializeSettings("", s));
+        CHECK(s == custom);
+    }
+
+    void TestWhitespaceAndCommentsAreIgnored() {
+        AppSettings s;
+        CHECK(DeserializeSettings(
+            "# comment\r\n; another\r\n  version=1  \r\n[audio]\r\n\tsmoothing =0.5\r\n", s));
+        CHECK(s.audio.smoothing == 0.5f);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestRoundTrip();
+    TestEnumsAreWrittenByName();
+    TestBadLinesAreSkippedOneByOne();
+    TestUnknownVersionIsRejected();
+    TestWhitespaceAndCommentsAreIgnored();
+    return Tests::Finish("SettingsFormatTest");
+}
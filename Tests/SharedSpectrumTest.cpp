@@ -0,0 +1,143 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SharedSpectrumTest.cpp: Runs the seqlock protocol of the shared spectrum
+// ring across two processes. The parent publishes frames whose every bar
+// encodes the frame's sequence into an anonymous shared mapping; a forked
+// reader checks that each copy it accepts is whole and that no slot ever
+// goes back to an older frame. POSIX only; the layout itself is portable.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Audio/Sharing/SharedSpectrumLayout.h"
+
+#include <new>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Spectrum {
+namespace {
+
+    using namespace SharedSpectrum;
+
+    constexpr uint64_t kFrames = 200000;
+    constexpr uint32_t kBars = 128;
+
+    enum ReaderExit { kReaderOk = 0, kReaderTorn = 1, kReaderBackwards = 2, kReaderStarved = 3 };
+
+    float BarValue(uint64_t sequence, uint32_t bar) noexcept {
+        return static_cast<float>(sequence % 65536) + static_cast<float>(bar) * 0.5f;
+    }
+
+    void Publish(Region& region, uint64_t sequence) noexcept {
+        WriteSlot(region.slots[SlotIndex(sequence)], [&](Frame& frame) {
+            frame.sequence = sequence;
+            frame.timestampNs = static_cast<int64_t>(sequence);
+            frame.barCount = kBars;
+            frame.peakCount = kBars;
+            for (uint32_t i = 0; i < kBars; ++i) {
+                frame.bars[i] = BarValue(sequence, i);
+                frame.peaks[i] = BarValue(sequence, i) + 1.0f;
+            }
+        });
+        region.header.latestSequence.store(sequence, std::memory_order_release);
+    }
+
+    bool IsWhole(const Frame& frame) noexcept {
+        if (frame.barCount != kBars || frame.peakCount != kBars) return false;
+        if (frame.timestampNs != static_cast<int64_t>(frame.sequence)) return false;
+        for (uint32_t i = 0; i < kBars; ++i) {
+            if (frame.bars[i] != BarValue(frame.sequence, i)) return false;
+            if (frame.peaks[i] != BarValue(frame.sequence, i) + 1.0f) return false;
+        }
+        return true;
+    }
+
+    // Alternates between the newest slot, as a subscriber reads it, and
+    // the slot the writer fills next, where a copy is most likely to race
+    // a write. Every accepted copy must be whole and no slot may go back.
+    int RunReader(const Region& region) {
+        uint64_t lastSeen[kSlotCount] = {};
+        uint64_t accepted = 0;
+
+        for (uint64_t attempt = 0; lastSeen[SlotIndex(kFrames)] < kFrames; ++attempt) {
+            const uint64_t latest = region.header.latestSequence.load(std::memory_order_acquire);
+            if (latest == 0) continue;
+
+            const size_t index = SlotIndex(latest + (attempt & 1));
+            Frame frame;
+            if (!TryReadSlot(region.slots[index], frame) || frame.sequence == 0) continue;
+            if (!IsWhole(frame)) return kReaderTorn;
+            if (frame.sequence < lastSeen[index]) return kReaderBackwards;
+
+            lastSeen[index] = frame.sequence;
+            ++accepted;
+        }
+        return accepted > 0 ? kReaderOk : kReaderStarved;
+    }
+
+    void TestCrossProcessReadsAreWhole() {
+        void* memory = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        CHECK(memory != MAP_FAILED);
+        if (memory == MAP_FAILED) return;
+
+        Region* region = new (memory) Region{};
+        region->header.magic = kMagic;
+        region->header.version = kVersion;
+        region->header.slotCount = kSlotCount;
+        region->header.maxBars = kMaxBars;
+
+        const pid_t reader = fork();
+        CHECK(reader >= 0);
+        if (reader == 0) _exit(RunReader(*region));
+
+        for (uint64_t sequence = 1; sequence <= kFrames; ++sequence)
+            Publish(*region, sequence);
+
+        int status = 0;
+        CHECK(waitpid(reader, &status, 0) == reader);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == kReaderOk);
+
+        munmap(memory, sizeof(Region));
+    }
+
+    void TestReadDuringWriteIsRejected() {
+        Region region{};
+        Publish(region, 1);
+
+        Slot& slot = region.slots[SlotIndex(1)];
+        Frame frame;
+        CHECK(TryReadSlot(slot, frame));
+        CHECK(IsWhole(frame));
+
+        // A writer caught between the two stores leaves the lock odd.
+        slot.lock.fetch_add(1);
+        CHECK(!TryReadSlot(slot, frame));
+        slot.lock.fetch_add(1);
+        CHECK(TryReadSlot(slot, frame));
+    }
+
+    void TestCountsAreClamped() {
+        Region region{};
+        WriteSlot(region.slots[0], [](Frame& frame) {
+            frame.barCount = kMaxBars + 10;
+            frame.peakCount = kMaxBars * 2;
+        });
+
+        Frame frame;
+        CHECK(TryReadSlot(region.slots[0], frame));
+        CHECK(frame.barCount == kMaxBars);
+        CHECK(frame.peakCount == kMaxBars);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestReadDuringWriteIsRejected();
+    TestCountsAreClamped();
+    TestCrossProcessReadsAreWhole();
+    return Tests::Finish("SharedSpectrumTest");
+}
@@ -0,0 +1,217 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectralTrackFileTest.cpp: Writes .sptk tracks at both bit depths and reads
+// them back in order and by seeking, then checks that headers and index
+// entries whose sizes and offsets would overflow the bounds checks are
+// rejected instead of read past the mapping.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Audio/Offline/SpectralTrackFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    namespace fs = std::filesystem;
+
+    constexpr size_t kFrames = 300;
+    constexpr size_t kBars = 48;
+    constexpr uint32_t kKeyframeInterval = 16;
+
+    fs::path TempPath(const char* name) {
+        return fs::temp_directory_path() / name;
+    }
+
+    // Smooth content with a few values the quantiser has to clamp: below
+    // zero, above one, and NaN.
+    SpectralTrack MakeTrack() {
+        SpectralTrack track;
+        track.sampleRate = 48000;
+        track.hopSize = 512;
+        track.barCount = kBars;
+        track.features.resize(kFrames);
+        track.bars.resize(kFrames * kBars);
+
+        for (size_t f = 0; f < kFrames; ++f) {
+            for (size_t i = 0; i < kBars; ++i) {
+                track.bars[f * kBars + i] = 0.5f + 0.5f *
+                    std::sin(0.05f * static_cast<float>(f) + 0.3f * static_cast<float>(i));
+            }
+        }
+        track.bars[3] = -0.25f;
+        track.bars[kBars + 5] = 1.75f;
+        track.bars[2 * kBars + 7] = std::numeric_limits<float>::quiet_NaN();
+        return track;
+    }
+
+    float Expected(const SpectralTrack& track, size_t frame, size_t bar) {
+        const float v = track.bars[frame * kBars + bar];
+        return v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f;
+    }
+
+    std::vector<uint8_t> ReadBytes(const fs::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+    }
+
+    void WriteBytes(const fs::path& path, const std::vector<uint8_t>& bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Round trip and seeking
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    void TestRoundTrip() {
+        const SpectralTrack track = MakeTrack();
+        const fs::path path = TempPath("SpectralTrackFileTest_roundtrip.sptk");
+
+        for (const uint32_t bits : { 8u, 12u }) {
+            CHECK(SpectralTrackWriter::Write(track, path, bits, kKeyframeInterval));
+
+            SpectralTrackReader reader;
+            CHECK(reader.Open(path));
+            CHECK(reader.GetFrameCount() == kFrames);
+            CHECK(reader.GetBarCount() == kBars);
+            CHECK_NEAR(reader.GetFrameRate(), 48000.0 / 512.0, 1e-9);
+
+            // Half a quantisation step, plus float rounding.
+            const float tolerance = 0.5f / static_cast<float>((1u << bits) - 1u) + 1e-6f;
+            SpectrumData frame;
+            float maxError = 0.0f;
+            for (size_t f = 0; f < kFrames; ++f) {
+                CHECK(reader.ReadFrame(f, frame));
+                for (size_t i = 0; i < kBars; ++i)
+                    maxError = std::max(maxError, std::fabs(frame[i] - Expected(track, f, i)));
+            }
+            CHECK(maxError <= tolerance);
+            CHECK(!reader.ReadFrame(kFrames, frame));
+        }
+        fs::remove(path);
+    }
+
+    void TestSeekMatchesSequentialRead() {
+        const fs::path path = TempPath("SpectralTrackFileTest_seek.sptk");
+        CHECK(SpectralTrackWriter::Write(MakeTrack(), path, 12, kKeyframeInterval));
+
+        SpectralTrackReader reader;
+        CHECK(reader.Open(path));
+
+        std::vector<SpectrumData> sequential(kFrames);
+        for (size_t f = 0; f < kFrames; ++f) CHECK(reader.ReadFrame(f, sequential[f]));
+
+        // Backwards, onto keyframes, just before them, and across several.
+        const size_t order[] = { 299, 0, 15, 16, 17, 150, 149, 31, 32, 288, 5, 299, 64 };
+        SpectrumData frame;
+        for (const size_t f : order) {
+            CHECK(reader.ReadFrame(f, frame));
+            bool same = frame.size() == kBars;
+            for (size_t i = 0; same && i < kBars; ++i) same = frame[i] == sequential[f][i];
+            CHECK(same);
+        }
+        fs::remove(path);
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Corrupt files
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    bool OpensWithHeader(const std::vector<uint8_t>& good, const SpectralTrackHeader& header) {
+        std::vector<uint8_t> bytes = good;
+        std::memcpy(bytes.data(), &header, sizeof(header));
+
+        const fs::path path = TempPath("SpectralTrackFileTest_corrupt.sptk");
+        WriteBytes(path, bytes);
+        SpectralTrackReader reader;
+        const bool opened = reader.Open(path);
+        reader.Close();
+        fs::remove(path);
+        return opened;
+    }
+
+    void TestCorruptHeaderIsRejected() {
+        const fs::path path = TempPath("SpectralTrackFileTest_good.sptk");
+        CHECK(SpectralTrackWriter::Write(MakeTrack(), path, 8, kKeyframeInterval));
+        const std::vector<uint8_t> good = ReadBytes(path);
+        fs::remove(path);
+
+        SpectralTrackHeader header;
+        std::memcpy(&header, good.data(), sizeof(header));
+        CHECK(OpensWithHeader(good, header));
+
+        SpectralTrackHeader bad = header;
+        bad.magic[0] = 'X';
+        CHECK(!OpensWithHeader(good, bad));
+
+        // indexOffset + the index size wraps to a small number.
+        bad = header;
+        bad.indexOffset = std::numeric_limits<uint64_t>::max() - 7;
+        CHECK(!OpensWithHeader(good, bad));
+
+        bad = header;
+        bad.indexOffset = good.size() + 8;
+        CHECK(!OpensWithHeader(good, bad));
+
+        // frameCount + keyframeInterval - 1 wraps in 32 bits to a count of
+        // zero keyframes, which an index of any size would satisfy.
+        bad = header;
+        bad.frameCount = std::numeric_limits<uint32_t>::max();
+        bad.keyframeInterval = 64;
+        CHECK(!OpensWithHeader(good, bad));
+
+        bad = header;
+        bad.keyframeInterval = 0;
+        CHECK(!OpensWithHeader(good, bad));
+
+        // Shorter than a header.
+        const fs::path shortPath = TempPath("SpectralTrackFileTest_short.sptk");
+        WriteBytes(shortPath, std::vector<uint8_t>(good.begin(), good.begin() + 8));
+        SpectralTrackReader reader;
+        CHECK(!reader.Open(shortPath));
+        fs::remove(shortPath);
+    }
+
+    // Header fine, but the first keyframe points near the end of the
+    // address space, where offset + header bytes wraps.
+    void TestCorruptIndexEntryFailsTheRead() {
+        const fs::path path = TempPath("SpectralTrackFileTest_index.sptk");
+        CHECK(SpectralTrackWriter::Write(MakeTrack(), path, 8, kKeyframeInterval));
+        std::vector<uint8_t> bytes = ReadBytes(path);
+
+        SpectralTrackHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        const uint64_t wrapping = std::numeric_limits<uint64_t>::max() - 1;
+        std::memcpy(bytes.data() + header.indexOffset, &wrapping, sizeof(wrapping));
+        const uint64_t atIndex = header.indexOffset;
+        std::memcpy(bytes.data() + header.indexOffset + sizeof(uint64_t), &atIndex, sizeof(atIndex));
+        WriteBytes(path, bytes);
+
+        SpectralTrackReader reader;
+        CHECK(reader.Open(path));
+        SpectrumData frame;
+        CHECK(!reader.ReadFrame(0, frame));
+        CHECK(!reader.ReadFrame(kKeyframeInterval + 1, frame));
+        CHECK(reader.ReadFrame(2 * kKeyframeInterval, frame));
+        reader.Close();
+        fs::remove(path);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestRoundTrip();
+    TestSeekMatchesSequentialRead();
+    TestCorruptHeaderIsRejected();
+    TestCorruptIndexEntryFailsTheRead();
+    return Tests::Finish("SpectralTrackFileTest");
+}
@@ -0,0 +1,102 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectralWhitenerTest.cpp: Feeds SpectralWhitener a steady tone over a
+// constant noise bed, then the noise alone, then the tone again. The tone
+// must pass from the first frame, before any floor is known; the noise
+// must be gated once it is; and after the tone stops the floor under its
+// bar must come down to the noise.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Audio/Processing/SpectralWhitener.h"
+
+namespace Spectrum {
+namespace {
+
+    constexpr size_t kBars = 32;
+    constexpr size_t kToneBar = 10;
+    constexpr size_t kNoiseBar = 20;
+    constexpr float  kTone = 0.5f;
+    constexpr float  kNoise = 0.01f;
+
+    // The whitener's sub-window and full window, in frames.
+    constexpr int kSubWindowFrames = 24;
+    constexpr int kWindowFrames = 8 * kSubWindowFrames;
+
+    // The floor sits this far above the minimum level.
+    constexpr float kFloorBias = 2.0f;
+
+    SpectrumData Frame(bool tone) {
+        SpectrumData spectrum(kBars, kNoise);
+        if (tone) spectrum[kToneBar] = kTone;
+        return spectrum;
+    }
+
+    // Output of the last of `frames` identical frames.
+    SpectrumData Run(SpectralWhitener& whitener, bool tone, int frames) {
+        SpectrumData out;
+        for (int i = 0; i < frames; ++i) {
+            out = Frame(tone);
+            whitener.Process(out);
+        }
+        return out;
+    }
+
+    void TestGateOpenBeforeFirstSubWindow() {
+        SpectralWhitener whitener;
+        for (int i = 0; i < kSubWindowFrames; ++i) {
+            SpectrumData out = Frame(true);
+            whitener.Process(out);
+            CHECK(whitener.GetNoiseFloor()[kToneBar] == 0.0f);
+            CHECK(out[kToneBar] > 0.1f);
+            CHECK(out[kToneBar] > out[kNoiseBar]);
+        }
+    }
+
+    void TestNoiseIsGatedOnceFloorIsKnown() {
+        SpectralWhitener whitener;
+        const SpectrumData out = Run(whitener, true, 2 * kSubWindowFrames);
+
+        CHECK_NEAR(whitener.GetNoiseFloor()[kNoiseBar], kFloorBias * kNoise, 1e-4f);
+        CHECK(out[kNoiseBar] == 0.0f);
+    }
+
+    void TestFloorConvergesAfterToneStops() {
+        SpectralWhitener whitener;
+
+        // Held for a whole window, the tone itself counts as floor.
+        Run(whitener, true, 2 * kWindowFrames);
+        CHECK(whitener.GetNoiseFloor()[kToneBar] > kTone);
+
+        const SpectrumData silence = Run(whitener, false, kWindowFrames);
+        for (size_t i = 0; i < kBars; ++i) {
+            CHECK_NEAR(whitener.GetNoiseFloor()[i], kFloorBias * kNoise, 1e-4f);
+            CHECK(silence[i] == 0.0f);
+        }
+
+        // Over the converged floor the tone opens the gate again.
+        const SpectrumData onset = Run(whitener, true, 4);
+        CHECK(onset[kToneBar] > 0.1f);
+        CHECK(onset[kNoiseBar] == 0.0f);
+    }
+
+    void TestResetForgetsTheFloor() {
+        SpectralWhitener whitener;
+        Run(whitener, true, 2 * kWindowFrames);
+        whitener.Reset();
+
+        const SpectrumData out = Run(whitener, true, 1);
+        CHECK(whitener.GetNoiseFloor()[kToneBar] == 0.0f);
+        CHECK(out[kToneBar] > 0.1f);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestGateOpenBeforeFirstSubWindow();
+    TestNoiseIsGatedOnceFloorIsKnown();
+    TestFloorConvergesAfterToneStops();
+    TestResetForgetsTheFloor();
+    return Tests::Finish("SpectralWhitenerTest");
+}
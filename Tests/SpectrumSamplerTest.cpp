@@ -0,0 +1,131 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SpectrumSamplerTest.cpp: Replays a capture that delivers audio in 10 ms
+// packets with jitter and stamps hops the way the analyzer does, samples it
+// at 60 and 144 Hz a hop plus the delivery latency late, and checks that
+// every sample blends the two frames around its time with t in [0, 1].
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Audio/Processing/SpectrumSampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    constexpr int64_t kSampleRate = 48000;
+    constexpr int64_t kFFTSize = 2048;
+    constexpr int64_t kHop = kFFTSize / 2;
+    constexpr int64_t kPacket = kSampleRate / 100;     // 10 ms
+    constexpr int64_t kMaxJitterNs = 2'000'000;
+    constexpr int64_t kSeconds = 5;
+
+    int64_t SampleNs(int64_t sample) {
+        return sample * 1'000'000'000 / kSampleRate;
+    }
+
+    struct Frame {
+        int64_t stampNs;
+        int64_t arrivalNs;
+    };
+
+    // Each packet is added a little after its last sample, and the hops it
+    // completes are stamped back from then, as the audio buffer does.
+    // Analysis runs on the render thread, so a frame is there for the first
+    // render after its packet.
+    std::vector<Frame> CaptureFrames() {
+        std::vector<Frame> frames;
+        uint32_t seed = 12345;
+        int64_t nextHopEnd = kFFTSize - 1;
+
+        for (int64_t first = 0; first < kSeconds * kSampleRate; first += kPacket) {
+            seed = seed * 1664525u + 1013904223u;
+            const int64_t last = first + kPacket - 1;
+            const int64_t arrivalNs = SampleNs(last + 1) + static_cast<int64_t>(seed >> 8) % kMaxJitterNs;
+
+            for (; nextHopEnd <= last; nextHopEnd += kHop)
+                frames.push_back({ arrivalNs - SampleNs(last - nextHopEnd), arrivalNs });
+        }
+        return frames;
+    }
+
+    struct Positions {
+        float  lowest = 1.0f;
+        float  highest = 0.0f;
+        float  maxError = 0.0f;     // against the exact blend, when both ends are in
+        size_t late = 0;
+        size_t samples = 0;
+    };
+
+    // Frame k holds the value k, so a sample between frames k and k + 1
+    // reads k + t.
+    Positions Replay(int displayHz, int64_t delayNs) {
+        const std::vector<Frame> frames = CaptureFrames();
+        SpectrumSampler sampler;
+        SpectrumData bars(1);
+        size_t pushed = 0;
+        Positions result;
+
+        const int64_t frameNs = 1'000'000'000 / displayHz;
+        for (int64_t displayNs = 0; displayNs < SampleNs(kSeconds * kSampleRate); displayNs += frameNs) {
+            while (pushed < frames.size() && frames[pushed].arrivalNs <= displayNs) {
+                bars[0] = static_cast<float>(pushed);
+                sampler.Push(bars, frames[pushed].stampNs);
+                ++pushed;
+            }
+
+            const int64_t presentNs = displayNs - delayNs;
+            size_t shown = 0;
+            while (shown < pushed && frames[shown].stampNs <= presentNs) ++shown;
+            if (shown == 0) continue;
+            const float t = sampler.Sample(presentNs)[0] - static_cast<float>(shown - 1);
+            result.lowest = std::min(result.lowest, t);
+            result.highest = std::max(result.highest, t);
+            ++result.samples;
+
+            if (shown == pushed) {
+                ++result.late;
+                continue;
+            }
+            const Frame& from = frames[shown - 1];
+            const Frame& to = frames[shown];
+            const float exact = static_cast<float>(presentNs - from.stampNs) /
+                static_cast<float>(to.stampNs - from.stampNs);
+            result.maxError = std::max(result.maxError, std::fabs(t - exact));
+        }
+        return result;
+    }
+
+    void TestPositionStaysInRange() {
+        const int64_t delayNs = SampleNs(kHop) + SpectrumSampler::kDeliveryLatencyNs;
+        for (const int displayHz : { 60, 144 }) {
+            const Positions p = Replay(displayHz, delayNs);
+            CHECK(p.samples > 0);
+            CHECK(p.late == 0);
+            CHECK(p.lowest >= 0.0f);
+            CHECK(p.highest <= 1.0f);
+            CHECK(p.maxError < 1e-3f);
+        }
+    }
+
+    // Sampled at the present time, the next frame has not been captured
+    // yet, so every sample reads past the newest frame, by a bounded amount.
+    void TestSamplingWithoutDelayExtrapolates() {
+        const Positions p = Replay(144, 0);
+        CHECK(p.late == p.samples);
+        CHECK(p.highest > 0.0f);
+        CHECK(p.highest <= SpectrumSampler::kMaxExtrapolation + 1e-4f);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestPositionStaysInRange();
+    TestSamplingWithoutDelayExtrapolates();
+    return Tests::Finish("SpectrumSamplerTest");
+}
@@ -0,0 +1,82 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// TestHarness.h: Just enough for the tests in this directory. Each test is
+// its own executable whose main runs the cases and returns Finish(), so
+// ctest sees a non-zero exit code on any failed CHECK. Benchmarks use
+// Measure and print one line per case; with --quick they run a few
+// iterations only, which is how ctest runs them.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+#ifndef SPECTRUM_CPP_TEST_HARNESS_H
+#define SPECTRUM_CPP_TEST_HARNESS_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace Spectrum::Tests {
+
+    inline int& FailureCount() noexcept {
+        static int count = 0;
+        return count;
+    }
+
+    inline void Fail(const char* file, int line, const char* what) noexcept {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+        ++FailureCount();
+    }
+
+    [[nodiscard]] inline int Finish(const char* name) noexcept {
+        if (FailureCount() == 0) {
+            std::printf("%s: passed\n", name);
+            return 0;
+        }
+        std::printf("%s: %d check(s) failed\n", name, FailureCount());
+        return 1;
+    }
+
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+    // Benchmarks
+    // =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+    [[nodiscard]] inline bool IsQuickRun(int argc, char** argv) noexcept {
+        for (int i = 1; i < argc; ++i)
+            if (std::strcmp(argv[i], "--quick") == 0) return true;
+        return false;
+    }
+
+    inline volatile char g_keepAliveSink;
+
+    // Keeps a result alive so the measured work is not optimized away.
+    template<typename T>
+    inline void KeepAlive(const T& value) noexcept {
+        g_keepAliveSink = *reinterpret_cast<const volatile char*>(&value);
+    }
+
+    // Nanoseconds per call of `body`, best of a few rounds.
+    template<typename Body>
+    [[nodiscard]] double Measure(int iterations, Body&& body) {
+        using Clock = std::chrono::steady_clock;
+        double best = 1e300;
+        for (int round = 0; round < 3; ++round) {
+            const auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i) body();
+            const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            best = std::fmin(best, elapsed.count() / iterations);
+        }
+        return best;
+    }
+
+    inline void Report(const char* name, double nanoseconds) noexcept {
+        std::printf("  %-40s %10.1f ns\n", name, nanoseconds);
+    }
+
+} // namespace Spectrum::Tests
+
+#define CHECK(expr) \
+    do { if (!(expr)) ::Spectrum::Tests::Fail(__FILE__, __LINE__, #expr); } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) \
+    do { if (!(std::fabs((a) - (b)) <= (tolerance))) \
+        ::Spectrum::Tests::Fail(__FILE__, __LINE__, #a " ~= " #b); } while (0)
+
+#endif // SPECTRUM_CPP_TEST_HARNESS_H
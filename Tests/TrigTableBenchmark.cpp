@@ -0,0 +1,136 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// TrigTableBenchmark.cpp: Checks rotor phase rotation against std::sin and
+// std::cos, then times the two loops TrigTable replaced: the fire wind,
+// which took one std::sin per grid cell, and the circular wave's per-ring
+// phase offsets.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "Common/TrigTable.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace Spectrum {
+namespace {
+
+    constexpr int kGridWidth = 480;
+    constexpr int kGridHeight = 270;
+    constexpr float kWindColumnPhase = 0.5f;
+    constexpr float kWindAmplitude = 2.0f;
+    constexpr size_t kRings = 48;
+
+    void TestRotationMatchesStdTrig() {
+        const TrigTable table(kGridWidth, 0.0f, kWindColumnPhase);
+
+        float maxError = 0.0f;
+        for (float time = 0.0f; time < 50.0f; time += 0.37f) {
+            const Rotor phase = Rotor::FromAngle(time);
+            for (size_t i = 0; i < table.size(); ++i) {
+                // In double, so the reference does not share float's
+                // rounding of large angles.
+                const double angle = static_cast<double>(i) * kWindColumnPhase + time;
+                maxError = std::max(maxError,
+                    static_cast<float>(std::fabs(table.Sin(i, phase) - std::sin(angle))));
+                maxError = std::max(maxError,
+                    static_cast<float>(std::fabs(table.Cos(i, phase) - std::cos(angle))));
+            }
+        }
+        std::printf("  max abs error vs std::sin/cos: %.2g\n", maxError);
+        CHECK(maxError < 1e-5f);
+    }
+
+    void TestCircleTablesAreShared() {
+        const TrigTable& a = TrigTable::Circle(64);
+        CHECK(&a == &TrigTable::Circle(64));
+        CHECK(&a != &TrigTable::Circle(65));
+        CHECK(a.size() == 64);
+        CHECK_NEAR(a[16].s, 1.0f, 1e-6f);
+        CHECK_NEAR(a[32].c, -1.0f, 1e-6f);
+    }
+
+    // Both wind variants fill the same per-cell source columns, so the
+    // timings include the grid pass the renderer does anyway.
+    void BenchmarkFireWind(int iterations) {
+        std::vector<int> sources(static_cast<size_t>(kGridWidth) * kGridHeight);
+        float time = 0.0f;
+
+        const double perCell = Tests::Measure(iterations, [&] {
+            time += 0.016f;
+            for (int y = 0; y < kGridHeight; ++y) {
+                for (int x = 0; x < kGridWidth; ++x) {
+                    const int srcX = x + static_cast<int>(
+                        std::sin(time * 2.0f + x * kWindColumnPhase) * kWindAmplitude);
+                    sources[static_cast<size_t>(y) * kGridWidth + x] =
+                        std::clamp(srcX, 0, kGridWidth - 1);
+                }
+            }
+            Tests::KeepAlive(sources[sources.size() / 2]);
+        });
+
+        const TrigTable phases(kGridWidth, 0.0f, kWindColumnPhase);
+        std::vector<int> offsets(kGridWidth);
+
+        const double perColumn = Tests::Measure(iterations, [&] {
+            time += 0.016f;
+            const Rotor phase = Rotor::FromAngle(time * 2.0f);
+            for (int x = 0; x < kGridWidth; ++x) {
+                const int srcX = x + static_cast<int>(
+                    phases.Sin(static_cast<size_t>(x), phase) * kWindAmplitude);
+                offsets[x] = std::clamp(srcX, 0, kGridWidth - 1);
+            }
+            for (int y = 0; y < kGridHeight; ++y)
+                for (int x = 0; x < kGridWidth; ++x)
+                    sources[static_cast<size_t>(y) * kGridWidth + x] = offsets[x];
+            Tests::KeepAlive(sources[sources.size() / 2]);
+        });
+
+        Tests::Report("fire wind, std::sin per cell", perCell);
+        Tests::Report("fire wind, rotor per column", perColumn);
+    }
+
+    void BenchmarkRingPhases(int iterations) {
+        std::vector<Point> directions(kRings);
+        const float ringStep = TWO_PI / static_cast<float>(kRings);
+        float time = 0.0f;
+
+        const double direct = Tests::Measure(iterations, [&] {
+            time += 0.016f;
+            for (size_t i = 0; i < kRings; ++i) {
+                const float angle = time + static_cast<float>(i) * ringStep;
+                directions[i] = { std::cos(angle), std::sin(angle) };
+            }
+            Tests::KeepAlive(directions[kRings / 2].x);
+        });
+
+        const TrigTable offsets(kRings, 0.0f, ringStep);
+
+        const double rotated = Tests::Measure(iterations, [&] {
+            time += 0.016f;
+            const Rotor phase = Rotor::FromAngle(time);
+            for (size_t i = 0; i < kRings; ++i) {
+                const Rotor r = offsets[i] * phase;
+                directions[i] = { r.c, r.s };
+            }
+            Tests::KeepAlive(directions[kRings / 2].x);
+        });
+
+        Tests::Report("48 ring phases, std::sin/cos", direct);
+        Tests::Report("48 ring phases, rotor", rotated);
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main(int argc, char** argv) {
+    using namespace Spectrum;
+    const bool quick = Tests::IsQuickRun(argc, argv);
+
+    TestRotationMatchesStdTrig();
+    TestCircleTablesAreShared();
+
+    BenchmarkFireWind(quick ? 2 : 200);
+    BenchmarkRingPhases(quick ? 100 : 200000);
+    return Tests::Finish("TrigTableBenchmark");
+}
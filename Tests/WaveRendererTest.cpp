@@ -0,0 +1,82 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// WaveRendererTest.cpp: Runs WaveRenderer against the recording canvas and
+// checks that a frame tessellates the waveform once however many glow
+// layers and reflections restroke it.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "TestHarness.h"
+#include "RecordingCanvas.h"
+#include "Graphics/Visualizers/WaveRenderer.h"
+#include "Graphics/Visualizers/Settings/QualityPresets.h"
+
+namespace Spectrum {
+namespace {
+
+    SpectrumData MakeSpectrum(size_t bars) {
+        SpectrumData spectrum(bars, 0.0f);
+        for (size_t i = 0; i < bars; ++i)
+            spectrum[i] = 0.2f + 0.6f * static_cast<float>(i % 7) / 6.0f;
+        return spectrum;
+    }
+
+    // Strokes a frame issues at `quality`: shadow pass plus main line when
+    // filled and mirrored, each glow layer, the main line, and a reflection
+    // of each of those when mirrored.
+    size_t ExpectedStrokes(RenderQuality quality) {
+        const auto settings = QualityPresets::Get<WaveRenderer>(quality);
+        const size_t mirror = settings.useMirror ? 2 : 1;
+        const size_t layers = settings.useFill ? static_cast<size_t>(settings.points / 64) : 0;
+        const size_t shadow = settings.useFill && settings.useMirror ? 2 : 0;
+        return shadow + layers * mirror + mirror;
+    }
+
+    void TestOneBuildPerFrameAtEveryQuality() {
+        WaveRenderer renderer;
+        renderer.OnActivate(800, 400);
+        Canvas canvas(nullptr, nullptr);
+        const SpectrumData spectrum = MakeSpectrum(128);
+
+        size_t mostStrokes = 0;
+        for (int q = 0; q < static_cast<int>(RenderQuality::Count); ++q) {
+            const auto quality = static_cast<RenderQuality>(q);
+            renderer.SetQuality(quality);
+
+            for (int frame = 0; frame < 3; ++frame) {
+                canvas.ResetFrameArena();
+                Tests::Recording().Clear();
+
+                renderer.Render(canvas, spectrum, FRAME_TIME);
+
+                const auto& recording = Tests::Recording();
+                CHECK(recording.geometryBuilds == 1);
+                CHECK(canvas.GetGeometryBuildCount() == 1);
+                CHECK(recording.draws.size() == ExpectedStrokes(quality));
+                CHECK(recording.transformDepth == 0);
+                mostStrokes = std::max(mostStrokes, recording.draws.size());
+            }
+        }
+
+        // The top tier has many passes, all over the one geometry.
+        CHECK(mostStrokes > 8);
+    }
+
+    void TestEmptySpectrumBuildsNothing() {
+        WaveRenderer renderer;
+        renderer.OnActivate(800, 400);
+        Canvas canvas(nullptr, nullptr);
+
+        Tests::Recording().Clear();
+        renderer.Render(canvas, SpectrumData(1, 0.5f), FRAME_TIME);
+        CHECK(Tests::Recording().geometryBuilds == 0);
+        CHECK(Tests::Recording().draws.empty());
+    }
+
+} // namespace
+} // namespace Spectrum
+
+int main() {
+    using namespace Spectrum;
+    TestOneBuildPerFrameAtEveryQuality();
+    TestEmptySpectrumBuildsNothing();
+    return Tests::Finish("WaveRendererTest");
+}
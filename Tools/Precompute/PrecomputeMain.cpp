@@ -0,0 +1,193 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// PrecomputeMain.cpp: Console batch tool that analyses every WAV file in a
+// directory and writes one spectral track per file. Files are spread over
+// worker threads; when there are fewer files than threads, the spare
+// threads split each file into independent chunks instead.
+//
+// Usage: SpectrumPrecompute <input-dir> <output-dir>
+//            [--threads N] [--bars N] [--fft N] [--scale linear|log|mel]
+//            [--bits 8|12]
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "Audio/Offline/SpectralTrackFile.h"
+#include "Audio/Offline/SpectrumPrecomputer.h"
+#include "Audio/Offline/WavFileReader.h"
+#include "Audio/Processing/FFTPlanCache.h"
+#include <cwctype>
+#include <iomanip>
+
+namespace fs = std::filesystem;
+
+namespace Spectrum {
+
+    namespace {
+
+        struct Options {
+            fs::path inputDir;
+            fs::path outputDir;
+            PrecomputeSettings settings;
+            uint32_t bitDepth = 8;
+        };
+
+        struct FileResult {
+            double audioSeconds = 0.0;
+            bool ok = false;
+        };
+
+        void PrintUsage() {
+            std::cout <<
+                "Usage: SpectrumPrecompute <input-dir> <output-dir>\n"
+                "           [--threads N] [--bars N] [--fft N] [--scale linear|log|mel]\n"
+                "           [--bits 8|12]\n";
+        }
+
+        bool ParseScale(const std::wstring& value, SpectrumScale& outScale) {
+            if (value == L"linear") { outScale = SpectrumScale::Linear; return true; }
+            if (value == L"log") { outScale = SpectrumScale::Logarithmic; return true; }
+            if (value == L"mel") { outScale = SpectrumScale::Mel; return true; }
+            return false;
+        }
+
+        // The whole value must be a decimal number; "12abc" or "" is rejected
+        // as 0, which no option accepts.
+        size_t ParseNumber(const std::wstring& value) {
+            if (value.empty() || !std::iswdigit(value.front())) return 0;
+
+            wchar_t* end = nullptr;
+            const unsigned long number = std::wcstoul(value.c_str(), &end, 10);
+            return *end == L'\0' ? static_cast<size_t>(number) : 0;
+        }
+
+        bool ParseOptions(int argc, wchar_t* argv[], Options& out) {
+            // Options come in key/value pairs, so a dangling key is an error.
+            if (argc < 3 || (argc - 3) % 2 != 0) return false;
+
+            out.inputDir = argv[1];
+            out.outputDir = argv[2];
+            out.settings.workerThreads = std::max(1u, std::thread::hardware_concurrency());
+
+            for (int i = 3; i + 1 < argc; i += 2) {
+                const std::wstring key = argv[i];
+                const std::wstring value = argv[i + 1];
+                const size_t number = ParseNumber(value);
+
+                if (key == L"--threads" && number > 0) out.settings.workerThreads = number;
+                else if (key == L"--bars" && number > 0) out.settings.audio.barCount = number;
+                else if (key == L"--fft" && FFTPlanCache::IsSupportedSize(number))
+                    out.settings.audio.fftSize = number;
+                else if (key == L"--scale" && ParseScale(value, out.settings.audio.scaleType)) {}
+                else if (key == L"--bits" && (number == 8 || number == 12))
+                    out.bitDepth = static_cast<uint32_t>(number);
+                else return false;
+            }
+            return true;
+        }
+
+        std::vector<fs::path> CollectInputs(const fs::path& dir) {
+            std::vector<fs::path> files;
+            std::error_code ec;
+            for (const auto& entry : fs::directory_iterator(dir, ec)) {
+                if (!entry.is_regular_file()) continue;
+
+                std::wstring ext = entry.path().extension().wstring();
+                std::transform(ext.begin(), ext.end(), ext.begin(),
+                    [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+                if (ext == L".wav") files.push_back(entry.path());
+            }
+            std::sort(files.begin(), files.end());
+            return files;
+        }
+
+        FileResult ProcessFile(
+            const fs::path& input,
+            const fs::path& outputDir,
+            const SpectrumPrecomputer& precomputer,
+            uint32_t bitDepth
+        ) {
+            FileResult result;
+
+            DecodedAudio audio;
+            if (!WavFileReader::Load(input, audio)) return result;
+
+            SpectralTrack track;
+            if (!precomputer.Process(audio, track)) return result;
+
+            fs::path output = outputDir / input.filename();
+            output.replace_extension(".sptk");
+            if (!SpectralTrackWriter::Write(track, output, bitDepth)) return result;
+
+            result.audioSeconds = audio.GetDurationSeconds();
+            result.ok = true;
+            return result;
+        }
+
+    } // anonymous namespace
+
+    int RunPrecompute(int argc, wchar_t* argv[]) {
+        Options options;
+        if (!ParseOptions(argc, argv, options)) {
+            PrintUsage();
+            return 2;
+        }
+
+        const std::vector<fs::path> inputs = CollectInputs(options.inputDir);
+        if (inputs.empty()) {
+            std::cerr << "No .wav files in " << options.inputDir.u8string() << std::endl;
+            return 1;
+        }
+
+        std::error_code ec;
+        fs::create_directories(options.outputDir, ec);
+
+        const size_t totalThreads = options.settings.workerThreads;
+        const size_t fileWorkers = std::min(totalThreads, inputs.size());
+
+        PrecomputeSettings perFile = options.settings;
+        perFile.workerThreads = std::max<size_t>(1, totalThreads / fileWorkers);
+        const SpectrumPrecomputer precomputer(perFile);
+
+        std::atomic<size_t> nextFile{ 0 };
+        std::atomic<size_t> failures{ 0 };
+        std::vector<double> audioSeconds(inputs.size(), 0.0);
+        std::mutex printMutex;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        auto worker = [&] {
+            for (size_t i = nextFile++; i < inputs.size(); i = nextFile++) {
+                const FileResult r = ProcessFile(
+                    inputs[i], options.outputDir, precomputer, options.bitDepth);
+                audioSeconds[i] = r.audioSeconds;
+                if (!r.ok) ++failures;
+
+                std::lock_guard<std::mutex> lock(printMutex);
+                std::cout << (r.ok ? "  ok    " : "  FAIL  ")
+                    << inputs[i].filename().u8string() << std::endl;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < fileWorkers; ++t) threads.emplace_back(worker);
+        worker();
+        for (auto& t : threads) t.join();
+
+        const double wallSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        const double totalAudio = std::accumulate(audioSeconds.begin(), audioSeconds.end(), 0.0);
+        const double rate = wallSeconds > 0.0 ? totalAudio / wallSeconds : 0.0;
+
+        std::cout << std::fixed << std::setprecision(1)
+            << inputs.size() - failures << "/" << inputs.size() << " files, "
+            << totalAudio << " s audio in " << wallSeconds << " s wall ("
+            << fileWorkers << " file workers x " << perFile.workerThreads << " chunk threads)\n"
+            << "throughput: " << rate << " audio-s/wall-s, "
+            << rate / static_cast<double>(totalThreads) << " per core" << std::endl;
+
+        return failures > 0 ? 1 : 0;
+    }
+
+} // namespace Spectrum
+
+int wmain(int argc, wchar_t* argv[]) {
+    return Spectrum::RunPrecompute(argc, argv);
+}
@@ -0,0 +1,99 @@
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+// SamplePlugin.cpp: Minimal renderer plugin - thin bars with falling peak
+// dots. Doubles as a template: everything a plugin needs is
+// SpectrumPlugin.h. The peak heights are the plugin's state and survive a
+// hot reload through saveState/create.
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+#include "Graphics/Plugins/SpectrumPlugin.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace {
+
+    constexpr uint32_t kStateMagic = 0x53504B31; // 'SPK1'
+    constexpr float kPeakFallPerSecond = 0.6f;
+    constexpr float kBarGap = 2.0f;
+    constexpr float kDotHeight = 3.0f;
+
+    struct Instance {
+        std::vector<float> peaks;
+    };
+
+    void* Create(const void* state, uint32_t stateSize) {
+        auto* self = new (std::nothrow) Instance();
+        if (!self) return nullptr;
+
+        // Header word, then the peaks; anything else starts fresh.
+        uint32_t magic = 0;
+        if (state && stateSize >= sizeof(magic) && (stateSize - sizeof(magic)) % sizeof(float) == 0) {
+            std::memcpy(&magic, state, sizeof(magic));
+            if (magic == kStateMagic) {
+                self->peaks.resize((stateSize - sizeof(magic)) / sizeof(float));
+                std::memcpy(self->peaks.data(),
+                    static_cast<const uint8_t*>(state) + sizeof(magic),
+                    self->peaks.size() * sizeof(float));
+            }
+        }
+        return self;
+    }
+
+    void Destroy(void* instance) {
+        delete static_cast<Instance*>(instance);
+    }
+
+    uint32_t SaveState(void* instance, void* buffer, uint32_t capacity) {
+        const auto* self = static_cast<const Instance*>(instance);
+        const uint32_t size = static_cast<uint32_t>(sizeof(kStateMagic) + self->peaks.size() * sizeof(float));
+        if (!buffer || capacity < size) return size;
+
+        std::memcpy(buffer, &kStateMagic, sizeof(kStateMagic));
+        std::memcpy(static_cast<uint8_t*>(buffer) + sizeof(kStateMagic),
+            self->peaks.data(), self->peaks.size() * sizeof(float));
+        return size;
+    }
+
+    void Render(void* instance, const SpFrame* frame, const SpDraw* draw) {
+        auto* self = static_cast<Instance*>(instance);
+        if (frame->binCount == 0) return;
+
+        self->peaks.resize(frame->binCount, 0.0f);
+
+        const float slot = frame->width / static_cast<float>(frame->binCount);
+        const float barWidth = std::max(1.0f, slot - kBarGap);
+        const float fall = kPeakFallPerSecond * frame->deltaTime;
+
+        SpColor dim = frame->primary;
+        dim.a *= 0.35f;
+
+        for (uint32_t i = 0; i < frame->binCount; ++i) {
+            const float v = std::clamp(frame->bins[i], 0.0f, 1.0f);
+            float& peak = self->peaks[i];
+            peak = std::max(v, peak - fall);
+
+            const float x = i * slot + kBarGap * 0.5f;
+            const float h = v * frame->height;
+            draw->fillRect(draw->context, x, frame->height - h, barWidth, h, dim);
+
+            const float py = frame->height - peak * frame->height;
+            draw->fillRect(draw->context, x, py - kDotHeight, barWidth, kDotHeight, frame->primary);
+        }
+    }
+
+    const SpPluginApi kApi = {
+        SPECTRUM_PLUGIN_ABI_VERSION,
+        sizeof(SpPluginApi),
+        "Peak Dots",
+        Create,
+        Destroy,
+        Render,
+        SaveState
+    };
+}
+
+extern "C" SPECTRUM_PLUGIN_EXPORT const SpPluginApi* SpectrumPluginGetApi(void) {
+    return &kApi;
+}
@@ -39,7 +39,7 @@ namespace Spectrum {
         static constexpr const char* k[] = {
             "Bars", "Wave", "Circular Wave", "Cubes", "Fire",
             "LED Panel", "Gauge", "Kenwood Bars", "Particles",
-            "Matrix LED", "Sphere", "Sunburst"
+            "Matrix LED", "Sphere", "Sunburst", "Plugin"
         };
         auto i = static_cast<size_t>(s);
         return i < static_cast<size_t>(RenderStyle::Count) ? k[i] : "Unknown";
@@ -54,6 +54,8 @@ namespace Spectrum {
     {
         if (!ctrl || !wm)
             throw std::invalid_argument("UIManager: null dependency");
+
+        m_color = ctrl->GetPrimaryColor();
     }
 
     UIManager::~UIManager() noexcept { Shutdown(); }
@@ -362,7 +364,8 @@ namespace Spectrum {
 
     bool UIManager::FancySliderFloat(
         const char* label, float* v,
-        float mn, float mx, const char* fmt)
+        float mn, float mx, const char* fmt,
+        ImGuiSliderFlags flags)
     {
         char valBuf[32];
         snprintf(valBuf, sizeof(valBuf), fmt,
@@ -391,9 +394,12 @@ namespace Spectrum {
 
         char id[64];
         snprintf(id, sizeof(id), "##sl_%s", label);
-        bool changed = ImGui::SliderFloat(id, v, mn, mx, "");
+        bool changed = ImGui::SliderFloat(id, v, mn, mx, "", flags);
 
-        const float t = (mx > mn) ? (*v - mn) / (mx - mn) : 0.0f;
+        const bool logarithmic = (flags & ImGuiSliderFlags_Logarithmic) && mn > 0.0f;
+        const float t = (mx <= mn) ? 0.0f
+            : logarithmic ? std::log(*v / mn) / std::log(mx / mn)
+            : (*v - mn) / (mx - mn);
         DrawSliderTrack(ImGui::GetItemRectMin(),
             ImGui::GetItemRectMax(), t);
 
@@ -523,6 +529,7 @@ namespace Spectrum {
             if (ImGui::BeginCombo("##rnd", cur)) {
                 for (int i = 0; i < static_cast<int>(RenderStyle::Count); ++i) {
                     const auto s = static_cast<RenderStyle>(i);
+                    if (!rm->IsAvailable(s)) continue;
                     const bool sel = (rm->GetCurrentStyle() == s);
                     ImGui::PushStyleColor(ImGuiCol_Header,
                         WithAlpha(T::accent, T::alphaDim));
@@ -565,6 +572,12 @@ namespace Spectrum {
 
         ImGui::Spacing();
 
+        // Noise floor removal and per-bar whitening; see SpectralWhitener.
+        if (AccentButton(am->IsWhitening() ? "Whitening: On###Whitening" : "Whitening: Off###Whitening"))
+            am->SetWhitening(!am->IsWhitening());
+
+        ImGui::Spacing();
+
         LabeledCombo("FFT Window",
             am->GetFFTWindowName(),
             am->GetAvailableFFTWindows(),
@@ -572,6 +585,13 @@ namespace Spectrum {
 
         ImGui::Spacing();
 
+        LabeledCombo("FFT Size",
+            std::to_string(am->GetFFTSize()),
+            am->GetAvailableFFTSizes(),
+            [am](const std::string& n) { am->SetFFTSizeByName(n); });
+
+        ImGui::Spacing();
+
         LabeledCombo("Scale",
             am->GetSpectrumScaleName(),
             am->GetAvailableSpectrumScales(),
@@ -579,11 +599,28 @@ namespace Spectrum {
 
         ImGui::Spacing();
 
+        float lo = am->GetWindowMinHz();
+        float hi = am->GetWindowMaxHz();
+        bool windowChanged = FancySliderFloat("Zoom From", &lo,
+            20.0f, 20000.0f, "%.0f Hz", ImGuiSliderFlags_Logarithmic);
+        windowChanged |= FancySliderFloat("Zoom To", &hi,
+            20.0f, 20000.0f, "%.0f Hz", ImGuiSliderFlags_Logarithmic);
+        if (windowChanged)
+            am->SetFrequencyWindow(lo, hi);
+
+        if (am->IsFrequencyZoomed() && AccentButton("Full Range"))
+            am->ResetFrequencyWindow();
+
+        ImGui::Spacing();
+
         if (AccentButton("Reset to Defaults")) {
             am->SetAmplification(DEFAULT_AMPLIFICATION);
             am->SetSmoothing(DEFAULT_SMOOTHING);
+            am->SetWhitening(false);
             am->SetBarCount(DEFAULT_BAR_COUNT);
             am->SetFFTWindowByName("Hann");
+            am->SetFFTSize(DEFAULT_FFT_SIZE);
+            am->ResetFrequencyWindow();
             am->SetSpectrumScaleByName("Logarithmic");
         }
 
@@ -167,7 +167,8 @@ namespace Spectrum {
 
         bool FancySliderFloat(
             const char* label, float* v,
-            float mn, float mx, const char* fmt = "%.2f");
+            float mn, float mx, const char* fmt = "%.2f",
+            ImGuiSliderFlags flags = 0);
         bool FancySliderInt(
             const char* label, int* v, int mn, int mx);
         void DrawSliderTrack(ImVec2 mn, ImVec2 mx, float t);